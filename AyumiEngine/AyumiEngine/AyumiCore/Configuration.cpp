@@ -28,6 +28,12 @@ namespace AyumiEngine
 			msaaLevel = 0;
 			fullscreenEnabled = false;
 			vSyncEnabled = false;
+			offscreenEnabled = false;
+			depthPrePassEnabled = false;
+			dynamicResolutionEnabled = false;
+			minResolutionScale = 0.5f;
+			maxResolutionScale = 1.0f;
+			targetFrameTime = 16.6f;
 			prepareConfigScript();
 		}
 
@@ -63,6 +69,12 @@ namespace AyumiEngine
 				.def("setMSAALevel",&Configuration::setMSAALevel)
 				.def("setFullscreenEnabled",&Configuration::setFullscreenEnabled)
 				.def("setVSyncEnabled",&Configuration::setVSyncEnabled)
+				.def("setOffscreenEnabled",&Configuration::setOffscreenEnabled)
+				.def("setDepthPrePassEnabled",&Configuration::setDepthPrePassEnabled)
+				.def("setDynamicResolutionEnabled",&Configuration::setDynamicResolutionEnabled)
+				.def("setMinResolutionScale",&Configuration::setMinResolutionScale)
+				.def("setMaxResolutionScale",&Configuration::setMaxResolutionScale)
+				.def("setTargetFrameTime",&Configuration::setTargetFrameTime)
 				.def("setWindowCaption",&Configuration::setWindowCaption)
 				.def("setTextureScriptName",&Configuration::setTextureScriptName)
 				.def("setMeshScriptName",&Configuration::setMeshScriptName)
@@ -150,6 +162,60 @@ namespace AyumiEngine
 			return vSyncEnabled;
 		}
 
+		/**
+		 * Accessor to off-screen rendering enabled private flag member.
+		 * @return	true if engine render without window, false otherwise.
+		 */
+		bool Configuration::isOffscreenEnabled() const
+		{
+			return offscreenEnabled;
+		}
+
+		/**
+		 * Accessor to depth pre-pass enabled private flag member.
+		 * @return	true if materials with depth shader are drawn in depth pre-pass, false otherwise.
+		 */
+		bool Configuration::isDepthPrePassEnabled() const
+		{
+			return depthPrePassEnabled;
+		}
+
+		/**
+		 * Accessor to dynamic resolution enabled private flag member.
+		 * @return	true if resolution of scene and post-process passes is adapted to frame time, false otherwise.
+		 */
+		bool Configuration::isDynamicResolutionEnabled() const
+		{
+			return dynamicResolutionEnabled;
+		}
+
+		/**
+		 * Accessor to minimal resolution scale private member.
+		 * @return	minimal resolution scale value.
+		 */
+		float Configuration::getMinResolutionScale() const
+		{
+			return minResolutionScale;
+		}
+
+		/**
+		 * Accessor to maximal resolution scale private member.
+		 * @return	maximal resolution scale value.
+		 */
+		float Configuration::getMaxResolutionScale() const
+		{
+			return maxResolutionScale;
+		}
+
+		/**
+		 * Accessor to target frame time private member.
+		 * @return	frame time budget in milliseconds.
+		 */
+		float Configuration::getTargetFrameTime() const
+		{
+			return targetFrameTime;
+		}
+
 		/**
 		 * Accessor to window caption private member.
 		 * @return	window caption value.
@@ -275,6 +341,62 @@ namespace AyumiEngine
 			this->vSyncEnabled = enabled;
 		}
 
+		/**
+		 * Setter for private off-screen rendering enabled flag member. Off-screen engine has no window and
+		 * render into screen FBO, it is used by render harness.
+		 * @param	enabled is flag bool value.
+		 */
+		void Configuration::setOffscreenEnabled(const bool enabled)
+		{
+			this->offscreenEnabled = enabled;
+		}
+
+		/**
+		 * Setter for private depth pre-pass enabled flag member. It can be changed between frames.
+		 * @param	enabled is flag bool value.
+		 */
+		void Configuration::setDepthPrePassEnabled(const bool enabled)
+		{
+			this->depthPrePassEnabled = enabled;
+		}
+
+		/**
+		 * Setter for private dynamic resolution enabled flag member. It can be changed between frames, scene
+		 * is rendered in full resolution when flag is disabled.
+		 * @param	enabled is flag bool value.
+		 */
+		void Configuration::setDynamicResolutionEnabled(const bool enabled)
+		{
+			this->dynamicResolutionEnabled = enabled;
+		}
+
+		/**
+		 * Setter for private minimal resolution scale member.
+		 * @param	scale is new minimal resolution scale value.
+		 */
+		void Configuration::setMinResolutionScale(const float scale)
+		{
+			this->minResolutionScale = scale;
+		}
+
+		/**
+		 * Setter for private maximal resolution scale member.
+		 * @param	scale is new maximal resolution scale value.
+		 */
+		void Configuration::setMaxResolutionScale(const float scale)
+		{
+			this->maxResolutionScale = scale;
+		}
+
+		/**
+		 * Setter for private target frame time member.
+		 * @param	time is new frame time budget in milliseconds.
+		 */
+		void Configuration::setTargetFrameTime(const float time)
+		{
+			this->targetFrameTime = time;
+		}
+
 		/**
 		 * Setter for private window caption member.
 		 * @param	caption is new constant window caption value.
@@ -34,6 +34,12 @@ namespace AyumiEngine
 			int msaaLevel;
 			bool fullscreenEnabled;
 			bool vSyncEnabled;
+			bool offscreenEnabled;
+			bool depthPrePassEnabled;
+			bool dynamicResolutionEnabled;
+			float minResolutionScale;
+			float maxResolutionScale;
+			float targetFrameTime;
 			std::string* windowCaption;
 			std::string* textureScriptName;
 			std::string* meshScriptName;
@@ -59,6 +65,12 @@ namespace AyumiEngine
 			int getMSAALevel() const;
 			bool isFullscreenEnabled() const;
 			bool isVSyncEnabled() const;
+			bool isOffscreenEnabled() const;
+			bool isDepthPrePassEnabled() const;
+			bool isDynamicResolutionEnabled() const;
+			float getMinResolutionScale() const;
+			float getMaxResolutionScale() const;
+			float getTargetFrameTime() const;
 			std::string* getWindowCaption() const;
 			std::string* getTextureScriptName() const;
 			std::string* getMeshScriptName() const;
@@ -74,6 +86,12 @@ namespace AyumiEngine
 			void setMSAALevel(const int msaaLevel);
 			void setFullscreenEnabled(const bool enabled);
 			void setVSyncEnabled(const bool enabled);
+			void setOffscreenEnabled(const bool enabled);
+			void setDepthPrePassEnabled(const bool enabled);
+			void setDynamicResolutionEnabled(const bool enabled);
+			void setMinResolutionScale(const float scale);
+			void setMaxResolutionScale(const float scale);
+			void setTargetFrameTime(const float time);
 			void setWindowCaption(const std::string& caption);
 			void setTextureScriptName(const std::string& name);
 			void setMeshScriptName(const std::string& name);
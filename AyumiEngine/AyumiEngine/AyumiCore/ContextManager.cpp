@@ -25,14 +25,27 @@ namespace AyumiEngine
 			msaaLevel = Configuration::getInstance()->getMSAALevel();
 			windowCaption = *Configuration::getInstance()->getWindowCaption();
 			fullScreenEnabled =  Configuration::getInstance()->isFullscreenEnabled();
+			offscreenEnabled = Configuration::getInstance()->isOffscreenEnabled();
+			contextWindow = nullptr;
+			offscreenContext = nullptr;
+			screenFrameBuffer = 0;
+			screenColorBuffer = 0;
+			screenDepthBuffer = 0;
 		}
 
 		/**
-		 * Class destructor, free allocated memory for context window.
+		 * Class destructor, free allocated memory for screen FBO and context.
 		 */
 		ContextManager::~ContextManager()
 		{
-
+			if(screenFrameBuffer != 0)
+			{
+				glDeleteFramebuffers(1,&screenFrameBuffer);
+				glDeleteRenderbuffers(1,&screenColorBuffer);
+				glDeleteRenderbuffers(1,&screenDepthBuffer);
+				AyumiUtils::FrameBufferObject::setDefaultFrameBuffer(0);
+			}
+			delete offscreenContext;
 		}
 
 		/**
@@ -41,9 +54,15 @@ namespace AyumiEngine
 		void ContextManager::initializeContextManager()
 		{
 			initializeContext();
-			resizeWindow(resolutionWidth, resolutionHeight);
 			initializeOpenGL();
+			if(offscreenEnabled)
+			{
+				initializeScreenFrameBuffer();
+				resizeWindow(resolutionWidth, resolutionHeight);
+				return;
+			}
 
+			resizeWindow(resolutionWidth, resolutionHeight);
 			contextWindow->setActive();
 			sf::Mouse::setPosition(sf::Vector2i(resolutionWidth/2,resolutionHeight/2),*contextWindow);
 			contextWindow->setMouseCursorVisible(false);
@@ -65,6 +84,13 @@ namespace AyumiEngine
 			contextVideoMode.width = resolutionWidth;
 			contextVideoMode.bitsPerPixel = colorDepth;
 
+			if(offscreenEnabled)
+			{
+				offscreenContext = new Context(contextSettings,resolutionWidth,resolutionHeight);
+				offscreenContext->setActive(true);
+				return;
+			}
+
 			if(fullScreenEnabled)
 				contextWindow = new Window(contextVideoMode,windowCaption,sf::Style::Fullscreen,contextSettings);
 			else
@@ -97,6 +123,36 @@ namespace AyumiEngine
 			}
 		}
 
+		/**
+		 * Private method which is used to create screen FBO of off-screen context. FBO has RGBA color and
+		 * depth/stencil render buffers of context resolution and it replace window frame buffer.
+		 */
+		void ContextManager::initializeScreenFrameBuffer()
+		{
+			glGenRenderbuffers(1,&screenColorBuffer);
+			glBindRenderbuffer(GL_RENDERBUFFER,screenColorBuffer);
+			glRenderbufferStorage(GL_RENDERBUFFER,GL_RGBA8,resolutionWidth,resolutionHeight);
+			glGenRenderbuffers(1,&screenDepthBuffer);
+			glBindRenderbuffer(GL_RENDERBUFFER,screenDepthBuffer);
+			glRenderbufferStorage(GL_RENDERBUFFER,GL_DEPTH24_STENCIL8,resolutionWidth,resolutionHeight);
+			glBindRenderbuffer(GL_RENDERBUFFER,0);
+
+			glGenFramebuffers(1,&screenFrameBuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER,screenFrameBuffer);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER,GL_COLOR_ATTACHMENT0,GL_RENDERBUFFER,screenColorBuffer);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER,GL_DEPTH_STENCIL_ATTACHMENT,GL_RENDERBUFFER,screenDepthBuffer);
+			glDrawBuffer(GL_COLOR_ATTACHMENT0);
+			glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+			if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Screen FrameBuffer creation error occurred!"));
+				Logger::getInstance()->saveLog(Log<string>("Application close - critical error!"));
+				exit(0);
+			}
+			AyumiUtils::FrameBufferObject::setDefaultFrameBuffer(screenFrameBuffer);
+		}
+
 		/**
 		 * Method is used to resize application window and set OpenGL viewport.
 		 * @param	windowWidth is application window resolution width.
@@ -113,7 +169,50 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Accessor to context window private pointer.
+		 * Method is used to finish frame. Window context swap buffers, off-screen context flush commands.
+		 */
+		void ContextManager::displayFrame()
+		{
+			if(contextWindow != nullptr)
+				contextWindow->display();
+			else
+				glFlush();
+		}
+
+		/**
+		 * Method is used to read pixels of last rendered frame from default frame buffer. Rows are stored
+		 * bottom-up as RGBA bytes.
+		 * @param	pixels is reference to vector which store read pixels.
+		 */
+		void ContextManager::readScreenPixels(vector<unsigned char>& pixels) const
+		{
+			pixels.resize(resolutionWidth*resolutionHeight*4);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER,screenFrameBuffer);
+			glReadBuffer(screenFrameBuffer != 0 ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+			glPixelStorei(GL_PACK_ALIGNMENT,1);
+			glReadPixels(0,0,resolutionWidth,resolutionHeight,GL_RGBA,GL_UNSIGNED_BYTE,&pixels[0]);
+		}
+
+		/**
+		 * Method is used to check if context is still open. Off-screen context is open until it is released.
+		 * @return	true if context is open, false otherwise.
+		 */
+		bool ContextManager::isContextOpen() const
+		{
+			return contextWindow != nullptr ? contextWindow->isOpen() : offscreenContext != nullptr;
+		}
+
+		/**
+		 * Accessor to off-screen context flag.
+		 * @return	true if context has no window, false otherwise.
+		 */
+		bool ContextManager::isOffscreen() const
+		{
+			return offscreenEnabled;
+		}
+
+		/**
+		 * Accessor to context window private pointer. Off-screen context has no window.
 		 * @return	pointer to context window.
 		 */
 		Window* ContextManager::getContextWindow() const
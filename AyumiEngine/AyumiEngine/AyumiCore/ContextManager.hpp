@@ -11,6 +11,7 @@
 #include <GL/glew.h>
 #include <SFML/Window.hpp>
 #include <string>
+#include <vector>
 
 #include "Configuration.hpp"
 #include "../Logger.hpp"
@@ -23,12 +24,17 @@ namespace AyumiEngine
 		 * Class represents main Engine Core class - ContextManager which is used
 		 * to create window and OpenGL context. Class is also used to initialize OpenGL
 		 * state mashine. Use Configuration class to get resolution and other data.
-		 * ContextManager use SFML library to create multi-platform code.
+		 * ContextManager use SFML library to create multi-platform code. Off-screen context has no window,
+		 * engine render into screen FBO which replace window frame buffer and frames are read back.
 		 */
 		class ContextManager
 		{
 		private:
 			sf::Window* contextWindow; 
+			sf::Context* offscreenContext;
+			GLuint screenFrameBuffer;
+			GLuint screenColorBuffer;
+			GLuint screenDepthBuffer;
 			sf::ContextSettings contextSettings;
 			sf::VideoMode contextVideoMode;
 			int resolutionHeight;
@@ -37,9 +43,11 @@ namespace AyumiEngine
 			int msaaLevel;
 			std::string windowCaption;
 			bool fullScreenEnabled;
+			bool offscreenEnabled;
 
 			void initializeContext();
 			void initializeOpenGL();
+			void initializeScreenFrameBuffer();
 
 		public:
 			ContextManager();
@@ -47,6 +55,10 @@ namespace AyumiEngine
 
 			void initializeContextManager();
 			void resizeWindow(int windowWidth, int windowHeight);
+			void displayFrame();
+			void readScreenPixels(std::vector<unsigned char>& pixels) const;
+			bool isContextOpen() const;
+			bool isOffscreen() const;
 
 			sf::Window* getContextWindow() const;
 			int getResolutionHeight() const;
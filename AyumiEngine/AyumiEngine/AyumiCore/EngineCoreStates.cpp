@@ -6,19 +6,29 @@
  */
 
 #include "EngineCoreStates.hpp"
+#include "StateMachine.hpp"
 
 namespace AyumiEngine
 {
 	namespace AyumiCore
 	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	stateMachine is pointer to StateMachine which shadow depth testing state.
+		 */
+		Depth::Depth(StateMachine* stateMachine)
+		{
+			this->stateMachine = stateMachine;
+		}
+
 		/**
 		 * Method is used to set Depth state to on state - turn on Engine depth testing.
 		 */
 		void Depth::on()
 		{
-			glEnable(GL_DEPTH_TEST);
-			glDepthFunc(GL_LEQUAL);
-			glDepthMask(GL_TRUE);
+			stateMachine->setCapability(GL_DEPTH_TEST,true);
+			stateMachine->setDepthFunction(GL_LEQUAL);
+			stateMachine->setDepthMask(true);
 		}
 
 		/**
@@ -26,8 +36,17 @@ namespace AyumiEngine
 		 */
 		void Depth::off()
 		{
-			glDisable(GL_DEPTH_TEST);
-			glDepthMask(GL_FALSE);
+			stateMachine->setCapability(GL_DEPTH_TEST,false);
+			stateMachine->setDepthMask(false);
+		}
+
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	stateMachine is pointer to StateMachine which shadow blending state.
+		 */
+		Blend::Blend(StateMachine* stateMachine)
+		{
+			this->stateMachine = stateMachine;
 		}
 
 		/**
@@ -35,8 +54,8 @@ namespace AyumiEngine
 		 */
 		void Blend::on()
 		{
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			stateMachine->setCapability(GL_BLEND,true);
+			stateMachine->setBlendFunction(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
 		}
 
 		/**
@@ -44,7 +63,16 @@ namespace AyumiEngine
 		 */
 		void Blend::off()
 		{
-			glDisable(GL_BLEND);
+			stateMachine->setCapability(GL_BLEND,false);
+		}
+
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	stateMachine is pointer to StateMachine which shadow wireframe rendering state.
+		 */
+		Wireframe::Wireframe(StateMachine* stateMachine)
+		{
+			this->stateMachine = stateMachine;
 		}
 
 		/**
@@ -52,8 +80,7 @@ namespace AyumiEngine
 		 */
 		void Wireframe::on()
 		{
-			glPolygonMode(GL_FRONT,GL_LINE);
-			glPolygonMode(GL_BACK,GL_LINE);
+			stateMachine->setPolygonMode(GL_LINE);
 		}
 
 		/**
@@ -61,8 +88,16 @@ namespace AyumiEngine
 		 */
 		void Wireframe::off()
 		{
-			glPolygonMode(GL_FRONT,GL_FILL);
-			glPolygonMode(GL_BACK,GL_FILL);
+			stateMachine->setPolygonMode(GL_FILL);
+		}
+
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	stateMachine is pointer to StateMachine which shadow back face culling state.
+		 */
+		BackCulling::BackCulling(StateMachine* stateMachine)
+		{
+			this->stateMachine = stateMachine;
 		}
 
 		/**
@@ -70,8 +105,8 @@ namespace AyumiEngine
 		 */
 		void BackCulling::on()
 		{
-			glCullFace(GL_BACK);
-			glEnable(GL_CULL_FACE);
+			stateMachine->setCullFace(GL_BACK);
+			stateMachine->setCapability(GL_CULL_FACE,true);
 		}
 
 		/**
@@ -80,7 +115,7 @@ namespace AyumiEngine
 		 */
 		void BackCulling::off()
 		{
-			glDisable(GL_CULL_FACE);
+			stateMachine->setCapability(GL_CULL_FACE,false);
 		}
 	}
 }
@@ -16,12 +16,19 @@ namespace AyumiEngine
 {
 	namespace AyumiCore
 	{
+		class StateMachine;
+
 		/**
 		 * Class represents depth testing on/off state. It is implementaion of binary State design pattern.
 		 */
 		class Depth : public AyumiUtils::State
 		{
+		private:
+			StateMachine* stateMachine;
+
 		public:
+			Depth(StateMachine* stateMachine);
+
 			void on();
 			void off();
 		};
@@ -31,7 +38,12 @@ namespace AyumiEngine
 		 */
 		class Blend : public AyumiUtils::State
 		{
+		private:
+			StateMachine* stateMachine;
+
 		public:
+			Blend(StateMachine* stateMachine);
+
 			void on();
 			void off();
 		};
@@ -41,7 +53,12 @@ namespace AyumiEngine
 		 */
 		class Wireframe : public AyumiUtils::State
 		{
+		private:
+			StateMachine* stateMachine;
+
 		public:
+			Wireframe(StateMachine* stateMachine);
+
 			void on();
 			void off();
 		};
@@ -51,7 +68,12 @@ namespace AyumiEngine
 		 */
 		class BackCulling : public AyumiUtils::State
 		{
+		private:
+			StateMachine* stateMachine;
+
 		public:
+			BackCulling(StateMachine* stateMachine);
+
 			void on();
 			void off();
 		};
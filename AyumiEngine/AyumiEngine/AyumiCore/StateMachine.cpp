@@ -0,0 +1,331 @@
+/**
+ * File contains definition of StateMachine class.
+ * @file    StateMachine.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-23
+ */
+
+#include "StateMachine.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiCore
+	{
+		/**
+		 * Class default constructor. Whole state is unknown until it is set for the first time.
+		 */
+		StateMachine::StateMachine() : depthState(this), blendState(this), wireframeState(this), backCullingState(this)
+		{
+			invalidateState();
+			resetStatistics();
+		}
+
+		/**
+		 * Class destructor, nothing to delete.
+		 */
+		StateMachine::~StateMachine()
+		{
+
+		}
+
+		/**
+		 * Method is used to apply render state block. Only states which differ from current ones are set.
+		 * @param	state is reference to applied render state block.
+		 */
+		void StateMachine::applyRenderState(const RenderState& state)
+		{
+			setCapability(GL_DEPTH_TEST,state.depthTest);
+			setDepthFunction(state.depthFunction);
+			setDepthMask(state.depthWrite);
+			setCapability(GL_BLEND,state.blend);
+			setBlendFunction(state.blendSource,state.blendDestination);
+			setCapability(GL_CULL_FACE,state.cullFace);
+			setCullFace(state.cullMode);
+			setColorMask(state.colorWrite,state.colorWrite,state.colorWrite,state.colorWrite);
+		}
+
+		/**
+		 * Method is used to enable or disable OpenGL capability. Capabilities which are not shadowed are
+		 * always set.
+		 * @param	capability is OpenGL capability enumeration.
+		 * @param	enable is new capability state.
+		 */
+		void StateMachine::setCapability(const GLenum capability, const bool enable)
+		{
+			const StateCapability index = getCapability(capability);
+			if(index != MAX_STATE_CAPABILITIES)
+			{
+				if(isRedundant(capabilities[index] == static_cast<GLuint>(enable)))
+					return;
+				capabilities[index] = enable;
+			}
+			else
+				isRedundant(false);
+
+			if(enable)
+				glEnable(capability);
+			else
+				glDisable(capability);
+		}
+
+		/**
+		 * Method is used to set depth test function.
+		 * @param	function is depth comparison function.
+		 */
+		void StateMachine::setDepthFunction(const GLenum function)
+		{
+			if(isRedundant(depthFunction == function))
+				return;
+			depthFunction = function;
+			glDepthFunc(function);
+		}
+
+		/**
+		 * Method is used to enable or disable depth buffer writing.
+		 * @param	write is new depth mask.
+		 */
+		void StateMachine::setDepthMask(const bool write)
+		{
+			if(isRedundant(depthMask == static_cast<GLuint>(write)))
+				return;
+			depthMask = write;
+			glDepthMask(write ? GL_TRUE : GL_FALSE);
+		}
+
+		/**
+		 * Method is used to set blending function.
+		 * @param	source is source blending factor.
+		 * @param	destination is destination blending factor.
+		 */
+		void StateMachine::setBlendFunction(const GLenum source, const GLenum destination)
+		{
+			if(isRedundant(blendSource == source && blendDestination == destination))
+				return;
+			blendSource = source;
+			blendDestination = destination;
+			glBlendFunc(source,destination);
+		}
+
+		/**
+		 * Method is used to set culled face.
+		 * @param	mode is culled face enumeration.
+		 */
+		void StateMachine::setCullFace(const GLenum mode)
+		{
+			if(isRedundant(cullMode == mode))
+				return;
+			cullMode = mode;
+			glCullFace(mode);
+		}
+
+		/**
+		 * Method is used to set color buffer write mask.
+		 * @param	red is red channel write flag.
+		 * @param	green is green channel write flag.
+		 * @param	blue is blue channel write flag.
+		 * @param	alpha is alpha channel write flag.
+		 */
+		void StateMachine::setColorMask(const bool red, const bool green, const bool blue, const bool alpha)
+		{
+			const GLuint mask = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+			if(isRedundant(colorMask == mask))
+				return;
+			colorMask = mask;
+			glColorMask(red,green,blue,alpha);
+		}
+
+		/**
+		 * Method is used to set polygon rasterization mode of front and back faces.
+		 * @param	mode is polygon mode enumeration.
+		 */
+		void StateMachine::setPolygonMode(const GLenum mode)
+		{
+			if(isRedundant(polygonMode == mode))
+				return;
+			polygonMode = mode;
+			glPolygonMode(GL_FRONT_AND_BACK,mode);
+		}
+
+		/**
+		 * Method is used to bind shader program.
+		 * @param	program is shader program name.
+		 */
+		void StateMachine::bindProgram(const GLuint program)
+		{
+			if(isRedundant(this->program == program))
+				return;
+			this->program = program;
+			glUseProgram(program);
+		}
+
+		/**
+		 * Method is used to bind vertex array object.
+		 * @param	vertexArray is vertex array object name.
+		 */
+		void StateMachine::bindVertexArray(const GLuint vertexArray)
+		{
+			if(isRedundant(this->vertexArray == vertexArray))
+				return;
+			this->vertexArray = vertexArray;
+			glBindVertexArray(vertexArray);
+		}
+
+		/**
+		 * Method is used to select active texture unit.
+		 * @param	unit is texture unit number.
+		 */
+		void StateMachine::setActiveTexture(const unsigned int unit)
+		{
+			if(isRedundant(activeTexture == unit))
+				return;
+			activeTexture = unit;
+			glActiveTexture(GL_TEXTURE0 + unit);
+		}
+
+		/**
+		 * Method is used to bind texture to texture unit. Active texture unit is changed only when texture
+		 * is really bound. Units above shadowed range are always bound.
+		 * @param	unit is texture unit number.
+		 * @param	target is texture target enumeration.
+		 * @param	texture is texture name.
+		 */
+		void StateMachine::bindTexture(const unsigned int unit, const GLenum target, const GLuint texture)
+		{
+			if(unit < MAX_STATE_TEXTURE_UNITS)
+			{
+				if(isRedundant(textureTargets[unit] == target && textures[unit] == texture))
+					return;
+				textureTargets[unit] = target;
+				textures[unit] = texture;
+			}
+			else
+				isRedundant(false);
+
+			setActiveTexture(unit);
+			glBindTexture(target,texture);
+		}
+
+		/**
+		 * Method is used to bind frame buffer object. Default frame buffer is window frame buffer or screen
+		 * FBO of off-screen context.
+		 * @param	frameBuffer is frame buffer object name, 0 is default frame buffer.
+		 */
+		void StateMachine::bindFrameBuffer(const GLuint frameBuffer)
+		{
+			const GLuint boundFrameBuffer = frameBuffer != 0 ? frameBuffer : AyumiUtils::FrameBufferObject::getDefaultFrameBuffer();
+			if(isRedundant(this->frameBuffer == boundFrameBuffer))
+				return;
+			this->frameBuffer = boundFrameBuffer;
+			glBindFramebuffer(GL_FRAMEBUFFER,boundFrameBuffer);
+		}
+
+		/**
+		 * Method is used to set viewport.
+		 * @param	x is left viewport coordinate.
+		 * @param	y is bottom viewport coordinate.
+		 * @param	width is viewport width.
+		 * @param	height is viewport height.
+		 */
+		void StateMachine::setViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+		{
+			if(isRedundant(viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height))
+				return;
+			viewport[0] = x;
+			viewport[1] = y;
+			viewport[2] = width;
+			viewport[3] = height;
+			glViewport(x,y,width,height);
+		}
+
+		/**
+		 * Method is used to forget whole shadowed state, so every state is set again at next request. It is
+		 * used when OpenGL context is recreated.
+		 */
+		void StateMachine::invalidateState()
+		{
+			for(unsigned int i = 0; i < MAX_STATE_CAPABILITIES; ++i)
+				capabilities[i] = UNKNOWN_STATE;
+			depthFunction = UNKNOWN_STATE;
+			depthMask = UNKNOWN_STATE;
+			blendSource = UNKNOWN_STATE;
+			blendDestination = UNKNOWN_STATE;
+			cullMode = UNKNOWN_STATE;
+			colorMask = UNKNOWN_STATE;
+			polygonMode = UNKNOWN_STATE;
+			invalidateBindings();
+		}
+
+		/**
+		 * Method is used to forget shadowed object bindings. Resources, frame buffer objects and sprites bind
+		 * their objects directly, so bindings are invalidated before StateMachine is used after such code.
+		 */
+		void StateMachine::invalidateBindings()
+		{
+			program = UNKNOWN_STATE;
+			vertexArray = UNKNOWN_STATE;
+			activeTexture = UNKNOWN_STATE;
+			for(unsigned int i = 0; i < MAX_STATE_TEXTURE_UNITS; ++i)
+			{
+				textureTargets[i] = UNKNOWN_STATE;
+				textures[i] = UNKNOWN_STATE;
+			}
+			frameBuffer = UNKNOWN_STATE;
+			viewport[0] = viewport[1] = 0;
+			viewport[2] = viewport[3] = -1;
+		}
+
+		/**
+		 * Method is used to reset issued and filtered calls counters.
+		 */
+		void StateMachine::resetStatistics()
+		{
+			statistics.issuedCalls = 0;
+			statistics.filteredCalls = 0;
+		}
+
+		/**
+		 * Method is used to get statistics of issued and filtered calls.
+		 * @return	reference to StateMachine statistics.
+		 */
+		const StateMachineStatistics& StateMachine::getStatistics() const
+		{
+			return statistics;
+		}
+
+		/**
+		 * Private method which is used to count state request.
+		 * @param	redundant is true if requested state is already set.
+		 * @return	redundant value.
+		 */
+		bool StateMachine::isRedundant(const bool redundant)
+		{
+			if(redundant)
+				++statistics.filteredCalls;
+			else
+				++statistics.issuedCalls;
+			return redundant;
+		}
+
+		/**
+		 * Private method which is used to get shadowed capability of OpenGL capability enumeration.
+		 * @param	capability is OpenGL capability enumeration.
+		 * @return	shadowed capability or MAX_STATE_CAPABILITIES if capability is not shadowed.
+		 */
+		StateCapability StateMachine::getCapability(const GLenum capability) const
+		{
+			switch(capability)
+			{
+			case GL_DEPTH_TEST:
+				return DEPTH_TEST_CAPABILITY;
+			case GL_BLEND:
+				return BLEND_CAPABILITY;
+			case GL_CULL_FACE:
+				return CULL_FACE_CAPABILITY;
+			case GL_RASTERIZER_DISCARD:
+				return RASTERIZER_DISCARD_CAPABILITY;
+			default:
+				return MAX_STATE_CAPABILITIES;
+			}
+		}
+	}
+}
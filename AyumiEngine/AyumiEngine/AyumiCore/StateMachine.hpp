@@ -1,5 +1,5 @@
 /**
- * File contains declaraion of StateMachine structure.
+ * File contains declaraion of StateMachine class.
  * @file    StateMachine.hpp
  * @author  Szymon "Veldrin" Jaboski
  * @date    2011-08-06
@@ -8,23 +8,124 @@
 #ifndef STATEMACHINE_HPP
 #define STATEMACHINE_HPP
 
+#include <GL/glew.h>
+
 #include "EngineCoreStates.hpp"
 
+#include "../AyumiUtils/Noncopyable.hpp"
+#include "../AyumiUtils/FrameBufferObject.hpp"
+
 namespace AyumiEngine
 {
 	namespace AyumiCore
 	{
+		const unsigned int MAX_STATE_TEXTURE_UNITS = 16;
+		const GLuint UNKNOWN_STATE = 0xFFFFFFFF;
+
+		/**
+		 * Enumeration represents OpenGL capabilities shadowed by StateMachine.
+		 */
+		enum StateCapability
+		{
+			DEPTH_TEST_CAPABILITY,
+			BLEND_CAPABILITY,
+			CULL_FACE_CAPABILITY,
+			RASTERIZER_DISCARD_CAPABILITY,
+			MAX_STATE_CAPABILITIES
+		};
+
+		/**
+		 * Structure represents immutable block of render state. Block describe whole fixed function state of
+		 * render pass and it is applied by StateMachine as difference to current state.
+		 */
+		struct RenderState
+		{
+			bool depthTest;
+			bool depthWrite;
+			GLenum depthFunction;
+			bool blend;
+			GLenum blendSource;
+			GLenum blendDestination;
+			bool cullFace;
+			GLenum cullMode;
+			bool colorWrite;
+		};
+
+		const RenderState DEFAULT_RENDER_STATE = {true,true,GL_LEQUAL,true,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,true,GL_BACK,true};
+		const RenderState OPAQUE_RENDER_STATE = {true,true,GL_LEQUAL,false,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,true,GL_BACK,true};
+		const RenderState TWO_SIDED_RENDER_STATE = {true,true,GL_LEQUAL,false,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,false,GL_BACK,true};
+		const RenderState TRANSPARENT_RENDER_STATE = {false,false,GL_LEQUAL,true,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,true,GL_BACK,true};
+		const RenderState OVERLAY_RENDER_STATE = {false,false,GL_LEQUAL,true,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,false,GL_BACK,true};
+
+		/**
+		 * Structure represents statistics of StateMachine. Issued calls reached OpenGL, filtered calls were
+		 * skipped because requested state was already set.
+		 */
+		struct StateMachineStatistics
+		{
+			unsigned int issuedCalls;
+			unsigned int filteredCalls;
+		};
+
 		/**
-		 * Structure represents group of Engine inner state machine. Each state implements
-		 * Binary State desgin pattern and represents some OpenGL API state machine effects
-		 * like depth testing, blending and culling operations.
+		 * Class represents Engine inner state machine. It is shadow copy of OpenGL state: capabilities, depth,
+		 * blend, cull face, color mask, polygon mode, bound program, vertex array, textures of each unit,
+		 * frame buffer and viewport. OpenGL is called only when requested state differs from shadowed one.
+		 * Unknown state is never filtered, so bindings changed outside of StateMachine must be invalidated.
+		 * Binary states like depth testing, blending and culling are still available and they are routed
+		 * through shadowed state.
 		 */
-		struct StateMachine
+		class StateMachine : private AyumiUtils::Noncopyable
 		{
+		private:
+			GLuint capabilities[MAX_STATE_CAPABILITIES];
+			GLuint depthFunction;
+			GLuint depthMask;
+			GLuint blendSource;
+			GLuint blendDestination;
+			GLuint cullMode;
+			GLuint colorMask;
+			GLuint polygonMode;
+			GLuint program;
+			GLuint vertexArray;
+			GLuint activeTexture;
+			GLuint textureTargets[MAX_STATE_TEXTURE_UNITS];
+			GLuint textures[MAX_STATE_TEXTURE_UNITS];
+			GLuint frameBuffer;
+			GLint viewport[4];
+			StateMachineStatistics statistics;
+
+			bool isRedundant(const bool redundant);
+			StateCapability getCapability(const GLenum capability) const;
+
+		public:
 			Depth depthState;
 			Blend blendState;
 			Wireframe wireframeState;
 			BackCulling backCullingState;
+
+			StateMachine();
+			~StateMachine();
+
+			void applyRenderState(const RenderState& state);
+			void setCapability(const GLenum capability, const bool enable);
+			void setDepthFunction(const GLenum function);
+			void setDepthMask(const bool write);
+			void setBlendFunction(const GLenum source, const GLenum destination);
+			void setCullFace(const GLenum mode);
+			void setColorMask(const bool red, const bool green, const bool blue, const bool alpha);
+			void setPolygonMode(const GLenum mode);
+			void bindProgram(const GLuint program);
+			void bindVertexArray(const GLuint vertexArray);
+			void setActiveTexture(const unsigned int unit);
+			void bindTexture(const unsigned int unit, const GLenum target, const GLuint texture);
+			void bindFrameBuffer(const GLuint frameBuffer);
+			void setViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height);
+			void invalidateState();
+			void invalidateBindings();
+			void resetStatistics();
+
+			const StateMachineStatistics& getStatistics() const;
 		};
 	}
 }
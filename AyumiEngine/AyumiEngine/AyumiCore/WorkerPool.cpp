@@ -0,0 +1,119 @@
+/**
+ * File contains definition of WorkerPool class.
+ * @file    WorkerPool.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-26
+ */
+
+#include <algorithm>
+#include <boost/bind.hpp>
+
+#include "WorkerPool.hpp"
+
+using namespace std;
+
+namespace AyumiEngine
+{
+	namespace AyumiCore
+	{
+		/**
+		 * Class default constructor. Worker threads are started once, one for each hardware thread except
+		 * calling one.
+		 */
+		WorkerPool::WorkerPool()
+		{
+			workerAmount = max(1u,boost::thread::hardware_concurrency()) - 1;
+			stopped = false;
+			for(unsigned int i = 0; i < workerAmount; ++i)
+				workerThreads.create_thread(boost::bind(&WorkerPool::runWorker,this));
+		}
+
+		/**
+		 * Class destructor, stop worker threads and wait for them.
+		 */
+		WorkerPool::~WorkerPool()
+		{
+			{
+				boost::lock_guard<boost::mutex> lock(queueMutex);
+				stopped = true;
+			}
+			jobAdded.notify_all();
+			workerThreads.join_all();
+		}
+
+		/**
+		 * Method is used to run group of jobs and wait for them. First job is run on calling thread, other jobs
+		 * are queued for worker threads. Jobs must not share written data and must not wait for other groups.
+		 * @param	jobs is reference to group of jobs.
+		 */
+		void WorkerPool::runJobs(const WorkerJobs& jobs)
+		{
+			if(jobs.empty())
+				return;
+
+			unsigned int pendingJobs = jobs.size() - 1;
+			if(pendingJobs > 0)
+			{
+				boost::lock_guard<boost::mutex> lock(queueMutex);
+				for(unsigned int i = 1; i < jobs.size(); ++i)
+				{
+					QueuedJob queuedJob = {jobs[i],&pendingJobs};
+					queuedJobs.push_back(queuedJob);
+				}
+			}
+			jobAdded.notify_all();
+			jobs[0]();
+
+			boost::unique_lock<boost::mutex> lock(queueMutex);
+			while(pendingJobs > 0)
+				if(!runQueuedJob(lock,&pendingJobs))
+					jobFinished.wait(lock);
+		}
+
+		/**
+		 * Accessor to amount of threads which run job group: worker threads and calling thread.
+		 * @return	amount of threads, at least one.
+		 */
+		unsigned int WorkerPool::getThreadAmount() const
+		{
+			return workerAmount + 1;
+		}
+
+		/**
+		 * Private method which is main loop of worker thread. Worker runs queued jobs of any group and sleeps
+		 * when queue is empty.
+		 */
+		void WorkerPool::runWorker()
+		{
+			boost::unique_lock<boost::mutex> lock(queueMutex);
+			while(!stopped)
+				if(!runQueuedJob(lock,nullptr))
+					jobAdded.wait(lock);
+		}
+
+		/**
+		 * Private method which is used to run first queued job of group. Queue mutex is unlocked while job runs,
+		 * last finished job of group wakes thread which waits for it.
+		 * @param	lock is reference to locked queue mutex.
+		 * @param	pendingJobs is pointer to counter of group, null pointer for job of any group.
+		 * @return	true if job was run.
+		 */
+		bool WorkerPool::runQueuedJob(boost::unique_lock<boost::mutex>& lock, const unsigned int* pendingJobs)
+		{
+			deque<QueuedJob>::iterator it = queuedJobs.begin();
+			while(it != queuedJobs.end() && pendingJobs != nullptr && (*it).pendingJobs != pendingJobs)
+				++it;
+			if(it == queuedJobs.end())
+				return false;
+
+			QueuedJob queuedJob = (*it);
+			queuedJobs.erase(it);
+			lock.unlock();
+			queuedJob.job();
+			lock.lock();
+			if(--(*queuedJob.pendingJobs) == 0)
+				jobFinished.notify_all();
+			return true;
+		}
+	}
+}
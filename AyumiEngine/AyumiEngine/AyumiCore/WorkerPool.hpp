@@ -0,0 +1,66 @@
+/**
+ * File contains declaraion of WorkerPool class.
+ * @file    WorkerPool.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-26
+ */
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <deque>
+#include <vector>
+#include <boost/thread.hpp>
+#include <boost/function.hpp>
+
+#include "../AyumiUtils/Singleton.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiCore
+	{
+		typedef boost::function<void()> WorkerJob;
+		typedef std::vector<WorkerJob> WorkerJobs;
+
+		/**
+		 * Class represents pool of persistent worker threads shared by engine modules. It implements singleton
+		 * interface pattern and is created with engine, so threads are not created and joined each frame. Pool
+		 * has one thread less than hardware threads, because calling thread takes part in its own jobs: module
+		 * splits work into ranges, runJobs runs first job on calling thread, queues the rest and returns when
+		 * all of them are finished. While waiting calling thread runs queued jobs of its own group.
+		 */
+		class WorkerPool : public AyumiUtils::Singleton<WorkerPool>
+		{
+			friend AyumiUtils::Singleton<WorkerPool>;
+
+		private:
+			/**
+			 * Structure represents queued job with counter of unfinished jobs of its group.
+			 */
+			struct QueuedJob
+			{
+				WorkerJob job;
+				unsigned int* pendingJobs;
+			};
+
+			boost::thread_group workerThreads;
+			std::deque<QueuedJob> queuedJobs;
+			boost::mutex queueMutex;
+			boost::condition_variable jobAdded;
+			boost::condition_variable jobFinished;
+			unsigned int workerAmount;
+			bool stopped;
+
+			WorkerPool();
+			~WorkerPool();
+
+			void runWorker();
+			bool runQueuedJob(boost::unique_lock<boost::mutex>& lock, const unsigned int* pendingJobs);
+
+		public:
+			void runJobs(const WorkerJobs& jobs);
+			unsigned int getThreadAmount() const;
+		};
+	}
+}
+#endif
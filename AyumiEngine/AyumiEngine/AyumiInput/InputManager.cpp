@@ -47,10 +47,13 @@ namespace AyumiEngine
 
 		/**
 		 * Method is used to update input per frame. Manager translates all occured window events and
-		 * emit events signals.
+		 * emit events signals. Off-screen context has no window and no input events.
 		 */
 		void InputManager::updateInput()
 		{
+			if(engineContext->isOffscreen())
+				return;
+
 			while (engineContext->getContextWindow()->pollEvent(event))
 			{
 				switch(event.type)
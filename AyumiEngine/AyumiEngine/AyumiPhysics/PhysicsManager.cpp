@@ -198,12 +198,12 @@ namespace AyumiEngine
 			}
 			else if(type == SPHERE)
 			{
-				float radius = entity->entityGeometry.geometrySphere->sphereRadius;
+				float radius = getColliderRadius(entity);
 				actor = PxCreateDynamic(*physicsSDK,transformation,PxSphereGeometry(radius),*materials[0].second,density);
 			}
 			else if(type == CAPSULE)
 			{
-				float radius = entity->entityGeometry.geometrySphere->sphereRadius;
+				float radius = getColliderRadius(entity);
 				actor = PxCreateDynamic(*physicsSDK,transformation,PxCapsuleGeometry(radius/2, radius),*materials[0].second,density);
 			}
 			else if(type == CONVEX)
@@ -487,5 +487,17 @@ namespace AyumiEngine
 			}
 			delete [] shapes;
 		}
+
+		/**
+		 * Private method which is used to calculate radius of sphere and capsule colliders. Shared bounding
+		 * sphere of mesh geometry is calculated in mesh space for culling, so collider radius is calculated
+		 * from entity mesh and position the same way as sphere of entity was calculated before geometry sharing.
+		 * @param	entity is pointer to scene entity.
+		 * @return	collider radius.
+		 */
+		float PhysicsManager::getColliderRadius(const SceneEntity* entity) const
+		{
+			return AyumiUtils::BoundingSphere(*entity->entityGeometry.geometryMesh,entity->entityState.position).sphereRadius;
+		}
 	}
 }
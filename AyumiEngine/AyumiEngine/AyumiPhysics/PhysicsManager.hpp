@@ -41,6 +41,7 @@ namespace AyumiEngine
 
 			void initializeScene();
 			void setupFiltering(PxRigidActor* actor, PxU32 filterGroup, PxU32 filterMask);
+			float getColliderRadius(const AyumiScene::SceneEntity* entity) const;
 		public:
 			PhysicsManager();
 			~PhysicsManager();
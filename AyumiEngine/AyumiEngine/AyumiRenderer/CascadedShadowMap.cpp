@@ -0,0 +1,253 @@
+/**
+ * File contains definition of CascadedShadowMap class.
+ * @file    CascadedShadowMap.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-14
+ */
+
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+
+#include "CascadedShadowMap.hpp"
+#include "../Logger.hpp"
+#include "../AyumiResource/ShaderUniform.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Depth texture and frame buffers are created in initialization.
+		 */
+		CascadedShadowMap::CascadedShadowMap()
+		{
+			cascadeAmount = 0;
+			resolution = 0;
+			splitLambda = CASCADE_SPLIT_LAMBDA;
+			depthTexture = 0;
+			frameIndex = 0;
+			nearPlane = 0.0f;
+			farPlane = 0.0f;
+			memset(shadowMatrices,0,sizeof(shadowMatrices));
+			for(unsigned int i = 0; i < MAX_BLOCK_CASCADES; ++i)
+			{
+				cascades[i].splitNear = 0.0f;
+				cascades[i].splitFar = 0.0f;
+				cascades[i].updateInterval = 1;
+				cascades[i].isUpdated = false;
+				cascades[i].frameBuffer = 0;
+				cascadeSplits[i] = FLT_MAX;
+			}
+		}
+
+		/**
+		 * Class destructor, free depth texture and cascade frame buffers.
+		 */
+		CascadedShadowMap::~CascadedShadowMap()
+		{
+			for(unsigned int i = 0; i < cascadeAmount; ++i)
+				glDeleteFramebuffers(1,&cascades[i].frameBuffer);
+			if(depthTexture != 0)
+				glDeleteTextures(1,&depthTexture);
+		}
+
+		/**
+		 * Method is used to create depth texture array and one frame buffer for each cascade layer. Near half
+		 * of cascades is updated every frame, far half every other frame.
+		 * @param	cascadeAmount is amount of cascades.
+		 * @param	resolution is width and height of cascade layer.
+		 * @param	splitLambda is blend factor between uniform (0.0) and logarithmic (1.0) splits.
+		 */
+		void CascadedShadowMap::initializeCascadedShadowMap(const unsigned int cascadeAmount, const int resolution, const float splitLambda)
+		{
+			this->cascadeAmount = min(cascadeAmount,MAX_BLOCK_CASCADES);
+			this->resolution = resolution;
+			this->splitLambda = splitLambda;
+
+			glGenTextures(1,&depthTexture);
+			glBindTexture(GL_TEXTURE_2D_ARRAY,depthTexture);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_COMPARE_MODE,GL_COMPARE_REF_TO_TEXTURE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY,GL_TEXTURE_COMPARE_FUNC,GL_LEQUAL);
+			glTexImage3D(GL_TEXTURE_2D_ARRAY,0,GL_DEPTH_COMPONENT24,resolution,resolution,this->cascadeAmount,0,GL_DEPTH_COMPONENT,GL_UNSIGNED_INT,NULL);
+
+			for(unsigned int i = 0; i < this->cascadeAmount; ++i)
+			{
+				cascades[i].updateInterval = i < (this->cascadeAmount + 1)/2 ? 1 : 2;
+				glGenFramebuffers(1,&cascades[i].frameBuffer);
+				glBindFramebuffer(GL_FRAMEBUFFER,cascades[i].frameBuffer);
+				glFramebufferTextureLayer(GL_FRAMEBUFFER,GL_DEPTH_ATTACHMENT,depthTexture,0,i);
+				glDrawBuffer(GL_NONE);
+				glReadBuffer(GL_NONE);
+				if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+					Logger::getInstance()->saveLog(Log<string>("Shadow cascade FrameBuffer creation error occurred!"));
+			}
+			glBindFramebuffer(GL_FRAMEBUFFER,AyumiUtils::FrameBufferObject::getDefaultFrameBuffer());
+
+			glActiveTexture(GL_TEXTURE0 + AyumiResource::CASCADE_SHADOW_UNIT);
+			glBindTexture(GL_TEXTURE_2D_ARRAY,depthTexture);
+			glActiveTexture(GL_TEXTURE0);
+		}
+
+		/**
+		 * Method is used to fit cascades to current camera frustum and calculate shadow matrices, which
+		 * transform view space position into cascade texture coordinates. Cascade is fitted again only if it
+		 * is its turn to be updated or light and camera projection changed - other cascades keep their light
+		 * matrices, because their layers were rendered with them.
+		 * @param	lightDirection is direction of light rays.
+		 * @param	viewMatrix is camera view matrix.
+		 * @param	projectionMatrix is camera projection matrix.
+		 */
+		void CascadedShadowMap::updateCascades(const Vector3D& lightDirection, const Matrix4D& viewMatrix, const Matrix4D& projectionMatrix)
+		{
+			const float cameraNear = projectionMatrix[11] / (projectionMatrix[10] - 1.0f);
+			const float cameraFar = projectionMatrix[11] / (projectionMatrix[10] + 1.0f);
+			bool isChanged = frameIndex == 0 || cameraNear != nearPlane || cameraFar != farPlane;
+			isChanged |= memcmp(lightDirection.data(),this->lightDirection.data(),3*sizeof(float)) != 0;
+
+			nearPlane = cameraNear;
+			farPlane = cameraFar;
+			this->lightDirection = lightDirection;
+			calculateSplits();
+
+			Matrix4D cameraMatrix = inverse(viewMatrix);
+			Matrix4D bias;
+			bias.LoadIdentity();
+			bias.Translatef(0.5f,0.5f,0.5f);
+			bias.Scalef(0.5f,0.5f,0.5f);
+
+			for(unsigned int i = 0; i < cascadeAmount; ++i)
+			{
+				ShadowCascade& cascade = cascades[i];
+				cascade.isUpdated = isChanged || (frameIndex + i) % cascade.updateInterval == 0;
+				if(cascade.isUpdated)
+					fitCascade(cascade,cameraMatrix,1.0f / projectionMatrix[0],1.0f / projectionMatrix[5]);
+
+				Matrix4D shadowMatrix = bias * cascade.lightViewProjection;
+				shadowMatrix *= cameraMatrix;
+				memcpy(shadowMatrices[i],transpose(shadowMatrix).data(),16*sizeof(float));
+			}
+			frameIndex++;
+		}
+
+		/**
+		 * Private method which is used to calculate split distances by practical split scheme. Shaders select
+		 * cascade by comparing view depth with far distance of each cascade but the last one.
+		 */
+		void CascadedShadowMap::calculateSplits()
+		{
+			for(unsigned int i = 0; i < cascadeAmount; ++i)
+			{
+				const float start = static_cast<float>(i) / cascadeAmount;
+				const float end = static_cast<float>(i + 1) / cascadeAmount;
+				cascades[i].splitNear = splitLambda*nearPlane*pow(farPlane/nearPlane,start) + (1.0f - splitLambda)*(nearPlane + (farPlane - nearPlane)*start);
+				cascades[i].splitFar = splitLambda*nearPlane*pow(farPlane/nearPlane,end) + (1.0f - splitLambda)*(nearPlane + (farPlane - nearPlane)*end);
+			}
+			for(unsigned int i = 0; i < MAX_BLOCK_CASCADES; ++i)
+				cascadeSplits[i] = i + 1 < cascadeAmount ? cascades[i].splitFar : FLT_MAX;
+		}
+
+		/**
+		 * Private method which is used to fit orthographic light projection to bounding sphere of cascade
+		 * part of camera frustum. Sphere radius is rounded up and projection origin is snapped to whole
+		 * texels of light space, so shadow map content only moves by whole texels. Projection is extended
+		 * towards light to catch casters which are outside of camera frustum.
+		 * @param	cascade is reference to fitted cascade.
+		 * @param	cameraMatrix is inverse of camera view matrix.
+		 * @param	tanHalfWidth is tangent of half horizontal field of view.
+		 * @param	tanHalfHeight is tangent of half vertical field of view.
+		 */
+		void CascadedShadowMap::fitCascade(ShadowCascade& cascade, Matrix4D& cameraMatrix, const float tanHalfWidth, const float tanHalfHeight)
+		{
+			const float a = cascade.splitNear;
+			const float b = cascade.splitFar;
+			const float k = tanHalfWidth*tanHalfWidth + tanHalfHeight*tanHalfHeight;
+			float center = min(0.5f*(a + b)*(1.0f + k),b);
+			float radius = sqrt(max(a*a*k + (center - a)*(center - a),b*b*k + (b - center)*(b - center)));
+			radius = ceil(radius*16.0f) / 16.0f;
+
+			const Vector4D worldCenter = cameraMatrix * Vector4D(0.0f,0.0f,-center,1.0f);
+			const Vector3D forward = normalize(lightDirection);
+			const Vector3D up = fabs(forward.y()) > 0.99f ? Vector3D(1.0f,0.0f,0.0f) : Vector3D(0.0f,1.0f,0.0f);
+			const Vector3D side = normalize(cross3(forward,up));
+			const Vector3D lightUp = cross3(side,forward);
+
+			cascade.lightMatrix = Matrix4D(side.x(),side.y(),side.z(),0.0f,
+										   lightUp.x(),lightUp.y(),lightUp.z(),0.0f,
+										   -forward.x(),-forward.y(),-forward.z(),0.0f,
+										   0.0f,0.0f,0.0f,1.0f);
+
+			const Vector4D lightCenter = cascade.lightMatrix * worldCenter;
+			const float texelSize = 2.0f*radius / resolution;
+			const float x = floor(lightCenter.x() / texelSize)*texelSize;
+			const float y = floor(lightCenter.y() / texelSize)*texelSize;
+			const float depth = -lightCenter.z();
+
+			cascade.lightProjection.LoadIdentity();
+			cascade.lightProjection.Ortho(x - radius,x + radius,y - radius,y + radius,depth - radius - CASCADE_CASTER_DISTANCE,depth + radius);
+			cascade.lightViewProjection = cascade.lightProjection * cascade.lightMatrix;
+		}
+
+		/**
+		 * Accessor to private cascade amount member.
+		 * @return	amount of cascades.
+		 */
+		unsigned int CascadedShadowMap::getCascadeAmount() const
+		{
+			return cascadeAmount;
+		}
+
+		/**
+		 * Accessor to cascade data.
+		 * @param	id is cascade id.
+		 * @return	reference to shadow cascade.
+		 */
+		ShadowCascade& CascadedShadowMap::getCascade(const unsigned int id)
+		{
+			return cascades[id];
+		}
+
+		/**
+		 * Accessor to private depth texture member.
+		 * @return	depth texture array id, 0 if cascades were not initialized.
+		 */
+		GLuint CascadedShadowMap::getDepthTexture() const
+		{
+			return depthTexture;
+		}
+
+		/**
+		 * Accessor to private resolution member.
+		 * @return	width and height of cascade layer.
+		 */
+		int CascadedShadowMap::getResolution() const
+		{
+			return resolution;
+		}
+
+		/**
+		 * Accessor to shadow matrices of current frame.
+		 * @return	pointer to column-major shadow matrices of all cascades.
+		 */
+		const float* CascadedShadowMap::getShadowMatrices() const
+		{
+			return &shadowMatrices[0][0];
+		}
+
+		/**
+		 * Accessor to cascade split distances.
+		 * @return	pointer to view depths which separate cascades.
+		 */
+		const float* CascadedShadowMap::getCascadeSplits() const
+		{
+			return cascadeSplits;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/**
+ * File contains declaration of CascadedShadowMap class.
+ * @file    CascadedShadowMap.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-14
+ */
+
+#ifndef CASCADEDSHADOWMAP_HPP
+#define CASCADEDSHADOWMAP_HPP
+
+#include <vector>
+
+#include "UniformBlocks.hpp"
+
+#include "../AyumiScene/SceneEntity.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+#include "../AyumiUtils/FrameBufferObject.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int CASCADE_AMOUNT = 4;
+		const int CASCADE_RESOLUTION = 2048;
+		const float CASCADE_SPLIT_LAMBDA = 0.75f;
+		const float CASCADE_CASTER_DISTANCE = 200.0f;
+
+		/**
+		 * Structure represents one shadow cascade - part of camera frustum between two split distances,
+		 * rendered into own layer of depth texture array. Light matrices are in row order. Far cascades
+		 * are updated every other frame, so they keep matrices which were used to render their layer.
+		 */
+		struct ShadowCascade
+		{
+			float splitNear;
+			float splitFar;
+			unsigned int updateInterval;
+			bool isUpdated;
+			GLuint frameBuffer;
+			AyumiMath::Matrix4D lightMatrix;
+			AyumiMath::Matrix4D lightProjection;
+			AyumiMath::Matrix4D lightViewProjection;
+			std::vector<AyumiScene::SceneEntity*> casters;
+		};
+
+		/**
+		 * Class represents cascaded shadow maps of directional light. Camera frustum is split by practical
+		 * split scheme (blend of logarithmic and uniform splits) and each split is covered by orthographic
+		 * light projection fitted to its bounding sphere. Sphere size does not depend on camera orientation
+		 * and projection origin is snapped to shadow texels, so shadow edges do not shimmer when camera
+		 * moves. Cascades are layers of one depth texture array.
+		 */
+		class CascadedShadowMap : private AyumiUtils::Noncopyable
+		{
+		private:
+			ShadowCascade cascades[MAX_BLOCK_CASCADES];
+			unsigned int cascadeAmount;
+			int resolution;
+			float splitLambda;
+			GLuint depthTexture;
+			unsigned int frameIndex;
+			AyumiMath::Vector3D lightDirection;
+			float nearPlane;
+			float farPlane;
+			float shadowMatrices[MAX_BLOCK_CASCADES][16];
+			float cascadeSplits[MAX_BLOCK_CASCADES];
+
+			void calculateSplits();
+			void fitCascade(ShadowCascade& cascade, AyumiMath::Matrix4D& cameraMatrix, const float tanHalfWidth, const float tanHalfHeight);
+
+		public:
+			CascadedShadowMap();
+			~CascadedShadowMap();
+
+			void initializeCascadedShadowMap(const unsigned int cascadeAmount = CASCADE_AMOUNT, const int resolution = CASCADE_RESOLUTION, const float splitLambda = CASCADE_SPLIT_LAMBDA);
+			void updateCascades(const AyumiMath::Vector3D& lightDirection, const AyumiMath::Matrix4D& viewMatrix, const AyumiMath::Matrix4D& projectionMatrix);
+
+			unsigned int getCascadeAmount() const;
+			ShadowCascade& getCascade(const unsigned int id);
+			GLuint getDepthTexture() const;
+			int getResolution() const;
+			const float* getShadowMatrices() const;
+			const float* getCascadeSplits() const;
+		};
+	}
+}
+#endif
@@ -36,6 +36,35 @@ static const char* spriteFragmentShader =
 	"	fragColor.a = alpha;\n" \
 	"}\n";
 
+static const char* spriteBatchVertexShader = 
+	"#version 330 core\n" \
+	"uniform mat4 projectionMatrix;\n" \
+	"in vec2 vertex;\n" \
+	"in vec2 texCoord;\n" \
+	"in float vertexAlpha;\n" \
+	"out vec2 TexCoord;\n" \
+	"out float Alpha;\n" \
+	"void main()\n" \
+	"{\n" \
+	"	gl_Position = projectionMatrix*vec4(vertex,0.0,1.0);\n" \
+	"	TexCoord = texCoord;\n" \
+	"	Alpha = vertexAlpha;\n" \
+	"}\n";
+
+static const char* spriteBatchFragmentShader =
+	"#version 330 core\n" \
+	"uniform samplerRect ColorMapSampler;\n" \
+	"in vec2 TexCoord;\n" \
+	"in float Alpha;\n" \
+	"out vec4 fragColor;\n" \
+	"void main()\n" \
+	"{\n" \
+	"	fragColor = texture(ColorMapSampler, TexCoord);\n" \
+	"	if(fragColor.a < 0.5f)\n" \
+	"		discard; \n"\
+	"	fragColor.a = Alpha;\n" \
+	"}\n";
+
 static const char* boxVertexShader =
 	"#version 330 core\n" \
 	"uniform mat4 modelViewMatrix;\n" \
@@ -64,6 +93,43 @@ static const char* renderToDepthVertex =
 	"	gl_Position = projectionMatrix*modelViewMatrix*vertex;\n" \
 	"}\n";
 
+static const char* renderToDepthKeyFrameVertex =
+	"#version 330 core\n" \
+	"uniform mat4 projectionMatrix;\n" \
+	"uniform mat4 modelViewMatrix;\n" \
+	"uniform vec4 keyFrameData;\n" \
+	"uniform vec4 blendFrameData;\n" \
+	"uniform samplerBuffer keyFrames;\n" \
+	"vec3 getFramePosition(vec4 frameData)\n" \
+	"{\n" \
+	"	vec4 current = texelFetch(keyFrames,(int(frameData.x) + gl_VertexID) * 2);\n" \
+	"	vec4 next = texelFetch(keyFrames,(int(frameData.y) + gl_VertexID) * 2);\n" \
+	"	return mix(current.xyz,next.xyz,frameData.z);\n" \
+	"}\n" \
+	"void main()\n" \
+	"{\n" \
+	"	vec3 position = mix(getFramePosition(blendFrameData),getFramePosition(keyFrameData),keyFrameData.w);\n" \
+	"	gl_Position = projectionMatrix*modelViewMatrix*vec4(position,1.0);\n" \
+	"}\n";
+
+static const char* renderToDepthSkinnedVertex =
+	"#version 330 core\n" \
+	"uniform mat4 projectionMatrix;\n" \
+	"uniform mat4 modelViewMatrix;\n" \
+	"uniform samplerBuffer skinInfluences;\n" \
+	"layout(std140) uniform SkinData\n" \
+	"{\n" \
+	"	mat4 skinMatrix[128];\n" \
+	"};\n" \
+	"in vec4 vertex;\n" \
+	"void main()\n" \
+	"{\n" \
+	"	vec4 joints = texelFetch(skinInfluences,gl_VertexID * 2);\n" \
+	"	vec4 weights = texelFetch(skinInfluences,gl_VertexID * 2 + 1);\n" \
+	"	mat4 skin = skinMatrix[int(joints.x)] * weights.x + skinMatrix[int(joints.y)] * weights.y + skinMatrix[int(joints.z)] * weights.z + skinMatrix[int(joints.w)] * weights.w;\n" \
+	"	gl_Position = projectionMatrix*modelViewMatrix*(skin*vertex);\n" \
+	"}\n";
+
 static const char* renderToDepthFragment =
 	"#version 330 core\n" \
 	"out vec4 fragColor;\n" \
@@ -71,4 +137,48 @@ static const char* renderToDepthFragment =
 	"{\n" \
 	"	fragColor = vec4( 1.0, 1.0, 1.0, 1.0 );\n" \
 	"}\n";
+
+static const char* particleFeedbackVertex =
+	"#version 330 core\n" \
+	"uniform float elapsedTime;\n" \
+	"uniform int emitFirst;\n" \
+	"uniform int emitAmount;\n" \
+	"uniform int particleCapacity;\n" \
+	"uniform vec4 emitVelocity;\n" \
+	"uniform vec4 velocitySpread;\n" \
+	"uniform vec4 emitAcceleration;\n" \
+	"uniform vec4 emitParameters;\n" \
+	"layout(location = 0) in vec4 particlePosition;\n" \
+	"layout(location = 1) in vec4 particleVelocity;\n" \
+	"out vec4 feedbackPosition;\n" \
+	"out vec4 feedbackVelocity;\n" \
+	"float random(float seed)\n" \
+	"{\n" \
+	"	return fract(sin(float(gl_VertexID)*12.9898 + seed*78.233)*43758.5453)*2.0 - 1.0;\n" \
+	"}\n" \
+	"void main()\n" \
+	"{\n" \
+	"	int emitIndex = gl_VertexID - emitFirst;\n" \
+	"	if(emitIndex < 0)\n" \
+	"		emitIndex += particleCapacity;\n" \
+	"	if(emitIndex < emitAmount)\n" \
+	"	{\n" \
+	"		vec3 noise = vec3(random(emitParameters.w),random(emitParameters.w + 1.0),random(emitParameters.w + 2.0));\n" \
+	"		feedbackPosition = vec4(0.0,0.0,0.0,emitParameters.y);\n" \
+	"		feedbackVelocity = vec4(emitVelocity.xyz + noise*velocitySpread.xyz,emitParameters.x);\n" \
+	"	}\n" \
+	"	else if(particleVelocity.w > 0.0)\n" \
+	"	{\n" \
+	"		vec3 velocity = particleVelocity.xyz + emitAcceleration.xyz*elapsedTime;\n" \
+	"		float lifeTime = particleVelocity.w - elapsedTime;\n" \
+	"		float size = lifeTime > 0.0 ? max(particlePosition.w + emitParameters.z*elapsedTime,0.0) : 0.0;\n" \
+	"		feedbackPosition = vec4(particlePosition.xyz + velocity*elapsedTime,size);\n" \
+	"		feedbackVelocity = vec4(velocity,lifeTime);\n" \
+	"	}\n" \
+	"	else\n" \
+	"	{\n" \
+	"		feedbackPosition = vec4(particlePosition.xyz,0.0);\n" \
+	"		feedbackVelocity = particleVelocity;\n" \
+	"	}\n" \
+	"}\n";
 #endif
@@ -0,0 +1,216 @@
+/**
+ * File contains definition of DepthPrePass class.
+ * @file    DepthPrePass.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-25
+ */
+
+#include <cstring>
+#include <algorithm>
+
+#include "DepthPrePass.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiScene;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Function is used to order pre-pass entities front-to-back.
+		 * @param	first is first pre-pass entity.
+		 * @param	second is second pre-pass entity.
+		 * @return	true if first entity is closer to camera.
+		 */
+		static bool compareDistances(const PrePassEntity& first, const PrePassEntity& second)
+		{
+			return first.distance < second.distance;
+		}
+
+		/**
+		 * Class default constructor.
+		 */
+		DepthPrePass::DepthPrePass()
+		{
+			memset(queries,0,sizeof(queries));
+			memset(queryIssued,0,sizeof(queryIssued));
+			memset(&statistics,0,sizeof(statistics));
+			queryTarget = 0;
+			activeQuery = -1;
+			frameIndex = 0;
+			baselineFrame = false;
+		}
+
+		/**
+		 * Class destructor, free queries of all frame slots.
+		 */
+		DepthPrePass::~DepthPrePass()
+		{
+			if(queryTarget != 0)
+				glDeleteQueries(PROFILER_FRAME_LATENCY*MAX_PRE_PASS_QUERIES,&queries[0][0]);
+		}
+
+		/**
+		 * Method is used to choose fragment query. GL_FRAGMENT_SHADER_INVOCATIONS_ARB query is used when
+		 * GL_ARB_pipeline_statistics_query is supported, otherwise GL_SAMPLES_PASSED query, which count samples
+		 * that passed depth test and is close to shaded fragments when early depth test is performed.
+		 */
+		void DepthPrePass::initializeDepthPrePass()
+		{
+			GLint extensionAmount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS,&extensionAmount);
+			for(GLint i = 0; i < extensionAmount && !statistics.pipelineStatistics; ++i)
+				statistics.pipelineStatistics = strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS,i)),"GL_ARB_pipeline_statistics_query") == 0;
+
+			queryTarget = statistics.pipelineStatistics ? GL_FRAGMENT_SHADER_INVOCATIONS_ARB : GL_SAMPLES_PASSED;
+			if(!statistics.pipelineStatistics)
+				Logger::getInstance()->saveLog(Log<string>("Pipeline statistics queries are not supported, depth pre-pass statistics count passed samples."));
+			glGenQueries(PROFILER_FRAME_LATENCY*MAX_PRE_PASS_QUERIES,&queries[0][0]);
+		}
+
+		/**
+		 * Method is used to start new frame. Queries of frame slot used PROFILER_FRAME_LATENCY frames ago are
+		 * read back and slot is reused by current frame. First frame and every DEPTH_PRE_PASS_BASELINE_INTERVAL
+		 * frame is baseline frame rendered without pre-pass.
+		 */
+		void DepthPrePass::beginFrame()
+		{
+			baselineFrame = frameIndex%DEPTH_PRE_PASS_BASELINE_INTERVAL == 0;
+			++frameIndex;
+			resolveFrame(frameIndex%PROFILER_FRAME_LATENCY);
+			entities.clear();
+		}
+
+		/**
+		 * Method is used to collect visible pre-pass entities of scene graph and sort them front-to-back by
+		 * distance of entity position from camera.
+		 * @param	sceneGraph is pointer to scene graph.
+		 * @param	cameraPosition is reference to world camera position.
+		 */
+		void DepthPrePass::collectEntities(const SceneGraph* sceneGraph, const Vector3D& cameraPosition)
+		{
+			entities.clear();
+			const vector<SceneEntity*>* lists[] = {&sceneGraph->sceneEntities, &sceneGraph->staticBatches};
+			for(unsigned int i = 0; i < 2; ++i)
+			{
+				for(vector<SceneEntity*>::const_iterator it = lists[i]->begin(); it != lists[i]->end(); ++it)
+				{
+					if(!(*it)->entityState.isVisible || !isPrePassEntity(*it))
+						continue;
+					const Vector3D& position = (*it)->entityState.position;
+					const float x = position.x() - cameraPosition.x();
+					const float y = position.y() - cameraPosition.y();
+					const float z = position.z() - cameraPosition.z();
+					PrePassEntity entity = {*it, x*x + y*y + z*z};
+					entities.push_back(entity);
+				}
+			}
+			sort(entities.begin(),entities.end(),compareDistances);
+			statistics.prePassEntities = entities.size();
+		}
+
+		/**
+		 * Method is used to start counting fragments of pass. Only first pass of each kind in frame is
+		 * measured, queries can not be nested.
+		 * @param	query is measured pass.
+		 */
+		void DepthPrePass::beginQuery(const DepthPrePassQuery query)
+		{
+			const unsigned int slot = frameIndex%PROFILER_FRAME_LATENCY;
+			if(queryTarget == 0 || activeQuery >= 0 || queryIssued[slot][query])
+				return;
+			glBeginQuery(queryTarget,queries[slot][query]);
+			queryIssued[slot][query] = true;
+			activeQuery = query;
+		}
+
+		/**
+		 * Method is used to finish counting fragments of pass.
+		 * @param	query is measured pass.
+		 */
+		void DepthPrePass::endQuery(const DepthPrePassQuery query)
+		{
+			if(activeQuery != query)
+				return;
+			glEndQuery(queryTarget);
+			activeQuery = -1;
+		}
+
+		/**
+		 * Method is used to check if entity is drawn in depth pre-pass. Entity material must have depth shader
+		 * and depth test, instanced and batched entities are drawn without pre-pass.
+		 * @param	entity is pointer to scene entity.
+		 * @return	true if entity is drawn in depth pre-pass.
+		 */
+		bool DepthPrePass::isPrePassEntity(const SceneEntity* entity) const
+		{
+			const EntityMaterial& material = entity->entityMaterial;
+			return material.depthShader != nullptr && material.depthTest && !material.instancing && !entity->entityState.isBatched;
+		}
+
+		/**
+		 * Method is used to check if current frame measures baseline fragments. Renderer skips pre-pass in
+		 * baseline frame even when it is enabled in Configuration.
+		 * @return	true if current frame is rendered without pre-pass.
+		 */
+		bool DepthPrePass::isBaselineFrame() const
+		{
+			return baselineFrame;
+		}
+
+		/**
+		 * Accessor to pre-pass entities of current frame ordered front-to-back.
+		 * @return	reference to pre-pass entities.
+		 */
+		const PrePassEntities& DepthPrePass::getEntities() const
+		{
+			return entities;
+		}
+
+		/**
+		 * Accessor to fragment statistics of last resolved frame.
+		 * @return	reference to pre-pass statistics.
+		 */
+		const DepthPrePassStatistics& DepthPrePass::getStatistics() const
+		{
+			return statistics;
+		}
+
+		/**
+		 * Private method which is used to read back queries of frame slot. Result availability is checked
+		 * first, so GPU is never waited for, frame which results are not ready yet is skipped. Main pass of
+		 * frame without pre-pass become new baseline.
+		 * @param	slot is index of frame slot.
+		 */
+		void DepthPrePass::resolveFrame(const unsigned int slot)
+		{
+			const bool prePass = queryIssued[slot][PRE_PASS_QUERY];
+			const bool mainPass = queryIssued[slot][MAIN_PASS_QUERY];
+			queryIssued[slot][PRE_PASS_QUERY] = false;
+			queryIssued[slot][MAIN_PASS_QUERY] = false;
+			if(!mainPass)
+				return;
+
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(queries[slot][MAIN_PASS_QUERY],GL_QUERY_RESULT_AVAILABLE,&available);
+			if(available == GL_FALSE)
+				return;
+			if(prePass)
+			{
+				glGetQueryObjectiv(queries[slot][PRE_PASS_QUERY],GL_QUERY_RESULT_AVAILABLE,&available);
+				if(available == GL_FALSE)
+					return;
+			}
+
+			statistics.prePassFragments = 0;
+			if(prePass)
+				glGetQueryObjectui64v(queries[slot][PRE_PASS_QUERY],GL_QUERY_RESULT,&statistics.prePassFragments);
+			glGetQueryObjectui64v(queries[slot][MAIN_PASS_QUERY],GL_QUERY_RESULT,&statistics.mainPassFragments);
+			if(!prePass)
+				statistics.baselineFragments = statistics.mainPassFragments;
+			statistics.savedFragments = prePass && statistics.baselineFragments > 0 ? static_cast<GLint64>(statistics.baselineFragments) - static_cast<GLint64>(statistics.mainPassFragments) : 0;
+		}
+	}
+}
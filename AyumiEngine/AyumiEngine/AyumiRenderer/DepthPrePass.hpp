@@ -0,0 +1,107 @@
+/**
+ * File contains declaration of DepthPrePass class.
+ * @file    DepthPrePass.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-25
+ */
+
+#ifndef DEPTHPREPASS_HPP
+#define DEPTHPREPASS_HPP
+
+#include <vector>
+#include <GL/glew.h>
+
+#include "RenderProfiler.hpp"
+
+#include "../Logger.hpp"
+#include "../AyumiScene/SceneGraph.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+#ifndef GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+#define GL_FRAGMENT_SHADER_INVOCATIONS_ARB 0x82F4
+#endif
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int DEPTH_PRE_PASS_BASELINE_INTERVAL = 300;
+
+		/**
+		 * Enumeration represents passes measured by depth pre-pass queries.
+		 */
+		enum DepthPrePassQuery
+		{
+			PRE_PASS_QUERY,
+			MAIN_PASS_QUERY,
+			MAX_PRE_PASS_QUERIES
+		};
+
+		/**
+		 * Structure represents entity drawn in depth pre-pass with its squared distance from camera.
+		 */
+		struct PrePassEntity
+		{
+			AyumiScene::SceneEntity* entity;
+			float distance;
+		};
+
+		/**
+		 * Structure represents fragment statistics of opaque scene rendering. Fragments are fragment shader
+		 * invocations when pipeline statistics queries are supported, otherwise samples which passed depth
+		 * test. Baseline is main pass of last frame rendered without pre-pass, saved fragments are difference
+		 * between baseline and current main pass. Pre-pass is skipped in first frame and then once every
+		 * DEPTH_PRE_PASS_BASELINE_INTERVAL frames, so baseline is measured even when pre-pass is always enabled
+		 * and follows changes of scene.
+		 */
+		struct DepthPrePassStatistics
+		{
+			GLuint64 prePassFragments;
+			GLuint64 mainPassFragments;
+			GLuint64 baselineFragments;
+			GLint64 savedFragments;
+			unsigned int prePassEntities;
+			bool pipelineStatistics;
+		};
+
+		typedef std::vector<PrePassEntity> PrePassEntities;
+
+		/**
+		 * Class represents depth pre-pass of opaque scene entities. Visible entities which material has depth
+		 * shader are drawn front-to-back with depth shader and disabled color writes, then main pass shade
+		 * them with GL_EQUAL depth test and disabled depth writes, so each pixel run expensive material shader
+		 * once. Fragments of pre-pass and main pass are counted by queries buffered like profiler queries,
+		 * in PROFILER_FRAME_LATENCY frame slots, so GPU is never waited for.
+		 */
+		class DepthPrePass : private AyumiUtils::Noncopyable
+		{
+		private:
+			PrePassEntities entities;
+			GLuint queries[PROFILER_FRAME_LATENCY][MAX_PRE_PASS_QUERIES];
+			bool queryIssued[PROFILER_FRAME_LATENCY][MAX_PRE_PASS_QUERIES];
+			GLenum queryTarget;
+			int activeQuery;
+			unsigned int frameIndex;
+			bool baselineFrame;
+			DepthPrePassStatistics statistics;
+
+			void resolveFrame(const unsigned int slot);
+
+		public:
+			DepthPrePass();
+			~DepthPrePass();
+
+			void initializeDepthPrePass();
+			void beginFrame();
+			void collectEntities(const AyumiScene::SceneGraph* sceneGraph, const AyumiMath::Vector3D& cameraPosition);
+			void beginQuery(const DepthPrePassQuery query);
+			void endQuery(const DepthPrePassQuery query);
+			bool isPrePassEntity(const AyumiScene::SceneEntity* entity) const;
+			bool isBaselineFrame() const;
+
+			const PrePassEntities& getEntities() const;
+			const DepthPrePassStatistics& getStatistics() const;
+		};
+	}
+}
+#endif
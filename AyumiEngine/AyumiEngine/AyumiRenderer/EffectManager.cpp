@@ -5,6 +5,9 @@
  * @date    2011-11-20
  */
 
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+
 #include "EffectManager.hpp"
 
 using namespace std;
@@ -28,6 +31,7 @@ namespace AyumiEngine
 			this->sprites = sprites;
 			renderPassScript = new AyumiScript("null");
 			renderPassListScript = new AyumiScript(Configuration::getInstance()->getEffectScriptName()->c_str());
+			renderTargets = new RenderTargetPool();
 			prepareEffectScripts();
 			currentID = 0;
 		}
@@ -39,13 +43,8 @@ namespace AyumiEngine
 		{
 			delete renderPassScript;
 			delete renderPassListScript;
-			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
-			{
-				delete (*it)->renderResult;
-				delete (*it)->frameBuffer;
-				delete (*it)->sprite;
-			}
-			renderPassList.clear();
+			releaseEffects();
+			delete renderTargets;
 		}
 
 		/**
@@ -54,6 +53,7 @@ namespace AyumiEngine
 		void EffectManager::initializeEffectManager()
 		{
 			renderPassListScript->executeScript();
+			compileEffects();
 		}
 
 		/**
@@ -62,16 +62,10 @@ namespace AyumiEngine
 		 */
 		void EffectManager::updateEffects(const string& scriptPath)
 		{
-			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
-			{
-				delete (*it)->renderResult;
-				delete (*it)->frameBuffer;
-				delete (*it)->sprite;
-			}
-			renderPassList.clear();
-
+			releaseEffects();
 			renderPassListScript->setScriptFile(scriptPath.c_str());
 			renderPassListScript->executeScript();
+			compileEffects();
 		}
 
 		/**
@@ -113,19 +107,263 @@ namespace AyumiEngine
 				.def("loadEffectIntegerUniform",&EffectManager::loadEffectIntegerUniform)
 				.def("loadEffectFloatUniform",&EffectManager::loadEffectFloatUniform)
 				.def("loadEffectTextureUniform",&EffectManager::loadEffectTextureUniform)
+				.def("loadEffectInput",&EffectManager::loadEffectInput)
+				.def("loadRenderTargetScale",&EffectManager::loadRenderTargetScale)
+				.def("loadColorFilter",&EffectManager::loadColorFilter)
 			];
 
 			luabind::globals(renderPassScript->getVirtualMachine())["Effect"] = this;
 			luabind::globals(renderPassListScript->getVirtualMachine())["EffectManager"] = this;
 		}
+
+		/**
+		 * Private method which is used to free all render passes. Pooled render targets are kept, so they
+		 * can be reused by next effects.
+		 */
+		void EffectManager::releaseEffects()
+		{
+			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
+			{
+				delete (*it)->renderResult;
+				delete (*it)->sprite;
+				delete (*it);
+			}
+			renderPassList.clear();
+			currentID = 0;
+		}
+
 		/**
 		 * Private method which is used to load post-process effect.
 		 * @param	scriptFileName is path to effect scritp file.
 		 */
 		void EffectManager::loadEffect(const string& scriptFileName)
 		{
+			const unsigned int effectStart = renderPassList.size();
 			renderPassScript->setScriptFile(scriptFileName.c_str());
 			renderPassScript->executeScript();
+			resolveEffectInputs(effectStart);
+		}
+
+		/**
+		 * Private method which is used to resolve inputs of loaded effect passes. Declared inputs are numbers
+		 * of previous passes of the same effect. Without declaration previous pass read result of pass before
+		 * it and final pass read results of all previous passes of effect.
+		 * @param	effectStart is id of first effect pass.
+		 */
+		void EffectManager::resolveEffectInputs(const unsigned int effectStart)
+		{
+			for(unsigned int i = effectStart; i < renderPassList.size(); ++i)
+			{
+				RenderPass* pass = renderPassList[i];
+				if(pass->offScreenRenderingScene)
+				{
+					pass->inputs.clear();
+					continue;
+				}
+
+				if(pass->inputs.empty())
+				{
+					if(pass->offScreenRenderingPrevious && i > effectStart)
+						pass->inputs.push_back(i-1);
+					else if(pass->finalRendering)
+						for(unsigned int j = effectStart; j < i; ++j)
+							pass->inputs.push_back(j);
+					continue;
+				}
+
+				vector<int> inputs;
+				for(vector<int>::const_iterator it = pass->inputs.begin(); it != pass->inputs.end(); ++it)
+				{
+					if((*it) < 0 || effectStart + (*it) >= i)
+					{
+						Logger::getInstance()->saveLog(Log<string>("Effect pass input must be one of previous passes!"));
+						continue;
+					}
+					inputs.push_back(effectStart + (*it));
+				}
+				pass->inputs.swap(inputs);
+			}
+		}
+
+		/**
+		 * Private method which is used to compile loaded passes into post-process chain and assign them
+		 * pooled render targets. Video memory and fill rate of chain are compared with dedicated full
+		 * resolution target per pass and logged.
+		 */
+		void EffectManager::compileEffects()
+		{
+			if(renderPassList.empty())
+				return;
+
+			const unsigned int declaredAmount = renderPassList.size();
+			unsigned int dedicatedSize = 0;
+			unsigned int dedicatedFill = 0;
+			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
+			{
+				RenderTargetDesc desc = (*it)->target;
+				desc.depthBuffer = true;
+				dedicatedSize += RenderTargetPool::getTargetSize(desc);
+				dedicatedFill += desc.width * desc.height;
+			}
+
+			chainEffects();
+			fuseColorFilters();
+			scheduleRenderTargets();
+
+			unsigned int fill = 0;
+			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
+			{
+				if((*it)->frameBuffer != nullptr)
+					fill += (*it)->frameBuffer->getWidth() * (*it)->frameBuffer->getHeight();
+				else
+					fill += (*it)->target.width * (*it)->target.height;
+			}
+
+			string log = "Post-process chain compiled, passes: ";
+			log += boost::lexical_cast<string>(declaredAmount);
+			log += " -> ";
+			log += boost::lexical_cast<string>(renderPassList.size());
+			log += ", render targets: ";
+			log += boost::lexical_cast<string>(renderTargets->getTargetAmount());
+			Logger::getInstance()->saveLog(Log<string>(log));
+
+			const unsigned int residentSize = renderTargets->getResidentSize();
+			log = "Post-process video memory: ";
+			log += boost::lexical_cast<string>(dedicatedSize / 1024);
+			log += " KB -> ";
+			log += boost::lexical_cast<string>(residentSize / 1024);
+			log += " KB, saved: ";
+			log += boost::lexical_cast<string>((dedicatedSize - min(dedicatedSize,residentSize)) / 1024);
+			log += " KB";
+			Logger::getInstance()->saveLog(Log<string>(log));
+
+			log = "Post-process fill rate, pixels per frame: ";
+			log += boost::lexical_cast<string>(dedicatedFill);
+			log += " -> ";
+			log += boost::lexical_cast<string>(fill);
+			Logger::getInstance()->saveLog(Log<string>(log));
+		}
+
+		/**
+		 * Private method which is used to chain following effects. Final pass of previous effect render
+		 * off-screen and replace scene pass of next effect, so scene is rendered once per frame.
+		 */
+		void EffectManager::chainEffects()
+		{
+			for(unsigned int i = 1; i < renderPassList.size(); ++i)
+			{
+				RenderPass* previous = renderPassList[i-1];
+				if(!previous->finalRendering || !renderPassList[i]->offScreenRenderingScene)
+					continue;
+
+				previous->finalRendering = false;
+				previous->clearBeforeFinal = false;
+				previous->offScreenRenderingPrevious = true;
+				removeRenderPass(i,i-1);
+				--i;
+			}
+		}
+
+		/**
+		 * Private method which is used to fuse adjacent color filter passes. Pass is fused with next one
+		 * only if next pass is the only reader of its result. Fused pass apply all filters in order by
+		 * ColorFilterFX shader.
+		 */
+		void EffectManager::fuseColorFilters()
+		{
+			Shader* filterShader = nullptr;
+			for(unsigned int i = 1; i < renderPassList.size(); ++i)
+			{
+				RenderPass* previous = renderPassList[i-1];
+				RenderPass* pass = renderPassList[i];
+				if(previous->colorFilters.empty() || pass->colorFilters.empty() || previous->inputs.size() != 1)
+					continue;
+				if(pass->inputs.size() != 1 || pass->inputs[0] != static_cast<int>(i-1))
+					continue;
+				if(previous->colorFilters.size() + pass->colorFilters.size() > MAX_COLOR_FILTERS)
+					continue;
+
+				bool isShared = false;
+				for(unsigned int j = i+1; j < renderPassList.size() && !isShared; ++j)
+					isShared = find(renderPassList[j]->inputs.begin(),renderPassList[j]->inputs.end(),static_cast<int>(i-1)) != renderPassList[j]->inputs.end();
+				if(isShared)
+					continue;
+
+				if(filterShader == nullptr)
+					filterShader = engineResource->getShaderResource("ColorFilterFX").get();
+				if(filterShader == nullptr)
+					return;
+
+				pass->colorFilters.insert(pass->colorFilters.begin(),previous->colorFilters.begin(),previous->colorFilters.end());
+				pass->inputs = previous->inputs;
+				pass->shader = filterShader;
+				pass->sprite->setShader(filterShader);
+				pass->integers["filterAmount"] = pass->colorFilters.size();
+				for(unsigned int j = 0; j < pass->colorFilters.size(); ++j)
+					pass->integers["filterChain[" + boost::lexical_cast<string>(j) + "]"] = pass->colorFilters[j];
+				removeRenderPass(i-1,-1);
+				--i;
+			}
+		}
+
+		/**
+		 * Private method which is used to assign pooled render targets to passes. Result of pass is alive
+		 * until last pass which read it, after that its target is reused by next pass with the same target
+		 * description. Only scene passes use depth buffer.
+		 */
+		void EffectManager::scheduleRenderTargets()
+		{
+			vector<unsigned int> lastUse(renderPassList.size());
+			for(unsigned int i = 0; i < renderPassList.size(); ++i)
+			{
+				lastUse[i] = i;
+				for(vector<int>::const_iterator it = renderPassList[i]->inputs.begin(); it != renderPassList[i]->inputs.end(); ++it)
+					lastUse[*it] = max(lastUse[*it],i);
+			}
+
+			renderTargets->releaseRenderTargets();
+			for(unsigned int i = 0; i < renderPassList.size(); ++i)
+			{
+				RenderPass* pass = renderPassList[i];
+				if(pass->finalRendering)
+				{
+					pass->frameBuffer = nullptr;
+					continue;
+				}
+
+				RenderTargetDesc desc = pass->target;
+				desc.width = max(1,static_cast<int>(desc.width * pass->resolutionScale + 0.5f));
+				desc.height = max(1,static_cast<int>(desc.height * pass->resolutionScale + 0.5f));
+				desc.depthBuffer = pass->offScreenRenderingScene;
+				pass->frameBuffer = renderTargets->getFrameBuffer(renderTargets->acquireRenderTarget(desc,i,lastUse[i]));
+				pass->renderResult->setTexture(desc.depthTexture ? pass->frameBuffer->getDepthBuffer() : pass->frameBuffer->getColorBuffer());
+			}
+			renderTargets->trimRenderTargets();
+		}
+
+		/**
+		 * Private method which is used to remove compiled pass. Inputs of following passes are remapped.
+		 * @param	id is removed pass id.
+		 * @param	replacement is id of pass which result is read instead of removed pass.
+		 */
+		void EffectManager::removeRenderPass(const unsigned int id, const int replacement)
+		{
+			RenderPass* removed = renderPassList[id];
+			renderPassList.erase(renderPassList.begin() + id);
+			delete removed->renderResult;
+			delete removed->sprite;
+			delete removed;
+
+			for(vector<RenderPass*>::const_iterator it = renderPassList.begin(); it != renderPassList.end(); ++it)
+			{
+				for(vector<int>::iterator input = (*it)->inputs.begin(); input != (*it)->inputs.end(); ++input)
+				{
+					if((*input) == static_cast<int>(id))
+						(*input) = replacement;
+					else if((*input) > static_cast<int>(id))
+						(*input)--;
+				}
+			}
 		}
 
 		/**
@@ -134,6 +372,20 @@ namespace AyumiEngine
 		void EffectManager::startEffectPass()
 		{
 			currentRenderPass = new RenderPass();
+			currentRenderPass->frameBuffer = nullptr;
+			currentRenderPass->shader = nullptr;
+			currentRenderPass->renderResult = nullptr;
+			currentRenderPass->sprite = nullptr;
+			currentRenderPass->target.width = 0;
+			currentRenderPass->target.height = 0;
+			currentRenderPass->target.textureType = GL_TEXTURE_RECTANGLE;
+			currentRenderPass->target.depthTexture = false;
+			currentRenderPass->target.depthBuffer = false;
+			currentRenderPass->resolutionScale = 1.0f;
+			currentRenderPass->offScreenRenderingScene = false;
+			currentRenderPass->offScreenRenderingPrevious = false;
+			currentRenderPass->finalRendering = false;
+			currentRenderPass->clearBeforeFinal = false;
 		}
 
 		/**
@@ -142,8 +394,8 @@ namespace AyumiEngine
 		void EffectManager::endEffectPass()
 		{
 			currentRenderPass->renderResult = new Texture();
-			const float width = static_cast<float>(currentRenderPass->frameBuffer->getWidth());
-			const float height = static_cast<float>(currentRenderPass->frameBuffer->getHeight());
+			const float width = static_cast<float>(currentRenderPass->target.width);
+			const float height = static_cast<float>(currentRenderPass->target.height);
 			currentRenderPass->sprite = sprites->createSprite(currentRenderPass->renderResult,currentRenderPass->shader,Vector3D(0.0f,0.0f,0.0f),Vector3D(width,height,0.0f));
 
 			renderPassList.push_back(currentRenderPass);
@@ -187,7 +439,8 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method which is used to load frame buffers initialize parameteres. Create new FBO and configure it.
+		 * Private method which is used to load frame buffers initialize parameteres. Render target is only
+		 * described here, frame buffer is assigned from render target pool when effects are compiled.
 		 * @param	renderTarget is name of render target. For example ColorBuffer/DepthBuffer.
 		 * @param	width is buffer width.
 		 * @param	height is buffer height.
@@ -195,41 +448,16 @@ namespace AyumiEngine
 		 */
 		void EffectManager::loadFrameBufferParams(const string& renderTarget, const int width, const int height, const string& textureType)
 		{
-			currentRenderPass->frameBuffer = new FrameBufferObject(width,height,depth32);
-			currentRenderPass->frameBuffer->create();
-			currentRenderPass->frameBuffer->bind();
-
-			if(renderTarget == "ColorBuffer")
-			{
-				if(textureType == "Rectangle")
-				{
-					if(!currentRenderPass->frameBuffer->attachColorTexture(GL_TEXTURE_RECTANGLE,currentRenderPass->frameBuffer->createColorRectTexture(GL_RGBA,GL_RGBA8),0))
-						Logger::getInstance()->saveLog(Log<string>("Buffer error with color attachment detected!"));
-				}
-				else if(textureType == "Texture2D")
-				{
-					if(!currentRenderPass->frameBuffer->attachColorTexture(GL_TEXTURE_2D,currentRenderPass->frameBuffer->createColorTexture(GL_RGBA,GL_RGBA8),0))
-						Logger::getInstance()->saveLog(Log<string>("Buffer error with color attachment detected!"));
-				}
-			}
-			else if(renderTarget == "DepthBuffer")
-			{
-				if(textureType == "Rectangle")
-				{
-					if(!currentRenderPass->frameBuffer->attachDepthTexture(GL_TEXTURE_RECTANGLE,currentRenderPass->frameBuffer->createColorRectTexture(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT)))
-						Logger::getInstance()->saveLog(Log<string>("Buffer error with color attachment detected!"));
-				}
-				else if(textureType == "Texture2D")
-				{
-					if(!currentRenderPass->frameBuffer->attachDepthTexture(GL_TEXTURE_2D,currentRenderPass->frameBuffer->createColorTexture(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT)))
-						Logger::getInstance()->saveLog(Log<string>("Buffer error with color attachment detected!"));
-				}
-			}
+			if(renderTarget != "ColorBuffer" && renderTarget != "DepthBuffer")
+				Logger::getInstance()->saveLog(Log<string>("Undefined render target requested!"));
+			if(textureType != "Rectangle" && textureType != "Texture2D")
+				Logger::getInstance()->saveLog(Log<string>("Undefined render target texture type requested!"));
 
-			if(!currentRenderPass->frameBuffer->isOk())
-				Logger::getInstance()->saveLog(Log<string>("Error with frame buffer!"));
-			
-			currentRenderPass->frameBuffer->unbind();
+			currentRenderPass->target.width = width;
+			currentRenderPass->target.height = height;
+			currentRenderPass->target.textureType = textureType == "Texture2D" ? GL_TEXTURE_2D : GL_TEXTURE_RECTANGLE;
+			currentRenderPass->target.depthTexture = renderTarget == "DepthBuffer";
+			currentRenderPass->target.depthBuffer = false;
 		}
 
 		/**
@@ -270,5 +498,44 @@ namespace AyumiEngine
 		{
 			currentRenderPass->textures.insert(make_pair(uniformName,value));
 		}
+
+		/**
+		 * Private method which is used to load effect pass input.
+		 * @param	passNumber is number of one of previous passes of the same effect, starting from 0.
+		 */
+		void EffectManager::loadEffectInput(const int passNumber)
+		{
+			currentRenderPass->inputs.push_back(passNumber);
+		}
+
+		/**
+		 * Private method which is used to load resolution scale of pass render target.
+		 * @param	scale is render target scale in (0,1] range.
+		 */
+		void EffectManager::loadRenderTargetScale(const float scale)
+		{
+			if(scale <= 0.0f || scale > 1.0f)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Render target scale must be in (0,1] range!"));
+				return;
+			}
+			currentRenderPass->resolutionScale = scale;
+		}
+
+		/**
+		 * Private method which is used to load per-pixel color filter applied by pass.
+		 * @param	filterName is filter name. For example Sepia/Grayscale/ColorInvert.
+		 */
+		void EffectManager::loadColorFilter(const string& filterName)
+		{
+			if(filterName == "Sepia")
+				currentRenderPass->colorFilters.push_back(SEPIA_FILTER);
+			else if(filterName == "Grayscale")
+				currentRenderPass->colorFilters.push_back(GRAYSCALE_FILTER);
+			else if(filterName == "ColorInvert")
+				currentRenderPass->colorFilters.push_back(COLOR_INVERT_FILTER);
+			else
+				Logger::getInstance()->saveLog(Log<string>("Undefined color filter requested!"));
+		}
 	}
 }
@@ -23,6 +23,8 @@ namespace AyumiEngine
 		 * and configure generic post-processing passes to perform many fullscreen shader effects like: motion
 		 * blur, depth of field or boolm effect. Effects definition are stored in Lua script, also all effects
 		 * are loaded from Lua script which name is stored in Configuration object.
+		 * Loaded passes are compiled into one chain: following effects read result of previous effect,
+		 * adjacent color filter passes are fused and intermediate results share pooled render targets.
 		 */
 		class EffectManager
 		{
@@ -33,8 +35,16 @@ namespace AyumiEngine
 			AyumiScript* renderPassListScript;
 			AyumiResource::ResourceManager* engineResource;
 			SpriteManager* sprites;
+			RenderTargetPool* renderTargets;
 
 			void prepareEffectScripts();
+			void releaseEffects();
+			void resolveEffectInputs(const unsigned int effectStart);
+			void compileEffects();
+			void chainEffects();
+			void fuseColorFilters();
+			void scheduleRenderTargets();
+			void removeRenderPass(const unsigned int id, const int replacement);
 			void loadEffect(const std::string& scriptFileName);
 			void startEffectPass();
 			void endEffectPass();
@@ -47,6 +57,9 @@ namespace AyumiEngine
 			void loadEffectIntegerUniform(const std::string& uniformName, const int value);
 			void loadEffectFloatUniform(const std::string& uniformName, const float value);
 			void loadEffectTextureUniform(const std::string& uniformName, const unsigned int value);
+			void loadEffectInput(const int passNumber);
+			void loadRenderTargetScale(const float scale);
+			void loadColorFilter(const std::string& filterName);
 		
 		public:
 			EffectManager(AyumiResource::ResourceManager* engineResource, SpriteManager* sprites);
@@ -0,0 +1,275 @@
+/**
+ * File contains definition of FrameUniforms class.
+ * @file    FrameUniforms.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-08
+ */
+
+#include <cstring>
+
+#include "FrameUniforms.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiMath;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Uniform buffers are created in initialization.
+		 */
+		FrameUniforms::FrameUniforms()
+		{
+			memset(blockBuffers,0,sizeof(blockBuffers));
+			memset(&cameraBlock,0,sizeof(CameraBlock));
+			memset(&lightBlock,0,sizeof(LightBlock));
+			memset(&shadowBlock,0,sizeof(ShadowBlock));
+			objectStride = sizeof(ObjectBlock);
+			objectCursor = 0;
+			submitObjects = 0;
+			skinStride = sizeof(SkinBlock);
+			skinCursor = 0;
+			submitSkins = 0;
+		}
+
+		/**
+		 * Class destructor, free uniform buffer objects.
+		 */
+		FrameUniforms::~FrameUniforms()
+		{
+			if(blockBuffers[0] != 0)
+				glDeleteBuffers(MAX_UNIFORM_BLOCKS,blockBuffers);
+			objectData.clear();
+		}
+
+		/**
+		 * Method is used to create uniform buffer objects and bind them to fixed binding points. Object data
+		 * and skin data strides are aligned to uniform buffer offset alignment of current OpenGL implementation.
+		 */
+		void FrameUniforms::initializeFrameUniforms()
+		{
+			GLint alignment = 0;
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,&alignment);
+			if(alignment < 16)
+				alignment = 16;
+			objectStride = (sizeof(ObjectBlock) + alignment - 1) / alignment * alignment;
+			objectData.assign(objectStride,0);
+			skinStride = (sizeof(SkinBlock) + alignment - 1) / alignment * alignment;
+
+			const GLsizeiptr blockSizes[MAX_UNIFORM_BLOCKS] = {sizeof(CameraBlock),sizeof(LightBlock),sizeof(ShadowBlock),objectStride*OBJECT_RING_CAPACITY,skinStride*SKIN_RING_CAPACITY};
+			glGenBuffers(MAX_UNIFORM_BLOCKS,blockBuffers);
+			for(unsigned int i = 0; i < MAX_UNIFORM_BLOCKS; ++i)
+			{
+				glBindBuffer(GL_UNIFORM_BUFFER,blockBuffers[i]);
+				glBufferData(GL_UNIFORM_BUFFER,blockSizes[i],NULL,GL_DYNAMIC_DRAW);
+			}
+			glBindBuffer(GL_UNIFORM_BUFFER,0);
+
+			glBindBufferBase(GL_UNIFORM_BUFFER,CAMERA_BLOCK,blockBuffers[CAMERA_BLOCK]);
+			glBindBufferBase(GL_UNIFORM_BUFFER,LIGHT_BLOCK,blockBuffers[LIGHT_BLOCK]);
+			glBindBufferBase(GL_UNIFORM_BUFFER,SHADOW_BLOCK,blockBuffers[SHADOW_BLOCK]);
+		}
+
+		/**
+		 * Method is used to update camera block. Upload is recorded only if matrices changed.
+		 * @param	matrices is reference to current perspective projection matrices.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::updateCameraData(const TransformationMatrices& matrices, RenderCommandBuffer& buffer)
+		{
+			CameraBlock block;
+			memcpy(block.viewMatrix,transpose(matrices.viewMatrix).data(),16*sizeof(float));
+			memcpy(block.projectionMatrix,matrices.projectionMatrix.data(),16*sizeof(float));
+			memcpy(block.inverseCameraMatrix,matrices.inverseViewMatrix.data(),16*sizeof(float));
+
+			if(memcmp(&block,&cameraBlock,sizeof(CameraBlock)) == 0)
+				return;
+			cameraBlock = block;
+			buffer.addBufferUpload(GL_UNIFORM_BUFFER,blockBuffers[CAMERA_BLOCK],0,sizeof(CameraBlock),&cameraBlock);
+		}
+
+		/**
+		 * Method is used to update light block. It is called once per frame, upload is recorded only if
+		 * lights changed.
+		 * @param	lights is pointer to engine light manager.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::updateLightData(LightManager* lights, RenderCommandBuffer& buffer)
+		{
+			LightBlock block;
+			memset(&block,0,sizeof(LightBlock));
+			memcpy(block.clusterData,lightBlock.clusterData,4*sizeof(float));
+
+			const DirectionalLights& directionalLights = *lights->getDirectionalLights();
+			block.lightAmount[0] = min<unsigned int>(directionalLights.size(),MAX_BLOCK_LIGHTS);
+			for(int i = 0; i < block.lightAmount[0]; ++i)
+			{
+				const DirectionalLight* light = directionalLights[i].first;
+				memcpy(block.directionalLight[i].direction,light->direction.data(),3*sizeof(float));
+				memcpy(block.directionalLight[i].ambient,light->color.ambient.data(),4*sizeof(float));
+				memcpy(block.directionalLight[i].diffuse,light->color.diffuse.data(),4*sizeof(float));
+				memcpy(block.directionalLight[i].specular,light->color.specular.data(),4*sizeof(float));
+			}
+
+			const PointLights& pointLights = *lights->getPointLights();
+			block.lightAmount[1] = min<unsigned int>(pointLights.size(),MAX_BLOCK_LIGHTS);
+			for(int i = 0; i < block.lightAmount[1]; ++i)
+			{
+				const PointLight* light = pointLights[i].first;
+				memcpy(block.pointLight[i].position,light->position.data(),3*sizeof(float));
+				block.pointLight[i].radius = light->radius;
+				memcpy(block.pointLight[i].ambient,light->color.ambient.data(),4*sizeof(float));
+				memcpy(block.pointLight[i].diffuse,light->color.diffuse.data(),4*sizeof(float));
+				memcpy(block.pointLight[i].specular,light->color.specular.data(),4*sizeof(float));
+			}
+
+			const SpotLights& spotLights = *lights->getSpotLights();
+			block.lightAmount[2] = min<unsigned int>(spotLights.size(),MAX_BLOCK_LIGHTS);
+			for(int i = 0; i < block.lightAmount[2]; ++i)
+			{
+				const SpotLight* light = spotLights[i].first;
+				memcpy(block.spotLight[i].position,light->position.data(),3*sizeof(float));
+				block.spotLight[i].range = light->range;
+				memcpy(block.spotLight[i].direction,light->direction.data(),3*sizeof(float));
+				block.spotLight[i].cosInnerCone = light->cosInnerCone;
+				memcpy(block.spotLight[i].ambient,light->color.ambient.data(),4*sizeof(float));
+				memcpy(block.spotLight[i].diffuse,light->color.diffuse.data(),4*sizeof(float));
+				memcpy(block.spotLight[i].specular,light->color.specular.data(),4*sizeof(float));
+				block.spotLight[i].cosOuterCone = light->cosOuterCone;
+			}
+
+			if(memcmp(&block,&lightBlock,sizeof(LightBlock)) == 0)
+				return;
+			lightBlock = block;
+			buffer.addBufferUpload(GL_UNIFORM_BUFFER,blockBuffers[LIGHT_BLOCK],0,sizeof(LightBlock),&lightBlock);
+		}
+
+		/**
+		 * Method is used to update light cluster parameters of light block. Upload is recorded only if
+		 * parameters changed.
+		 * @param	clusterData is pointer to cluster parameters.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::updateClusterData(const float* clusterData, RenderCommandBuffer& buffer)
+		{
+			if(memcmp(lightBlock.clusterData,clusterData,4*sizeof(float)) == 0)
+				return;
+			memcpy(lightBlock.clusterData,clusterData,4*sizeof(float));
+			buffer.addBufferUpload(GL_UNIFORM_BUFFER,blockBuffers[LIGHT_BLOCK],0,sizeof(LightBlock),&lightBlock);
+		}
+
+		/**
+		 * Method is used to update shadow block with already calculated shadow matrices.
+		 * @param	shadowMaps is reference to renderer shadow maps.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::updateShadowData(const vector<ShadowMap*>& shadowMaps, RenderCommandBuffer& buffer)
+		{
+			ShadowBlock block;
+			memset(&block,0,sizeof(ShadowBlock));
+			memcpy(block.cascadeMatrix,shadowBlock.cascadeMatrix,sizeof(block.cascadeMatrix));
+			memcpy(block.cascadeSplits,shadowBlock.cascadeSplits,sizeof(block.cascadeSplits));
+			for(unsigned int i = 0; i < shadowMaps.size() && i < MAX_BLOCK_SHADOWS; ++i)
+				memcpy(block.shadowMatrix[i],shadowMaps[i]->shadowMatrix.data(),16*sizeof(float));
+
+			if(memcmp(&block,&shadowBlock,sizeof(ShadowBlock)) == 0)
+				return;
+			shadowBlock = block;
+			buffer.addBufferUpload(GL_UNIFORM_BUFFER,blockBuffers[SHADOW_BLOCK],0,sizeof(ShadowBlock),&shadowBlock);
+		}
+
+		/**
+		 * Method is used to update shadow cascade part of shadow block. Upload is recorded only if cascade
+		 * matrices or splits changed.
+		 * @param	cascadeMatrices is pointer to shadow matrices of all cascades.
+		 * @param	cascadeSplits is pointer to cascade split distances.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::updateCascadeData(const float* cascadeMatrices, const float* cascadeSplits, RenderCommandBuffer& buffer)
+		{
+			if(memcmp(shadowBlock.cascadeMatrix,cascadeMatrices,sizeof(shadowBlock.cascadeMatrix)) == 0 && memcmp(shadowBlock.cascadeSplits,cascadeSplits,sizeof(shadowBlock.cascadeSplits)) == 0)
+				return;
+			memcpy(shadowBlock.cascadeMatrix,cascadeMatrices,sizeof(shadowBlock.cascadeMatrix));
+			memcpy(shadowBlock.cascadeSplits,cascadeSplits,sizeof(shadowBlock.cascadeSplits));
+			buffer.addBufferUpload(GL_UNIFORM_BUFFER,blockBuffers[SHADOW_BLOCK],0,sizeof(ShadowBlock),&shadowBlock);
+		}
+
+		/**
+		 * Method is used to write object matrices into next ring buffer range and assign this range to last
+		 * recorded draw command. Uploads of following objects are merged by command buffer.
+		 * @param	matrices is reference to current object matrices.
+		 * @param	buffer is reference to command buffer.
+		 * @param	keyFrameData is pointer to key frame data of animated entity or nullptr.
+		 */
+		void FrameUniforms::addObjectData(const TransformationMatrices& matrices, RenderCommandBuffer& buffer, const float* keyFrameData)
+		{
+			if(objectCursor + objectStride > objectStride*OBJECT_RING_CAPACITY)
+				objectCursor = 0;
+
+			ObjectBlock* block = reinterpret_cast<ObjectBlock*>(&objectData[0]);
+			memcpy(block->modelMatrix,transpose(matrices.modelMatrix).data(),16*sizeof(float));
+			memcpy(block->modelViewMatrix,transpose(matrices.modelViewMatrix).data(),16*sizeof(float));
+			for(unsigned int i = 0; i < 3; ++i)
+				memcpy(&block->normalMatrix[i*4],&matrices.normalMatrix.data()[i*3],3*sizeof(float));
+			if(keyFrameData != nullptr)
+				memcpy(block->keyFrameData,keyFrameData,KEY_FRAME_DATA_SIZE*sizeof(float));
+			else
+				memset(block->keyFrameData,0,KEY_FRAME_DATA_SIZE*sizeof(float));
+
+			buffer.addCommandUpload(GL_UNIFORM_BUFFER,blockBuffers[OBJECT_BLOCK],objectCursor,objectStride,&objectData[0]);
+			buffer.addBufferRange(blockBuffers[OBJECT_BLOCK],objectCursor,sizeof(ObjectBlock));
+			objectCursor += objectStride;
+			submitObjects++;
+		}
+
+		/**
+		 * Method is used to release object and skin ring buffer ranges after command buffer was submitted.
+		 */
+		void FrameUniforms::releaseObjectData()
+		{
+			submitObjects = 0;
+			submitSkins = 0;
+		}
+
+		/**
+		 * Method is used to check if next object fits into ring buffer without overwriting data of commands
+		 * which were not submitted yet.
+		 * @return	true if object data can be added.
+		 */
+		bool FrameUniforms::hasObjectSpace() const
+		{
+			return submitObjects < OBJECT_RING_CAPACITY;
+		}
+
+		/**
+		 * Method is used to write skin matrices into next skin ring buffer range and assign this range to last
+		 * recorded draw command. Only matrices of skeleton joints are uploaded, whole block is bound.
+		 * @param	skinMatrices is pointer to column-major skin matrices.
+		 * @param	jointAmount is amount of skin matrices.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void FrameUniforms::addSkinData(const float* skinMatrices, const unsigned int jointAmount, RenderCommandBuffer& buffer)
+		{
+			if(skinCursor + skinStride > skinStride*SKIN_RING_CAPACITY)
+				skinCursor = 0;
+
+			const unsigned int matrixAmount = jointAmount < MAX_SKIN_JOINTS ? jointAmount : MAX_SKIN_JOINTS;
+			buffer.addCommandUpload(GL_UNIFORM_BUFFER,blockBuffers[SKIN_BLOCK],skinCursor,matrixAmount*SKIN_MATRIX_SIZE*sizeof(float),skinMatrices);
+			buffer.addSkinRange(blockBuffers[SKIN_BLOCK],skinCursor,sizeof(SkinBlock));
+			skinCursor += skinStride;
+			submitSkins++;
+		}
+
+		/**
+		 * Method is used to check if next skin matrices fit into skin ring buffer without overwriting data of
+		 * commands which were not submitted yet.
+		 * @return	true if skin data can be added.
+		 */
+		bool FrameUniforms::hasSkinSpace() const
+		{
+			return submitSkins < SKIN_RING_CAPACITY;
+		}
+	}
+}
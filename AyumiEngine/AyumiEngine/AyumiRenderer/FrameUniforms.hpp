@@ -0,0 +1,67 @@
+/**
+ * File contains declaration of FrameUniforms class.
+ * @file    FrameUniforms.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-08
+ */
+
+#ifndef FRAMEUNIFORMS_HPP
+#define FRAMEUNIFORMS_HPP
+
+#include <vector>
+
+#include "UniformBlocks.hpp"
+#include "LightManager.hpp"
+#include "ShadowMap.hpp"
+#include "RenderCommandBuffer.hpp"
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int OBJECT_RING_CAPACITY = 4096;
+		const unsigned int SKIN_RING_CAPACITY = 256;
+
+		/**
+		 * Class represents uniform buffer objects with per-frame data shared by all shaders: camera, lights
+		 * and shadow matrices. Each block is bound once to fixed binding point and updated only when data
+		 * change. Per-object data and skin matrices of skinned entities are written into ring buffers - each draw
+		 * command use own aligned range.
+		 * All uploads are recorded into command buffer, so they are executed by render backend.
+		 */
+		class FrameUniforms : private AyumiUtils::Noncopyable
+		{
+		private:
+			GLuint blockBuffers[AyumiResource::MAX_UNIFORM_BLOCKS];
+			CameraBlock cameraBlock;
+			LightBlock lightBlock;
+			ShadowBlock shadowBlock;
+			std::vector<unsigned char> objectData;
+			unsigned int objectStride;
+			unsigned int objectCursor;
+			unsigned int submitObjects;
+			unsigned int skinStride;
+			unsigned int skinCursor;
+			unsigned int submitSkins;
+
+		public:
+			FrameUniforms();
+			~FrameUniforms();
+
+			void initializeFrameUniforms();
+			void updateCameraData(const TransformationMatrices& matrices, RenderCommandBuffer& buffer);
+			void updateLightData(LightManager* lights, RenderCommandBuffer& buffer);
+			void updateClusterData(const float* clusterData, RenderCommandBuffer& buffer);
+			void updateShadowData(const std::vector<ShadowMap*>& shadowMaps, RenderCommandBuffer& buffer);
+			void updateCascadeData(const float* cascadeMatrices, const float* cascadeSplits, RenderCommandBuffer& buffer);
+			void addObjectData(const TransformationMatrices& matrices, RenderCommandBuffer& buffer, const float* keyFrameData = nullptr);
+			void releaseObjectData();
+			bool hasObjectSpace() const;
+			void addSkinData(const float* skinMatrices, const unsigned int jointAmount, RenderCommandBuffer& buffer);
+			bool hasSkinSpace() const;
+		};
+	}
+}
+#endif
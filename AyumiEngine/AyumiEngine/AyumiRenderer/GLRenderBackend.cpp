@@ -0,0 +1,241 @@
+/**
+ * File contains definition of GLRenderBackend class.
+ * @file    GLRenderBackend.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#include "GLRenderBackend.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	lights is pointer to engine LightManager.
+		 * @param	materials is pointer to engine MaterialManager.
+		 * @param	stateMachine is pointer to engine StateMachine.
+		 */
+		GLRenderBackend::GLRenderBackend(LightManager* lights, MaterialManager* materials, AyumiCore::StateMachine* stateMachine)
+		{
+			this->lights = lights;
+			this->materials = materials;
+			this->stateMachine = stateMachine;
+		}
+
+		/**
+		 * Class destructor, nothing to delete - managers are owned by Renderer and StateMachine by Configuration.
+		 */
+		GLRenderBackend::~GLRenderBackend()
+		{
+
+		}
+
+		/**
+		 * Method is used to execute recorded commands in OpenGL context. Buffer uploads are executed in
+		 * recording order, before commands which follow them.
+		 * Shader, vertex array, textures, frame buffer and render states are changed only when they differ
+		 * from current ones. Bindings are invalidated first, because resources bind their objects directly
+		 * between executions. Shader and vertex array are unbound after execution.
+		 * @param	buffer is reference to recorded command buffer.
+		 */
+		void GLRenderBackend::executeCommands(const RenderCommandBuffer& buffer)
+		{
+			const RenderCommands& commands = *buffer.getCommands();
+			const UniformValues& uniforms = *buffer.getUniforms();
+			const TextureBindings& textures = *buffer.getTextures();
+
+			stateMachine->invalidateBindings();
+
+			unsigned int upload = 0;
+			for(RenderCommands::const_iterator it = commands.begin(); it != commands.end(); ++it)
+			{
+				upload = executeUploads(buffer,upload,it - commands.begin());
+				switch((*it).type)
+				{
+				case DRAW_ELEMENTS:
+				case DRAW_ARRAYS:
+				case DRAW_ELEMENTS_INSTANCED:
+				case DRAW_FEEDBACK:
+					stateMachine->bindProgram((*it).shader->getShaderProgram());
+					stateMachine->bindVertexArray((*it).vertexArray);
+					executeDraw(*it,uniforms,textures);
+					break;
+				case BIND_FRAMEBUFFER:
+					stateMachine->bindFrameBuffer((*it).buffer);
+					break;
+				case SET_VIEWPORT:
+					stateMachine->setViewport((*it).parameters[0],(*it).parameters[1],(*it).parameters[2],(*it).parameters[3]);
+					break;
+				case CLEAR_BUFFERS:
+					glClear((*it).parameters[0]);
+					break;
+				case SET_COLOR_MASK:
+					stateMachine->setColorMask((*it).parameters[0] != 0,(*it).parameters[1] != 0,(*it).parameters[2] != 0,(*it).parameters[3] != 0);
+					break;
+				case SET_CULL_FACE:
+					stateMachine->setCullFace((*it).parameters[0]);
+					stateMachine->setCapability(GL_CULL_FACE,(*it).parameters[1] != 0);
+					break;
+				case SET_BLEND_FUNC:
+					stateMachine->setBlendFunction((*it).parameters[0],(*it).parameters[1]);
+					break;
+				case SET_DEPTH_STATE:
+					stateMachine->setDepthFunction((*it).parameters[0]);
+					stateMachine->setDepthMask((*it).parameters[1] != 0);
+					break;
+				default:
+					break;
+				}
+			}
+			executeUploads(buffer,upload,commands.size());
+
+			stateMachine->bindProgram(0);
+			stateMachine->bindVertexArray(0);
+		}
+
+		/**
+		 * Private method which is used to execute recorded buffer uploads which precede given command. Stream
+		 * uploads orphan buffer storage first.
+		 * @param	buffer is reference to recorded command buffer.
+		 * @param	first is index of first not executed upload.
+		 * @param	command is index of next executed command.
+		 * @return	index of first upload which follows given command.
+		 */
+		unsigned int GLRenderBackend::executeUploads(const RenderCommandBuffer& buffer, const unsigned int first, const unsigned int command)
+		{
+			const BufferUploads& uploads = *buffer.getUploads();
+			unsigned int i = first;
+			for(; i < uploads.size() && uploads[i].commandFirst <= command; ++i)
+			{
+				glBindBuffer(uploads[i].target,uploads[i].buffer);
+				if(uploads[i].orphanSize != 0)
+					glBufferData(uploads[i].target,uploads[i].orphanSize,NULL,GL_STREAM_DRAW);
+				glBufferSubData(uploads[i].target,uploads[i].offset,uploads[i].size,buffer.getUploadData(uploads[i]));
+				glBindBuffer(uploads[i].target,0);
+			}
+			return i;
+		}
+
+		/**
+		 * Private method which is used to execute one draw command: send shader data, bind textures and draw.
+		 * Indexed draws use index offset and base vertex, so geometry heap meshes share one vertex array.
+		 * Transform feedback draws write into command buffer with rasterization disabled.
+		 * @param	command is reference to draw command.
+		 * @param	uniforms is reference to command buffer uniform values.
+		 * @param	textures is reference to command buffer texture bindings.
+		 */
+		void GLRenderBackend::executeDraw(const RenderCommand& command, const UniformValues& uniforms, const TextureBindings& textures)
+		{
+			if(command.flags & SEND_LIGHTS)
+				lights->sendLightsData(command.shader);
+			if((command.flags & SEND_MATERIAL) && command.material != nullptr)
+				materials->sendMaterialData(command.material,command.materialTime);
+			if(command.flags & SEND_OBJECT_DATA)
+				glBindBufferRange(GL_UNIFORM_BUFFER,AyumiResource::OBJECT_BLOCK,command.buffer,command.bufferOffset,command.bufferSize);
+			if(command.flags & SEND_SKIN_DATA)
+				glBindBufferRange(GL_UNIFORM_BUFFER,AyumiResource::SKIN_BLOCK,command.skinBuffer,command.skinOffset,command.skinSize);
+
+			sendUniforms(command,uniforms);
+
+			for(unsigned int i = 0; i < command.textureAmount; ++i)
+			{
+				const TextureBinding& binding = textures[command.textureFirst + i];
+				stateMachine->bindTexture(i,binding.target,binding.texture);
+			}
+
+			const GLvoid* indices = reinterpret_cast<const GLubyte*>(0) + command.indexOffset;
+			if(command.type == DRAW_ELEMENTS)
+				glDrawElementsBaseVertex(command.primitive,command.count,GL_UNSIGNED_INT,indices,command.baseVertex);
+			else if(command.type == DRAW_ELEMENTS_INSTANCED)
+			{
+				bindInstanceAttributes(command);
+				glDrawElementsInstancedBaseVertex(command.primitive,command.count,GL_UNSIGNED_INT,indices,command.instanceAmount,command.baseVertex);
+				unbindInstanceAttributes(command);
+			}
+			else if(command.type == DRAW_FEEDBACK)
+			{
+				stateMachine->setCapability(GL_RASTERIZER_DISCARD,true);
+				glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER,0,command.buffer);
+				glBeginTransformFeedback(command.primitive);
+				glDrawArrays(command.primitive,command.first,command.count);
+				glEndTransformFeedback();
+				glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER,0,0);
+				stateMachine->setCapability(GL_RASTERIZER_DISCARD,false);
+			}
+			else
+				glDrawArrays(command.primitive,command.first,command.count);
+		}
+
+		/**
+		 * Private method which is used to point instance matrix attribute of bound vertex array at command
+		 * instance data. Matrix use four attribute locations, one column each, advanced once per instance.
+		 * @param	command is reference to instanced draw command.
+		 */
+		void GLRenderBackend::bindInstanceAttributes(const RenderCommand& command)
+		{
+			const GLint location = command.shader->getInstanceAttribute();
+			glBindBuffer(GL_ARRAY_BUFFER,command.instanceBuffer);
+			for(GLint i = 0; i < 4; ++i)
+			{
+				glEnableVertexAttribArray(location + i);
+				glVertexAttribPointer(location + i,4,GL_FLOAT,GL_FALSE,16*sizeof(float),reinterpret_cast<const GLubyte*>(0) + command.instanceOffset + i*4*sizeof(float));
+				glVertexAttribDivisor(location + i,1);
+			}
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Private method which is used to disable instance matrix attribute of bound vertex array after instanced
+		 * draw. Geometry heap vertex array is shared by all meshes, so following draws must not read instance data.
+		 * @param	command is reference to instanced draw command.
+		 */
+		void GLRenderBackend::unbindInstanceAttributes(const RenderCommand& command)
+		{
+			const GLint location = command.shader->getInstanceAttribute();
+			for(GLint i = 0; i < 4; ++i)
+			{
+				glVertexAttribDivisor(location + i,0);
+				glDisableVertexAttribArray(location + i);
+			}
+		}
+
+		/**
+		 * Private method which is used to send command uniform values to bound shader.
+		 * @param	command is reference to draw command.
+		 * @param	uniforms is reference to command buffer uniform values.
+		 */
+		void GLRenderBackend::sendUniforms(const RenderCommand& command, const UniformValues& uniforms)
+		{
+			for(unsigned int i = command.uniformFirst; i < command.uniformFirst + command.uniformAmount; ++i)
+			{
+				const UniformValue& value = uniforms[i];
+				switch(value.type)
+				{
+				case UNIFORM_INTEGER:
+					command.shader->setUniformi(value.handle,value.integer);
+					break;
+				case UNIFORM_FLOAT:
+					command.shader->setUniformf(value.handle,value.data[0]);
+					break;
+				case UNIFORM_VECTOR4:
+					command.shader->setUniform4fv(value.handle,value.data);
+					break;
+				case UNIFORM_MATRIX3:
+					command.shader->setUniformMatrix3fv(value.handle,value.data);
+					break;
+				case UNIFORM_MATRIX4:
+					command.shader->setUniformMatrix4fv(value.handle,value.data);
+					break;
+				case UNIFORM_TEXTURE:
+					command.shader->setUniformTexture(value.handle,value.integer);
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+/**
+ * File contains declaration of GLRenderBackend class.
+ * @file    GLRenderBackend.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#ifndef GLRENDERBACKEND_HPP
+#define GLRENDERBACKEND_HPP
+
+#include "RenderBackend.hpp"
+#include "LightManager.hpp"
+#include "MaterialManager.hpp"
+
+#include "../AyumiCore/StateMachine.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class represents OpenGL implementation of RenderBackend. Commands are executed in recorded order.
+		 * Bindings and render states are set through engine StateMachine, so redundant OpenGL calls are filtered.
+		 */
+		class GLRenderBackend : public RenderBackend
+		{
+		private:
+			LightManager* lights;
+			MaterialManager* materials;
+			AyumiCore::StateMachine* stateMachine;
+
+			unsigned int executeUploads(const RenderCommandBuffer& buffer, const unsigned int first, const unsigned int command);
+			void executeDraw(const RenderCommand& command, const UniformValues& uniforms, const TextureBindings& textures);
+			void bindInstanceAttributes(const RenderCommand& command);
+			void unbindInstanceAttributes(const RenderCommand& command);
+			void sendUniforms(const RenderCommand& command, const UniformValues& uniforms);
+
+		public:
+			GLRenderBackend(LightManager* lights, MaterialManager* materials, AyumiCore::StateMachine* stateMachine);
+			~GLRenderBackend();
+
+			void executeCommands(const RenderCommandBuffer& buffer);
+		};
+	}
+}
+#endif
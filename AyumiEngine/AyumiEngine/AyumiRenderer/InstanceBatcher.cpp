@@ -0,0 +1,168 @@
+/**
+ * File contains definition of InstanceBatcher class.
+ * @file    InstanceBatcher.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-10
+ */
+
+#include "InstanceBatcher.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiScene;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Instance buffer is created in initialization.
+		 */
+		InstanceBatcher::InstanceBatcher()
+		{
+			batchAmount = 0;
+			instanceBuffer = 0;
+			instanceCursor = 0;
+			submitInstances = 0;
+		}
+
+		/**
+		 * Class destructor, free instance buffer and batches.
+		 */
+		InstanceBatcher::~InstanceBatcher()
+		{
+			if(instanceBuffer != 0)
+				glDeleteBuffers(1,&instanceBuffer);
+			batches.clear();
+		}
+
+		/**
+		 * Method is used to create instance ring buffer.
+		 */
+		void InstanceBatcher::initializeInstanceBatcher()
+		{
+			glGenBuffers(1,&instanceBuffer);
+			glBindBuffer(GL_ARRAY_BUFFER,instanceBuffer);
+			glBufferData(GL_ARRAY_BUFFER,INSTANCE_RING_CAPACITY*INSTANCE_DATA_SIZE*sizeof(float),NULL,GL_STREAM_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Method is used to add visible entity to batch of entities with the same mesh and material.
+		 * @param	entity is pointer to scene entity.
+		 * @return	false if entity material or shader do not support instancing or entity is key frame animated or skinned.
+		 */
+		bool InstanceBatcher::addInstance(SceneEntity* entity)
+		{
+			if(!entity->entityMaterial.instancing || entity->entityMaterial.entityShader->getInstanceAttribute() < 0)
+				return false;
+			if(entity->entityGeometry.geometryData->isKeyFrameGeometry() || entity->entityGeometry.geometryMesh->isSkinnedMesh())
+				return false;
+
+			unsigned int id = 0;
+			for(; id < batchAmount; ++id)
+			{
+				const SceneEntity* first = batches[id].entity;
+				if(first->entityGeometry.geometryMesh == entity->entityGeometry.geometryMesh && first->entityMaterial.materialName == entity->entityMaterial.materialName)
+					break;
+			}
+
+			if(id == batchAmount)
+			{
+				if(batchAmount == batches.size())
+					batches.push_back(InstanceBatch());
+				batches[id].entity = entity;
+				batches[id].instanceAmount = 0;
+				batches[id].transforms.clear();
+				batchAmount++;
+			}
+
+			Matrix4D modelMatrix;
+			modelMatrix.LoadIdentity();
+			modelMatrix.Translatef(entity->entityState.position);
+			modelMatrix *= entity->entityState.orientation.matrix4();
+			modelMatrix.Scalef(entity->entityState.scale);
+			modelMatrix.transpose();
+
+			InstanceBatch& batch = batches[id];
+			batch.transforms.insert(batch.transforms.end(),modelMatrix.data(),modelMatrix.data() + INSTANCE_DATA_SIZE);
+			batch.instanceAmount++;
+			return true;
+		}
+
+		/**
+		 * Method is used to clear batches after they were recorded. Memory is kept for next frame.
+		 */
+		void InstanceBatcher::clearInstances()
+		{
+			batchAmount = 0;
+		}
+
+		/**
+		 * Method is used to write instance transforms into ring buffer. Amount of instances must not exceed
+		 * free instances amount.
+		 * @param	transforms is pointer to instance transforms.
+		 * @param	instanceAmount is amount of instances.
+		 * @param	buffer is reference to command buffer.
+		 * @return	offset of instance data in instance buffer.
+		 */
+		GLintptr InstanceBatcher::addInstanceData(const float* transforms, const unsigned int instanceAmount, RenderCommandBuffer& buffer)
+		{
+			if(instanceCursor + instanceAmount > INSTANCE_RING_CAPACITY)
+				instanceCursor = 0;
+
+			const GLintptr offset = instanceCursor*INSTANCE_DATA_SIZE*sizeof(float);
+			buffer.addBufferUpload(GL_ARRAY_BUFFER,instanceBuffer,offset,instanceAmount*INSTANCE_DATA_SIZE*sizeof(float),transforms);
+			instanceCursor += instanceAmount;
+			submitInstances += instanceAmount;
+			return offset;
+		}
+
+		/**
+		 * Method is used to release ring buffer ranges after command buffer was submitted.
+		 */
+		void InstanceBatcher::releaseInstanceData()
+		{
+			submitInstances = 0;
+		}
+
+		/**
+		 * Accessor to amount of batches recorded in current frame.
+		 * @return	amount of batches.
+		 */
+		unsigned int InstanceBatcher::getBatchAmount() const
+		{
+			return batchAmount;
+		}
+
+		/**
+		 * Accessor to recorded batch.
+		 * @param	id is batch id.
+		 * @return	reference to instance batch.
+		 */
+		InstanceBatch& InstanceBatcher::getBatch(const unsigned int id)
+		{
+			return batches[id];
+		}
+
+		/**
+		 * Method is used to get amount of instances which can be written before command buffer must be
+		 * submitted. Ring buffer wraps only at the beginning of submit, so data of recorded commands is never
+		 * overwritten.
+		 * @return	amount of free instances.
+		 */
+		unsigned int InstanceBatcher::getFreeInstances() const
+		{
+			return submitInstances == 0 ? INSTANCE_RING_CAPACITY : INSTANCE_RING_CAPACITY - instanceCursor;
+		}
+
+		/**
+		 * Accessor to private instance buffer member.
+		 * @return	instance buffer object id.
+		 */
+		GLuint InstanceBatcher::getInstanceBuffer() const
+		{
+			return instanceBuffer;
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/**
+ * File contains declaration of InstanceBatcher class.
+ * @file    InstanceBatcher.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-10
+ */
+
+#ifndef INSTANCEBATCHER_HPP
+#define INSTANCEBATCHER_HPP
+
+#include <vector>
+
+#include "RenderCommandBuffer.hpp"
+
+#include "../AyumiScene/SceneEntity.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int INSTANCE_RING_CAPACITY = 16384;
+		const unsigned int INSTANCE_DATA_SIZE = 16;
+
+		/**
+		 * Structure represents batch of visible entities which share mesh and material. First entity is used
+		 * as batch representative (vertex array, material, textures), transforms store model matrix of each
+		 * instance in column-major order.
+		 */
+		struct InstanceBatch
+		{
+			AyumiScene::SceneEntity* entity;
+			unsigned int instanceAmount;
+			std::vector<float> transforms;
+		};
+
+		/**
+		 * Class represents hardware instancing batcher. Visible entities with instancing material are grouped
+		 * by mesh and material and drawn by one instanced draw call per batch. Per-instance transforms are
+		 * written into ring vertex buffer - shader read them from instanceMatrix attribute. Batches and their
+		 * transform arrays are reused between frames, so batching does not allocate in steady state.
+		 */
+		class InstanceBatcher : private AyumiUtils::Noncopyable
+		{
+		private:
+			std::vector<InstanceBatch> batches;
+			unsigned int batchAmount;
+			GLuint instanceBuffer;
+			unsigned int instanceCursor;
+			unsigned int submitInstances;
+
+		public:
+			InstanceBatcher();
+			~InstanceBatcher();
+
+			void initializeInstanceBatcher();
+			bool addInstance(AyumiScene::SceneEntity* entity);
+			void clearInstances();
+			GLintptr addInstanceData(const float* transforms, const unsigned int instanceAmount, RenderCommandBuffer& buffer);
+			void releaseInstanceData();
+
+			unsigned int getBatchAmount() const;
+			InstanceBatch& getBatch(const unsigned int id);
+			unsigned int getFreeInstances() const;
+			GLuint getInstanceBuffer() const;
+		};
+	}
+}
+#endif
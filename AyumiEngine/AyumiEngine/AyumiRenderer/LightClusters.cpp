@@ -0,0 +1,368 @@
+/**
+ * File contains definition of LightClusters class.
+ * @file    LightClusters.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-13
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <boost/bind.hpp>
+
+#include "LightClusters.hpp"
+
+#include "../AyumiCore/WorkerPool.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiCore;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Buffer textures are created in initialization.
+		 */
+		LightClusters::LightClusters()
+		{
+			setClusterFrustum(1.0f,1.0f,1.0f,1000.0f);
+			clusterCounts.assign(CLUSTER_AMOUNT,0);
+			clusterOffsets.assign(CLUSTER_AMOUNT,0);
+			clusterCursors.assign(CLUSTER_AMOUNT,0);
+			gridData.assign(CLUSTER_AMOUNT*2,0);
+			workerIndices.resize(MAX_CLUSTER_WORKERS);
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				clusterBuffers[i] = 0;
+				clusterTextures[i] = 0;
+			}
+			indexCapacity = 0;
+			lightCapacity = 0;
+		}
+
+		/**
+		 * Class destructor, free buffer textures.
+		 */
+		LightClusters::~LightClusters()
+		{
+			if(clusterBuffers[0] != 0)
+			{
+				glDeleteTextures(3,clusterTextures);
+				glDeleteBuffers(3,clusterBuffers);
+			}
+		}
+
+		/**
+		 * Method is used to create cluster grid, light index and light data buffer textures and bind them to
+		 * fixed texture units.
+		 */
+		void LightClusters::initializeLightClusters()
+		{
+			indexCapacity = CLUSTER_AMOUNT*8;
+			lightCapacity = MAX_BLOCK_LIGHTS*8;
+			const GLsizeiptr bufferSizes[3] = {CLUSTER_AMOUNT*2*sizeof(unsigned int),indexCapacity*sizeof(unsigned int),lightCapacity*CLUSTER_LIGHT_TEXELS*4*sizeof(float)};
+			const GLenum formats[3] = {GL_RG32UI,GL_R32UI,GL_RGBA32F};
+
+			glGenBuffers(3,clusterBuffers);
+			glGenTextures(3,clusterTextures);
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				glBindBuffer(GL_TEXTURE_BUFFER,clusterBuffers[i]);
+				glBufferData(GL_TEXTURE_BUFFER,bufferSizes[i],NULL,GL_STREAM_DRAW);
+				glActiveTexture(GL_TEXTURE0 + AyumiResource::CLUSTER_GRID_UNIT + i);
+				glBindTexture(GL_TEXTURE_BUFFER,clusterTextures[i]);
+				glTexBuffer(GL_TEXTURE_BUFFER,formats[i],clusterBuffers[i]);
+			}
+			glBindBuffer(GL_TEXTURE_BUFFER,0);
+			glActiveTexture(GL_TEXTURE0);
+		}
+
+		/**
+		 * Method is used to assign scene point and spot lights to clusters of current perspective projection
+		 * and record upload of cluster data. Light positions and directions are stored in view space.
+		 * @param	lights is pointer to engine light manager.
+		 * @param	matrices is reference to current perspective projection matrices.
+		 * @param	viewportScale is scale of scene viewport, clusters are fitted to scaled screen.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void LightClusters::updateLightClusters(LightManager* lights, const TransformationMatrices& matrices, const float viewportScale, RenderCommandBuffer& buffer)
+		{
+			const float* projection = matrices.projectionMatrix.data();
+			setClusterFrustum(1.0f / projection[0],1.0f / projection[5],projection[14] / (projection[10] - 1.0f),projection[14] / (projection[10] + 1.0f));
+			clusterData[0] = AyumiCore::Configuration::getInstance()->getResolutionWidth() * viewportScale;
+			clusterData[1] = AyumiCore::Configuration::getInstance()->getResolutionHeight() * viewportScale;
+
+			spheres.clear();
+			lightData.clear();
+			const PointLights& pointLights = *lights->getPointLights();
+			for(PointLights::const_iterator it = pointLights.begin(); it != pointLights.end() && spheres.size() < MAX_CLUSTER_LIGHTS; ++it)
+			{
+				const PointLight* light = (*it).first;
+				addLightData(matrices.viewMatrix,light->color,light->position,Vector3D(0.0f,0.0f,0.0f),light->radius,0.0f,0.0f,0.0f);
+			}
+
+			const SpotLights& spotLights = *lights->getSpotLights();
+			for(SpotLights::const_iterator it = spotLights.begin(); it != spotLights.end() && spheres.size() < MAX_CLUSTER_LIGHTS; ++it)
+			{
+				const SpotLight* light = (*it).first;
+				addLightData(matrices.viewMatrix,light->color,light->position,light->direction,light->range,light->cosInnerCone,light->cosOuterCone,1.0f);
+			}
+
+			binLights(spheres);
+
+			if(clusterIndices.size() > indexCapacity)
+				while(indexCapacity < clusterIndices.size())
+					indexCapacity *= 2;
+			if(spheres.size() > lightCapacity)
+				while(lightCapacity < spheres.size())
+					lightCapacity *= 2;
+
+			buffer.addStreamUpload(GL_TEXTURE_BUFFER,clusterBuffers[0],gridData.size()*sizeof(unsigned int),gridData.size()*sizeof(unsigned int),&gridData[0]);
+			if(!clusterIndices.empty())
+				buffer.addStreamUpload(GL_TEXTURE_BUFFER,clusterBuffers[1],indexCapacity*sizeof(unsigned int),clusterIndices.size()*sizeof(unsigned int),&clusterIndices[0]);
+			if(!lightData.empty())
+				buffer.addStreamUpload(GL_TEXTURE_BUFFER,clusterBuffers[2],lightCapacity*CLUSTER_LIGHT_TEXELS*4*sizeof(float),lightData.size()*sizeof(float),&lightData[0]);
+		}
+
+		/**
+		 * Method is used to set perspective frustum which is split into clusters.
+		 * @param	tanHalfWidth is tangent of half horizontal field of view.
+		 * @param	tanHalfHeight is tangent of half vertical field of view.
+		 * @param	nearPlane is near clipping plane distance.
+		 * @param	farPlane is far clipping plane distance.
+		 */
+		void LightClusters::setClusterFrustum(const float tanHalfWidth, const float tanHalfHeight, const float nearPlane, const float farPlane)
+		{
+			this->tanHalfWidth = tanHalfWidth;
+			this->tanHalfHeight = tanHalfHeight;
+			this->nearPlane = nearPlane;
+			this->farPlane = farPlane;
+			clusterData[2] = nearPlane;
+			clusterData[3] = farPlane;
+		}
+
+		/**
+		 * Method is used to bin light bounding spheres into clusters. Cluster ranges of lights are calculated
+		 * first, then depth slices are split between WorkerPool threads if there are enough lights. Each worker
+		 * build compact index lists of own clusters, lists are joined in slice order.
+		 * @param	spheres is reference to light bounding spheres in view space.
+		 */
+		void LightClusters::binLights(const vector<ClusterSphere>& spheres)
+		{
+			ranges.clear();
+			ClusterRange range;
+			for(unsigned int i = 0; i < spheres.size(); ++i)
+			{
+				if(computeClusterRange(spheres[i],range))
+				{
+					range.light = i;
+					ranges.push_back(range);
+				}
+			}
+
+			unsigned int workers = 1;
+			if(ranges.size() >= CLUSTER_PARALLEL_LIGHTS)
+				workers = max(1u,min(MAX_CLUSTER_WORKERS,WorkerPool::getInstance()->getThreadAmount()));
+
+			const unsigned int slicesPerWorker = (CLUSTER_Z + workers - 1) / workers;
+			if(workers == 1)
+				binSlices(0,0,CLUSTER_Z);
+			else
+			{
+				WorkerJobs jobs;
+				for(unsigned int i = 0; i < workers; ++i)
+					jobs.push_back(boost::bind(&LightClusters::binSlices,this,i,i*slicesPerWorker,min((i+1)*slicesPerWorker,CLUSTER_Z)));
+				WorkerPool::getInstance()->runJobs(jobs);
+			}
+
+			clusterIndices.clear();
+			for(unsigned int i = 0; i < workers; ++i)
+			{
+				const unsigned int firstCluster = min(i*slicesPerWorker,CLUSTER_Z)*CLUSTER_X*CLUSTER_Y;
+				const unsigned int lastCluster = min((i+1)*slicesPerWorker,CLUSTER_Z)*CLUSTER_X*CLUSTER_Y;
+				const unsigned int base = clusterIndices.size();
+				for(unsigned int j = firstCluster; j < lastCluster; ++j)
+				{
+					clusterOffsets[j] += base;
+					gridData[j*2] = clusterOffsets[j];
+					gridData[j*2+1] = clusterCounts[j];
+				}
+				clusterIndices.insert(clusterIndices.end(),workerIndices[i].begin(),workerIndices[i].end());
+			}
+		}
+
+		/**
+		 * Method is used to get cluster index from cluster coordinates.
+		 * @param	x is screen tile column.
+		 * @param	y is screen tile row.
+		 * @param	z is depth slice.
+		 * @return	cluster index.
+		 */
+		unsigned int LightClusters::getClusterIndex(const unsigned int x, const unsigned int y, const unsigned int z) const
+		{
+			return (z*CLUSTER_Y + y)*CLUSTER_X + x;
+		}
+
+		/**
+		 * Accessor to amount of lights assigned to cluster.
+		 * @param	cluster is cluster index.
+		 * @return	amount of cluster lights.
+		 */
+		unsigned int LightClusters::getClusterLightAmount(const unsigned int cluster) const
+		{
+			return clusterCounts[cluster];
+		}
+
+		/**
+		 * Accessor to light indices assigned to cluster.
+		 * @param	cluster is cluster index.
+		 * @return	pointer to first cluster light index or nullptr if cluster is empty.
+		 */
+		const unsigned int* LightClusters::getClusterLights(const unsigned int cluster) const
+		{
+			return clusterCounts[cluster] == 0 ? nullptr : &clusterIndices[clusterOffsets[cluster]];
+		}
+
+		/**
+		 * Accessor to amount of light indices of all clusters.
+		 * @return	amount of light indices.
+		 */
+		unsigned int LightClusters::getIndexAmount() const
+		{
+			return clusterIndices.size();
+		}
+
+		/**
+		 * Accessor to cluster parameters used by shaders: screen width, screen height, near and far plane.
+		 * @return	pointer to cluster parameters.
+		 */
+		const float* LightClusters::getClusterData() const
+		{
+			return clusterData;
+		}
+
+		/**
+		 * Private method which is used to calculate range of clusters touched by light bounding sphere.
+		 * Screen range is calculated from sphere bounding box projected at nearest and farthest depth, so
+		 * it is conservative.
+		 * @param	sphere is reference to light bounding sphere in view space.
+		 * @param	range is reference to result cluster range.
+		 * @return	false if light is outside view frustum.
+		 */
+		bool LightClusters::computeClusterRange(const ClusterSphere& sphere, ClusterRange& range) const
+		{
+			const float minDepth = max(-sphere.z - sphere.radius,nearPlane);
+			const float maxDepth = min(-sphere.z + sphere.radius,farPlane);
+			if(minDepth > maxDepth)
+				return false;
+
+			const float minX = min((sphere.x - sphere.radius) / minDepth,(sphere.x - sphere.radius) / maxDepth) / tanHalfWidth;
+			const float maxX = max((sphere.x + sphere.radius) / minDepth,(sphere.x + sphere.radius) / maxDepth) / tanHalfWidth;
+			const float minY = min((sphere.y - sphere.radius) / minDepth,(sphere.y - sphere.radius) / maxDepth) / tanHalfHeight;
+			const float maxY = max((sphere.y + sphere.radius) / minDepth,(sphere.y + sphere.radius) / maxDepth) / tanHalfHeight;
+			if(minX > 1.0f || maxX < -1.0f || minY > 1.0f || maxY < -1.0f)
+				return false;
+
+			range.minX = static_cast<unsigned int>(max(0.0f,(minX + 1.0f) * 0.5f * CLUSTER_X));
+			range.maxX = min(static_cast<unsigned int>(max(0.0f,(maxX + 1.0f) * 0.5f * CLUSTER_X)),CLUSTER_X - 1);
+			range.minY = static_cast<unsigned int>(max(0.0f,(minY + 1.0f) * 0.5f * CLUSTER_Y));
+			range.maxY = min(static_cast<unsigned int>(max(0.0f,(maxY + 1.0f) * 0.5f * CLUSTER_Y)),CLUSTER_Y - 1);
+			range.minZ = getDepthSlice(minDepth);
+			range.maxZ = getDepthSlice(maxDepth);
+			return true;
+		}
+
+		/**
+		 * Private method which is used to get exponential depth slice of view space depth.
+		 * @param	depth is positive view space depth.
+		 * @return	depth slice.
+		 */
+		unsigned int LightClusters::getDepthSlice(const float depth) const
+		{
+			const float slice = log(depth / nearPlane) / log(farPlane / nearPlane) * CLUSTER_Z;
+			return min(static_cast<unsigned int>(max(0.0f,slice)),CLUSTER_Z - 1);
+		}
+
+		/**
+		 * Private method which is used to bin lights into clusters of depth slices range. Clusters of range are
+		 * contiguous, so worker counts lights, calculate local offsets and fill own index list without locks.
+		 * @param	worker is worker id.
+		 * @param	firstSlice is first depth slice.
+		 * @param	lastSlice is depth slice after last one.
+		 */
+		void LightClusters::binSlices(const unsigned int worker, const unsigned int firstSlice, const unsigned int lastSlice)
+		{
+			vector<unsigned int>& indices = workerIndices[worker];
+			const unsigned int firstCluster = firstSlice*CLUSTER_X*CLUSTER_Y;
+			const unsigned int lastCluster = lastSlice*CLUSTER_X*CLUSTER_Y;
+			fill(clusterCounts.begin()+firstCluster,clusterCounts.begin()+lastCluster,0);
+
+			for(vector<ClusterRange>::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+			{
+				const unsigned int minZ = max((*it).minZ,firstSlice);
+				const unsigned int maxZ = min((*it).maxZ + 1,lastSlice);
+				for(unsigned int z = minZ; z < maxZ; ++z)
+					for(unsigned int y = (*it).minY; y <= (*it).maxY; ++y)
+						for(unsigned int x = (*it).minX; x <= (*it).maxX; ++x)
+							clusterCounts[getClusterIndex(x,y,z)]++;
+			}
+
+			unsigned int offset = 0;
+			for(unsigned int i = firstCluster; i < lastCluster; ++i)
+			{
+				clusterOffsets[i] = offset;
+				clusterCursors[i] = offset;
+				offset += clusterCounts[i];
+			}
+			indices.resize(offset);
+
+			for(vector<ClusterRange>::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+			{
+				const unsigned int minZ = max((*it).minZ,firstSlice);
+				const unsigned int maxZ = min((*it).maxZ + 1,lastSlice);
+				for(unsigned int z = minZ; z < maxZ; ++z)
+					for(unsigned int y = (*it).minY; y <= (*it).maxY; ++y)
+						for(unsigned int x = (*it).minX; x <= (*it).maxX; ++x)
+							indices[clusterCursors[getClusterIndex(x,y,z)]++] = (*it).light;
+			}
+		}
+
+		/**
+		 * Private method which is used to add light bounding sphere and light buffer texture data. Each light
+		 * use six texels: position and radius, direction and inner cone, ambient, diffuse, specular, outer cone
+		 * and light type.
+		 * @param	viewMatrix is reference to camera view matrix.
+		 * @param	color is reference to light color parameters.
+		 * @param	position is light position in world space.
+		 * @param	direction is light direction in world space.
+		 * @param	radius is light radius or range.
+		 * @param	cosInnerCone is spot light inner cone.
+		 * @param	cosOuterCone is spot light outer cone.
+		 * @param	type is light type: 0 for point and 1 for spot light.
+		 */
+		void LightClusters::addLightData(const Matrix4D& viewMatrix, const LightSourceParameters& color, const Vector3D& position, const Vector3D& direction, const float radius, const float cosInnerCone, const float cosOuterCone, const float type)
+		{
+			const Vector4D viewPosition = viewMatrix * Vector4D(position.x(),position.y(),position.z(),1.0f);
+			const Vector4D viewDirection = viewMatrix * Vector4D(direction.x(),direction.y(),direction.z(),0.0f);
+
+			ClusterSphere sphere;
+			sphere.x = viewPosition[0];
+			sphere.y = viewPosition[1];
+			sphere.z = viewPosition[2];
+			sphere.radius = radius;
+			spheres.push_back(sphere);
+
+			const float texels[CLUSTER_LIGHT_TEXELS*4] =
+			{
+				viewPosition[0], viewPosition[1], viewPosition[2], radius,
+				viewDirection[0], viewDirection[1], viewDirection[2], cosInnerCone,
+				color.ambient[0], color.ambient[1], color.ambient[2], color.ambient[3],
+				color.diffuse[0], color.diffuse[1], color.diffuse[2], color.diffuse[3],
+				color.specular[0], color.specular[1], color.specular[2], color.specular[3],
+				cosOuterCone, type, 0.0f, 0.0f
+			};
+			lightData.insert(lightData.end(),texels,texels + CLUSTER_LIGHT_TEXELS*4);
+		}
+	}
+}
@@ -0,0 +1,104 @@
+/**
+ * File contains declaration of LightClusters class.
+ * @file    LightClusters.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-13
+ */
+
+#ifndef LIGHTCLUSTERS_HPP
+#define LIGHTCLUSTERS_HPP
+
+#include <vector>
+
+#include "LightManager.hpp"
+#include "UniformBlocks.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "TransformationMatrices.hpp"
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int CLUSTER_X = 16;
+		const unsigned int CLUSTER_Y = 9;
+		const unsigned int CLUSTER_Z = 24;
+		const unsigned int CLUSTER_AMOUNT = CLUSTER_X*CLUSTER_Y*CLUSTER_Z;
+		const unsigned int CLUSTER_LIGHT_TEXELS = 6;
+		const unsigned int CLUSTER_PARALLEL_LIGHTS = 128;
+		const unsigned int MAX_CLUSTER_WORKERS = 4;
+
+		/**
+		 * Structure represents light bounding sphere in view space.
+		 */
+		struct ClusterSphere
+		{
+			float x, y, z;
+			float radius;
+		};
+
+		/**
+		 * Structure represents range of clusters which are touched by light.
+		 */
+		struct ClusterRange
+		{
+			unsigned int light;
+			unsigned int minX, maxX;
+			unsigned int minY, maxY;
+			unsigned int minZ, maxZ;
+		};
+
+		/**
+		 * Class represents clustered light assignment for Forward Rendering. View frustum is split into
+		 * 16x9x24 clusters (screen tiles and exponential depth slices). Point and spot light bounding
+		 * spheres are binned into compact per-cluster light index lists, so shaders fetch only lights
+		 * which affect fragment cluster. Binning is pure CPU code which does not need OpenGL context - depth
+		 * slices are split between WorkerPool threads, each worker owns contiguous range of clusters. Cluster
+		 * grid, light indices and light data are uploaded as buffer textures.
+		 */
+		class LightClusters : private AyumiUtils::Noncopyable
+		{
+		private:
+			float tanHalfWidth;
+			float tanHalfHeight;
+			float nearPlane;
+			float farPlane;
+			float clusterData[4];
+			std::vector<ClusterRange> ranges;
+			std::vector<unsigned int> clusterCounts;
+			std::vector<unsigned int> clusterOffsets;
+			std::vector<unsigned int> clusterCursors;
+			std::vector<unsigned int> clusterIndices;
+			std::vector<unsigned int> gridData;
+			std::vector<std::vector<unsigned int> > workerIndices;
+			std::vector<ClusterSphere> spheres;
+			std::vector<float> lightData;
+			GLuint clusterBuffers[3];
+			GLuint clusterTextures[3];
+			unsigned int indexCapacity;
+			unsigned int lightCapacity;
+
+			bool computeClusterRange(const ClusterSphere& sphere, ClusterRange& range) const;
+			unsigned int getDepthSlice(const float depth) const;
+			void binSlices(const unsigned int worker, const unsigned int firstSlice, const unsigned int lastSlice);
+			void addLightData(const AyumiMath::Matrix4D& viewMatrix, const LightSourceParameters& color, const AyumiMath::Vector3D& position, const AyumiMath::Vector3D& direction, const float radius, const float cosInnerCone, const float cosOuterCone, const float type);
+
+		public:
+			LightClusters();
+			~LightClusters();
+
+			void initializeLightClusters();
+			void updateLightClusters(LightManager* lights, const TransformationMatrices& matrices, const float viewportScale, RenderCommandBuffer& buffer);
+			void setClusterFrustum(const float tanHalfWidth, const float tanHalfHeight, const float nearPlane, const float farPlane);
+			void binLights(const std::vector<ClusterSphere>& spheres);
+
+			unsigned int getClusterIndex(const unsigned int x, const unsigned int y, const unsigned int z) const;
+			unsigned int getClusterLightAmount(const unsigned int cluster) const;
+			const unsigned int* getClusterLights(const unsigned int cluster) const;
+			unsigned int getIndexAmount() const;
+			const float* getClusterData() const;
+		};
+	}
+}
+#endif
@@ -61,36 +61,36 @@ namespace AyumiEngine
 			for(DirectionalLights::const_iterator it = directionalLights.begin(); it != directionalLights.end(); ++it)
 			{
 				DirectionalLight* light = (*it).first;
-				vector<string> uniforms = (*it).second;
-				shader->setUniform3fv(uniforms[0].c_str(),light->direction.data());
-				shader->setUniform4fv(uniforms[1].c_str(),light->color.ambient.data());
-				shader->setUniform4fv(uniforms[2].c_str(),light->color.diffuse.data());
-				shader->setUniform4fv(uniforms[3].c_str(),light->color.specular.data());
+				const LightUniforms& uniforms = (*it).second;
+				shader->setUniform3fv(uniforms[0],light->direction.data());
+				shader->setUniform4fv(uniforms[1],light->color.ambient.data());
+				shader->setUniform4fv(uniforms[2],light->color.diffuse.data());
+				shader->setUniform4fv(uniforms[3],light->color.specular.data());
 			}
 
 			for(PointLights::const_iterator it = pointLights.begin(); it != pointLights.end(); ++it)
 			{
 				PointLight* light = (*it).first;
-				vector<string> uniforms = (*it).second;
-				shader->setUniform3fv(uniforms[0].c_str(),light->position.data());
-				shader->setUniform4fv(uniforms[1].c_str(),light->color.ambient.data());
-				shader->setUniform4fv(uniforms[2].c_str(),light->color.diffuse.data());
-				shader->setUniform4fv(uniforms[3].c_str(),light->color.specular.data());
-				shader->setUniformf(uniforms[4].c_str(),light->radius);
+				const LightUniforms& uniforms = (*it).second;
+				shader->setUniform3fv(uniforms[0],light->position.data());
+				shader->setUniform4fv(uniforms[1],light->color.ambient.data());
+				shader->setUniform4fv(uniforms[2],light->color.diffuse.data());
+				shader->setUniform4fv(uniforms[3],light->color.specular.data());
+				shader->setUniformf(uniforms[4],light->radius);
 			}
 
 			for(SpotLights::const_iterator it = spotLights.begin(); it != spotLights.end(); ++it)
 			{
 				SpotLight* light = (*it).first;
-				vector<string> uniforms = (*it).second;
-				shader->setUniform3fv(uniforms[0].c_str(),light->position.data());
-				shader->setUniform4fv(uniforms[1].c_str(),light->color.ambient.data());
-				shader->setUniform4fv(uniforms[2].c_str(),light->color.diffuse.data());
-				shader->setUniform4fv(uniforms[3].c_str(),light->color.specular.data());
-				shader->setUniform3fv(uniforms[4].c_str(),light->direction.data());	
-				shader->setUniformf(uniforms[5].c_str(),light->range);
-				shader->setUniformf(uniforms[6].c_str(),light->cosInnerCone);
-				shader->setUniformf(uniforms[7].c_str(),light->cosOuterCone);
+				const LightUniforms& uniforms = (*it).second;
+				shader->setUniform3fv(uniforms[0],light->position.data());
+				shader->setUniform4fv(uniforms[1],light->color.ambient.data());
+				shader->setUniform4fv(uniforms[2],light->color.diffuse.data());
+				shader->setUniform4fv(uniforms[3],light->color.specular.data());
+				shader->setUniform3fv(uniforms[4],light->direction.data());	
+				shader->setUniformf(uniforms[5],light->range);
+				shader->setUniformf(uniforms[6],light->cosInnerCone);
+				shader->setUniformf(uniforms[7],light->cosOuterCone);
 			}
 		}
 
@@ -174,25 +174,25 @@ namespace AyumiEngine
 			light->direction[1] = luabind::object_cast<float>(direction[2]);
 			light->direction[2] = luabind::object_cast<float>(direction[3]);
 	
-			vector<string> uniforms;
+			LightUniforms uniforms;
 			int i = directionalLights.size();
 
 			string uniformBase = "directionalLight[";
 			uniformBase += boost::lexical_cast<string>(i);
 			uniformBase+= "]";
 			string uniformName = uniformBase + ".direction";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".ambient";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".diffuse";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".specular";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			
 			directionalLights.push_back(make_pair(light,uniforms));
 			
-			if(directionalLights.size() + pointLights.size() + spotLights.size() >= 8)
-				Logger::getInstance()->saveLog(Log<string>("Too many lights for Forward Rendering!"));
+			if(directionalLights.size() > MAX_BLOCK_LIGHTS)
+				Logger::getInstance()->saveLog(Log<string>("Too many directional lights for Forward Rendering!"));
 		}
 
 		/**
@@ -230,7 +230,7 @@ namespace AyumiEngine
 
 			light->radius = radius;
 
-			vector<string> uniforms;
+			LightUniforms uniforms;
 			int i = pointLights.size();
 
 			string uniformBase = "pointLight[";
@@ -238,20 +238,20 @@ namespace AyumiEngine
 			uniformBase+= "]";
 
 			string uniformName = uniformBase + ".position";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".ambient";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".diffuse";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".specular";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".radius";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 
 			pointLights.push_back(make_pair(light,uniforms));
 
-			if(directionalLights.size() + pointLights.size() + spotLights.size() >= 8)
-				Logger::getInstance()->saveLog(Log<string>("Too many lights for Forward Rendering!"));
+			if(pointLights.size() + spotLights.size() > MAX_CLUSTER_LIGHTS)
+				Logger::getInstance()->saveLog(Log<string>("Too many lights for Clustered Forward Rendering!"));
 		}
 
 		/**
@@ -298,7 +298,7 @@ namespace AyumiEngine
 			light->cosInnerCone = cosInnerCone;
 			light->cosOuterCone = cosOuterCone;
 
-			vector<string> uniforms;
+			LightUniforms uniforms;
 			int i = spotLights.size();
 
 			string uniformBase = "spotLight[";
@@ -306,25 +306,25 @@ namespace AyumiEngine
 			uniformBase+= "]";
 
 			string uniformName = uniformBase + ".position";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".ambient";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".diffuse";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".specular";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".direction";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".range";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".cosInnerCone";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 			uniformName = uniformBase + ".cosOuterCone";
-			uniforms.push_back(uniformName);
+			uniforms.push_back(Shader::getUniformHandle(uniformName.c_str()));
 
 			spotLights.push_back(make_pair(light,uniforms));
-			if(directionalLights.size() + pointLights.size() + spotLights.size() >=8 )
-				Logger::getInstance()->saveLog(Log<string>("Too many lights for Forward Rendering!"));
+			if(pointLights.size() + spotLights.size() > MAX_CLUSTER_LIGHTS)
+				Logger::getInstance()->saveLog(Log<string>("Too many lights for Clustered Forward Rendering!"));
 		}
 
 		/**
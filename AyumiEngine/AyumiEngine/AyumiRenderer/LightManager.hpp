@@ -14,6 +14,7 @@
 #include "PointLight.hpp"
 #include "SpotLight.hpp"
 #include "DirectionalLight.hpp"
+#include "UniformBlocks.hpp"
 
 #include "../AyumiScript.hpp"
 #include "../AyumiCore/Configuration.hpp"
@@ -23,15 +24,17 @@ namespace AyumiEngine
 {
 	namespace AyumiRenderer
 	{
-		typedef std::vector<std::pair<DirectionalLight*,std::vector<std::string>>> DirectionalLights;
-		typedef std::vector<std::pair<PointLight*,std::vector<std::string>>> PointLights;
-		typedef std::vector<std::pair<SpotLight*,std::vector<std::string>>> SpotLights;
+		typedef std::vector<AyumiResource::UniformHandle> LightUniforms;
+		typedef std::vector<std::pair<DirectionalLight*,LightUniforms>> DirectionalLights;
+		typedef std::vector<std::pair<PointLight*,LightUniforms>> PointLights;
+		typedef std::vector<std::pair<SpotLight*,LightUniforms>> SpotLights;
 
 		/**
 		 * Class represents LightManager which is important part of Renderer used to load and store data
 		 * of scene lights which is used in Forward Rendering. User can define and load three type of lights:
-		 * spot, point and directional from Lua script. 8 lights is maximum value for good efficient. User can
-		 * add more lights to scene but it cannot be calculated in real-time. 
+		 * spot, point and directional from Lua script. Directional lights are limited to 8 lights of light
+		 * uniform block. Point and spot lights are assigned to light clusters, so shaders which use clustered
+		 * lighting calculate only lights affecting fragment.
 		 */
 		class LightManager
 		{
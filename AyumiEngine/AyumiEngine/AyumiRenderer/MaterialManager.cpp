@@ -96,12 +96,14 @@ namespace AyumiEngine
 				.def("loadMaterialFloatParameter",&MaterialManager::loadMaterialFloatParameter)
 				.def("loadMaterialLayer",&MaterialManager::loadMaterialLayer)
 				.def("loadMaterialShader",&MaterialManager::loadMaterialShader)
+				.def("loadMaterialDepthShader",&MaterialManager::loadMaterialDepthShader)
 				.def("loadMaterialAmbient",&MaterialManager::loadMaterialAmbient)
 				.def("loadMaterialDiffuse",&MaterialManager::loadMaterialDiffuse)
 				.def("loadMaterialSpecular",&MaterialManager::loadMaterialSpecular)
 				.def("loadMaterialShininess",&MaterialManager::loadMaterialShininess)
 				.def("setDepthTest",&MaterialManager::setDepthTest)
 				.def("setBackFaceCull",&MaterialManager::setBackFaceCull)
+				.def("setInstancing",&MaterialManager::setInstancing)
 				.def("loadEffectVectorUniform",&MaterialManager::loadEffectVectorUniform)
 				.def("loadMaterialUpdateFunctor",&MaterialManager::loadMaterialUpdateFunctor)
 			];
@@ -112,7 +114,8 @@ namespace AyumiEngine
 
 		/**
 		 * Private method which is used to initialize loaded material, set material constant layers and material
-		 * properties uniforms.
+		 * properties uniforms. Constant parameters and layers are set in depth shader as well, because its vertex
+		 * shader is shared with material shader.
 		 */
 		void MaterialManager::initializeMaterial()
 		{
@@ -135,6 +138,20 @@ namespace AyumiEngine
 			material->entityShader->setUniform4fv("material.specular",material->materialProperties.specular.data());
 			material->entityShader->setUniformf("material.shininess",material->materialProperties.shininess);
 			material->entityShader->unbindShader();
+
+			if(material->depthShader != nullptr)
+			{
+				material->depthShader->bindShader();
+				for(IntegerUniforms::const_iterator it = material->integers.begin(); it != material->integers.end(); ++it)
+					material->depthShader->setUniformi((*it).first,(*it).second);
+				for(FloatUniforms::const_iterator it = material->floats.begin(); it != material->floats.end(); ++it)
+					material->depthShader->setUniformf((*it).first,(*it).second);
+				for(TextureUniforms::const_iterator it = material->textures.begin(); it != material->textures.end(); ++it)
+					material->depthShader->setUniformTexture((*it).first,(*it).second);
+				for(VectorUniforms::const_iterator it = material->vectors.begin(); it != material->vectors.end(); ++it)
+					material->depthShader->setUniform3fv(it->first,it->second.data());
+				material->depthShader->unbindShader();
+			}
 		}
 
 		/**
@@ -149,10 +166,24 @@ namespace AyumiEngine
 			//default
 			material->depthTest = true; 
 			material->backfaceCull = true;
+			material->instancing = false;
+			material->depthShader = nullptr;
 			material->updateFunctorName = "null"; //istotne!
 
 			materialScript->setScriptFile(scriptFileName.c_str());
 			materialScript->executeScript();
+			if(material->instancing && material->entityShader->getInstanceAttribute() < 0)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Material shader does not support instancing: "));
+				Logger::getInstance()->saveLog(Log<string>(material->materialName));
+				material->instancing = false;
+			}
+			if(material->depthShader != nullptr && material->updateFunctorName != "null")
+			{
+				Logger::getInstance()->saveLog(Log<string>("Material with update function can not use depth pre-pass: "));
+				Logger::getInstance()->saveLog(Log<string>(material->materialName));
+				material->depthShader = nullptr;
+			}
 			initializeMaterial();
 			addResource(material->materialName,Material(material));
 		}
@@ -223,6 +254,18 @@ namespace AyumiEngine
 			material->entityShader = engineResource->getShaderResource(name).get();
 		}
 
+		/**
+		 * Private method which is used to load material depth shader. Material is drawn in depth pre-pass, so
+		 * depth shader must use the same vertex shader as material shader - depth of both passes must be equal.
+		 * This vertex shader must declare gl_Position as invariant, otherwise compiler may optimize both programs
+		 * differently and equal depth test fails. It can be called from Lua script.
+		 * @param	name is material depth shader name.
+		 */
+		void MaterialManager::loadMaterialDepthShader(const string& name)
+		{
+			material->depthShader = engineResource->getShaderResource(name).get();
+		}
+
 		/**
 		 * Private method which is used to load material ambient properties. It can be called from Lua script.
 		 * @param	ambinet is material ambient properties array.
@@ -283,6 +326,16 @@ namespace AyumiEngine
 			material->backfaceCull = (backfaceCull == "true" || backfaceCull == "True" || backfaceCull == "TRUE");
 		}
 
+		/**
+		 * Private method which is used to mark material as instanced. Material shader must read model matrix
+		 * from instanceMatrix attribute, otherwise flag is cleared after loading. It can be called from Lua script.
+		 * @param	instancing is instancing flag string.
+		 */
+		void MaterialManager::setInstancing(const string& instancing)
+		{
+			material->instancing = (instancing == "true" || instancing == "True" || instancing == "TRUE");
+		}
+
 		void MaterialManager::loadEffectVectorUniform(const string& name, const luabind::object& vector)
 		{
 			Vector3D v;
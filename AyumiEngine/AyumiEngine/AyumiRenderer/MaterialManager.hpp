@@ -54,6 +54,7 @@ namespace AyumiEngine
 			void loadMaterialFloatParameter(const std::string& parameterName, const float value);
 			void loadMaterialLayer(const std::string& layerName, const unsigned int slot);
 			void loadMaterialShader(const std::string& name);
+			void loadMaterialDepthShader(const std::string& name);
 			void loadMaterialAmbient(const luabind::object& ambient); 
 			void loadMaterialDiffuse(const luabind::object& diffuse); 
 			void loadMaterialSpecular(const luabind::object& specular);
@@ -61,6 +62,7 @@ namespace AyumiEngine
 			void loadMaterialUpdateFunctor(const std::string& name);
 			void setDepthTest(const std::string& depthTest);
 			void setBackFaceCull(const std::string& backfaceCull);
+			void setInstancing(const std::string& instancing);
 			void loadEffectVectorUniform(const std::string& name, const luabind::object& vector);
 
 		public:
@@ -0,0 +1,153 @@
+/**
+ * File contains definition of NullRenderBackend class.
+ * @file    NullRenderBackend.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#include <cstring>
+
+#include "NullRenderBackend.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	recording is flag which determine if executed commands are copied for later inspection.
+		 */
+		NullRenderBackend::NullRenderBackend(const bool recording)
+		{
+			this->recording = recording;
+			resetStatistics();
+		}
+
+		/**
+		 * Class destructor, free recorded commands.
+		 */
+		NullRenderBackend::~NullRenderBackend()
+		{
+			recordedCommands.clear();
+			recordedUniforms.clear();
+			recordedTextures.clear();
+		}
+
+		/**
+		 * Method is used to "execute" recorded commands. No OpenGL call is made, backend only count commands,
+		 * draw calls, primitives and state changes which real backend would perform.
+		 * @param	buffer is reference to recorded command buffer.
+		 */
+		void NullRenderBackend::executeCommands(const RenderCommandBuffer& buffer)
+		{
+			const RenderCommands& commands = *buffer.getCommands();
+			Shader* currentShader = nullptr;
+			GLuint currentVertexArray = 0;
+			statistics.executions++;
+
+			const BufferUploads& uploads = *buffer.getUploads();
+			for(BufferUploads::const_iterator it = uploads.begin(); it != uploads.end(); ++it)
+			{
+				statistics.bufferUploads++;
+				statistics.uploadedBytes += (*it).size;
+			}
+
+			for(RenderCommands::const_iterator it = commands.begin(); it != commands.end(); ++it)
+			{
+				statistics.commands[(*it).type]++;
+				if((*it).type == DRAW_ELEMENTS || (*it).type == DRAW_ARRAYS || (*it).type == DRAW_ELEMENTS_INSTANCED || (*it).type == DRAW_FEEDBACK)
+				{
+					const unsigned int instances = (*it).type == DRAW_ELEMENTS_INSTANCED ? (*it).instanceAmount : 1;
+					statistics.drawCalls++;
+					statistics.instances += instances;
+					statistics.primitives += ((*it).primitive == GL_TRIANGLES ? (*it).count / 3 : (*it).count) * instances;
+					statistics.uniformValues += (*it).uniformAmount;
+					statistics.textureBindings += (*it).textureAmount;
+					if((*it).shader != currentShader)
+					{
+						statistics.shaderChanges++;
+						currentShader = (*it).shader;
+					}
+					if((*it).vertexArray != currentVertexArray)
+					{
+						statistics.vertexArrayChanges++;
+						currentVertexArray = (*it).vertexArray;
+					}
+				}
+			}
+
+			if(recording)
+			{
+				const unsigned int uniformOffset = recordedUniforms.size();
+				const unsigned int textureOffset = recordedTextures.size();
+				recordedUniforms.insert(recordedUniforms.end(),buffer.getUniforms()->begin(),buffer.getUniforms()->end());
+				recordedTextures.insert(recordedTextures.end(),buffer.getTextures()->begin(),buffer.getTextures()->end());
+				for(RenderCommands::const_iterator it = commands.begin(); it != commands.end(); ++it)
+				{
+					recordedCommands.push_back(*it);
+					recordedCommands.back().uniformFirst += uniformOffset;
+					recordedCommands.back().textureFirst += textureOffset;
+				}
+			}
+		}
+
+		/**
+		 * Method is used to reset collected statistics and recorded commands.
+		 */
+		void NullRenderBackend::resetStatistics()
+		{
+			memset(&statistics,0,sizeof(RenderBackendStatistics));
+			recordedCommands.clear();
+			recordedUniforms.clear();
+			recordedTextures.clear();
+		}
+
+		/**
+		 * Accessor to private statistics member.
+		 * @return	reference to collected statistics.
+		 */
+		const RenderBackendStatistics& NullRenderBackend::getStatistics() const
+		{
+			return statistics;
+		}
+
+		/**
+		 * Accessor to private recorded commands member.
+		 * @return	pointer to recorded commands.
+		 */
+		const RenderCommands* NullRenderBackend::getRecordedCommands() const
+		{
+			return &recordedCommands;
+		}
+
+		/**
+		 * Accessor to private recorded uniform values member.
+		 * @return	pointer to recorded uniform values.
+		 */
+		const UniformValues* NullRenderBackend::getRecordedUniforms() const
+		{
+			return &recordedUniforms;
+		}
+
+		/**
+		 * Accessor to private recorded texture bindings member.
+		 * @return	pointer to recorded texture bindings.
+		 */
+		const TextureBindings* NullRenderBackend::getRecordedTextures() const
+		{
+			return &recordedTextures;
+		}
+
+		/**
+		 * Method is used to set recording flag.
+		 * @param	recording is flag which determine if executed commands are copied.
+		 */
+		void NullRenderBackend::setRecording(const bool recording)
+		{
+			this->recording = recording;
+		}
+	}
+}
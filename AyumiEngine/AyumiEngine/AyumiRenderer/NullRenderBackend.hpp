@@ -0,0 +1,64 @@
+/**
+ * File contains declaration of NullRenderBackend class.
+ * @file    NullRenderBackend.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#ifndef NULLRENDERBACKEND_HPP
+#define NULLRENDERBACKEND_HPP
+
+#include "RenderBackend.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Structure represents statistics collected by NullRenderBackend.
+		 */
+		struct RenderBackendStatistics
+		{
+			unsigned int executions;
+			unsigned int commands[MAX_COMMAND_TYPES];
+			unsigned int drawCalls;
+			unsigned int primitives;
+			unsigned int instances;
+			unsigned int uniformValues;
+			unsigned int textureBindings;
+			unsigned int shaderChanges;
+			unsigned int vertexArrayChanges;
+			unsigned int bufferUploads;
+			unsigned int uploadedBytes;
+		};
+
+		/**
+		 * Class represents null implementation of RenderBackend which do not call OpenGL at all. Backend only
+		 * count and optionally record executed commands, so it is used to benchmark and test CPU side rendering
+		 * cost on machines without GPU. RenderHarness use it to measure frames without command execution.
+		 */
+		class NullRenderBackend : public RenderBackend
+		{
+		private:
+			RenderBackendStatistics statistics;
+			RenderCommands recordedCommands;
+			UniformValues recordedUniforms;
+			TextureBindings recordedTextures;
+			bool recording;
+
+		public:
+			NullRenderBackend(const bool recording = false);
+			~NullRenderBackend();
+
+			void executeCommands(const RenderCommandBuffer& buffer);
+			void resetStatistics();
+
+			const RenderBackendStatistics& getStatistics() const;
+			const RenderCommands* getRecordedCommands() const;
+			const UniformValues* getRecordedUniforms() const;
+			const TextureBindings* getRecordedTextures() const;
+			void setRecording(const bool recording);
+		};
+	}
+}
+#endif
@@ -11,8 +11,9 @@
 #include <boost/function.hpp>
 
 #include "Particle.hpp"
+#include "ParticlePool.hpp"
+#include "ParticleFeedback.hpp"
 
-#include "../AyumiUtils/Vertex.hpp"
 #include "../AyumiResource/Texture.hpp"
 #include "../AyumiResource/Shader.hpp"
 #include "../AyumiUtils/VertexArrayObject.hpp"
@@ -21,14 +22,32 @@ namespace AyumiEngine
 {
 	namespace AyumiRenderer
 	{
+		/**
+		 * Enumeration represents particle simulation backend of emiter. CPU emiters integrate particle pool with
+		 * SSE and stream vertices, GPU emiters simulate particles by transform feedback.
+		 */
+		enum ParticleSimulation
+		{
+			CPU_SIMULATION,
+			GPU_SIMULATION
+		};
+
 		/**
 		 * Structure represents Particle Emiter which is used to create particle effects. Particle Emiter is 
-		 * defined by Lua script and store data of all particles, points geometry and initialize/update function.
+		 * defined by Lua script and store emission parameters, particle pool, points geometry and initialize/update
+		 * function. Particles are emitted with emission rate per second, velocity of each particle is randomized
+		 * by velocity spread. Depending on simulation backend emiter use particle pool or transform feedback buffers.
 		 */
 		struct ParticleEmiter
 		{
-			//todo color in vbo
-			Particle* particles;
+			Particle particle;
+			AyumiMath::Vector3D velocitySpread;
+			float sizeGrowth;
+			float emissionRate;
+			float emissionTime;
+			ParticleSimulation simulation;
+			ParticlePool* pool;
+			ParticleFeedback* feedback;
 			std::string name;
 			AyumiMath::Vector3D origin;
 			AyumiResource::Shader* shader;
@@ -37,7 +56,6 @@ namespace AyumiEngine
 			boost::function<void (ParticleEmiter*,float)> updateFunction;
 			AyumiUtils::VertexArrayObject* particleVao;
 			GLuint particleVbo;
-			AyumiUtils::Vertex<>* points;
 			int particleAmount;
 		};
 	}
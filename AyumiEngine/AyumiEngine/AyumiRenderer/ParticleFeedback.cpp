@@ -0,0 +1,146 @@
+/**
+ * File contains definition of ParticleFeedback class.
+ * @file    ParticleFeedback.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-19
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "ParticleFeedback.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiResource;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class constructor with initialize parameters. Buffers are created in initialization.
+		 * @param	particleCapacity is maximum amount of particles.
+		 */
+		ParticleFeedback::ParticleFeedback(const unsigned int particleCapacity)
+		{
+			this->particleCapacity = max(1u,particleCapacity);
+			particleBuffers[0] = particleBuffers[1] = 0;
+			updateArrays[0] = updateArrays[1] = 0;
+			renderArrays[0] = renderArrays[1] = 0;
+			sourceBuffer = 0;
+			emitFirst = 0;
+			emitAmount = 0;
+			elapsedTime = 0.0f;
+			updateShader = nullptr;
+		}
+
+		/**
+		 * Class destructor, free particle buffers and vertex arrays. Update shader is owned by ParticleManager.
+		 */
+		ParticleFeedback::~ParticleFeedback()
+		{
+			glDeleteVertexArrays(2,renderArrays);
+			glDeleteVertexArrays(2,updateArrays);
+			glDeleteBuffers(2,particleBuffers);
+		}
+
+		/**
+		 * Method is used to create particle buffers and vertex arrays. Update vertex arrays feed particle state
+		 * to update shader, render vertex arrays feed position and size to emiter render shader as inPosition.
+		 * Both buffers are cleared, so all particles are dead at start.
+		 * @param	updateShader is pointer to transform feedback update shader.
+		 * @param	renderShader is pointer to emiter render shader.
+		 */
+		void ParticleFeedback::initializeFeedback(Shader* updateShader, Shader* renderShader)
+		{
+			this->updateShader = updateShader;
+			const vector<float> particleData(particleCapacity*FEEDBACK_PARTICLE_SIZE,0.0f);
+			const GLsizei stride = FEEDBACK_PARTICLE_SIZE*sizeof(float);
+			const GLint positionLoc = glGetAttribLocation(renderShader->getShaderProgram(),"inPosition");
+
+			glGenBuffers(2,particleBuffers);
+			glGenVertexArrays(2,updateArrays);
+			glGenVertexArrays(2,renderArrays);
+			for(unsigned int i = 0; i < 2; ++i)
+			{
+				glBindBuffer(GL_ARRAY_BUFFER,particleBuffers[i]);
+				glBufferData(GL_ARRAY_BUFFER,particleData.size()*sizeof(float),&particleData[0],GL_DYNAMIC_COPY);
+
+				glBindVertexArray(updateArrays[i]);
+				glVertexAttribPointer(0,4,GL_FLOAT,GL_FALSE,stride,reinterpret_cast<const GLubyte*>(0));
+				glVertexAttribPointer(1,4,GL_FLOAT,GL_FALSE,stride,reinterpret_cast<const GLubyte*>(0) + 4*sizeof(float));
+				glEnableVertexAttribArray(0);
+				glEnableVertexAttribArray(1);
+
+				glBindVertexArray(renderArrays[i]);
+				glVertexAttribPointer(positionLoc,4,GL_FLOAT,GL_FALSE,stride,reinterpret_cast<const GLubyte*>(0));
+				glEnableVertexAttribArray(positionLoc);
+			}
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Method is used to set simulation step of next update. Emitted particles are accumulated till update
+		 * is recorded.
+		 * @param	elapsedTime is difference betweenn two frame in seconds.
+		 * @param	emitAmount is amount of particles emitted in this frame.
+		 */
+		void ParticleFeedback::updateParticles(const float elapsedTime, const unsigned int emitAmount)
+		{
+			this->elapsedTime = elapsedTime;
+			this->emitAmount = min(particleCapacity,this->emitAmount + emitAmount);
+		}
+
+		/**
+		 * Method is used to record simulation step into command buffer. Update shader reads source buffer and
+		 * writes destination buffer by transform feedback with rasterization disabled, after that buffers are
+		 * swapped and emission ring is advanced.
+		 * @param	buffer is reference to command buffer.
+		 * @param	particle is reference to emiter particle template.
+		 * @param	velocitySpread is emiter velocity spread vector.
+		 * @param	sizeGrowth is change of particle size per second.
+		 */
+		void ParticleFeedback::addSimulation(RenderCommandBuffer& buffer, const Particle& particle, const Vector3D& velocitySpread, const float sizeGrowth)
+		{
+			const unsigned int destinationBuffer = 1 - sourceBuffer;
+			const float velocity[4] = {particle.velocity[0], particle.velocity[1], particle.velocity[2], 0.0f};
+			const float spread[4] = {velocitySpread[0], velocitySpread[1], velocitySpread[2], 0.0f};
+			const float acceleration[4] = {particle.acceleration[0], particle.acceleration[1], particle.acceleration[2], 0.0f};
+			const float parameters[4] = {particle.lifeTime, particle.size, sizeGrowth, CommonMath::random(0.0f,1000.0f)};
+
+			buffer.addDrawFeedback(updateShader,updateArrays[sourceBuffer],particleCapacity,particleBuffers[destinationBuffer]);
+			buffer.addUniformf("elapsedTime",elapsedTime);
+			buffer.addUniformi("emitFirst",emitFirst);
+			buffer.addUniformi("emitAmount",emitAmount);
+			buffer.addUniformi("particleCapacity",particleCapacity);
+			buffer.addUniform4fv("emitVelocity",velocity);
+			buffer.addUniform4fv("velocitySpread",spread);
+			buffer.addUniform4fv("emitAcceleration",acceleration);
+			buffer.addUniform4fv("emitParameters",parameters);
+
+			emitFirst = (emitFirst + emitAmount) % particleCapacity;
+			emitAmount = 0;
+			sourceBuffer = destinationBuffer;
+		}
+
+		/**
+		 * Accessor to vertex array of particles written by last recorded simulation step.
+		 * @return	render vertex array object id.
+		 */
+		GLuint ParticleFeedback::getRenderArray() const
+		{
+			return renderArrays[sourceBuffer];
+		}
+
+		/**
+		 * Accessor to private particle capacity member.
+		 * @return	maximum amount of particles.
+		 */
+		unsigned int ParticleFeedback::getParticleCapacity() const
+		{
+			return particleCapacity;
+		}
+	}
+}
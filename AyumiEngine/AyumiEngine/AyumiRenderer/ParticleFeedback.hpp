@@ -0,0 +1,56 @@
+/**
+ * File contains declaration of ParticleFeedback class.
+ * @file    ParticleFeedback.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-19
+ */
+
+#ifndef PARTICLEFEEDBACK_HPP
+#define PARTICLEFEEDBACK_HPP
+
+#include "Particle.hpp"
+#include "RenderCommandBuffer.hpp"
+
+#include "../AyumiResource/Shader.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int FEEDBACK_PARTICLE_SIZE = 8;
+
+		/**
+		 * Class represents GPU particle simulation by transform feedback. Particle state (position and size,
+		 * velocity and life time) is stored in two vertex buffers - each update reads one buffer and writes
+		 * the other one, so simulation never leaves GPU memory and nothing is read back. New particles are
+		 * emitted into ring of slots which follows last emitted slot, oldest particle is replaced when ring
+		 * is full. Dead particles have zero size, so render geometry shader skips them.
+		 */
+		class ParticleFeedback : private AyumiUtils::Noncopyable
+		{
+		private:
+			unsigned int particleCapacity;
+			GLuint particleBuffers[2];
+			GLuint updateArrays[2];
+			GLuint renderArrays[2];
+			unsigned int sourceBuffer;
+			unsigned int emitFirst;
+			unsigned int emitAmount;
+			float elapsedTime;
+			AyumiResource::Shader* updateShader;
+
+		public:
+			ParticleFeedback(const unsigned int particleCapacity);
+			~ParticleFeedback();
+
+			void initializeFeedback(AyumiResource::Shader* updateShader, AyumiResource::Shader* renderShader);
+			void updateParticles(const float elapsedTime, const unsigned int emitAmount);
+			void addSimulation(RenderCommandBuffer& buffer, const Particle& particle, const AyumiMath::Vector3D& velocitySpread, const float sizeGrowth);
+
+			GLuint getRenderArray() const;
+			unsigned int getParticleCapacity() const;
+		};
+	}
+}
+#endif
@@ -25,6 +25,7 @@ namespace AyumiEngine
 			this->engineResource = engineResource;
 			particleEmiterScript = new AyumiScript("null");
 			particleEmiter = nullptr;
+			feedbackShader = nullptr;
 		}
 
 		/**
@@ -36,36 +37,51 @@ namespace AyumiEngine
 
 			for(ParticleEmiters::const_iterator it = emiters.begin(); it != emiters.end(); ++it)
 			{
-				delete [] (*it)->particles;
-				delete [] (*it)->points;
+				delete (*it)->pool;
+				delete (*it)->feedback;
 				delete (*it)->particleVao;
 				glDeleteBuffers(1,&(*it)->particleVbo);
+				delete (*it);
 			}
 			emiters.clear();
+			delete feedbackShader;
 		}
 
 		/**
-		 * Method is used to initialize particle manager. Prepare particle emiters loading script
-		 * and configure OpenGL state machine for enabling creating point size in geomety shader.
+		 * Method is used to initialize particle manager. Prepare particle emiters loading script, transform
+		 * feedback update shader and configure OpenGL state machine for enabling creating point size in geomety shader.
 		 */
 		void ParticleManager::initializeParticleManager()
 		{
 			prepareParticleScript();
+			initializeFeedbackShader();
 			glEnable(GL_PROGRAM_POINT_SIZE);
 		}
 
 		/**
-		 * Method is used to update particle emiters. Call update function for each emiter.
+		 * Method is used to update particle emiters. Call update function for each emiter, emit new particles
+		 * and integrate particle pool of CPU emiters. GPU emiters record transform feedback simulation step, so
+		 * rendering only draws particles written by it.
 		 * @param	elapsedTime is difference betweenn two frame in seconds.
+		 * @param	buffer is reference to command buffer which GPU simulation steps are recorded to.
 		 */
-		void ParticleManager::updateEmiters(const float elapsedTime)
+		void ParticleManager::updateEmiters(const float elapsedTime, RenderCommandBuffer& buffer)
 		{
 			for(ParticleEmiters::const_iterator it = emiters.begin(); it != emiters.end(); ++it)
-				(*it)->updateFunction((*it),elapsedTime);
+			{
+				if((*it)->updateFunction)
+					(*it)->updateFunction((*it),elapsedTime);
+				emitParticles((*it),elapsedTime);
+				if((*it)->simulation == CPU_SIMULATION)
+					(*it)->pool->updateParticles(elapsedTime,(*it)->sizeGrowth);
+				else
+					(*it)->feedback->addSimulation(buffer,(*it)->particle,(*it)->velocitySpread,(*it)->sizeGrowth);
+			}
 		}
 
 		/**
 		 * Method is ued to add new particle emiter to scene. Create new emiter and initialize it by Lua script.
+		 * If script does not set emission rate, emiter emits whole pool during one particle life time.
 		 * @param	name is particle emiter name.
 		 * @param	path is emiter script file path.
 		 * @param	initializeFunction is emiter initialize functor object
@@ -75,6 +91,15 @@ namespace AyumiEngine
 		void ParticleManager::addParticleEmiter(const string& name, const string& path, boost::function<void (ParticleEmiter*)> initializeFunction, boost::function<void (ParticleEmiter*,float)> updateFunction, const Vector3D& origin)
 		{
 			particleEmiter = new ParticleEmiter();
+			particleEmiter->sizeGrowth = 0.0f;
+			particleEmiter->emissionRate = 0.0f;
+			particleEmiter->emissionTime = 0.0f;
+			particleEmiter->particleAmount = 0;
+			particleEmiter->simulation = CPU_SIMULATION;
+			particleEmiter->pool = nullptr;
+			particleEmiter->feedback = nullptr;
+			particleEmiter->particleVao = nullptr;
+			particleEmiter->particleVbo = 0;
 			particleEmiterScript->setScriptFile(path.c_str());
 			particleEmiterScript->executeScript();
 
@@ -82,37 +107,32 @@ namespace AyumiEngine
 			particleEmiter->origin = origin;
 			particleEmiter->updateFunction = updateFunction;
 			particleEmiter->initializeFunction = initializeFunction;
-			particleEmiter->points = new Vertex<>[particleEmiter->particleAmount];
-			for(int i = 0; i < particleEmiter->particleAmount; ++i)
+			particleEmiter->particle = storageParticle;
+			particleEmiter->particle.position = Vector3D();
+			if(particleEmiter->emissionRate <= 0.0f && storageParticle.lifeTime > 0.0f)
+				particleEmiter->emissionRate = particleEmiter->particleAmount / storageParticle.lifeTime;
+
+			if(particleEmiter->simulation == GPU_SIMULATION)
 			{
-				particleEmiter->points[i].x = 0.0f;
-				particleEmiter->points[i].y = 0.0f;
-				particleEmiter->points[i].z = 0.0f;
+				particleEmiter->feedback = new ParticleFeedback(particleEmiter->particleAmount);
+				particleEmiter->feedback->initializeFeedback(feedbackShader,particleEmiter->shader);
 			}
-
-			particleEmiter->particleVao = new VertexArrayObject();
-			glGenBuffers(1,&particleEmiter->particleVbo);
-			glBindBuffer(GL_ARRAY_BUFFER,particleEmiter->particleVbo);
-			glBufferData(GL_ARRAY_BUFFER,particleEmiter->particleAmount*12*sizeof(float),particleEmiter->points,GL_DYNAMIC_DRAW);
-			
-			GLuint positionLoc = glGetAttribLocation(particleEmiter->shader->getShaderProgram(), "inPosition");
-			glVertexAttribPointer(positionLoc,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + 0);
-			glEnableVertexAttribArray(positionLoc);
-			glBindVertexArray(0);
-
-			particleEmiter->particles = new Particle[particleEmiter->particleAmount];
-			for(int i = 0; i < particleEmiter->particleAmount; i++)
+			else
 			{
-				particleEmiter->particles[i].position = origin;
-				particleEmiter->particles[i].velocity = storageParticle.velocity;
-				particleEmiter->particles[i].rotation = storageParticle.rotation;
-				particleEmiter->particles[i].acceleration = storageParticle.acceleration;
-				particleEmiter->particles[i].color = storageParticle.color;
-				particleEmiter->particles[i].lifeTime = storageParticle.lifeTime;
-				particleEmiter->particles[i].size = storageParticle.size;
+				particleEmiter->pool = new ParticlePool(particleEmiter->particleAmount);
+				particleEmiter->particleVao = new VertexArrayObject();
+				glGenBuffers(1,&particleEmiter->particleVbo);
+				glBindBuffer(GL_ARRAY_BUFFER,particleEmiter->particleVbo);
+				glBufferData(GL_ARRAY_BUFFER,particleEmiter->particleAmount*sizeof(ParticleVertex),NULL,GL_STREAM_DRAW);
+			
+				GLuint positionLoc = glGetAttribLocation(particleEmiter->shader->getShaderProgram(), "inPosition");
+				glVertexAttribPointer(positionLoc,4,GL_FLOAT,GL_FALSE,sizeof(ParticleVertex),reinterpret_cast<const GLubyte *>(0) + 0);
+				glEnableVertexAttribArray(positionLoc);
+				glBindVertexArray(0);
 			}
 			
-			particleEmiter->initializeFunction(particleEmiter);
+			if(particleEmiter->initializeFunction)
+				particleEmiter->initializeFunction(particleEmiter);
 			emiters.push_back(particleEmiter);
 		}
 
@@ -130,10 +150,11 @@ namespace AyumiEngine
 
 			if(it != emiters.end())
 			{
-				delete [] (*it)->particles;
-				delete [] (*it)->points;
+				delete (*it)->pool;
+				delete (*it)->feedback;
 				delete (*it)->particleVao;
 				glDeleteBuffers(1,&(*it)->particleVbo);
+				delete (*it);
 				emiters.erase(it);
 			}
 		}
@@ -162,6 +183,10 @@ namespace AyumiEngine
 				.def("setColor",&ParticleManager::setColor)
 				.def("setSize",&ParticleManager::setSize)
 				.def("setLifeTime",&ParticleManager::setLifeTime)
+				.def("setVelocitySpread",&ParticleManager::setVelocitySpread)
+				.def("setSizeGrowth",&ParticleManager::setSizeGrowth)
+				.def("setEmissionRate",&ParticleManager::setEmissionRate)
+				.def("setSimulation",&ParticleManager::setSimulation)
 				.def("setParticleAmount",&ParticleManager::setParticleAmount)
 				.def("setEmiterShader",&ParticleManager::setEmiterShader)
 				.def("setEmiterTexture",&ParticleManager::setEmiterTexture)
@@ -170,6 +195,61 @@ namespace AyumiEngine
 			luabind::globals(particleEmiterScript->getVirtualMachine())["Particles"] = this;;
 		}
 
+		/**
+		 * Private method which is used to emit new particles of emiter. Particles are spawned at emiter origin
+		 * with velocity randomized by velocity spread. CPU emission stops when particle pool is full, GPU emiters
+		 * only pass amount of emitted particles to transform feedback simulation.
+		 * @param	emiter is pointer to particle emiter.
+		 * @param	elapsedTime is difference betweenn two frame in seconds.
+		 */
+		void ParticleManager::emitParticles(ParticleEmiter* emiter, const float elapsedTime)
+		{
+			const float position[3] = {0.0f, 0.0f, 0.0f};
+			float velocity[3];
+
+			emiter->emissionTime += emiter->emissionRate*elapsedTime;
+			const unsigned int emitAmount = static_cast<unsigned int>(emiter->emissionTime);
+			emiter->emissionTime -= emitAmount;
+
+			if(emiter->simulation == GPU_SIMULATION)
+			{
+				emiter->feedback->updateParticles(elapsedTime,emitAmount);
+				return;
+			}
+
+			for(unsigned int i = 0; i < emitAmount; ++i)
+			{
+				for(unsigned int j = 0; j < 3; ++j)
+					velocity[j] = emiter->particle.velocity[j] + CommonMath::random(-emiter->velocitySpread[j],emiter->velocitySpread[j]);
+
+				if(!emiter->pool->spawnParticle(position,velocity,emiter->particle.acceleration.data(),emiter->particle.lifeTime,emiter->particle.size))
+					break;
+			}
+		}
+
+		/**
+		 * Private method which is used to create transform feedback update shader of GPU emiters. Particle state
+		 * outputs are captured interleaved, so feedback buffer has the same layout as source buffer.
+		 */
+		void ParticleManager::initializeFeedbackShader()
+		{
+			const char* varyings[2] = {"feedbackPosition", "feedbackVelocity"};
+			feedbackShader = new Shader("particleFeedback");
+			feedbackShader->setVertexPath("null");
+			feedbackShader->createVertexShader();
+			glShaderSource(feedbackShader->getShaderVertex(),1,&particleFeedbackVertex,0);
+			glCompileShader(feedbackShader->getShaderVertex());
+			feedbackShader->createShaderProgram();
+			glAttachShader(feedbackShader->getShaderProgram(),feedbackShader->getShaderVertex());
+			glTransformFeedbackVaryings(feedbackShader->getShaderProgram(),2,varyings,GL_INTERLEAVED_ATTRIBS);
+			feedbackShader->linkShaderProgram();
+
+			GLint linked = GL_FALSE;
+			glGetProgramiv(feedbackShader->getShaderProgram(),GL_LINK_STATUS,&linked);
+			if(linked != GL_TRUE)
+				Logger::getInstance()->saveLog(Log<string>("Particle feedback shader loading error detected"));
+		}
+
 		/**
 		 * Private method which is used to set particle emiter partilce velocity. It can be called from Lua script.
 		 * @param	velocity is particle velocity vector.
@@ -232,6 +312,50 @@ namespace AyumiEngine
 		{
 			storageParticle.lifeTime = lifeTime;
 		}
+
+		/**
+		 * Private method which is used to set particle emiter velocity spread. Each component of emitted particle
+		 * velocity is randomized in range [-spread,spread]. It can be called from Lua script.
+		 * @param	spread is particle velocity spread vector.
+		 */
+		void ParticleManager::setVelocitySpread(const luabind::object& spread)
+		{
+			particleEmiter->velocitySpread[0] = luabind::object_cast<float>(spread[1]);
+			particleEmiter->velocitySpread[1] = luabind::object_cast<float>(spread[2]);
+			particleEmiter->velocitySpread[2] = luabind::object_cast<float>(spread[3]);
+		}
+
+		/**
+		 * Private method which is used to set particle emiter particle size growth. It can be called from Lua script.
+		 * @param	growth is change of particle size per second.
+		 */
+		void ParticleManager::setSizeGrowth(const float growth)
+		{
+			particleEmiter->sizeGrowth = growth;
+		}
+
+		/**
+		 * Private method which is used to set particle emiter emission rate. It can be called from Lua script.
+		 * @param	rate is amount of particles emitted per second.
+		 */
+		void ParticleManager::setEmissionRate(const float rate)
+		{
+			particleEmiter->emissionRate = rate;
+		}
+
+		/**
+		 * Private method which is used to set particle emiter simulation backend. It can be called from Lua script.
+		 * @param	simulation is simulation backend name - "CPU" or "GPU".
+		 */
+		void ParticleManager::setSimulation(const string& simulation)
+		{
+			if(simulation == "GPU")
+				particleEmiter->simulation = GPU_SIMULATION;
+			else if(simulation == "CPU")
+				particleEmiter->simulation = CPU_SIMULATION;
+			else
+				Logger::getInstance()->saveLog(Log<string>("Particle emiter simulation error - unknown backend: " + simulation));
+		}
 			
 		/**
 		 * Private method which is used to set particle emiter particle maximum amount. It can be called from Lua script.
@@ -9,6 +9,7 @@
 #define PARTICLEMANAGER_HPP
 
 #include "ParticleEmiter.hpp"
+#include "DefinedShader.hpp"
 #include "../AyumiScript.hpp"
 #include "../AyumiResource/ResourceManager.hpp"
 
@@ -23,7 +24,9 @@ namespace AyumiEngine
 		 * particle effects emiters. Particle systems are to create suck effects like smoke, weather effects, fire,
 		 * explosions and many other special effects based on small particles which is defined by texture.
 		 * Particle Emiters store data of points - in Geometry Shader Engine create textured quads and add size, color
-		 * and other properties.
+		 * and other properties. Particles are emitted and integrated by engine, user update function is called once
+		 * per emiter to control emiter itself. Each emiter select CPU or GPU simulation backend in its script,
+		 * GPU emiters share one transform feedback update shader and their simulation steps are recorded by update.
 		 */
 		class ParticleManager
 		{
@@ -31,16 +34,23 @@ namespace AyumiEngine
 			ParticleEmiters emiters;
 			ParticleEmiter* particleEmiter;
 			Particle storageParticle;
+			AyumiResource::Shader* feedbackShader;
 			AyumiScript* particleEmiterScript;
 			AyumiResource::ResourceManager* engineResource;
 
 			void prepareParticleScript();
+			void initializeFeedbackShader();
+			void emitParticles(ParticleEmiter* emiter, const float elapsedTime);
 			void setVelocity(const luabind::object& velocity);
 			void setAcceleration(const luabind::object& acceleration);
 			void setRotation(const luabind::object& rotation);
 			void setColor(const luabind::object& color);
 			void setSize(const float size);
 			void setLifeTime(const float lifeTime);
+			void setVelocitySpread(const luabind::object& spread);
+			void setSizeGrowth(const float growth);
+			void setEmissionRate(const float rate);
+			void setSimulation(const std::string& simulation);
 			void setParticleAmount(const int amount);
 			void setEmiterShader(const std::string& name);
 			void setEmiterTexture(const std::string& name);
@@ -50,7 +60,7 @@ namespace AyumiEngine
 			~ParticleManager();
 
 			void initializeParticleManager();
-			void updateEmiters(const float elapsedTime);
+			void updateEmiters(const float elapsedTime, RenderCommandBuffer& buffer);
 			void addParticleEmiter(const std::string& name, const std::string& path, boost::function<void (ParticleEmiter*)> initializeFunction,
 								boost::function<void (ParticleEmiter*,float)> updateFunction, const AyumiMath::Vector3D& origin);
 			void deleteParticleEmiter(const std::string& name);
@@ -0,0 +1,244 @@
+/**
+ * File contains definition of ParticlePool class.
+ * @file    ParticlePool.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-18
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <xmmintrin.h>
+#include <boost/bind.hpp>
+
+#include "ParticlePool.hpp"
+
+#include "../AyumiCore/WorkerPool.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiCore;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class constructor with initialize parameters. Capacity of streams is rounded up to SIMD width,
+		 * padding slots are never spawned.
+		 * @param	maxParticles is maximum amount of alive particles.
+		 */
+		ParticlePool::ParticlePool(const unsigned int maxParticles)
+		{
+			this->maxParticles = maxParticles;
+			capacity = max(PARTICLE_SIMD_WIDTH,(maxParticles + PARTICLE_SIMD_WIDTH - 1) / PARTICLE_SIMD_WIDTH * PARTICLE_SIMD_WIDTH);
+			usedSlots = 0;
+			aliveAmount = 0;
+
+			streams = static_cast<float*>(_mm_malloc(capacity*PARTICLE_STREAMS*sizeof(float),16));
+			memset(streams,0,capacity*PARTICLE_STREAMS*sizeof(float));
+			positionX = streams;
+			positionY = positionX + capacity;
+			positionZ = positionY + capacity;
+			velocityX = positionZ + capacity;
+			velocityY = velocityX + capacity;
+			velocityZ = velocityY + capacity;
+			accelerationX = velocityZ + capacity;
+			accelerationY = accelerationX + capacity;
+			accelerationZ = accelerationY + capacity;
+			lifeTime = accelerationZ + capacity;
+			size = lifeTime + capacity;
+
+			vertices = static_cast<ParticleVertex*>(_mm_malloc(capacity*sizeof(ParticleVertex),16));
+			memset(vertices,0,capacity*sizeof(ParticleVertex));
+			freeSlots.reserve(maxParticles);
+		}
+
+		/**
+		 * Class destructor, free particle streams and vertices.
+		 */
+		ParticlePool::~ParticlePool()
+		{
+			_mm_free(streams);
+			_mm_free(vertices);
+		}
+
+		/**
+		 * Method is used to spawn new particle. Slot of dead particle is reused if free list is not empty.
+		 * @param	position is pointer to particle position vector.
+		 * @param	velocity is pointer to particle velocity vector.
+		 * @param	acceleration is pointer to particle acceleration vector.
+		 * @param	particleLifeTime is particle life time in seconds.
+		 * @param	particleSize is particle point size.
+		 * @return	false if pool is full or life time is not positive.
+		 */
+		bool ParticlePool::spawnParticle(const float* position, const float* velocity, const float* acceleration, const float particleLifeTime, const float particleSize)
+		{
+			if(particleLifeTime <= 0.0f)
+				return false;
+
+			unsigned int slot = 0;
+			if(!freeSlots.empty())
+			{
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			}
+			else if(usedSlots < maxParticles)
+				slot = usedSlots++;
+			else
+				return false;
+
+			positionX[slot] = position[0];
+			positionY[slot] = position[1];
+			positionZ[slot] = position[2];
+			velocityX[slot] = velocity[0];
+			velocityY[slot] = velocity[1];
+			velocityZ[slot] = velocity[2];
+			accelerationX[slot] = acceleration[0];
+			accelerationY[slot] = acceleration[1];
+			accelerationZ[slot] = acceleration[2];
+			lifeTime[slot] = particleLifeTime;
+			size[slot] = particleSize;
+			aliveAmount++;
+			return true;
+		}
+
+		/**
+		 * Method is used to integrate all particles and write particle vertices. Slots are split between
+		 * WorkerPool threads when pool is large, first range is updated on calling thread. Particles killed by
+		 * workers are moved to free list after all workers finish.
+		 * @param	elapsedTime is difference betweenn two frame in seconds.
+		 * @param	sizeGrowth is change of particle size per second.
+		 */
+		void ParticlePool::updateParticles(const float elapsedTime, const float sizeGrowth)
+		{
+			const unsigned int blockAmount = (usedSlots + PARTICLE_SIMD_WIDTH - 1) / PARTICLE_SIMD_WIDTH;
+			unsigned int workers = 1;
+			if(aliveAmount >= PARTICLE_PARALLEL_AMOUNT)
+				workers = max(1u,min(MAX_PARTICLE_WORKERS,WorkerPool::getInstance()->getThreadAmount()));
+
+			if(workers == 1)
+				updateRange(0,0,blockAmount*PARTICLE_SIMD_WIDTH,elapsedTime,sizeGrowth);
+			else
+			{
+				const unsigned int blocksPerWorker = (blockAmount + workers - 1) / workers;
+				WorkerJobs jobs;
+				for(unsigned int i = 0; i < workers && i*blocksPerWorker < blockAmount; ++i)
+					jobs.push_back(boost::bind(&ParticlePool::updateRange,this,i,i*blocksPerWorker*PARTICLE_SIMD_WIDTH,min((i+1)*blocksPerWorker,blockAmount)*PARTICLE_SIMD_WIDTH,elapsedTime,sizeGrowth));
+				WorkerPool::getInstance()->runJobs(jobs);
+			}
+
+			for(unsigned int i = 0; i < workers; ++i)
+			{
+				aliveAmount -= killedSlots[i].size();
+				freeSlots.insert(freeSlots.end(),killedSlots[i].begin(),killedSlots[i].end());
+				killedSlots[i].clear();
+			}
+		}
+
+		/**
+		 * Method is used to kill all particles and reset pool.
+		 */
+		void ParticlePool::clearParticles()
+		{
+			memset(lifeTime,0,capacity*sizeof(float));
+			memset(vertices,0,capacity*sizeof(ParticleVertex));
+			freeSlots.clear();
+			usedSlots = 0;
+			aliveAmount = 0;
+		}
+
+		/**
+		 * Accessor to particle vertices written by last update.
+		 * @return	pointer to particle vertices.
+		 */
+		const ParticleVertex* ParticlePool::getVertices() const
+		{
+			return vertices;
+		}
+
+		/**
+		 * Method is used to get amount of vertices which must be drawn. It is amount of slots used since pool
+		 * creation, dead slots have zero size.
+		 * @return	amount of particle vertices.
+		 */
+		unsigned int ParticlePool::getVertexAmount() const
+		{
+			return usedSlots;
+		}
+
+		/**
+		 * Accessor to amount of alive particles.
+		 * @return	amount of alive particles.
+		 */
+		unsigned int ParticlePool::getAliveAmount() const
+		{
+			return aliveAmount;
+		}
+
+		/**
+		 * Accessor to private maximum particles amount member.
+		 * @return	maximum amount of particles.
+		 */
+		unsigned int ParticlePool::getMaxParticles() const
+		{
+			return maxParticles;
+		}
+
+		/**
+		 * Private method which is used to integrate range of particles with SSE. Velocity, position, life time
+		 * and size of four particles are updated at once, dead particles are masked out. Particles which die in
+		 * this update are stored in worker kill list and their vertices get zero size.
+		 * @param	worker is worker thread id.
+		 * @param	first is first updated slot, multiple of SIMD width.
+		 * @param	last is slot after last updated slot, multiple of SIMD width.
+		 * @param	elapsedTime is difference betweenn two frame in seconds.
+		 * @param	sizeGrowth is change of particle size per second.
+		 */
+		void ParticlePool::updateRange(const unsigned int worker, const unsigned int first, const unsigned int last, const float elapsedTime, const float sizeGrowth)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 time = _mm_set1_ps(elapsedTime);
+			const __m128 growth = _mm_set1_ps(sizeGrowth);
+			vector<unsigned int>& killed = killedSlots[worker];
+
+			for(unsigned int i = first; i < last; i += PARTICLE_SIMD_WIDTH)
+			{
+				const __m128 life = _mm_load_ps(lifeTime + i);
+				const __m128 alive = _mm_cmpgt_ps(life,zero);
+				const __m128 step = _mm_and_ps(alive,time);
+
+				const __m128 vx = _mm_add_ps(_mm_load_ps(velocityX + i),_mm_mul_ps(_mm_load_ps(accelerationX + i),step));
+				const __m128 vy = _mm_add_ps(_mm_load_ps(velocityY + i),_mm_mul_ps(_mm_load_ps(accelerationY + i),step));
+				const __m128 vz = _mm_add_ps(_mm_load_ps(velocityZ + i),_mm_mul_ps(_mm_load_ps(accelerationZ + i),step));
+				_mm_store_ps(velocityX + i,vx);
+				_mm_store_ps(velocityY + i,vy);
+				_mm_store_ps(velocityZ + i,vz);
+
+				__m128 px = _mm_add_ps(_mm_load_ps(positionX + i),_mm_mul_ps(vx,step));
+				__m128 py = _mm_add_ps(_mm_load_ps(positionY + i),_mm_mul_ps(vy,step));
+				__m128 pz = _mm_add_ps(_mm_load_ps(positionZ + i),_mm_mul_ps(vz,step));
+				_mm_store_ps(positionX + i,px);
+				_mm_store_ps(positionY + i,py);
+				_mm_store_ps(positionZ + i,pz);
+
+				const __m128 newLife = _mm_sub_ps(life,step);
+				_mm_store_ps(lifeTime + i,newLife);
+				__m128 particleSize = _mm_max_ps(_mm_add_ps(_mm_load_ps(size + i),_mm_mul_ps(growth,step)),zero);
+				_mm_store_ps(size + i,particleSize);
+
+				const __m128 living = _mm_cmpgt_ps(newLife,zero);
+				int died = _mm_movemask_ps(_mm_andnot_ps(living,alive));
+				for(unsigned int j = 0; died != 0; ++j, died >>= 1)
+					if(died & 1)
+						killed.push_back(i + j);
+
+				particleSize = _mm_and_ps(living,particleSize);
+				_MM_TRANSPOSE4_PS(px,py,pz,particleSize);
+				float* vertex = reinterpret_cast<float*>(vertices + i);
+				_mm_store_ps(vertex,px);
+				_mm_store_ps(vertex + 4,py);
+				_mm_store_ps(vertex + 8,pz);
+				_mm_store_ps(vertex + 12,particleSize);
+			}
+		}
+	}
+}
@@ -0,0 +1,80 @@
+/**
+ * File contains declaration of ParticlePool class.
+ * @file    ParticlePool.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-18
+ */
+
+#ifndef PARTICLEPOOL_HPP
+#define PARTICLEPOOL_HPP
+
+#include <vector>
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int PARTICLE_SIMD_WIDTH = 4;
+		const unsigned int PARTICLE_STREAMS = 11;
+		const unsigned int PARTICLE_PARALLEL_AMOUNT = 16384;
+		const unsigned int MAX_PARTICLE_WORKERS = 4;
+
+		/**
+		 * Structure represents particle streaming vertex. Size of dead particle is zero, so geometry shader
+		 * does not emit its quad.
+		 */
+		struct ParticleVertex
+		{
+			float position[3];
+			float size;
+		};
+
+		/**
+		 * Class represents pool of particles stored as structure of arrays. Each particle property is separate
+		 * 16 byte aligned stream, so four particles are integrated by one SSE instruction. Dead particles keep
+		 * their slots - indices are stored in free list and reused by next spawned particles, pool is never
+		 * compacted. Update writes tightly packed particle vertices, large pools are updated by WorkerPool threads.
+		 */
+		class ParticlePool : private AyumiUtils::Noncopyable
+		{
+		private:
+			unsigned int maxParticles;
+			unsigned int capacity;
+			unsigned int usedSlots;
+			unsigned int aliveAmount;
+			float* streams;
+			float* positionX;
+			float* positionY;
+			float* positionZ;
+			float* velocityX;
+			float* velocityY;
+			float* velocityZ;
+			float* accelerationX;
+			float* accelerationY;
+			float* accelerationZ;
+			float* lifeTime;
+			float* size;
+			ParticleVertex* vertices;
+			std::vector<unsigned int> freeSlots;
+			std::vector<unsigned int> killedSlots[MAX_PARTICLE_WORKERS];
+
+			void updateRange(const unsigned int worker, const unsigned int first, const unsigned int last, const float elapsedTime, const float sizeGrowth);
+
+		public:
+			ParticlePool(const unsigned int maxParticles);
+			~ParticlePool();
+
+			bool spawnParticle(const float* position, const float* velocity, const float* acceleration, const float particleLifeTime, const float particleSize);
+			void updateParticles(const float elapsedTime, const float sizeGrowth);
+			void clearParticles();
+
+			const ParticleVertex* getVertices() const;
+			unsigned int getVertexAmount() const;
+			unsigned int getAliveAmount() const;
+			unsigned int getMaxParticles() const;
+		};
+	}
+}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * File contains declaration of RenderBackend interface class.
+ * @file    RenderBackend.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#ifndef RENDERBACKEND_HPP
+#define RENDERBACKEND_HPP
+
+#include "RenderCommandBuffer.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class represents abstract render backend interface. Backend execute commands recorded by Renderer
+		 * tasks in RenderCommandBuffer. Engine use OpenGL backend, null backend is used to measure CPU side
+		 * cost of rendering without GPU.
+		 */
+		class RenderBackend
+		{
+		public:
+			virtual ~RenderBackend() {};
+			virtual void executeCommands(const RenderCommandBuffer& buffer) = 0;
+		};
+	}
+}
+#endif
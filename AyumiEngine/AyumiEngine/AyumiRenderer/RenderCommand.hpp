@@ -0,0 +1,143 @@
+/**
+ * File contains declaration of RenderCommand structure.
+ * @file    RenderCommand.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#ifndef RENDERCOMMAND_HPP
+#define RENDERCOMMAND_HPP
+
+#include <GL/glew.h>
+
+#include "../AyumiResource/Shader.hpp"
+#include "../AyumiScene/EntityMaterial.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Enumeration represents all kind of render commands which can be recorded into command buffer.
+		 */
+		enum RenderCommandType
+		{
+			DRAW_ELEMENTS,
+			DRAW_ARRAYS,
+			DRAW_ELEMENTS_INSTANCED,
+			DRAW_FEEDBACK,
+			BIND_FRAMEBUFFER,
+			SET_VIEWPORT,
+			CLEAR_BUFFERS,
+			SET_COLOR_MASK,
+			SET_CULL_FACE,
+			SET_BLEND_FUNC,
+			SET_DEPTH_STATE,
+			MAX_COMMAND_TYPES
+		};
+
+		/**
+		 * Enumeration represents draw command flags. They define which data is send to shader by backend.
+		 */
+		enum RenderCommandFlags
+		{
+			SEND_LIGHTS = 1,
+			SEND_MATERIAL = 2,
+			SEND_OBJECT_DATA = 4,
+			SEND_SKIN_DATA = 8
+		};
+
+		/**
+		 * Enumeration represents type of uniform value stored in command buffer.
+		 */
+		enum UniformValueType
+		{
+			UNIFORM_INTEGER,
+			UNIFORM_FLOAT,
+			UNIFORM_VECTOR4,
+			UNIFORM_MATRIX3,
+			UNIFORM_MATRIX4,
+			UNIFORM_TEXTURE
+		};
+
+		/**
+		 * Structure represents one shader uniform value recorded with draw command. Uniform is addressed
+		 * by pre-hashed name handle.
+		 */
+		struct UniformValue
+		{
+			AyumiResource::UniformHandle handle;
+			UniformValueType type;
+			int integer;
+			float data[16];
+		};
+
+		/**
+		 * Structure represents texture unit binding used by draw command. Bindings are stored in command
+		 * buffer, command keeps only range of them, so commands stay small.
+		 */
+		struct TextureBinding
+		{
+			GLenum target;
+			GLuint texture;
+		};
+
+		/**
+		 * Structure represents buffer data upload recorded in command buffer. Upload is executed in command
+		 * order, before command with commandFirst index, data is stored in command buffer. If orphan size
+		 * is set, buffer storage is orphaned before upload.
+		 */
+		struct BufferUpload
+		{
+			GLenum target;
+			GLuint buffer;
+			GLintptr offset;
+			GLsizeiptr size;
+			GLsizeiptr orphanSize;
+			unsigned int dataFirst;
+			unsigned int commandFirst;
+		};
+
+		const unsigned int MAX_COMMAND_TEXTURES = 16;
+
+		/**
+		 * Structure represents compact draw packet. Packet store only plain data: shader, vertex array,
+		 * ranges of textures and uniforms in command buffer so it can be recorded first and executed
+		 * later by render backend. State commands use parameters array (viewport, masks, blend function).
+		 * Draw commands with per-object uniform block use buffer range (buffer, offset, size), skinned entities
+		 * use skin range of skin matrices uniform block. Instanced draw
+		 * commands read instance transforms from instance buffer at instance offset. Indexed draw commands of
+		 * geometry heap meshes use index offset and base vertex. Transform feedback draw commands capture
+		 * vertex shader outputs into buffer.
+		 */
+		struct RenderCommand
+		{
+			RenderCommandType type;
+			unsigned int flags;
+			AyumiResource::Shader* shader;
+			AyumiScene::EntityMaterial* material;
+			float materialTime;
+			GLuint vertexArray;
+			GLenum primitive;
+			GLint first;
+			GLsizei count;
+			GLintptr indexOffset;
+			GLint baseVertex;
+			GLsizei instanceAmount;
+			GLuint instanceBuffer;
+			GLintptr instanceOffset;
+			GLuint buffer;
+			GLintptr bufferOffset;
+			GLsizeiptr bufferSize;
+			GLuint skinBuffer;
+			GLintptr skinOffset;
+			GLsizeiptr skinSize;
+			int parameters[4];
+			unsigned int textureFirst;
+			unsigned int textureAmount;
+			unsigned int uniformFirst;
+			unsigned int uniformAmount;
+		};
+	}
+}
+#endif
@@ -0,0 +1,564 @@
+/**
+ * File contains definition of RenderCommandBuffer class.
+ * @file    RenderCommandBuffer.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#include <cstring>
+
+#include "RenderCommandBuffer.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiMath;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor.
+		 */
+		RenderCommandBuffer::RenderCommandBuffer()
+		{
+
+		}
+
+		/**
+		 * Class destructor, free allocated memory. Nothing to delete.
+		 */
+		RenderCommandBuffer::~RenderCommandBuffer()
+		{
+			commands.clear();
+			uniforms.clear();
+			textures.clear();
+			uploads.clear();
+			uploadData.clear();
+		}
+
+		/**
+		 * Method is used to reserve memory for commands, so recording do not reallocate buffers in frame.
+		 * Texture bindings are reserved for one binding per command.
+		 * @param	commandAmount is amount of commands to reserve.
+		 * @param	uniformAmount is amount of uniform values to reserve.
+		 */
+		void RenderCommandBuffer::reserveCommands(const unsigned int commandAmount, const unsigned int uniformAmount)
+		{
+			commands.reserve(commandAmount);
+			uniforms.reserve(uniformAmount);
+			textures.reserve(commandAmount);
+		}
+
+		/**
+		 * Method is used to clear recorded commands. Reserved memory is not released.
+		 */
+		void RenderCommandBuffer::clearCommands()
+		{
+			commands.clear();
+			uniforms.clear();
+			textures.clear();
+			uploads.clear();
+			uploadData.clear();
+		}
+
+		/**
+		 * Method is used to add new empty command of given type.
+		 * @param	type is type of new command.
+		 * @return	reference to recorded command.
+		 */
+		RenderCommand& RenderCommandBuffer::addCommand(const RenderCommandType type)
+		{
+			RenderCommand command;
+			memset(&command,0,sizeof(RenderCommand));
+			command.type = type;
+			command.uniformFirst = uniforms.size();
+			command.textureFirst = textures.size();
+			commands.push_back(command);
+			return commands.back();
+		}
+
+		/**
+		 * Method is used to add indexed draw command.
+		 * @param	shader is pointer to draw shader.
+		 * @param	vertexArray is id of vertex array object.
+		 * @param	count is amount of indices to draw.
+		 * @param	primitive is type of drawn primitive.
+		 * @return	reference to recorded command.
+		 */
+		RenderCommand& RenderCommandBuffer::addDrawElements(Shader* shader, const GLuint vertexArray, const GLsizei count, const GLenum primitive)
+		{
+			RenderCommand& command = addCommand(DRAW_ELEMENTS);
+			command.shader = shader;
+			command.vertexArray = vertexArray;
+			command.count = count;
+			command.primitive = primitive;
+			return command;
+		}
+
+		/**
+		 * Method is used to add instanced indexed draw command.
+		 * @param	shader is pointer to draw shader.
+		 * @param	vertexArray is id of vertex array object.
+		 * @param	count is amount of indices to draw.
+		 * @param	instanceAmount is amount of instances.
+		 * @param	instanceBuffer is id of buffer with instance transforms.
+		 * @param	instanceOffset is offset of first instance transform in buffer.
+		 * @return	reference to recorded command.
+		 */
+		RenderCommand& RenderCommandBuffer::addDrawElementsInstanced(Shader* shader, const GLuint vertexArray, const GLsizei count, const GLsizei instanceAmount, const GLuint instanceBuffer, const GLintptr instanceOffset)
+		{
+			RenderCommand& command = addCommand(DRAW_ELEMENTS_INSTANCED);
+			command.shader = shader;
+			command.vertexArray = vertexArray;
+			command.count = count;
+			command.primitive = GL_TRIANGLES;
+			command.instanceAmount = instanceAmount;
+			command.instanceBuffer = instanceBuffer;
+			command.instanceOffset = instanceOffset;
+			return command;
+		}
+
+		/**
+		 * Method is used to add non-indexed draw command.
+		 * @param	shader is pointer to draw shader.
+		 * @param	vertexArray is id of vertex array object.
+		 * @param	first is first vertex to draw.
+		 * @param	count is amount of vertices to draw.
+		 * @param	primitive is type of drawn primitive.
+		 * @return	reference to recorded command.
+		 */
+		RenderCommand& RenderCommandBuffer::addDrawArrays(Shader* shader, const GLuint vertexArray, const GLint first, const GLsizei count, const GLenum primitive)
+		{
+			RenderCommand& command = addCommand(DRAW_ARRAYS);
+			command.shader = shader;
+			command.vertexArray = vertexArray;
+			command.first = first;
+			command.count = count;
+			command.primitive = primitive;
+			return command;
+		}
+
+		/**
+		 * Method is used to add transform feedback draw command. Points are drawn with rasterization disabled
+		 * and vertex shader outputs are written into feedback buffer.
+		 * @param	shader is pointer to shader with transform feedback varyings.
+		 * @param	vertexArray is id of vertex array object.
+		 * @param	count is amount of vertices to draw.
+		 * @param	feedbackBuffer is id of buffer which capture shader outputs.
+		 * @return	reference to recorded command.
+		 */
+		RenderCommand& RenderCommandBuffer::addDrawFeedback(Shader* shader, const GLuint vertexArray, const GLsizei count, const GLuint feedbackBuffer)
+		{
+			RenderCommand& command = addCommand(DRAW_FEEDBACK);
+			command.shader = shader;
+			command.vertexArray = vertexArray;
+			command.first = 0;
+			command.count = count;
+			command.primitive = GL_POINTS;
+			command.buffer = feedbackBuffer;
+			return command;
+		}
+
+		/**
+		 * Method is used to add frame buffer binding command.
+		 * @param	frameBuffer is id of frame buffer object, 0 is default frame buffer.
+		 */
+		void RenderCommandBuffer::addBindFrameBuffer(const GLuint frameBuffer)
+		{
+			addCommand(BIND_FRAMEBUFFER).buffer = frameBuffer;
+		}
+
+		/**
+		 * Method is used to add viewport command.
+		 * @param	x is viewport left corner position.
+		 * @param	y is viewport bottom corner position.
+		 * @param	width is viewport width.
+		 * @param	height is viewport height.
+		 */
+		void RenderCommandBuffer::addViewport(const int x, const int y, const int width, const int height)
+		{
+			RenderCommand& command = addCommand(SET_VIEWPORT);
+			command.parameters[0] = x;
+			command.parameters[1] = y;
+			command.parameters[2] = width;
+			command.parameters[3] = height;
+		}
+
+		/**
+		 * Method is used to add clear buffers command.
+		 * @param	mask is bitwise mask of cleared buffers.
+		 */
+		void RenderCommandBuffer::addClear(const GLbitfield mask)
+		{
+			addCommand(CLEAR_BUFFERS).parameters[0] = mask;
+		}
+
+		/**
+		 * Method is used to add color mask command.
+		 * @param	red is red channel write flag.
+		 * @param	green is green channel write flag.
+		 * @param	blue is blue channel write flag.
+		 * @param	alpha is alpha channel write flag.
+		 */
+		void RenderCommandBuffer::addColorMask(const bool red, const bool green, const bool blue, const bool alpha)
+		{
+			RenderCommand& command = addCommand(SET_COLOR_MASK);
+			command.parameters[0] = red;
+			command.parameters[1] = green;
+			command.parameters[2] = blue;
+			command.parameters[3] = alpha;
+		}
+
+		/**
+		 * Method is used to add face culling command.
+		 * @param	face is culled face.
+		 * @param	enable is face culling enable flag.
+		 */
+		void RenderCommandBuffer::addCullFace(const GLenum face, const bool enable)
+		{
+			RenderCommand& command = addCommand(SET_CULL_FACE);
+			command.parameters[0] = face;
+			command.parameters[1] = enable;
+		}
+
+		/**
+		 * Method is used to add blend function command.
+		 * @param	source is source blend factor.
+		 * @param	destination is destination blend factor.
+		 */
+		void RenderCommandBuffer::addBlendFunc(const GLenum source, const GLenum destination)
+		{
+			RenderCommand& command = addCommand(SET_BLEND_FUNC);
+			command.parameters[0] = source;
+			command.parameters[1] = destination;
+		}
+
+		/**
+		 * Method is used to add depth test function and depth write mask command.
+		 * @param	function is depth test function.
+		 * @param	write is depth write flag.
+		 */
+		void RenderCommandBuffer::addDepthState(const GLenum function, const bool write)
+		{
+			RenderCommand& command = addCommand(SET_DEPTH_STATE);
+			command.parameters[0] = function;
+			command.parameters[1] = write;
+		}
+
+		/**
+		 * Method is used to add buffer data upload, which is executed before next recorded command.
+		 * @param	target is buffer target.
+		 * @param	buffer is buffer object id.
+		 * @param	offset is offset in buffer object.
+		 * @param	size is size of data in bytes.
+		 * @param	data is pointer to source data.
+		 */
+		void RenderCommandBuffer::addBufferUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data)
+		{
+			addUpload(target,buffer,offset,size,data,commands.size());
+		}
+
+		/**
+		 * Method is used to add buffer data upload read by last recorded command, like its per-object uniform
+		 * block range. Upload is executed before last recorded command.
+		 * @param	target is buffer target.
+		 * @param	buffer is buffer object id.
+		 * @param	offset is offset in buffer object.
+		 * @param	size is size of data in bytes.
+		 * @param	data is pointer to source data.
+		 */
+		void RenderCommandBuffer::addCommandUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data)
+		{
+			addUpload(target,buffer,offset,size,data,commands.empty() ? 0 : commands.size() - 1);
+		}
+
+		/**
+		 * Method is used to add stream buffer upload. Buffer storage is orphaned and data is written at the
+		 * beginning of new storage, so upload never waits for draws of previous frame.
+		 * @param	target is buffer target.
+		 * @param	buffer is buffer object id.
+		 * @param	bufferSize is size of orphaned buffer storage in bytes.
+		 * @param	size is size of data in bytes.
+		 * @param	data is pointer to source data.
+		 */
+		void RenderCommandBuffer::addStreamUpload(const GLenum target, const GLuint buffer, const GLsizeiptr bufferSize, const GLsizeiptr size, const GLvoid* data)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			BufferUpload upload;
+			upload.target = target;
+			upload.buffer = buffer;
+			upload.offset = 0;
+			upload.size = size;
+			upload.orphanSize = bufferSize;
+			upload.dataFirst = uploadData.size();
+			upload.commandFirst = commands.size();
+			uploadData.insert(uploadData.end(),bytes,bytes+size);
+			uploads.push_back(upload);
+		}
+
+		/**
+		 * Method is used to set per-object uniform buffer range of last recorded draw command.
+		 * @param	buffer is uniform buffer object id.
+		 * @param	offset is offset of object data in buffer.
+		 * @param	size is size of object data.
+		 */
+		void RenderCommandBuffer::addBufferRange(const GLuint buffer, const GLintptr offset, const GLsizeiptr size)
+		{
+			RenderCommand& command = commands.back();
+			command.flags |= SEND_OBJECT_DATA;
+			command.buffer = buffer;
+			command.bufferOffset = offset;
+			command.bufferSize = size;
+		}
+
+		/**
+		 * Method is used to set skin matrices uniform buffer range of last recorded draw command.
+		 * @param	buffer is uniform buffer object id.
+		 * @param	offset is offset of skin data in buffer.
+		 * @param	size is size of skin data.
+		 */
+		void RenderCommandBuffer::addSkinRange(const GLuint buffer, const GLintptr offset, const GLsizeiptr size)
+		{
+			RenderCommand& command = commands.back();
+			command.flags |= SEND_SKIN_DATA;
+			command.skinBuffer = buffer;
+			command.skinOffset = offset;
+			command.skinSize = size;
+		}
+
+		/**
+		 * Method is used to set index range of last recorded indexed draw command.
+		 * @param	indexOffset is byte offset of first index in bound index buffer.
+		 * @param	baseVertex is value added to each index.
+		 */
+		void RenderCommandBuffer::addIndexRange(const GLintptr indexOffset, const GLint baseVertex)
+		{
+			RenderCommand& command = commands.back();
+			command.indexOffset = indexOffset;
+			command.baseVertex = baseVertex;
+		}
+
+		/**
+		 * Method is used to add texture binding to last recorded command. Textures are bound to next units,
+		 * up to MAX_COMMAND_TEXTURES units.
+		 * @param	target is texture target.
+		 * @param	texture is texture id.
+		 */
+		void RenderCommandBuffer::addTexture(const GLenum target, const GLuint texture)
+		{
+			RenderCommand& command = commands.back();
+			if(command.textureAmount < MAX_COMMAND_TEXTURES)
+			{
+				TextureBinding binding = {target,texture};
+				textures.push_back(binding);
+				command.textureAmount++;
+			}
+		}
+
+		/**
+		 * Method is used to add integer uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	value is uniform value.
+		 */
+		void RenderCommandBuffer::addUniformi(const char* name, const int value)
+		{
+			addUniform(Shader::getUniformHandle(name),UNIFORM_INTEGER).integer = value;
+		}
+
+		/**
+		 * Method is used to add float uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	value is uniform value.
+		 */
+		void RenderCommandBuffer::addUniformf(const char* name, const float value)
+		{
+			addUniform(Shader::getUniformHandle(name),UNIFORM_FLOAT).data[0] = value;
+		}
+
+		/**
+		 * Method is used to add vec4 uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	valueArray is pointer to four floats.
+		 */
+		void RenderCommandBuffer::addUniform4fv(const char* name, const float* valueArray)
+		{
+			memcpy(addUniform(Shader::getUniformHandle(name),UNIFORM_VECTOR4).data,valueArray,4*sizeof(float));
+		}
+
+		/**
+		 * Method is used to add texture sampler uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	unit is texture unit.
+		 */
+		void RenderCommandBuffer::addUniformTexture(const char* name, const int unit)
+		{
+			addUniform(Shader::getUniformHandle(name),UNIFORM_TEXTURE).integer = unit;
+		}
+
+		/**
+		 * Method is used to add mat3 uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	valueArray is pointer to matrix data.
+		 */
+		void RenderCommandBuffer::addUniformMatrix3fv(const char* name, const float* valueArray)
+		{
+			memcpy(addUniform(Shader::getUniformHandle(name),UNIFORM_MATRIX3).data,valueArray,9*sizeof(float));
+		}
+
+		/**
+		 * Method is used to add mat4 uniform to last recorded command.
+		 * @param	name is uniform name.
+		 * @param	valueArray is pointer to matrix data.
+		 */
+		void RenderCommandBuffer::addUniformMatrix4fv(const char* name, const float* valueArray)
+		{
+			memcpy(addUniform(Shader::getUniformHandle(name),UNIFORM_MATRIX4).data,valueArray,16*sizeof(float));
+		}
+
+		/**
+		 * Method is used to add transformation matrices to last recorded command. It is recording
+		 * equivalent of TransformationMatrices::sendMatricesData.
+		 * @param	matrices is reference to transformation matrices package.
+		 */
+		void RenderCommandBuffer::addMatrices(const TransformationMatrices& matrices)
+		{
+			memcpy(addUniform(matrices.modelHandle,UNIFORM_MATRIX4).data,transpose(matrices.modelMatrix).data(),16*sizeof(float));
+			memcpy(addUniform(matrices.viewHandle,UNIFORM_MATRIX4).data,transpose(matrices.viewMatrix).data(),16*sizeof(float));
+			memcpy(addUniform(matrices.modelViewHandle,UNIFORM_MATRIX4).data,transpose(matrices.modelViewMatrix).data(),16*sizeof(float));
+			memcpy(addUniform(matrices.projectionHandle,UNIFORM_MATRIX4).data,matrices.projectionMatrix.data(),16*sizeof(float));
+			memcpy(addUniform(matrices.inverseViewHandle,UNIFORM_MATRIX4).data,matrices.inverseViewMatrix.data(),16*sizeof(float));
+			memcpy(addUniform(matrices.normalHandle,UNIFORM_MATRIX3).data,matrices.normalMatrix.data(),9*sizeof(float));
+		}
+
+		/**
+		 * Accessor to private commands collection member.
+		 * @return	pointer to recorded commands.
+		 */
+		const RenderCommands* RenderCommandBuffer::getCommands() const
+		{
+			return &commands;
+		}
+
+		/**
+		 * Accessor to private uniform values collection member.
+		 * @return	pointer to recorded uniform values.
+		 */
+		const UniformValues* RenderCommandBuffer::getUniforms() const
+		{
+			return &uniforms;
+		}
+
+		/**
+		 * Accessor to private texture bindings collection member.
+		 * @return	pointer to recorded texture bindings.
+		 */
+		const TextureBindings* RenderCommandBuffer::getTextures() const
+		{
+			return &textures;
+		}
+
+		/**
+		 * Accessor to private buffer uploads collection member.
+		 * @return	pointer to recorded buffer uploads.
+		 */
+		const BufferUploads* RenderCommandBuffer::getUploads() const
+		{
+			return &uploads;
+		}
+
+		/**
+		 * Method is used to get data of recorded buffer upload.
+		 * @param	upload is reference to recorded upload.
+		 * @return	pointer to upload data.
+		 */
+		const unsigned char* RenderCommandBuffer::getUploadData(const BufferUpload& upload) const
+		{
+			return &uploadData[upload.dataFirst];
+		}
+
+		/**
+		 * Accessor to last recorded command.
+		 * @return	reference to last command.
+		 */
+		RenderCommand& RenderCommandBuffer::getLastCommand()
+		{
+			return commands.back();
+		}
+
+		/**
+		 * Accessor to amount of recorded commands.
+		 * @return	amount of recorded commands.
+		 */
+		unsigned int RenderCommandBuffer::getCommandAmount() const
+		{
+			return commands.size();
+		}
+
+		/**
+		 * Private method which is used to add new uniform value to last recorded command.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	type is uniform value type.
+		 * @return	reference to new uniform value.
+		 */
+		UniformValue& RenderCommandBuffer::addUniform(const UniformHandle handle, const UniformValueType type)
+		{
+			UniformValue value;
+			value.handle = handle;
+			value.type = type;
+			value.integer = 0;
+			uniforms.push_back(value);
+			commands.back().uniformAmount++;
+			return uniforms.back();
+		}
+
+		/**
+		 * Private method which is used to add buffer data upload executed before command with given index. Data
+		 * is copied into command buffer. Upload which replace pending upload of the same range, executed before
+		 * the same command, overwrite it. Upload which continue last upload range is merged with it, so many
+		 * small uploads of ring buffer ranges (e.g. per-object uniform blocks) are executed as one - continued
+		 * range is not read by commands recorded before it.
+		 * @param	target is buffer target.
+		 * @param	buffer is buffer object id.
+		 * @param	offset is offset in buffer object.
+		 * @param	size is size of data in bytes.
+		 * @param	data is pointer to source data.
+		 * @param	commandFirst is index of command executed after upload.
+		 */
+		void RenderCommandBuffer::addUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data, const unsigned int commandFirst)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for(BufferUploads::reverse_iterator it = uploads.rbegin(); it != uploads.rend() && (*it).commandFirst >= commandFirst; ++it)
+			{
+				if((*it).commandFirst == commandFirst && (*it).buffer == buffer && (*it).offset == offset && (*it).size == size && (*it).orphanSize == 0)
+				{
+					copy(bytes,bytes+size,uploadData.begin()+(*it).dataFirst);
+					return;
+				}
+			}
+
+			if(!uploads.empty() && uploads.back().commandFirst <= commandFirst && uploads.back().buffer == buffer && uploads.back().orphanSize == 0
+				&& uploads.back().offset + uploads.back().size == offset && uploads.back().dataFirst + uploads.back().size == uploadData.size())
+			{
+				uploadData.insert(uploadData.end(),bytes,bytes+size);
+				uploads.back().size += size;
+				return;
+			}
+
+			BufferUpload upload;
+			upload.target = target;
+			upload.buffer = buffer;
+			upload.offset = offset;
+			upload.size = size;
+			upload.orphanSize = 0;
+			upload.dataFirst = uploadData.size();
+			upload.commandFirst = commandFirst;
+			uploadData.insert(uploadData.end(),bytes,bytes+size);
+
+			BufferUploads::iterator position = uploads.end();
+			while(position != uploads.begin() && (*(position - 1)).commandFirst > commandFirst)
+				--position;
+			uploads.insert(position,upload);
+		}
+	}
+}
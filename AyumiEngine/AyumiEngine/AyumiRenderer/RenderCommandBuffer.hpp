@@ -0,0 +1,90 @@
+/**
+ * File contains declaration of RenderCommandBuffer class.
+ * @file    RenderCommandBuffer.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-04
+ */
+
+#ifndef RENDERCOMMANDBUFFER_HPP
+#define RENDERCOMMANDBUFFER_HPP
+
+#include <vector>
+
+#include "RenderCommand.hpp"
+#include "TransformationMatrices.hpp"
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		typedef std::vector<RenderCommand> RenderCommands;
+		typedef std::vector<UniformValue> UniformValues;
+		typedef std::vector<TextureBinding> TextureBindings;
+		typedef std::vector<BufferUpload> BufferUploads;
+
+		/**
+		 * Class represents linear buffer of render commands. Renderer tasks record draw packets into buffer
+		 * and RenderBackend execute them. Commands are recorded on render thread, buffer is not thread-safe.
+		 * Uniform values and texture bindings are always added to last recorded command. Buffer uploads are stored separately with
+		 * index of following command, so they are executed in recording order between commands.
+		 */
+		class RenderCommandBuffer : private AyumiUtils::Noncopyable
+		{
+		private:
+			RenderCommands commands;
+			UniformValues uniforms;
+			TextureBindings textures;
+			BufferUploads uploads;
+			std::vector<unsigned char> uploadData;
+
+			UniformValue& addUniform(const AyumiResource::UniformHandle handle, const UniformValueType type);
+			void addUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data, const unsigned int commandFirst);
+
+		public:
+			RenderCommandBuffer();
+			~RenderCommandBuffer();
+
+			void reserveCommands(const unsigned int commandAmount, const unsigned int uniformAmount);
+			void clearCommands();
+
+			RenderCommand& addCommand(const RenderCommandType type);
+			RenderCommand& addDrawElements(AyumiResource::Shader* shader, const GLuint vertexArray, const GLsizei count, const GLenum primitive = GL_TRIANGLES);
+			RenderCommand& addDrawElementsInstanced(AyumiResource::Shader* shader, const GLuint vertexArray, const GLsizei count, const GLsizei instanceAmount, const GLuint instanceBuffer, const GLintptr instanceOffset);
+			RenderCommand& addDrawArrays(AyumiResource::Shader* shader, const GLuint vertexArray, const GLint first, const GLsizei count, const GLenum primitive);
+			RenderCommand& addDrawFeedback(AyumiResource::Shader* shader, const GLuint vertexArray, const GLsizei count, const GLuint feedbackBuffer);
+			void addBindFrameBuffer(const GLuint frameBuffer);
+			void addViewport(const int x, const int y, const int width, const int height);
+			void addClear(const GLbitfield mask);
+			void addColorMask(const bool red, const bool green, const bool blue, const bool alpha);
+			void addCullFace(const GLenum face, const bool enable);
+			void addBlendFunc(const GLenum source, const GLenum destination);
+			void addDepthState(const GLenum function, const bool write);
+
+			void addBufferUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data);
+			void addCommandUpload(const GLenum target, const GLuint buffer, const GLintptr offset, const GLsizeiptr size, const GLvoid* data);
+			void addStreamUpload(const GLenum target, const GLuint buffer, const GLsizeiptr bufferSize, const GLsizeiptr size, const GLvoid* data);
+			void addBufferRange(const GLuint buffer, const GLintptr offset, const GLsizeiptr size);
+			void addSkinRange(const GLuint buffer, const GLintptr offset, const GLsizeiptr size);
+			void addIndexRange(const GLintptr indexOffset, const GLint baseVertex);
+			void addTexture(const GLenum target, const GLuint texture);
+			void addUniformi(const char* name, const int value);
+			void addUniformf(const char* name, const float value);
+			void addUniform4fv(const char* name, const float* valueArray);
+			void addUniformTexture(const char* name, const int unit);
+			void addUniformMatrix3fv(const char* name, const float* valueArray);
+			void addUniformMatrix4fv(const char* name, const float* valueArray);
+			void addMatrices(const TransformationMatrices& matrices);
+
+			const RenderCommands* getCommands() const;
+			const UniformValues* getUniforms() const;
+			const TextureBindings* getTextures() const;
+			const BufferUploads* getUploads() const;
+			const unsigned char* getUploadData(const BufferUpload& upload) const;
+			RenderCommand& getLastCommand();
+			unsigned int getCommandAmount() const;
+		};
+	}
+}
+#endif
@@ -8,8 +8,11 @@
 #ifndef RENDERPASS_HPP
 #define RENDERPASS_HPP
 
+#include <vector>
+
 #include "Sprite.hpp"
 #include "MaterialProperties.hpp"
+#include "RenderTargetPool.hpp"
 #include "../AyumiUtils/FrameBufferObject.hpp"
 #include "../AyumiResource/Shader.hpp"
 #include "../AyumiResource/Texture.hpp"
@@ -18,14 +21,34 @@ namespace AyumiEngine
 {
 	namespace AyumiRenderer
 	{
+		const unsigned int MAX_COLOR_FILTERS = 4;
+
+		/**
+		 * Enumeration represents per-pixel color filters. Passes which apply only color filters can be
+		 * fused into one pass of ColorFilterFX shader.
+		 */
+		enum ColorFilter
+		{
+			NO_FILTER = 0,
+			SEPIA_FILTER = 1,
+			GRAYSCALE_FILTER = 2,
+			COLOR_INVERT_FILTER = 3
+		};
+
 		/**
 		 * Structure represents data of post-processing pass. It store Frame Buffer, shaders and additional
 		 * parametres/control flags. All post-processing effects like Bloom, Depth of Field are collection of 
 		 * defined RenderPasses.
+		 * Inputs store ids of passes which results are bound to following texture units. Frame buffer is
+		 * borrowed from render target pool for passes lifetime, final pass render directly to screen.
 		 */
 		struct RenderPass
 		{
 			AyumiUtils::FrameBufferObject* frameBuffer;
+			RenderTargetDesc target;
+			float resolutionScale;
+			std::vector<int> inputs;
+			std::vector<int> colorFilters;
 			AyumiResource::Shader* shader;
 			AyumiResource::Texture* renderResult;
 			AyumiRenderer::Sprite* sprite;
@@ -0,0 +1,261 @@
+/**
+ * File contains definition of RenderProfiler class.
+ * @file    RenderProfiler.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-24
+ */
+
+#include <boost/lexical_cast.hpp>
+
+#include "RenderProfiler.hpp"
+
+using namespace std;
+using namespace boost::posix_time;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor.
+		 */
+		RenderProfiler::RenderProfiler()
+		{
+			frameIndex = 0;
+			currentTask = 0;
+			gpuTimingSupported = false;
+			frameCpuTime = 0.0f;
+			frameGpuTime = 0.0f;
+			droppedQueries = 0;
+			stateStatistics.issuedCalls = 0;
+			stateStatistics.filteredCalls = 0;
+			uniformStatistics.uniformCalls = 0;
+			uniformStatistics.avoidedCalls = 0;
+			uniformStatistics.missingCalls = 0;
+		}
+
+		/**
+		 * Class destructor, free timer queries of all frame slots.
+		 */
+		RenderProfiler::~RenderProfiler()
+		{
+			for(unsigned int i = 0; i < PROFILER_FRAME_LATENCY; ++i)
+				if(!frames[i].queries.empty())
+					glDeleteQueries(frames[i].queries.size(),&frames[i].queries[0]);
+		}
+
+		/**
+		 * Method is used to check timer query support. Context must support GL_TIME_ELAPSED queries with non
+		 * zero counter bits, software rasterizers like llvmpipe report them as well.
+		 */
+		void RenderProfiler::initializeProfiler()
+		{
+			gpuTimingSupported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+			if(gpuTimingSupported)
+			{
+				GLint counterBits = 0;
+				glGetQueryiv(GL_TIME_ELAPSED,GL_QUERY_COUNTER_BITS,&counterBits);
+				gpuTimingSupported = counterBits > 0;
+			}
+			if(!gpuTimingSupported)
+				Logger::getInstance()->saveLog(Log<string>("Timer queries are not supported, GPU task timing is disabled."));
+		}
+
+		/**
+		 * Method is used to start new frame. Frame slot used PROFILER_FRAME_LATENCY frames ago is read back
+		 * and reused by current frame.
+		 */
+		void RenderProfiler::beginFrame()
+		{
+			++frameIndex;
+			ProfilerFrame& frame = frames[frameIndex%PROFILER_FRAME_LATENCY];
+			if(gpuTimingSupported)
+				resolveFrame(frame);
+			frame.tasks.clear();
+
+			taskOccurrences.clear();
+			for(TaskTimings::iterator it = timings.begin(); it != timings.end(); ++it)
+				(*it).cpuTime = 0.0f;
+		}
+
+		/**
+		 * Method is used to finish frame and sum CPU time of its tasks.
+		 */
+		void RenderProfiler::endFrame()
+		{
+			frameCpuTime = 0.0f;
+			for(TaskTimings::const_iterator it = timings.begin(); it != timings.end(); ++it)
+				frameCpuTime += (*it).cpuTime;
+		}
+
+		/**
+		 * Method is used to start measuring render task. Tasks can not be nested.
+		 * @param	name is render task name.
+		 */
+		void RenderProfiler::beginTask(const string& name)
+		{
+			const unsigned int occurrence = ++taskOccurrences[name];
+			currentTask = getTaskIndex(occurrence == 1 ? name : name + boost::lexical_cast<string>(occurrence));
+			if(gpuTimingSupported)
+			{
+				ProfilerFrame& frame = frames[frameIndex%PROFILER_FRAME_LATENCY];
+				if(frame.tasks.size() == frame.queries.size())
+				{
+					GLuint query;
+					glGenQueries(1,&query);
+					frame.queries.push_back(query);
+				}
+				glBeginQuery(GL_TIME_ELAPSED,frame.queries[frame.tasks.size()]);
+				frame.tasks.push_back(currentTask);
+			}
+			taskStart = microsec_clock::universal_time();
+		}
+
+		/**
+		 * Method is used to finish measuring current render task.
+		 */
+		void RenderProfiler::endTask()
+		{
+			timings[currentTask].cpuTime += (microsec_clock::universal_time() - taskStart).total_microseconds()*0.001f;
+			if(gpuTimingSupported)
+				glEndQuery(GL_TIME_ELAPSED);
+		}
+
+		/**
+		 * Accessor to timings of render tasks.
+		 * @return	reference to task timings.
+		 */
+		const TaskTimings& RenderProfiler::getTaskTimings() const
+		{
+			return timings;
+		}
+
+		/**
+		 * Accessor to CPU time of last finished frame.
+		 * @return	CPU time in milliseconds.
+		 */
+		float RenderProfiler::getFrameCpuTime() const
+		{
+			return frameCpuTime;
+		}
+
+		/**
+		 * Accessor to GPU time of last resolved frame.
+		 * @return	GPU time in milliseconds.
+		 */
+		float RenderProfiler::getFrameGpuTime() const
+		{
+			return frameGpuTime;
+		}
+
+		/**
+		 * Accessor to amount of queries which were not available when their frame slot was read back.
+		 * @return	amount of dropped queries.
+		 */
+		unsigned int RenderProfiler::getDroppedQueries() const
+		{
+			return droppedQueries;
+		}
+
+		/**
+		 * Accessor to timer queries support.
+		 * @return	true if GPU times are measured.
+		 */
+		bool RenderProfiler::isGpuTimingSupported() const
+		{
+			return gpuTimingSupported;
+		}
+
+		/**
+		 * Method is used to store StateMachine statistics of finished frame.
+		 * @param	statistics is reference to issued and filtered calls of frame.
+		 */
+		void RenderProfiler::setStateStatistics(const AyumiCore::StateMachineStatistics& statistics)
+		{
+			stateStatistics = statistics;
+		}
+
+		/**
+		 * Accessor to StateMachine statistics of last frame.
+		 * @return	reference to issued and filtered calls of last frame.
+		 */
+		const AyumiCore::StateMachineStatistics& RenderProfiler::getStateStatistics() const
+		{
+			return stateStatistics;
+		}
+
+		/**
+		 * Method is used to store uniform set calls of finished frame.
+		 * @param	uniformCalls is amount of all uniform set calls.
+		 * @param	avoidedCalls is amount of calls with unchanged value.
+		 * @param	missingCalls is amount of calls of uniforms not active in program.
+		 */
+		void RenderProfiler::setUniformStatistics(const unsigned int uniformCalls, const unsigned int avoidedCalls, const unsigned int missingCalls)
+		{
+			uniformStatistics.uniformCalls = uniformCalls;
+			uniformStatistics.avoidedCalls = avoidedCalls;
+			uniformStatistics.missingCalls = missingCalls;
+		}
+
+		/**
+		 * Accessor to uniform set calls of last frame.
+		 * @return	reference to uniform calls statistics of last frame.
+		 */
+		const UniformCallStatistics& RenderProfiler::getUniformStatistics() const
+		{
+			return uniformStatistics;
+		}
+
+		/**
+		 * Private method which is used to read back timer queries of frame slot. Result availability is
+		 * checked first, so GPU is never waited for. Query which is not ready yet is dropped.
+		 * @param	frame is reference to read frame slot.
+		 */
+		void RenderProfiler::resolveFrame(ProfilerFrame& frame)
+		{
+			if(frame.tasks.empty())
+				return;
+
+			for(TaskTimings::iterator it = timings.begin(); it != timings.end(); ++it)
+				(*it).gpuTime = 0.0f;
+
+			frameGpuTime = 0.0f;
+			for(unsigned int i = 0; i < frame.tasks.size(); ++i)
+			{
+				GLint available = GL_FALSE;
+				glGetQueryObjectiv(frame.queries[i],GL_QUERY_RESULT_AVAILABLE,&available);
+				if(available == GL_FALSE)
+				{
+					++droppedQueries;
+					continue;
+				}
+
+				GLuint64 elapsedTime = 0;
+				glGetQueryObjectui64v(frame.queries[i],GL_QUERY_RESULT,&elapsedTime);
+				const float gpuTime = static_cast<float>(elapsedTime*0.000001);
+				timings[frame.tasks[i]].gpuTime += gpuTime;
+				frameGpuTime += gpuTime;
+			}
+		}
+
+		/**
+		 * Private method which is used to get timing index of task. New timing is added for unknown task.
+		 * @param	name is render task name.
+		 * @return	index of task timing.
+		 */
+		unsigned int RenderProfiler::getTaskIndex(const string& name)
+		{
+			map<string,unsigned int>::const_iterator it = taskIndices.find(name);
+			if(it != taskIndices.end())
+				return it->second;
+
+			TaskTiming timing;
+			timing.name = name;
+			timing.cpuTime = 0.0f;
+			timing.gpuTime = 0.0f;
+			timings.push_back(timing);
+			taskIndices[name] = timings.size() - 1;
+			return timings.size() - 1;
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/**
+ * File contains declaration of RenderProfiler class.
+ * @file    RenderProfiler.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-24
+ */
+
+#ifndef RENDERPROFILER_HPP
+#define RENDERPROFILER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "../Logger.hpp"
+#include "../AyumiCore/StateMachine.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int PROFILER_FRAME_LATENCY = 3;
+
+		/**
+		 * Structure represents timing of one render task. CPU time is measured in current frame, GPU time
+		 * comes from frame which was rendered PROFILER_FRAME_LATENCY frames earlier. Both are in milliseconds.
+		 */
+		struct TaskTiming
+		{
+			std::string name;
+			float cpuTime;
+			float gpuTime;
+		};
+
+		/**
+		 * Structure represents timer queries issued in one frame. Queries are kept for next use of frame
+		 * slot, task indices store which timing each used query belongs to.
+		 */
+		struct ProfilerFrame
+		{
+			std::vector<GLuint> queries;
+			std::vector<unsigned int> tasks;
+		};
+
+		/**
+		 * Structure represents shader uniform set calls of one frame. Avoided calls had unchanged value,
+		 * missing calls set uniform which is not active in program.
+		 */
+		struct UniformCallStatistics
+		{
+			unsigned int uniformCalls;
+			unsigned int avoidedCalls;
+			unsigned int missingCalls;
+		};
+
+		typedef std::vector<TaskTiming> TaskTimings;
+
+		/**
+		 * Class represents render task profiler. Each task is measured by CPU clock and by GL_TIME_ELAPSED
+		 * query. Queries are buffered in PROFILER_FRAME_LATENCY frame slots and read back when slot is used
+		 * again, so results are available without waiting for GPU. Tasks which occur many times in render
+		 * queue, like post-process passes, are reported separately with following numbers after name. GPU
+		 * time stays zero when timer queries are not supported. Issued and filtered StateMachine calls and
+ * uniform set calls of last frame are kept next to frame timings.
+		 */
+		class RenderProfiler : private AyumiUtils::Noncopyable
+		{
+		private:
+			TaskTimings timings;
+			std::map<std::string,unsigned int> taskIndices;
+			std::map<std::string,unsigned int> taskOccurrences;
+			ProfilerFrame frames[PROFILER_FRAME_LATENCY];
+			unsigned int frameIndex;
+			unsigned int currentTask;
+			boost::posix_time::ptime taskStart;
+			bool gpuTimingSupported;
+			float frameCpuTime;
+			float frameGpuTime;
+			unsigned int droppedQueries;
+			AyumiCore::StateMachineStatistics stateStatistics;
+			UniformCallStatistics uniformStatistics;
+
+			void resolveFrame(ProfilerFrame& frame);
+			unsigned int getTaskIndex(const std::string& name);
+
+		public:
+			RenderProfiler();
+			~RenderProfiler();
+
+			void initializeProfiler();
+			void beginFrame();
+			void endFrame();
+			void beginTask(const std::string& name);
+			void endTask();
+			void setStateStatistics(const AyumiCore::StateMachineStatistics& statistics);
+			void setUniformStatistics(const unsigned int uniformCalls, const unsigned int avoidedCalls, const unsigned int missingCalls);
+
+			const TaskTimings& getTaskTimings() const;
+			float getFrameCpuTime() const;
+			float getFrameGpuTime() const;
+			unsigned int getDroppedQueries() const;
+			bool isGpuTimingSupported() const;
+			const AyumiCore::StateMachineStatistics& getStateStatistics() const;
+			const UniformCallStatistics& getUniformStatistics() const;
+		};
+	}
+}
+#endif
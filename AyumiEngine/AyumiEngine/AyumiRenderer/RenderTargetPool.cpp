@@ -0,0 +1,177 @@
+/**
+ * File contains definition of RenderTargetPool class.
+ * @file    RenderTargetPool.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-15
+ */
+
+#include "RenderTargetPool.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiUtils;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Targets are created on first acquire.
+		 */
+		RenderTargetPool::RenderTargetPool()
+		{
+
+		}
+
+		/**
+		 * Class destructor, free all pooled frame buffers.
+		 */
+		RenderTargetPool::~RenderTargetPool()
+		{
+			for(vector<RenderTarget>::const_iterator it = targets.begin(); it != targets.end(); ++it)
+				delete (*it).frameBuffer;
+			targets.clear();
+		}
+
+		/**
+		 * Method is used to start new schedule. All targets become free, but their frame buffers are kept.
+		 */
+		void RenderTargetPool::releaseRenderTargets()
+		{
+			for(vector<RenderTarget>::iterator it = targets.begin(); it != targets.end(); ++it)
+			{
+				(*it).lastUse = 0;
+				(*it).isScheduled = false;
+			}
+		}
+
+		/**
+		 * Method is used to delete targets which were not acquired by current schedule.
+		 */
+		void RenderTargetPool::trimRenderTargets()
+		{
+			vector<RenderTarget> scheduled;
+			for(vector<RenderTarget>::const_iterator it = targets.begin(); it != targets.end(); ++it)
+			{
+				if((*it).isScheduled)
+					scheduled.push_back(*it);
+				else
+					delete (*it).frameBuffer;
+			}
+			targets.swap(scheduled);
+		}
+
+		/**
+		 * Method is used to acquire render target for range of passes. Target with the same description
+		 * which is not read after first use is aliased, otherwise new target is created. Targets must be
+		 * acquired in pass order.
+		 * @param	desc is reference to render target description.
+		 * @param	firstUse is id of pass which render into target.
+		 * @param	lastUse is id of last pass which read target.
+		 * @return	render target id.
+		 */
+		int RenderTargetPool::acquireRenderTarget(const RenderTargetDesc& desc, const unsigned int firstUse, const unsigned int lastUse)
+		{
+			for(unsigned int i = 0; i < targets.size(); ++i)
+			{
+				RenderTarget& target = targets[i];
+				if(target.desc.width != desc.width || target.desc.height != desc.height || target.desc.textureType != desc.textureType)
+					continue;
+				if(target.desc.depthTexture != desc.depthTexture || target.desc.depthBuffer != desc.depthBuffer)
+					continue;
+				if(target.isScheduled && target.lastUse >= firstUse)
+					continue;
+
+				target.lastUse = lastUse;
+				target.isScheduled = true;
+				return i;
+			}
+
+			RenderTarget target;
+			target.desc = desc;
+			target.frameBuffer = createFrameBuffer(desc);
+			target.lastUse = lastUse;
+			target.isScheduled = true;
+			targets.push_back(target);
+			return targets.size() - 1;
+		}
+
+		/**
+		 * Accessor to pooled frame buffer.
+		 * @param	id is render target id.
+		 * @return	pointer to frame buffer object.
+		 */
+		FrameBufferObject* RenderTargetPool::getFrameBuffer(const int id) const
+		{
+			return targets[id].frameBuffer;
+		}
+
+		/**
+		 * Accessor to amount of pooled targets.
+		 * @return	amount of targets.
+		 */
+		unsigned int RenderTargetPool::getTargetAmount() const
+		{
+			return targets.size();
+		}
+
+		/**
+		 * Method is used to calculate video memory used by all pooled targets.
+		 * @return	size in bytes.
+		 */
+		unsigned int RenderTargetPool::getResidentSize() const
+		{
+			unsigned int size = 0;
+			for(vector<RenderTarget>::const_iterator it = targets.begin(); it != targets.end(); ++it)
+				size += getTargetSize((*it).desc);
+			return size;
+		}
+
+		/**
+		 * Method is used to calculate video memory used by render target. Color and depth attachments
+		 * use four bytes per pixel.
+		 * @param	desc is reference to render target description.
+		 * @return	size in bytes.
+		 */
+		unsigned int RenderTargetPool::getTargetSize(const RenderTargetDesc& desc)
+		{
+			const unsigned int pixels = desc.width * desc.height;
+			return desc.depthBuffer ? pixels * 8 : pixels * 4;
+		}
+
+		/**
+		 * Private method which is used to create and configure frame buffer for target description.
+		 * @param	desc is reference to render target description.
+		 * @return	pointer to new frame buffer object.
+		 */
+		FrameBufferObject* RenderTargetPool::createFrameBuffer(const RenderTargetDesc& desc)
+		{
+			FrameBufferObject* frameBuffer = new FrameBufferObject(desc.width,desc.height,desc.depthBuffer ? depth32 : 0);
+			frameBuffer->create();
+			frameBuffer->bind();
+
+			bool attached = false;
+			if(!desc.depthTexture)
+			{
+				if(desc.textureType == GL_TEXTURE_RECTANGLE)
+					attached = frameBuffer->attachColorTexture(GL_TEXTURE_RECTANGLE,frameBuffer->createColorRectTexture(GL_RGBA,GL_RGBA8),0);
+				else
+					attached = frameBuffer->attachColorTexture(GL_TEXTURE_2D,frameBuffer->createColorTexture(GL_RGBA,GL_RGBA8),0);
+			}
+			else
+			{
+				if(desc.textureType == GL_TEXTURE_RECTANGLE)
+					attached = frameBuffer->attachDepthTexture(GL_TEXTURE_RECTANGLE,frameBuffer->createColorRectTexture(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT));
+				else
+					attached = frameBuffer->attachDepthTexture(GL_TEXTURE_2D,frameBuffer->createColorTexture(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT));
+			}
+
+			if(!attached)
+				Logger::getInstance()->saveLog(Log<string>("Buffer error with color attachment detected!"));
+			if(!frameBuffer->isOk())
+				Logger::getInstance()->saveLog(Log<string>("Error with frame buffer!"));
+
+			frameBuffer->unbind();
+			return frameBuffer;
+		}
+	}
+}
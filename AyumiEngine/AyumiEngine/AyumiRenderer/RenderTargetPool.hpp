@@ -0,0 +1,73 @@
+/**
+ * File contains declaration of RenderTargetPool class.
+ * @file    RenderTargetPool.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-15
+ */
+
+#ifndef RENDERTARGETPOOL_HPP
+#define RENDERTARGETPOOL_HPP
+
+#include <vector>
+
+#include "../AyumiUtils/FrameBufferObject.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Structure represents description of post-process render target. Targets with equal description
+		 * are interchangeable, so they can be shared by passes.
+		 */
+		struct RenderTargetDesc
+		{
+			int width;
+			int height;
+			GLenum textureType;
+			bool depthTexture;
+			bool depthBuffer;
+		};
+
+		/**
+		 * Structure represents pooled render target. Last use store id of last pass which read target in
+		 * current schedule.
+		 */
+		struct RenderTarget
+		{
+			RenderTargetDesc desc;
+			AyumiUtils::FrameBufferObject* frameBuffer;
+			unsigned int lastUse;
+			bool isScheduled;
+		};
+
+		/**
+		 * Class represents pool of transient post-process render targets. Passes acquire target for range
+		 * of passes in which their result is alive - target is aliased by next pass with the same description
+		 * when ranges do not overlap. Frame buffers are kept between schedules, so reloading effects reuse
+		 * already created targets.
+		 */
+		class RenderTargetPool : private AyumiUtils::Noncopyable
+		{
+		private:
+			std::vector<RenderTarget> targets;
+
+			AyumiUtils::FrameBufferObject* createFrameBuffer(const RenderTargetDesc& desc);
+
+		public:
+			RenderTargetPool();
+			~RenderTargetPool();
+
+			void releaseRenderTargets();
+			void trimRenderTargets();
+			int acquireRenderTarget(const RenderTargetDesc& desc, const unsigned int firstUse, const unsigned int lastUse);
+
+			AyumiUtils::FrameBufferObject* getFrameBuffer(const int id) const;
+			unsigned int getTargetAmount() const;
+			unsigned int getResidentSize() const;
+			static unsigned int getTargetSize(const RenderTargetDesc& desc);
+		};
+	}
+}
+#endif
@@ -5,6 +5,8 @@
  * @date    2012-01-12
  */
 
+#include <cstring>
+
 #include "Renderer.hpp"
 
 using namespace std;
@@ -34,6 +36,17 @@ namespace AyumiEngine
 			volumes = new VolumeStorage();
 			occlusionCulling = new Occlusion();
 			particles = new ParticleManager(engineResource);
+			renderBackend = new GLRenderBackend(lights,materials,engineState);
+			frameUniforms = new FrameUniforms();
+			instances = new InstanceBatcher();
+			spriteBatcher = new SpriteBatcher();
+			clusters = new LightClusters();
+			cascades = new CascadedShadowMap();
+			profiler = new RenderProfiler();
+			depthPrePass = new DepthPrePass();
+			resolutionScaler = new ResolutionScaler();
+			sceneScale = 1.0f;
+			cascadeDirection.set(0.0f,-1.0f,0.0f);
 		}
 
 		/**
@@ -57,6 +70,17 @@ namespace AyumiEngine
 				delete (*it);
 			}
 			delete renderToDepth;
+			delete renderToDepthKeyFrame;
+			delete renderToDepthSkinned;
+			delete renderBackend;
+			delete frameUniforms;
+			delete instances;
+			delete spriteBatcher;
+			delete clusters;
+			delete cascades;
+			delete profiler;
+			delete depthPrePass;
+			delete resolutionScaler;
 		}	
 
 		/**
@@ -70,8 +94,14 @@ namespace AyumiEngine
 			effects->initializeEffectManager();
 			particles->initializeParticleManager();
 			volumes->initializeVolumeStorage();	
-			engineState->depthState.on(); 
-			engineState->blendState.on();
+			engineResource->getGeometryHeap()->initializeGeometryHeap();
+			frameUniforms->initializeFrameUniforms();
+			instances->initializeInstanceBatcher();
+			spriteBatcher->initializeSpriteBatcher(sprites->getBatchShader());
+			clusters->initializeLightClusters();
+			profiler->initializeProfiler();
+			depthPrePass->initializeDepthPrePass();
+			engineState->applyRenderState(DEFAULT_RENDER_STATE);
 			updatePerspectiveProjection();
 			updateOrthogonalProjection();
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
@@ -88,6 +118,8 @@ namespace AyumiEngine
 		{
 			if(effects->getRenderPassList()->size() == 0)
 			{	
+				if(Configuration::getInstance()->isDynamicResolutionEnabled())
+					Logger::getInstance()->saveLog(Log<string>("Dynamic resolution needs post-process effect with off-screen scene pass, scene is rendered in full resolution"));
 				renderQueue.push_back(make_pair("renderClearScene",boost::bind(&Renderer::renderClearScene,this)));
 				renderQueue.push_back(make_pair("renderSceneEntities",boost::bind(&Renderer::renderSceneEntities,this)));	
 			}
@@ -111,11 +143,32 @@ namespace AyumiEngine
 			
 		/**
 		 * Method is used to render engine scene. Class main method which is part of Renderer public API.
+		 * StateMachine and shader uniform call counters are reset each frame and stored in RenderProfiler
+		 * with frame timings.
 		 */
 		void Renderer::renderScene()
 		{
+			profiler->beginFrame();
+			engineState->resetStatistics();
+			Shader::resetUniformStatistics();
+			depthPrePass->beginFrame();
+			engineResource->uploadTextureResources();
+			frameUniforms->updateLightData(lights,commandBuffer);
+			updateLightMatrices();
+			uploadSkinnedVertices();
 			for(RenderQueue::const_iterator it = renderQueue.begin(); it != renderQueue.end(); ++it)
+			{
+				profiler->beginTask((*it).first);
 				(*it).second();
+				profiler->endTask();
+			}
+			profiler->setStateStatistics(engineState->getStatistics());
+			profiler->setUniformStatistics(Shader::getUniformCalls(),Shader::getAvoidedUniformCalls(),Shader::getMissingUniformCalls());
+			profiler->endFrame();
+			if(Configuration::getInstance()->isDynamicResolutionEnabled() && !effects->getRenderPassList()->empty())
+				resolutionScaler->updateResolutionScale(profiler->getFrameCpuTime(),profiler->getFrameGpuTime());
+			else
+				resolutionScaler->resetResolutionScale();
 		}
 
 		/**
@@ -144,6 +197,12 @@ namespace AyumiEngine
 					renderQueue.push_front(make_pair("performOcclusionQuery",boost::bind(&Renderer::performOcclusionQuery,this)));
 				else if(task == "renderShadows")
 					renderQueue.push_front(make_pair("renderShadows",boost::bind(&Renderer::renderShadowMaps,this)));
+				else if(task == "renderCascadedShadows")
+				{
+					if(cascades->getDepthTexture() == 0)
+						cascades->initializeCascadedShadowMap();
+					renderQueue.push_front(make_pair("renderCascadedShadows",boost::bind(&Renderer::renderCascadedShadowMaps,this)));
+				}
 				else if(task == "renderSceneEntities")
 					renderQueue.push_back(make_pair("renderSceneEntities2",boost::bind(&Renderer::renderSceneEntities,this)));
 			}
@@ -189,7 +248,7 @@ namespace AyumiEngine
 		void Renderer::prepareEntity(SceneEntity* entity, bool occlusionChecking)
 		{
 			entity->entityMaterial = *materials->getResource(entity->materialName).get();
-			entity->setGeometryData(engineResource->getMeshResource(entity->geometryName));
+			entity->setGeometryData(engineResource->getGeometryResource(entity->geometryName));
 			entity->configureGeometryAttributes();
 			if(occlusionChecking)
 				occlusionCulling->addNewQuery();
@@ -203,12 +262,29 @@ namespace AyumiEngine
 		void Renderer::prepareAnimatedEntity(AnimatedEntity* entity, bool occlusionChecking)
 		{
 			entity->entityMaterial = *materials->getResource(entity->materialName).get();
-			entity->setGeometryData(engineResource->getMeshResource(entity->geometryName));
+			entity->entityMaterial.instancing = false;
+			entity->setGeometryData(engineResource->getGeometryResource(entity->geometryName));
 			entity->configureGeometryAttributes();
 			if(occlusionChecking)
 				occlusionCulling->addNewQuery();
 		}
 
+		/**
+		 * Method is used to prepare new skinned entity rendering data: get material, set shared geometry and
+		 * create skinning data. CPU skinning entity configure own vertex array with fixed attribute locations.
+		 * @param	entity is pointer to new skinned scene entity.
+		 * @param	occlusionChecking is bool flag to determine if entity will be affected by occlusion culling.
+		 */
+		void Renderer::prepareSkinnedEntity(SkinnedEntity* entity, bool occlusionChecking)
+		{
+			entity->entityMaterial = *materials->getResource(entity->materialName).get();
+			entity->entityMaterial.instancing = false;
+			entity->setGeometryData(engineResource->getGeometryResource(entity->geometryName));
+			entity->initializeSkinning();
+			if(occlusionChecking)
+				occlusionCulling->addNewQuery();
+		}
+
 		/**
 		 * Method is used to realese entity - delete entity occlusion query object.
 		 */
@@ -229,6 +305,16 @@ namespace AyumiEngine
 			shadowMaps[id]->direction = direction;
 		}
 
+		/**
+		 * Method is used to update light direction of shadow cascades. It is used when scene has no directional
+		 * light, for example when sun is represented by point light - otherwise first directional light is used.
+		 * @param	direction is direction of light rays.
+		 */
+		void Renderer::updateCascadeSource(const Vector3D& direction)
+		{
+			cascadeDirection = direction;
+		}
+
 		/**
 		 * Accessor to private engine scene member.
 		 * @return	pointer to engine scene.
@@ -302,68 +388,131 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method which is used to render scene entities. One of render tasks.
+		 * Accessor to private render command buffer member.
+		 * @return	pointer to renderer command buffer.
+		 */
+		RenderCommandBuffer* Renderer::getCommandBuffer()
+		{
+			return &commandBuffer;
+		}
+
+		/**
+		 * Accessor to private render backend member.
+		 * @return	pointer to current render backend.
+		 */
+		RenderBackend* Renderer::getRenderBackend() const
+		{
+			return renderBackend;
+		}
+
+		/**
+		 * Method is used to change render backend, e.g. to NullRenderBackend for CPU side benchmarks of RenderHarness.
+		 * Renderer take ownership of new backend and delete previous one.
+		 * @param	renderBackend is pointer to new render backend.
+		 */
+		void Renderer::setRenderBackend(RenderBackend* renderBackend)
+		{
+			if(renderBackend != nullptr && renderBackend != this->renderBackend)
+			{
+				delete this->renderBackend;
+				this->renderBackend = renderBackend;
+			}
+		}
+
+		/**
+		 * Accessor to private RenderProfiler member which store CPU and GPU times of render tasks.
+		 * @return	pointer to render profiler.
+		 */
+		RenderProfiler* Renderer::getRenderProfiler() const
+		{
+			return profiler;
+		}
+
+		/**
+		 * Accessor to depth pre-pass.
+		 * @return	pointer to depth pre-pass.
+		 */
+		DepthPrePass* Renderer::getDepthPrePass() const
+		{
+			return depthPrePass;
+		}
+
+		/**
+		 * Accessor to resolution scaler which adapts resolution of off-screen passes to frame time budget.
+		 * @return	pointer to resolution scaler.
+		 */
+		ResolutionScaler* Renderer::getResolutionScaler() const
+		{
+			return resolutionScaler;
+		}
+
+		/**
+		 * Private method which is used to render scene entities. One of render tasks. Point and spot lights
+		 * are assigned to light clusters of current camera before entities are recorded. When depth pre-pass
+		 * is enabled, pre-pass entities are shaded first with GL_EQUAL depth test and disabled depth writes.
+		 * Fragments of opaque entities are counted by depth pre-pass main pass query. Pre-pass is skipped in
+		 * baseline frames, which measure fragments of scene rendered without it.
 		 */
 		void Renderer::renderSceneEntities()		
 		{
-			engineState->blendState.off();
+			engineState->applyRenderState(OPAQUE_RENDER_STATE);
 			updatePerspectiveProjection();
-			for_each(engineScene->getSceneGraph()->sceneEntities.begin(),engineScene->getSceneGraph()->sceneEntities.end(),boost::bind(&Renderer::renderSceneEntity,this,_1));
-			for_each(engineScene->getSceneGraph()->animatedEntities.begin(),engineScene->getSceneGraph()->animatedEntities.end(),boost::bind(&Renderer::renderSceneEntity,this,_1));
-			engineState->backCullingState.off();
+			updateShadowMatrices();
+			clusters->updateLightClusters(lights,perspectiveProjection,sceneScale,commandBuffer);
+			frameUniforms->updateClusterData(clusters->getClusterData(),commandBuffer);
+
+			const bool prePass = Configuration::getInstance()->isDepthPrePassEnabled() && !depthPrePass->isBaselineFrame();
+			if(prePass)
+				renderDepthPrePass();
+			depthPrePass->beginQuery(MAIN_PASS_QUERY);
+			if(prePass && !depthPrePass->getEntities().empty())
+			{
+				commandBuffer.addDepthState(GL_EQUAL,false);
+				for(PrePassEntities::const_iterator it = depthPrePass->getEntities().begin(); it != depthPrePass->getEntities().end(); ++it)
+					renderSceneEntity((*it).entity);
+				commandBuffer.addDepthState(OPAQUE_RENDER_STATE.depthFunction,OPAQUE_RENDER_STATE.depthWrite);
+			}
+
+			const SceneGraph* sceneGraph = engineScene->getSceneGraph();
+			for(vector<SceneEntity*>::const_iterator it = sceneGraph->sceneEntities.begin(); it != sceneGraph->sceneEntities.end(); ++it)
+				if(!prePass || !depthPrePass->isPrePassEntity(*it))
+					renderSceneEntity(*it);
+			for(vector<SceneEntity*>::const_iterator it = sceneGraph->staticBatches.begin(); it != sceneGraph->staticBatches.end(); ++it)
+				if(!prePass || !depthPrePass->isPrePassEntity(*it))
+					renderSceneEntity(*it);
+			renderInstanceBatches();
+			submitCommands();
+			depthPrePass->endQuery(MAIN_PASS_QUERY);
+			engineState->applyRenderState(TWO_SIDED_RENDER_STATE);
 			const float far = engineScene->getWorldCamera()->far;
 			engineScene->getWorldCamera()->far = 100000.0f;
 			updatePerspectiveProjection();
 			for_each(engineScene->getSceneGraph()->independentEntities.begin(),engineScene->getSceneGraph()->independentEntities.end(),boost::bind(&Renderer::renderSceneEntity,this,_1));
+			renderInstanceBatches();
+			submitCommands();
 			engineScene->getWorldCamera()->far = far;
 		}
 
 		/**
-		 * Private method which is used to render sprites. One of render tasks.
+		 * Private method which is used to render sprites. One of render tasks. Sprites and text glyphs are
+		 * batched, so each texture used by sprites and font atlas is drawn by one draw call.
 		 */
 		void Renderer::renderSprites()
 		{
-			engineState->blendState.on();
-			engineState->depthState.off();
-			engineState->backCullingState.off();
+			engineState->applyRenderState(OVERLAY_RENDER_STATE);
 			updateOrthogonalProjection();
 
 			for(SpriteBatch::const_iterator it = sprites->getSpriteCollection()->begin(); it != sprites->getSpriteCollection()->end(); ++it)
-			{
-				orthogonalProjection.reset();
-				orthogonalProjection.modelMatrix.Translatef((*it)->getPosition());
-				orthogonalProjection.modelMatrix.Scalef((*it)->getSize());
-				(*it)->attachRenderObjects();
-				(*it)->getShader()->setUniformMatrix4fv("projectionMatrix",orthogonalProjection.projectionMatrix.data());
-				(*it)->getShader()->setUniformMatrix4fv("modelViewMatrix",orthogonalProjection.modelMatrix.transpose().data());
-				(*it)->getShader()->setUniformTexture("ColorMapSampler",0);
-				(*it)->getShader()->setUniformf("alpha",(*it)->getAlpha());
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_RECTANGLE,*(*it)->getTexture()->getTexture());
-				glDrawElements(GL_TRIANGLES,6,GL_UNSIGNED_INT,NULL);
-				(*it)->detachRenderObjects();
-			}
+				spriteBatcher->addSprite(SPRITE_LAYER,(*it)->getTexture(),(*it)->getPosition(),(*it)->getSize(),Vector3D(0.0f,0.0f,0.0f),(*it)->getAlpha());
 
 			for(TextBatch::const_iterator it = sprites->getTextCollection()->begin(); it != sprites->getTextCollection()->end(); ++it)
-			{
-				for(vector<TextElement>::const_iterator it2 = (*it).second.begin(); it2 != (*it).second.end(); ++it2)
-				{	
-					orthogonalProjection.modelMatrix.LoadIdentity();
-					orthogonalProjection.modelMatrix.Translatef((*it2).second);
-					orthogonalProjection.modelMatrix.Scalef((*it2).first->getSize());
-					(*it2).first->attachRenderObjects();
-					(*it2).first->getShader()->setUniformMatrix4fv("projectionMatrix",orthogonalProjection.projectionMatrix.data());
-					(*it2).first->getShader()->setUniformMatrix4fv("modelViewMatrix",orthogonalProjection.modelMatrix.transpose().data());
-					(*it2).first->getShader()->setUniformTexture("ColorMapSampler",0);
-					(*it2).first->getShader()->setUniformf("alpha",(*it2).first->getAlpha());				
-					glActiveTexture(GL_TEXTURE0);
-					glBindTexture(GL_TEXTURE_RECTANGLE,*(*it2).first->getTexture()->getTexture());
-					glDrawElements(GL_TRIANGLES,6,GL_UNSIGNED_INT,NULL);
-					(*it2).first->detachRenderObjects();
-				}
-			}
-			engineState->depthState.on();
-			engineState->backCullingState.on();
+				for(vector<TextElement>::const_iterator it2 = (*it).chars.begin(); it2 != (*it).chars.end(); ++it2)
+					spriteBatcher->addSprite(TEXT_LAYER,(*it2).first->getTexture(),(*it2).second,(*it2).first->getSize(),(*it2).first->getCharsetOffset(),(*it2).first->getAlpha());
+
+			spriteBatcher->recordSprites(orthogonalProjection.projectionMatrix.data(),commandBuffer);
+			spriteBatcher->clearSprites();
+			submitCommands();
+			engineState->applyRenderState(DEFAULT_RENDER_STATE);
 		}
 
 		/**
@@ -372,11 +521,11 @@ namespace AyumiEngine
 		void Renderer::renderParticles()
 		{
 			updatePerspectiveProjection();
-			engineState->blendState.on();
-			engineState->depthState.off();
-			particles->updateEmiters(engineScene->getDeltaTime());
+			engineState->applyRenderState(TRANSPARENT_RENDER_STATE);
+			particles->updateEmiters(engineScene->getDeltaTime(),commandBuffer);
 			for_each(particles->getEmiters()->begin(),particles->getEmiters()->end(),boost::bind(&Renderer::renderParticleEmiter,this,_1));
-			engineState->depthState.on();
+			submitCommands();
+			engineState->applyRenderState(DEFAULT_RENDER_STATE);
 		}
 
 		/**
@@ -389,6 +538,7 @@ namespace AyumiEngine
 			for_each(engineScene->getSceneGraph()->sceneEntities.begin(),engineScene->getSceneGraph()->sceneEntities.end(),boost::bind(&Renderer::renderBoundingBox,this,_1));
 			for_each(engineScene->getSceneGraph()->animatedEntities.begin(),engineScene->getSceneGraph()->animatedEntities.end(),boost::bind(&Renderer::renderBoundingBox,this,_1));
 			for_each(engineScene->getSceneGraph()->independentEntities.begin(),engineScene->getSceneGraph()->independentEntities.end(),boost::bind(&Renderer::renderBoundingBox,this,_1));
+			for_each(engineScene->getSceneGraph()->staticBatches.begin(),engineScene->getSceneGraph()->staticBatches.end(),boost::bind(&Renderer::renderBoundingBox,this,_1));
 		}
 
 		/**
@@ -416,66 +566,193 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method which is used to render shadow maps. One for each directional light on scene.
+		 * Private method which is used to render shadow maps. One for each directional light on scene. Only
+		 * casters inside of light frustum are drawn and shadow map is skipped if it is still valid.
 		 */
 		void Renderer::renderShadowMaps()
 		{
 			for(ShadowMaps::const_iterator it = shadowMaps.begin(); it != shadowMaps.end(); ++it)
 			{
-				glBindFramebuffer(GL_FRAMEBUFFER,(*it)->frameBuffer);
-				renderToDepth->bindShader();
-				glViewport(0,0,(*it)->shadowMapWidth,(*it)->shadowMapHeight);
-				glClear(GL_DEPTH_BUFFER_BIT);
-				glColorMask(GL_FALSE,GL_FALSE,GL_FALSE,GL_FALSE); 
-				glCullFace(GL_FRONT);
-				glEnable(GL_CULL_FACE);
-				updatePerspectiveProjection();
-				perspectiveProjection.reset();
-				vector<SceneEntity*>* entities = &engineScene->getSceneGraph()->sceneEntities;
-				vector<AnimatedEntity*>* animated = &engineScene->getSceneGraph()->animatedEntities;
-				
-				(*it)->lightMatrix.LoadIdentity();
-				Quaternion rotate(Vector3D(1.0f,0.0f,0.0f),(*it)->direction[0]);
-				rotate *= Quaternion(Vector3D(0.0f,1.0f,0.0f),(*it)->direction[1]);
-				rotate *= Quaternion(Vector3D(0.0f,0.0f,1.0f),(*it)->direction[2]);
-				(*it)->lightMatrix *= rotate.matrix4(); 
-				(*it)->lightMatrix.Translatef(-(*it)->position[0],-(*it)->position[1],-(*it)->position[2]);
-
-				for(unsigned i = 0; i < entities->size(); ++i)
-				{	
-					perspectiveProjection.reset();
-					perspectiveProjection.modelMatrix.Translatef(entities->at(i)->entityState.position);
-					perspectiveProjection.modelMatrix *= entities->at(i)->entityState.orientation.matrix4();
-					perspectiveProjection.modelMatrix.Scalef(entities->at(i)->entityState.scale);
-					perspectiveProjection.modelViewMatrix = (*it)->lightMatrix * perspectiveProjection.modelMatrix;
-					entities->at(i)->entityGeometry.geometryVao->bindVertexArray();
-					renderToDepth->setUniformMatrix4fv("projectionMatrix",perspectiveProjection.projectionMatrix.data());
-					renderToDepth->setUniformMatrix4fv("modelViewMatrix",perspectiveProjection.modelViewMatrix.transpose().data());
-					glDrawElements(GL_TRIANGLES,entities->at(i)->entityGeometry.geometryMesh->getTrianglesAmount()*3,GL_UNSIGNED_INT,NULL);
-					entities->at(i)->entityGeometry.geometryVao->unbindVertexArray();
-				}
-				
-				for(unsigned i = 0; i < animated->size(); ++i)
-				{
-					perspectiveProjection.reset();
-					perspectiveProjection.modelMatrix.Translatef(animated->at(i)->entityState.position);
-					perspectiveProjection.modelMatrix *= animated->at(i)->entityState.orientation.matrix4();
-					perspectiveProjection.modelMatrix.Scalef(animated->at(i)->entityState.scale);
-					perspectiveProjection.modelViewMatrix = (*it)->lightMatrix * perspectiveProjection.modelMatrix;
-					animated->at(i)->entityGeometry.geometryVao->bindVertexArray();
-					renderToDepth->setUniformMatrix4fv("projectionMatrix",perspectiveProjection.projectionMatrix.data());
-					renderToDepth->setUniformMatrix4fv("modelViewMatrix",perspectiveProjection.modelViewMatrix.data());
-					glDrawElements(GL_TRIANGLES,animated->at(i)->entityGeometry.geometryMesh->getTrianglesAmount()*3,GL_UNSIGNED_INT,NULL);
-					animated->at(i)->entityGeometry.geometryVao->unbindVertexArray();
-				}
+				if(!updateShadowCasters(*it))
+					continue;
+
+				commandBuffer.addBindFrameBuffer((*it)->frameBuffer);
+				commandBuffer.addViewport(0,0,(*it)->shadowMapWidth,(*it)->shadowMapHeight);
+				commandBuffer.addClear(GL_DEPTH_BUFFER_BIT);
+				commandBuffer.addColorMask(false,false,false,false);
+				commandBuffer.addCullFace(GL_FRONT,true);
+				const vector<SceneEntity*>& casters = (*it)->casters;
+
+				for(unsigned i = 0; i < casters.size(); ++i)
+					addShadowCaster(casters[i],(*it)->lightMatrix,(*it)->lightProjection.data());
 				
-				renderToDepth->unbindShader();
-				glBindFramebuffer(GL_FRAMEBUFFER,0);
-				glViewport(0,0,Configuration::getInstance()->getResolutionWidth(),Configuration::getInstance()->getResolutionHeight());
-				glColorMask(GL_TRUE,GL_TRUE,GL_TRUE,GL_TRUE); 
-				glCullFace(GL_BACK);
-				glDisable(GL_CULL_FACE);
+				commandBuffer.addBindFrameBuffer(0);
+				commandBuffer.addViewport(0,0,Configuration::getInstance()->getResolutionWidth(),Configuration::getInstance()->getResolutionHeight());
+				commandBuffer.addColorMask(true,true,true,true);
+				commandBuffer.addCullFace(GL_BACK,false);
 			}
+			submitCommands();
+		}
+
+		/**
+		 * Private method which is used to render cascaded shadow maps of first directional light. Cascades
+		 * are fitted to camera frustum, each of them has own casters culled by its light frustum. Cascades
+		 * which are not updated in current frame keep their depth layer.
+		 */
+		void Renderer::renderCascadedShadowMaps()
+		{
+			const DirectionalLights* directionalLights = lights->getDirectionalLights();
+			const Vector3D& direction = directionalLights->empty() ? cascadeDirection : directionalLights->at(0).first->direction;
+
+			Matrix4D viewMatrix;
+			Matrix4D projectionMatrix;
+			engineScene->getWorldCamera()->setViewMatrix(&viewMatrix);
+			engineScene->getWorldCamera()->setProjectionMatrix(&projectionMatrix);
+			cascades->updateCascades(direction,viewMatrix,projectionMatrix);
+
+			for(unsigned int i = 0; i < cascades->getCascadeAmount(); ++i)
+			{
+				ShadowCascade& cascade = cascades->getCascade(i);
+				if(!cascade.isUpdated)
+					continue;
+
+				engineScene->performShadowCasterCulling(cascade.lightViewProjection,cascade.casters);
+				commandBuffer.addBindFrameBuffer(cascade.frameBuffer);
+				commandBuffer.addViewport(0,0,cascades->getResolution(),cascades->getResolution());
+				commandBuffer.addClear(GL_DEPTH_BUFFER_BIT);
+				commandBuffer.addColorMask(false,false,false,false);
+				commandBuffer.addCullFace(GL_FRONT,true);
+				const Matrix4D lightProjection = transpose(cascade.lightProjection);
+
+				for(unsigned j = 0; j < cascade.casters.size(); ++j)
+					addShadowCaster(cascade.casters[j],cascade.lightMatrix,lightProjection.data());
+			}
+
+			commandBuffer.addBindFrameBuffer(0);
+			commandBuffer.addViewport(0,0,Configuration::getInstance()->getResolutionWidth(),Configuration::getInstance()->getResolutionHeight());
+			commandBuffer.addColorMask(true,true,true,true);
+			commandBuffer.addCullFace(GL_BACK,false);
+			frameUniforms->updateCascadeData(cascades->getShadowMatrices(),cascades->getCascadeSplits(),commandBuffer);
+			submitCommands();
+		}
+
+		/**
+		 * Private method which is used to render depth pre-pass. Visible pre-pass entities are drawn front-to-back
+		 * by depth shaders of their materials with disabled color writes. Material layers and geometry textures
+		 * are bound like in scene pass, so vertex shader shared by both passes compute the same depth.
+		 */
+		void Renderer::renderDepthPrePass()
+		{
+			depthPrePass->collectEntities(engineScene->getSceneGraph(),engineScene->getWorldCamera()->getPosition());
+			const PrePassEntities& entities = depthPrePass->getEntities();
+			if(entities.empty())
+				return;
+
+			depthPrePass->beginQuery(PRE_PASS_QUERY);
+			commandBuffer.addColorMask(false,false,false,false);
+			for(PrePassEntities::const_iterator it = entities.begin(); it != entities.end(); ++it)
+			{
+				SceneEntity* entity = (*it).entity;
+				addEntityDraw(entity->entityMaterial.depthShader,entity);
+				unsigned int layer = 0;
+				for(; layer < entity->entityMaterial.materialLayers.size(); ++layer)
+					commandBuffer.addTexture(entity->entityMaterial.materialLayers[layer]->getType(),*entity->entityMaterial.materialLayers[layer]->getTexture());
+				addGeometryTextures(entity,layer);
+			}
+			commandBuffer.addColorMask(true,true,true,true);
+			submitCommands();
+			depthPrePass->endQuery(PRE_PASS_QUERY);
+		}
+
+		/**
+		 * Private method which is used to record shadow caster depth draw. Key frame animated casters use
+		 * depth shader which interpolate frames from mesh key frame buffer, GPU skinning casters use depth
+		 * shader which skin vertices by skin matrices.
+		 * @param	caster is pointer to shadow caster.
+		 * @param	lightMatrix is reference to light view matrix.
+		 * @param	lightProjection is pointer to light projection matrix.
+		 */
+		void Renderer::addShadowCaster(SceneEntity* caster, const Matrix4D& lightMatrix, const float* lightProjection)
+		{
+			perspectiveProjection.reset();
+			perspectiveProjection.modelMatrix.Translatef(caster->entityState.position);
+			perspectiveProjection.modelMatrix *= caster->entityState.orientation.matrix4();
+			perspectiveProjection.modelMatrix.Scalef(caster->entityState.scale);
+			perspectiveProjection.modelViewMatrix = lightMatrix * perspectiveProjection.modelMatrix;
+
+			float keyFrameData[KEY_FRAME_DATA_SIZE];
+			const bool isKeyFrame = caster->getKeyFrameData(keyFrameData);
+			unsigned int jointAmount = 0;
+			const float* skinMatrices = caster->getSkinMatrices(jointAmount);
+			if(skinMatrices != nullptr && !frameUniforms->hasSkinSpace())
+				submitCommands();
+
+			addEntityGeometry(isKeyFrame ? renderToDepthKeyFrame : skinMatrices != nullptr ? renderToDepthSkinned : renderToDepth,caster);
+			commandBuffer.addUniformMatrix4fv("projectionMatrix",lightProjection);
+			commandBuffer.addUniformMatrix4fv("modelViewMatrix",transpose(perspectiveProjection.modelViewMatrix).data());
+			if(isKeyFrame)
+			{
+				commandBuffer.addUniform4fv("keyFrameData",keyFrameData);
+				commandBuffer.addUniform4fv("blendFrameData",keyFrameData + 4);
+				commandBuffer.addUniformTexture("keyFrames",0);
+				commandBuffer.addTexture(GL_TEXTURE_BUFFER,caster->entityGeometry.geometryData->getKeyFrameTexture());
+			}
+			if(skinMatrices != nullptr)
+			{
+				frameUniforms->addSkinData(skinMatrices,jointAmount,commandBuffer);
+				commandBuffer.addUniformTexture("skinInfluences",0);
+				commandBuffer.addTexture(GL_TEXTURE_BUFFER,caster->entityGeometry.geometryData->getInfluenceTexture());
+			}
+		}
+
+		/**
+		 * Private method which is used to stream vertices of CPU skinning entities into their vertex buffers.
+		 * It is called once per frame before render tasks, so shadow and scene passes use the same pose. Buffer
+		 * storage is orphaned, so upload does not wait for draws of previous frame.
+		 */
+		void Renderer::uploadSkinnedVertices()
+		{
+			const vector<SkinnedEntity*>& skinnedEntities = engineScene->getSceneGraph()->skinnedEntities;
+			for(vector<SkinnedEntity*>::const_iterator it = skinnedEntities.begin(); it != skinnedEntities.end(); ++it)
+			{
+				if((*it)->getSkinnedBuffer() == 0)
+					continue;
+				const GLsizeiptr size = (*it)->getSkinnedVerticesAmount()*sizeof(Vertex<>);
+				commandBuffer.addStreamUpload(GL_ARRAY_BUFFER,(*it)->getSkinnedBuffer(),size,size,(*it)->getSkinnedVertices());
+			}
+		}
+
+		/**
+		 * Private method which is used to collect shadow casters of shadow map and check if shadow map must be
+		 * rendered again. Shadow map is valid if light did not move, set of casters is the same and none of
+		 * dynamic casters moved. Animated casters invalidate shadow map every frame.
+		 * @param	shadowMap is pointer to shadow map.
+		 * @return	true if shadow map must be rendered.
+		 */
+		bool Renderer::updateShadowCasters(ShadowMap* shadowMap)
+		{
+			const unsigned int animatedAmount = engineScene->performShadowCasterCulling(shadowMap->lightViewProjection,shadowMap->casters);
+
+			casterState.resize(shadowMap->casters.size());
+			for(unsigned i = 0; i < shadowMap->casters.size(); ++i)
+			{
+				const SceneEntity* caster = shadowMap->casters[i];
+				casterState[i].entity = caster;
+				memset(casterState[i].transform,0,10*sizeof(float));
+				if(caster->entityState.isStatic)
+					continue;
+				memcpy(&casterState[i].transform[0],caster->entityState.position.data(),3*sizeof(float));
+				memcpy(&casterState[i].transform[3],caster->entityState.orientation.data(),4*sizeof(float));
+				memcpy(&casterState[i].transform[7],caster->entityState.scale.data(),3*sizeof(float));
+			}
+
+			if(shadowMap->isCached && animatedAmount == 0 && casterState.size() == shadowMap->casterState.size())
+				if(casterState.empty() || memcmp(&casterState[0],&shadowMap->casterState[0],casterState.size()*sizeof(ShadowCasterState)) == 0)
+					return false;
+
+			shadowMap->casterState.swap(casterState);
+			shadowMap->isCached = true;
+			return true;
 		}
 
 		/**
@@ -485,82 +762,186 @@ namespace AyumiEngine
 		 */
 		void Renderer::renderSceneEntity(SceneEntity* entity)
 		{
-			if(entity->entityState.isVisible)
+			if(entity->entityState.isVisible && !entity->entityState.isBatched && !instances->addInstance(entity))
 			{
-				perspectiveProjection.reset();
-				perspectiveProjection.modelMatrix.Translatef(entity->entityState.position);
-				perspectiveProjection.modelMatrix *= entity->entityState.orientation.matrix4();
-				perspectiveProjection.modelMatrix.Scalef(entity->entityState.scale);					
-				perspectiveProjection.modelViewMatrix = perspectiveProjection.viewMatrix * perspectiveProjection.modelMatrix;
-				perspectiveProjection.createNormalMatrix();
+				addEntityDraw(entity->entityMaterial.entityShader,entity);
+				addEntityMaterial(entity);
+			}
+		}
 
-				entity->attachMaterial();
-				lights->sendLightsData(entity->entityMaterial.entityShader);
-				perspectiveProjection.sendMatricesData(entity->entityMaterial.entityShader);
-				materials->sendMaterialData(&entity->entityMaterial,engineScene->getDeltaTime());
+		/**
+		 * Private method which is used to record entity draw command with transformation matrices, key frame
+		 * data and skin matrices of entity. It is used by scene pass and depth pre-pass.
+		 * @param	shader is pointer to draw shader.
+		 * @param	entity is pointer to scene entity.
+		 */
+		void Renderer::addEntityDraw(Shader* shader, SceneEntity* entity)
+		{
+			perspectiveProjection.reset();
+			perspectiveProjection.modelMatrix.Translatef(entity->entityState.position);
+			perspectiveProjection.modelMatrix *= entity->entityState.orientation.matrix4();
+			perspectiveProjection.modelMatrix.Scalef(entity->entityState.scale);					
+			perspectiveProjection.modelViewMatrix = perspectiveProjection.viewMatrix * perspectiveProjection.modelMatrix;
+			perspectiveProjection.createNormalMatrix();
 
-				for(unsigned i = 0; i < shadowMaps.size(); ++i)
-				{
-					shadowMaps[i]->lightMatrix.LoadIdentity();
-					Quaternion rotate(Vector3D(1.0f,0.0f,0.0f),shadowMaps[i]->direction[0]);
-					rotate *= Quaternion(Vector3D(0.0f,1.0f,0.0f),shadowMaps[i]->direction[1]);
-					rotate *= Quaternion(Vector3D(0.0f,0.0f,1.0f),shadowMaps[i]->direction[2]);
-					shadowMaps[i]->lightMatrix *= rotate.matrix4(); 
-					shadowMaps[i]->lightMatrix.Translatef(-shadowMaps[i]->position[0],-shadowMaps[i]->position[1],-shadowMaps[i]->position[2]);			
-					shadowMaps[i]->lightMatrix.transpose();
-					shadowMaps[i]->shadowMatrix.LoadIdentity();
-					shadowMaps[i]->shadowMatrix = shadowMaps[i]->shadowMatrix * shadowMaps[i]->bias;
-					shadowMaps[i]->shadowMatrix = perspectiveProjection.projectionMatrix * shadowMaps[i]->shadowMatrix;	
-					shadowMaps[i]->shadowMatrix = shadowMaps[i]->lightMatrix * shadowMaps[i]->shadowMatrix;
-					shadowMaps[i]->shadowMatrix = perspectiveProjection.inverseViewMatrix * shadowMaps[i]->shadowMatrix;
-					entity->entityMaterial.entityShader->setUniformMatrix4fv(shadowMaps[i]->matrixName,shadowMaps[i]->shadowMatrix.data());
-				}
-				
-				unsigned int layer = 0;
-				for(; layer < entity->entityMaterial.materialLayers.size(); ++layer)
+			unsigned int jointAmount = 0;
+			const float* skinMatrices = shader->hasUniformBlock(SKIN_BLOCK) ? entity->getSkinMatrices(jointAmount) : nullptr;
+			if((shader->hasUniformBlock(OBJECT_BLOCK) && !frameUniforms->hasObjectSpace()) || (skinMatrices != nullptr && !frameUniforms->hasSkinSpace()))
+				submitCommands();
+
+			float keyFrameData[KEY_FRAME_DATA_SIZE];
+			const bool isKeyFrame = entity->getKeyFrameData(keyFrameData);
+			addEntityGeometry(shader,entity);
+			if(shader->hasUniformBlock(OBJECT_BLOCK))
+				frameUniforms->addObjectData(perspectiveProjection,commandBuffer,isKeyFrame ? keyFrameData : nullptr);
+			else
+				commandBuffer.addMatrices(perspectiveProjection);
+			if(isKeyFrame && !shader->hasUniformBlock(OBJECT_BLOCK))
+			{
+				commandBuffer.addUniform4fv("keyFrameData",keyFrameData);
+				commandBuffer.addUniform4fv("blendFrameData",keyFrameData + 4);
+			}
+			if(skinMatrices != nullptr)
+				frameUniforms->addSkinData(skinMatrices,jointAmount,commandBuffer);
+		}
+
+		/**
+		 * Private method which is used to render instance batches collected by scene entity rendering. Each
+		 * batch is drawn by one instanced draw call, batches bigger than instance buffer are split. Batches
+		 * are cleared after recording.
+		 */
+		void Renderer::renderInstanceBatches()
+		{
+			for(unsigned int i = 0; i < instances->getBatchAmount(); ++i)
+			{
+				InstanceBatch& batch = instances->getBatch(i);
+				SceneEntity* entity = batch.entity;
+				Shader* shader = entity->entityMaterial.entityShader;
+
+				for(unsigned int first = 0; first < batch.instanceAmount;)
 				{
-					glActiveTexture(GL_TEXTURE0 + layer);
-					glBindTexture(entity->entityMaterial.materialLayers[layer]->getType(),*entity->entityMaterial.materialLayers[layer]->getTexture());
+					if(instances->getFreeInstances() == 0)
+						submitCommands();
+					const unsigned int amount = min<unsigned int>(batch.instanceAmount - first,instances->getFreeInstances());
+					const GLintptr offset = instances->addInstanceData(&batch.transforms[first*INSTANCE_DATA_SIZE],amount,commandBuffer);
+					const EntityGeometry& geometry = entity->entityGeometry;
+					const GLuint vertexArray = geometry.geometryVao != nullptr ? geometry.geometryVao->getVAO() : geometry.geometryData->getVertexArray();
+					commandBuffer.addDrawElementsInstanced(shader,vertexArray,geometry.geometryMesh->getTrianglesAmount()*3,amount,instances->getInstanceBuffer(),offset);
+					commandBuffer.addIndexRange(geometry.geometryData->getIndexOffset(),geometry.geometryData->getBaseVertex());
+					if(!shader->hasUniformBlock(CAMERA_BLOCK))
+					{
+						perspectiveProjection.reset();
+						commandBuffer.addMatrices(perspectiveProjection);
+					}
+					addEntityMaterial(entity);
+					first += amount;
 				}
+			}
+			instances->clearInstances();
+		}
 
+		/**
+		 * Private method which is used to record entity draw command. Geometry heap meshes are drawn from
+		 * shared heap vertex array with own index range and base vertex.
+		 * @param	shader is pointer to draw shader.
+		 * @param	entity is pointer to scene entity.
+		 */
+		void Renderer::addEntityGeometry(Shader* shader, SceneEntity* entity)
+		{
+			const EntityGeometry& geometry = entity->entityGeometry;
+			const GLuint vertexArray = geometry.geometryVao != nullptr ? geometry.geometryVao->getVAO() : geometry.geometryData->getVertexArray();
+			commandBuffer.addDrawElements(shader,vertexArray,geometry.geometryMesh->getTrianglesAmount()*3);
+			commandBuffer.addIndexRange(geometry.geometryData->getIndexOffset(),geometry.geometryData->getBaseVertex());
+		}
+
+		/**
+		 * Private method which is used to add entity material data to last recorded draw command: material and
+		 * light flags, shadow matrices, material layers, shadow map textures, key frame buffer of animated
+		 * meshes and joint influences buffer of skinned meshes.
+		 * @param	entity is pointer to scene entity.
+		 */
+		void Renderer::addEntityMaterial(SceneEntity* entity)
+		{
+			Shader* shader = entity->entityMaterial.entityShader;
+			RenderCommand& command = commandBuffer.getLastCommand();
+			command.flags |= shader->hasUniformBlock(LIGHT_BLOCK) ? SEND_MATERIAL : SEND_LIGHTS | SEND_MATERIAL;
+			command.material = &entity->entityMaterial;
+			command.materialTime = engineScene->getDeltaTime();
+
+			if(!shader->hasUniformBlock(SHADOW_BLOCK))
 				for(unsigned i = 0; i < shadowMaps.size(); ++i)
-				{
-					entity->entityMaterial.entityShader->setUniformTexture(shadowMaps[i]->textureName,layer);
-					glActiveTexture(GL_TEXTURE0+layer);
-					glBindTexture(GL_TEXTURE_2D,shadowMaps[i]->depthTexture);
-					layer++;
-				}
-				glDrawElements(GL_TRIANGLES,entity->entityGeometry.geometryMesh->getTrianglesAmount()*3,GL_UNSIGNED_INT,NULL);
-				entity->detachMaterial();
+					commandBuffer.addUniformMatrix4fv(shadowMaps[i]->matrixName.c_str(),shadowMaps[i]->shadowMatrix.data());
+			
+			unsigned int layer = 0;
+			for(; layer < entity->entityMaterial.materialLayers.size(); ++layer)
+				commandBuffer.addTexture(entity->entityMaterial.materialLayers[layer]->getType(),*entity->entityMaterial.materialLayers[layer]->getTexture());
+
+			for(unsigned i = 0; i < shadowMaps.size(); ++i)
+			{
+				commandBuffer.addUniformTexture(shadowMaps[i]->textureName.c_str(),layer);
+				commandBuffer.addTexture(GL_TEXTURE_2D,shadowMaps[i]->depthTexture);
+				layer++;
+			}
+			addGeometryTextures(entity,layer);
+		}
+
+		/**
+		 * Private method which is used to add key frame buffer of animated meshes or joint influences buffer
+		 * of skinned meshes to last recorded draw command.
+		 * @param	entity is pointer to scene entity.
+		 * @param	unit is texture unit of geometry buffer.
+		 */
+		void Renderer::addGeometryTextures(SceneEntity* entity, const unsigned int unit)
+		{
+			const MeshGeometry* geometryData = entity->entityGeometry.geometryData.get();
+			if(geometryData != nullptr && geometryData->isKeyFrameGeometry())
+			{
+				commandBuffer.addUniformTexture("keyFrames",unit);
+				commandBuffer.addTexture(GL_TEXTURE_BUFFER,geometryData->getKeyFrameTexture());
+			}
+			else if(geometryData != nullptr && geometryData->isSkinnedGeometry())
+			{
+				commandBuffer.addUniformTexture("skinInfluences",unit);
+				commandBuffer.addTexture(GL_TEXTURE_BUFFER,geometryData->getInfluenceTexture());
 			}
 		}
 
 		/**
 		 * Private method which is used to render particle emiter. It is part of particle systems rendering
-		 * render task. Method is used to render one particle emiter.
+		 * render task. Method is used to render one particle emiter. Particles of CPU emiters are streamed to
+		 * vertex buffer, GPU emiters draw buffer written by simulation step recorded in particle update.
 		 * @param	emiter is pointer to particle emiter representaion
 		 */	
 		void Renderer::renderParticleEmiter(ParticleEmiter* emiter)
 		{	
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+			commandBuffer.addBlendFunc(GL_SRC_ALPHA,GL_ONE);
 			perspectiveProjection.reset();
 			perspectiveProjection.modelMatrix.Translatef(emiter->origin);
 			perspectiveProjection.modelViewMatrix = perspectiveProjection.viewMatrix * perspectiveProjection.modelMatrix;
-			emiter->particleVao->bindVertexArray();		
-			glBindBuffer(GL_ARRAY_BUFFER,emiter->particleVbo);
-			glBufferData(GL_ARRAY_BUFFER,emiter->particleAmount*12*sizeof(float),emiter->points,GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_ARRAY_BUFFER,0);
-			emiter->shader->bindShader();
-			perspectiveProjection.sendMatricesData(emiter->shader);
-			emiter->shader->setUniformTexture("particleMap",0);
-			emiter->shader->setUniformf("pointSize",emiter->particles[0].size);
-			emiter->shader->setUniform4fv("color",emiter->particles->color.data());
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D,*emiter->texture->getTexture());
-			glDrawArrays(GL_POINTS,0,emiter->particleAmount);
-			emiter->shader->unbindShader();
-			emiter->particleVao->unbindVertexArray();
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			unsigned int vertexAmount = 0;
+			GLuint vertexArray = 0;
+			if(emiter->simulation == GPU_SIMULATION)
+			{
+				vertexAmount = emiter->feedback->getParticleCapacity();
+				vertexArray = emiter->feedback->getRenderArray();
+			}
+			else
+			{
+				vertexAmount = emiter->pool->getVertexAmount();
+				vertexArray = emiter->particleVao->getVAO();
+				if(vertexAmount > 0)
+					commandBuffer.addStreamUpload(GL_ARRAY_BUFFER,emiter->particleVbo,emiter->particleAmount*sizeof(ParticleVertex),vertexAmount*sizeof(ParticleVertex),emiter->pool->getVertices());
+			}
+
+			if(vertexAmount > 0)
+			{
+				commandBuffer.addDrawArrays(emiter->shader,vertexArray,0,vertexAmount,GL_POINTS);
+				commandBuffer.addMatrices(perspectiveProjection);
+				commandBuffer.addUniformTexture("particleMap",0);
+				commandBuffer.addUniform4fv("color",emiter->particle.color.data());
+				commandBuffer.addTexture(GL_TEXTURE_2D,*emiter->texture->getTexture());
+			}
+			commandBuffer.addBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
 		}
 
 		/**
@@ -644,15 +1025,22 @@ namespace AyumiEngine
 
 		/**
 		 * Private method which is used to render off-screen scene. One of generic post process render tasks.
+		 * Scene is rendered into lower left part of frame buffer, which size is scaled by resolution scale.
 		 */
 		void Renderer::renderOffScreenScene()
 		{
-			engineState->blendState.off();
-			effects->getRenderPassList()->at(effects->currentID)->frameBuffer->bind();
-			renderClearScene();
+			FrameBufferObject* frameBuffer = effects->getRenderPassList()->at(effects->currentID)->frameBuffer;
+			commandBuffer.addBindFrameBuffer(frameBuffer->getFrameBuffer());
+			commandBuffer.addClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+			submitCommands();
+			sceneScale = resolutionScaler->getResolutionScale();
+			commandBuffer.addViewport(0,0,resolutionScaler->getScaledSize(frameBuffer->getWidth()),resolutionScaler->getScaledSize(frameBuffer->getHeight()));
 			renderSceneEntities();
-			effects->getRenderPassList()->at(effects->currentID)->frameBuffer->unbind();
-			engineState->blendState.on();
+			sceneScale = 1.0f;
+			commandBuffer.addBindFrameBuffer(0);
+			commandBuffer.addViewport(0,0,Configuration::getInstance()->getResolutionWidth(),Configuration::getInstance()->getResolutionHeight());
+			submitCommands();
+			engineState->applyRenderState(DEFAULT_RENDER_STATE);
 			effects->currentID++;
 		}
 
@@ -661,39 +1049,7 @@ namespace AyumiEngine
 		 */
 		void Renderer::renderOffScreenPrevious()
 		{
-			engineState->depthState.off();
-			engineState->backCullingState.off();
-			effects->getRenderPassList()->at(effects->currentID)->frameBuffer->bind();
-			renderClearScene();
-
-			Sprite* current = effects->getRenderPassList()->at(effects->currentID)->sprite;
-			effects->getRenderPassList()->at(effects->currentID-1)->renderResult->setTexture(effects->getRenderPassList()->at(effects->currentID-1)->frameBuffer->getColorBuffer());
-			current->setTexture(effects->getRenderPassList()->at(effects->currentID-1)->renderResult);
-
-			updateOrthogonalProjection();
-			orthogonalProjection.modelMatrix.LoadIdentity();
-			orthogonalProjection.modelMatrix.Translatef(current->getPosition().x(),current->getPosition().y(),0.0f);
-			orthogonalProjection.modelMatrix.Scalef(current->getSize().x(),current->getSize().y(),0.0f);
-			Quaternion rotate(Vector3D(1.0f,0.0f,0.0f),180.0f); 
-			rotate *= Quaternion(Vector3D(0.0f,1.0f,0.0f),0.0f); 
-			orthogonalProjection.modelMatrix *= rotate.matrix4(); 
-			Matrix4D modelViewProjection = transpose(orthogonalProjection.projectionMatrix*orthogonalProjection.modelMatrix);
-
-			current->attachRenderObjects();
-
-			current->getShader()->setUniformMatrix4fv("modelViewProjectionMatrix",modelViewProjection.data());
-			current->getShader()->setUniformTexture("FrameBuffer",0);
-			
-			for(FloatUniforms::const_iterator it = effects->getRenderPassList()->at(effects->currentID)->floats.begin(); it != effects->getRenderPassList()->at(effects->currentID)->floats.end(); ++it)
-				current->getShader()->setUniformf((*it).first,(*it).second);
-
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_RECTANGLE,*current->getTexture()->getTexture());
-			glDrawElements(GL_TRIANGLES,6,GL_UNSIGNED_INT,NULL);
-			current->detachRenderObjects();
-			effects->getRenderPassList()->at(effects->currentID)->frameBuffer->unbind();
-			engineState->depthState.on();
-			engineState->backCullingState.on();
+			renderEffectPass(effects->getRenderPassList()->at(effects->currentID));
 			effects->currentID++;
 		}
 
@@ -702,14 +1058,33 @@ namespace AyumiEngine
 		 */
 		void Renderer::renderFinalRendering()
 		{
-			engineState->depthState.off();
-			engineState->backCullingState.off();
-			updateOrthogonalProjection();
-	
-			Sprite* current = effects->getRenderPassList()->at(effects->currentID)->sprite;
-			effects->getRenderPassList()->at(effects->currentID-1)->renderResult->setTexture(effects->getRenderPassList()->at(effects->currentID-1)->frameBuffer->getColorBuffer());
-			current->setTexture(effects->getRenderPassList()->at(effects->currentID-1)->renderResult);
+			renderEffectPass(effects->getRenderPassList()->at(effects->currentID));
+			effects->currentID = 0;
+		}
+
+		/**
+		 * Private method which is used to render fullscreen post-process pass. Results of input passes are
+		 * bound to following texture units as FrameBuffer, FrameBuffer2... samplers. Texture coordinates
+		 * are in pass pixels, so scale of each input is passed in FrameBufferScale, FrameBuffer2Scale...
+		 * uniforms. Off-screen pass is rendered into part of frame buffer scaled by resolution scale and
+		 * texture coordinates are scaled by TexCoordScale uniform, so inputs are read from their scaled
+		 * parts. Pass without frame buffer render to screen in full resolution, it upscales its inputs.
+		 * Pass is recorded into command buffer, so frame buffer, viewport and texture units go through
+		 * state cache like other render tasks.
+		 * @param	pass is pointer to rendered pass.
+		 */
+		void Renderer::renderEffectPass(RenderPass* pass)
+		{
+			engineState->applyRenderState(OVERLAY_RENDER_STATE);
+			if(pass->frameBuffer != nullptr)
+			{
+				commandBuffer.addBindFrameBuffer(pass->frameBuffer->getFrameBuffer());
+				commandBuffer.addClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+				commandBuffer.addViewport(0,0,resolutionScaler->getScaledSize(pass->frameBuffer->getWidth()),resolutionScaler->getScaledSize(pass->frameBuffer->getHeight()));
+			}
 
+			Sprite* current = pass->sprite;
+			updateOrthogonalProjection();
 			orthogonalProjection.modelMatrix.LoadIdentity();
 			orthogonalProjection.modelMatrix.Translatef(current->getPosition().x(),current->getPosition().y(),0.0f);
 			orthogonalProjection.modelMatrix.Scalef(current->getSize().x(),current->getSize().y(),0.0f);
@@ -718,28 +1093,33 @@ namespace AyumiEngine
 			orthogonalProjection.modelMatrix *= rotate.matrix4();
 			Matrix4D modelViewProjection = transpose(orthogonalProjection.projectionMatrix*orthogonalProjection.modelMatrix);
 
-			current->attachRenderObjects();
-			current->getShader()->setUniformMatrix4fv("modelViewProjectionMatrix",modelViewProjection.data());
-			current->getShader()->setUniformTexture("FrameBuffer",0);
-			current->getShader()->setUniformTexture("FrameBuffer2",1);
+			commandBuffer.addDrawElements(current->getShader(),current->getVertexArray()->getVAO(),6);
+			commandBuffer.addUniformMatrix4fv("modelViewProjectionMatrix",modelViewProjection.data());
+			commandBuffer.addUniformf("TexCoordScale",resolutionScaler->getResolutionScale());
 
-			for(FloatUniforms::const_iterator it = effects->getRenderPassList()->at(effects->currentID)->floats.begin(); it != effects->getRenderPassList()->at(effects->currentID)->floats.end(); ++it)
-				current->getShader()->setUniformf((*it).first,(*it).second);
+			for(unsigned int i = 0; i < pass->inputs.size(); ++i)
+			{
+				const RenderPass* input = effects->getRenderPassList()->at(pass->inputs[i]);
+				string sampler = "FrameBuffer";
+				if(i > 0)
+					sampler += boost::lexical_cast<string>(i+1);
+				commandBuffer.addUniformTexture(sampler.c_str(),i);
+				commandBuffer.addUniformf((sampler + "Scale").c_str(),static_cast<float>(input->frameBuffer->getWidth())/pass->target.width);
+				commandBuffer.addTexture(input->target.textureType,*input->renderResult->getTexture());
+			}
 
-			int passAmount = effects->getRenderPassList()->size() - 1;
-			for(int i = 0; i < passAmount-1; i++)
+			for(FloatUniforms::const_iterator it = pass->floats.begin(); it != pass->floats.end(); ++it)
+				commandBuffer.addUniformf((*it).first.c_str(),(*it).second);
+			for(IntegerUniforms::const_iterator it = pass->integers.begin(); it != pass->integers.end(); ++it)
+				commandBuffer.addUniformi((*it).first.c_str(),(*it).second);
+
+			if(pass->frameBuffer != nullptr)
 			{
-				Sprite* pass = effects->getRenderPassList()->at(effects->currentID-passAmount+i)->sprite;
-				glActiveTexture(GL_TEXTURE0+i);
-				glBindTexture(GL_TEXTURE_RECTANGLE,*pass->getTexture()->getTexture());
+				commandBuffer.addBindFrameBuffer(0);
+				commandBuffer.addViewport(0,0,Configuration::getInstance()->getResolutionWidth(),Configuration::getInstance()->getResolutionHeight());
 			}
-			glActiveTexture(GL_TEXTURE0+passAmount-1);
-			glBindTexture(GL_TEXTURE_RECTANGLE,*current->getTexture()->getTexture());
-			glDrawElements(GL_TRIANGLES,6,GL_UNSIGNED_INT,NULL);
-			current->detachRenderObjects();
-			engineState->depthState.on();
-			engineState->backCullingState.on();
-			effects->currentID = 0;
+			submitCommands();
+			engineState->applyRenderState(DEFAULT_RENDER_STATE);
 		}
 
 		/**
@@ -754,8 +1134,56 @@ namespace AyumiEngine
 			perspectiveProjection.projectionMatrix.transpose();
 			perspectiveProjection.inverseViewMatrix = inverse(perspectiveProjection.viewMatrix);
 			perspectiveProjection.inverseViewMatrix.transpose();
+			frameUniforms->updateCameraData(perspectiveProjection,commandBuffer);
 		}
 		
+		/**
+		 * Private method which is used to calculate light matrices of all shadow maps. It is called once per
+		 * frame, light projection is taken from camera projection like in shadow rendering. Shadow map cache
+		 * is invalidated when light matrices change.
+		 */
+		void Renderer::updateLightMatrices()
+		{
+			Matrix4D projectionMatrix;
+			engineScene->getWorldCamera()->setProjectionMatrix(&projectionMatrix);
+
+			for(unsigned i = 0; i < shadowMaps.size(); ++i)
+			{
+				Matrix4D lightMatrix;
+				lightMatrix.LoadIdentity();
+				Quaternion rotate(Vector3D(1.0f,0.0f,0.0f),shadowMaps[i]->direction[0]);
+				rotate *= Quaternion(Vector3D(0.0f,1.0f,0.0f),shadowMaps[i]->direction[1]);
+				rotate *= Quaternion(Vector3D(0.0f,0.0f,1.0f),shadowMaps[i]->direction[2]);
+				lightMatrix *= rotate.matrix4(); 
+				lightMatrix.Translatef(-shadowMaps[i]->position[0],-shadowMaps[i]->position[1],-shadowMaps[i]->position[2]);
+
+				const Matrix4D lightViewProjection = projectionMatrix * lightMatrix;
+				if(memcmp(lightViewProjection.data(),shadowMaps[i]->lightViewProjection.data(),16*sizeof(float)) != 0)
+					shadowMaps[i]->isCached = false;
+				shadowMaps[i]->lightMatrix = lightMatrix;
+				shadowMaps[i]->lightViewProjection = lightViewProjection;
+				shadowMaps[i]->lightProjection = transpose(projectionMatrix);
+			}
+		}
+
+		/**
+		 * Private method which is used to calculate shadow matrices of all shadow maps for current perspective
+		 * projection. Light matrices of current frame are used, so shadow matrices match rendered shadow maps.
+		 * Matrices are send to shadow uniform block.
+		 */
+		void Renderer::updateShadowMatrices()
+		{
+			for(unsigned i = 0; i < shadowMaps.size(); ++i)
+			{
+				shadowMaps[i]->shadowMatrix.LoadIdentity();
+				shadowMaps[i]->shadowMatrix = shadowMaps[i]->shadowMatrix * shadowMaps[i]->bias;
+				shadowMaps[i]->shadowMatrix = shadowMaps[i]->lightProjection * shadowMaps[i]->shadowMatrix;	
+				shadowMaps[i]->shadowMatrix = transpose(shadowMaps[i]->lightMatrix) * shadowMaps[i]->shadowMatrix;
+				shadowMaps[i]->shadowMatrix = perspectiveProjection.inverseViewMatrix * shadowMaps[i]->shadowMatrix;
+			}
+			frameUniforms->updateShadowData(shadowMaps,commandBuffer);
+		}
+
 		/**
 		 * Private method which is used to update orthogonal projection transformation matrices.
 		 */
@@ -772,30 +1200,42 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method is used to intiialize shadow maps for directiona lights source.
+		 * Private method which is used to compile and link in-engine depth shader.
+		 * @param	shader is pointer to depth shader.
+		 * @param	vertexShaderSource is vertex shader source code.
+		 * @param	fragmentShaderSource is fragment shader source code.
 		 */
-		void Renderer::initializeShadowMaps()
+		void Renderer::initializeDepthShader(Shader* shader, const char* vertexShaderSource, const char* fragmentShaderSource)
 		{
-			renderToDepth = new Shader("renderToDepth");
-			renderToDepth->setVertexPath("null");
-			renderToDepth->setFragmentPath("null");
-			renderToDepth->createVertexShader();
-			renderToDepth->createFragmentShader();
-
-			const char* vertexShaderSource = renderToDepthVertex;
-			const char* fragmentShaderSource = renderToDepthFragment;
+			shader->setVertexPath("null");
+			shader->setFragmentPath("null");
+			shader->createVertexShader();
+			shader->createFragmentShader();
 
 			if(vertexShaderSource == nullptr || fragmentShaderSource == nullptr)
-				Logger::getInstance()->saveLog(Log<string>("Sprite shader loading error detected: "));
+				Logger::getInstance()->saveLog(Log<string>("Depth shader loading error detected: " + string(shader->getResourceName())));
 		
-			glShaderSource(renderToDepth->getShaderVertex(),1,&vertexShaderSource,0);
-			glShaderSource(renderToDepth->getShaderFragment(),1,&fragmentShaderSource,0);
-			glCompileShader(renderToDepth->getShaderVertex());
-			glCompileShader(renderToDepth->getShaderFragment());
-			renderToDepth->createShaderProgram();
-			glAttachShader(renderToDepth->getShaderProgram(),renderToDepth->getShaderVertex());
-			glAttachShader(renderToDepth->getShaderProgram(),renderToDepth->getShaderFragment());
-			glLinkProgram(renderToDepth->getShaderProgram());
+			glShaderSource(shader->getShaderVertex(),1,&vertexShaderSource,0);
+			glShaderSource(shader->getShaderFragment(),1,&fragmentShaderSource,0);
+			glCompileShader(shader->getShaderVertex());
+			glCompileShader(shader->getShaderFragment());
+			shader->createShaderProgram();
+			glAttachShader(shader->getShaderProgram(),shader->getShaderVertex());
+			glAttachShader(shader->getShaderProgram(),shader->getShaderFragment());
+			shader->linkShaderProgram();
+		}
+
+		/**
+		 * Private method is used to intiialize shadow maps for directiona lights source.
+		 */
+		void Renderer::initializeShadowMaps()
+		{
+			renderToDepth = new Shader("renderToDepth");
+			initializeDepthShader(renderToDepth,renderToDepthVertex,renderToDepthFragment);
+			renderToDepthKeyFrame = new Shader("renderToDepthKeyFrame");
+			initializeDepthShader(renderToDepthKeyFrame,renderToDepthKeyFrameVertex,renderToDepthFragment);
+			renderToDepthSkinned = new Shader("renderToDepthSkinned");
+			initializeDepthShader(renderToDepthSkinned,renderToDepthSkinnedVertex,renderToDepthFragment);
 
 			unsigned lightAmount = lights->getDirectionalLights()->size();
 			lightAmount += lights->getPointLights()->size();
@@ -827,8 +1267,12 @@ namespace AyumiEngine
 				if(FBOstatus != GL_FRAMEBUFFER_COMPLETE)
 					Logger::getInstance()->saveLog(Log<string>("ShadowMap FrameBuffer creaton error occurred!"));
 				
-				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+				glBindFramebuffer(GL_FRAMEBUFFER,FrameBufferObject::getDefaultFrameBuffer());
 				shadowMap->bias = Matrix4D(0.5,0.0,0.0,0.0,0.0,0.5,0.0,0.0,0.0,0.0,0.5,0.0,0.5,0.5,0.5,1.0);
+				shadowMap->lightMatrix.LoadIdentity();
+				shadowMap->lightProjection.LoadIdentity();
+				shadowMap->lightViewProjection.LoadIdentity();
+				shadowMap->isCached = false;
 				shadowMaps.push_back(shadowMap);
 				string uniform = "shadowMatrix";
 				uniform += boost::lexical_cast<string>(i);
@@ -838,5 +1282,17 @@ namespace AyumiEngine
 				shadowMap->textureName = uniform;	
 			}
 		}
+
+		/**
+		 * Private method which is used to execute recorded render commands by current backend and clear
+		 * command buffer. It is called at the end of each render task which record commands.
+		 */
+		void Renderer::submitCommands()
+		{
+			renderBackend->executeCommands(commandBuffer);
+			commandBuffer.clearCommands();
+			frameUniforms->releaseObjectData();
+			instances->releaseInstanceData();
+		}
 	}
 }
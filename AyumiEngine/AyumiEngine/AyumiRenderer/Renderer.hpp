@@ -21,6 +21,17 @@
 #include "VolumeStorage.hpp"
 #include "Occlusion.hpp"
 #include "ShadowMap.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "FrameUniforms.hpp"
+#include "InstanceBatcher.hpp"
+#include "SpriteBatcher.hpp"
+#include "LightClusters.hpp"
+#include "CascadedShadowMap.hpp"
+#include "GLRenderBackend.hpp"
+#include "NullRenderBackend.hpp"
+#include "RenderProfiler.hpp"
+#include "DepthPrePass.hpp"
+#include "ResolutionScaler.hpp"
 
 #include "../AyumiCore/Configuration.hpp"
 #include "../AyumiScene/SceneManager.hpp"
@@ -39,7 +50,11 @@ namespace AyumiEngine
 		 * in OpenGL context window. Renderer use SceneManager data to draw visible object, 2D sprites etc.
 		 * Renderer store few important managers: ResourceManager, MaterialManager, LightManager and 2D module
 		 * SpriteManager. Renderer is the only place where projecion Matrices are calculated and transmitted to
-		 * object shaders. Pipeline is done by task queue.
+		 * object shaders. Pipeline is done by task queue. Tasks record draw commands into command buffer which is
+		 * executed by pluggable render backend. Camera, light and shadow data is shared by shaders in uniform
+		 * blocks which are updated once per frame. Each task is timed on CPU and GPU by RenderProfiler.
+		 * Opaque entities which material has depth shader can be drawn in depth pre-pass before scene pass.
+		 * Off-screen scene and post-process passes are rendered in resolution adapted to frame time budget.
 		 */
 		class Renderer
 		{
@@ -59,6 +74,21 @@ namespace AyumiEngine
 			ParticleManager* particles;
 			ShadowMaps shadowMaps;
 			AyumiResource::Shader* renderToDepth;
+			AyumiResource::Shader* renderToDepthKeyFrame;
+			AyumiResource::Shader* renderToDepthSkinned;
+			RenderCommandBuffer commandBuffer;
+			RenderBackend* renderBackend;
+			FrameUniforms* frameUniforms;
+			InstanceBatcher* instances;
+			SpriteBatcher* spriteBatcher;
+			LightClusters* clusters;
+			CascadedShadowMap* cascades;
+			RenderProfiler* profiler;
+			DepthPrePass* depthPrePass;
+			ResolutionScaler* resolutionScaler;
+			float sceneScale;
+			AyumiMath::Vector3D cascadeDirection;
+			std::vector<ShadowCasterState> casterState;
 	
 			void renderSceneEntities();
 			void renderSprites();
@@ -67,8 +97,15 @@ namespace AyumiEngine
 			void renderOctTree();
 			void performOcclusionQuery();
 			void renderShadowMaps();
+			void renderCascadedShadowMaps();
+			void renderDepthPrePass();
 			
 			void renderSceneEntity(AyumiScene::SceneEntity* entity);
+			void addEntityDraw(AyumiResource::Shader* shader, AyumiScene::SceneEntity* entity);
+			void renderInstanceBatches();
+			void addEntityGeometry(AyumiResource::Shader* shader, AyumiScene::SceneEntity* entity);
+			void addEntityMaterial(AyumiScene::SceneEntity* entity);
+			void addGeometryTextures(AyumiScene::SceneEntity* entity, const unsigned int unit);
 			void renderParticleEmiter(ParticleEmiter* emiter);
 			void renderBoundingBox(AyumiScene::SceneEntity* entity);
 			void renderOctTreeNode(AyumiScene::OctNode* node);
@@ -78,9 +115,17 @@ namespace AyumiEngine
 			void renderOffScreenScene();
 			void renderOffScreenPrevious();
 			void renderFinalRendering();
+			void renderEffectPass(RenderPass* pass);
 			void updatePerspectiveProjection();
 			void updateOrthogonalProjection();
+			void updateLightMatrices();
+			void updateShadowMatrices();
+			bool updateShadowCasters(ShadowMap* shadowMap);
+			void uploadSkinnedVertices();
+			void addShadowCaster(AyumiScene::SceneEntity* caster, const AyumiMath::Matrix4D& lightMatrix, const float* lightProjection);
+			void initializeDepthShader(AyumiResource::Shader* shader, const char* vertexShaderSource, const char* fragmentShaderSource);
 			void initializeShadowMaps();
+			void submitCommands();
 		public:
 			Renderer(AyumiScene::SceneManager* engineScene);
 			~Renderer();
@@ -94,8 +139,10 @@ namespace AyumiEngine
 			void clearRenderQueue();
 			void prepareEntity(AyumiScene::SceneEntity* entity, bool occlusionChecking = true);
 			void prepareAnimatedEntity(AyumiScene::AnimatedEntity* entity, bool occlusionChecking = true);
+			void prepareSkinnedEntity(AyumiScene::SkinnedEntity* entity, bool occlusionChecking = true);
 			void releaseEntity();
 			void updateShadowSource(const int id, const AyumiMath::Vector3D& position, const AyumiMath::Vector3D& direction);
+			void updateCascadeSource(const AyumiMath::Vector3D& direction);
 			
 			AyumiScene::SceneManager* getEngineScene() const;		
 			AyumiResource::ResourceManager* getEngineResource() const;
@@ -105,6 +152,12 @@ namespace AyumiEngine
 			MaterialManager* getMaterialManager() const;
 			EffectManager* getEffectManager() const;
 			ShadowMaps* getShadowMaps();
+			RenderCommandBuffer* getCommandBuffer();
+			RenderBackend* getRenderBackend() const;
+			void setRenderBackend(RenderBackend* renderBackend);
+			RenderProfiler* getRenderProfiler() const;
+			DepthPrePass* getDepthPrePass() const;
+			ResolutionScaler* getResolutionScaler() const;
 		};
 	}
 }
@@ -0,0 +1,119 @@
+/**
+ * File contains definition of ResolutionScaler class.
+ * @file    ResolutionScaler.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-26
+ */
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "ResolutionScaler.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiCore;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Class default constructor. Scene is rendered in full resolution until first update.
+		 */
+		ResolutionScaler::ResolutionScaler()
+		{
+			memset(&statistics,0,sizeof(statistics));
+			resolutionScale = 1.0f;
+			controllerScale = 1.0f;
+			previousError = 0.0f;
+			statistics.controllerScale = controllerScale;
+			statistics.resolutionScale = resolutionScale;
+		}
+
+		/**
+		 * Class destructor. Nothing to delete.
+		 */
+		ResolutionScaler::~ResolutionScaler()
+		{
+
+		}
+
+		/**
+		 * Method is used to update resolution scale with frame times of last measured frame. Scale range and
+		 * frame time budget are read from Configuration, so they can be changed between frames.
+		 * @param	cpuTime is CPU frame time in milliseconds.
+		 * @param	gpuTime is GPU frame time in milliseconds.
+		 */
+		void ResolutionScaler::updateResolutionScale(const float cpuTime, const float gpuTime)
+		{
+			Configuration* config = Configuration::getInstance();
+			const float minScale = min(max(config->getMinResolutionScale(),MIN_RESOLUTION_SCALE),1.0f);
+			const float maxScale = min(max(config->getMaxResolutionScale(),minScale),1.0f);
+			const float targetTime = config->getTargetFrameTime();
+			controllerScale = max(minScale,min(controllerScale,maxScale));
+			statistics.frameTime = max(cpuTime,gpuTime);
+			if(targetTime > 0.0f && statistics.frameTime > 0.0f)
+			{
+				statistics.error = (targetTime - statistics.frameTime) / targetTime;
+				const float error = fabs(statistics.error) > RESOLUTION_HYSTERESIS ? statistics.error : 0.0f;
+				controllerScale += RESOLUTION_PROPORTIONAL_GAIN*(error - previousError) + RESOLUTION_INTEGRAL_GAIN*error;
+				controllerScale = max(minScale,min(controllerScale,maxScale));
+				previousError = error;
+			}
+			statistics.controllerScale = controllerScale;
+
+			const float appliedScale = max(minScale,min(resolutionScale,maxScale));
+			if(fabs(controllerScale - appliedScale) >= RESOLUTION_SCALE_STEP || ((controllerScale == minScale || controllerScale == maxScale) && controllerScale != appliedScale))
+			{
+				resolutionScale = controllerScale;
+				statistics.scaleChanges++;
+			}
+			else
+				resolutionScale = appliedScale;
+			statistics.resolutionScale = resolutionScale;
+		}
+
+		/**
+		 * Method is used to restore full resolution and clear controller state. It is used when dynamic
+		 * resolution is disabled.
+		 */
+		void ResolutionScaler::resetResolutionScale()
+		{
+			resolutionScale = 1.0f;
+			controllerScale = 1.0f;
+			previousError = 0.0f;
+			statistics.error = 0.0f;
+			statistics.controllerScale = controllerScale;
+			statistics.resolutionScale = resolutionScale;
+		}
+
+		/**
+		 * Method is used to scale size of render target by current resolution scale.
+		 * @param	size is full resolution width or height in pixels.
+		 * @return	scaled size in pixels, at least one.
+		 */
+		int ResolutionScaler::getScaledSize(const int size) const
+		{
+			return max(1,static_cast<int>(size * resolutionScale + 0.5f));
+		}
+
+		/**
+		 * Accessor to private resolution scale member.
+		 * @return	current resolution scale in range (0,1].
+		 */
+		float ResolutionScaler::getResolutionScale() const
+		{
+			return resolutionScale;
+		}
+
+		/**
+		 * Accessor to private statistics member.
+		 * @return	reference to statistics of resolution scale controller.
+		 */
+		const ResolutionScalerStatistics& ResolutionScaler::getStatistics() const
+		{
+			return statistics;
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/**
+ * File contains declaration of ResolutionScaler class.
+ * @file    ResolutionScaler.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-26
+ */
+
+#ifndef RESOLUTIONSCALER_HPP
+#define RESOLUTIONSCALER_HPP
+
+#include "../AyumiCore/Configuration.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const float MIN_RESOLUTION_SCALE = 0.25f;
+		const float RESOLUTION_PROPORTIONAL_GAIN = 0.2f;
+		const float RESOLUTION_INTEGRAL_GAIN = 0.02f;
+		const float RESOLUTION_HYSTERESIS = 0.05f;
+		const float RESOLUTION_SCALE_STEP = 0.02f;
+
+		/**
+		 * Structure represents state of resolution scale controller. Frame time is longer of CPU and GPU frame
+		 * times in milliseconds, error is frame budget part which is left, negative when budget is exceeded.
+		 * Controller scale is PI controller output, resolution scale is its value applied to render targets.
+		 */
+		struct ResolutionScalerStatistics
+		{
+			float frameTime;
+			float error;
+			float controllerScale;
+			float resolutionScale;
+			unsigned int scaleChanges;
+		};
+
+		/**
+		 * Class represents dynamic resolution controller. Resolution scale of scene and off-screen post-process
+		 * passes is adapted each frame by PI controller in velocity form, which compares measured frame time with
+		 * frame time budget from Configuration: controller scale is changed by proportional gain times error
+		 * change and integral gain times error. Errors inside RESOLUTION_HYSTERESIS band around budget are
+		 * treated as zero and controller scale is applied only when it differs from resolution scale by at least
+		 * RESOLUTION_SCALE_STEP, so scale does not oscillate when frame time is close to budget. Clamping of
+		 * controller scale to its range stops integration. GPU time comes from frame which was rendered
+		 * PROFILER_FRAME_LATENCY frames earlier, so gains are kept low.
+		 */
+		class ResolutionScaler : private AyumiUtils::Noncopyable
+		{
+		private:
+			float resolutionScale;
+			float controllerScale;
+			float previousError;
+			ResolutionScalerStatistics statistics;
+
+		public:
+			ResolutionScaler();
+			~ResolutionScaler();
+
+			void updateResolutionScale(const float cpuTime, const float gpuTime);
+			void resetResolutionScale();
+			int getScaledSize(const int size) const;
+
+			float getResolutionScale() const;
+			const ResolutionScalerStatistics& getStatistics() const;
+		};
+	}
+}
+#endif
@@ -8,14 +8,29 @@
 #ifndef SHADOWMAP_HPP
 #define SHADOWMAP_HPP
 
+#include <vector>
+
 #include "../AyumiUtils/FrameBufferObject.hpp"
+#include "../AyumiScene/SceneEntity.hpp"
 
 namespace AyumiEngine
 {
 	namespace AyumiRenderer
 	{
 		/**
-		 * Structure represents shadow map data which is used in simple shadow mapping algorithm.
+		 * Structure represents shadow caster state which is used to detect shadow map changes. Transform of
+		 * static casters is not stored - they change shadow only by entering or leaving light frustum.
+		 */
+		struct ShadowCasterState
+		{
+			const AyumiScene::SceneEntity* entity;
+			float transform[10];
+		};
+
+		/**
+		 * Structure represents shadow map data which is used in simple shadow mapping algorithm. Light
+		 * matrices are calculated once per frame. Depth texture is cached and rendered again only when light
+		 * or casters inside of light frustum change.
 		 */
 		struct ShadowMap
 		{
@@ -24,12 +39,17 @@ namespace AyumiEngine
 			GLuint frameBuffer;
 			GLuint depthTexture;
 			AyumiMath::Matrix4D lightMatrix;
+			AyumiMath::Matrix4D lightProjection;
+			AyumiMath::Matrix4D lightViewProjection;
 			AyumiMath::Matrix4D shadowMatrix;
 			AyumiMath::Matrix4D bias;
 			AyumiMath::Vector3D position;
 			AyumiMath::Vector3D direction;
 			std::string textureName;
 			std::string matrixName;
+			std::vector<AyumiScene::SceneEntity*> casters;
+			std::vector<ShadowCasterState> casterState;
+			bool isCached;
 		};
 	}
 }
@@ -27,6 +27,7 @@ namespace AyumiEngine
 			spriteTexture = nullptr;
 			position.set(0.0f,0.0f,0.0f);
 			size.set(0.0f,0.0f,0.0f);
+			charsetOffset.set(0.0f,0.0f,0.0f);
 			alpha = 1.0f;
 		}
 
@@ -46,6 +47,7 @@ namespace AyumiEngine
 			this->spriteTexture = spriteTexture;
 			setPosition(position[0],position[1]);
 			setSize(size[0],size[1]);
+			charsetOffset.set(0.0f,0.0f,0.0f);
 			this->alpha = alpha;
 		}
 
@@ -98,6 +100,7 @@ namespace AyumiEngine
 		 */
 		void Sprite::setCharsetCoordinates(const float x, const float y)
 		{
+			charsetOffset.set(x,y,0.0f);
 			for(int i = 0; i < spriteMesh->getVerticesAmount(); ++i)
 			{
 				spriteMesh->getVertices()[i].u += x;
@@ -123,6 +126,15 @@ namespace AyumiEngine
 			return size;
 		}
 
+		/**
+		 * Accessor to private sprite charset offset member.
+		 * @return	sprite texture coordinates offset in font charset.
+		 */
+		Vector3D Sprite::getCharsetOffset() const
+		{
+			return charsetOffset;
+		}
+
 		/**
 		 * Accessor to private sprite texture member.
 		 * @return	pointer to sprite texture.
@@ -159,6 +171,15 @@ namespace AyumiEngine
 			return alpha;
 		}
 
+		/**
+		 * Accessor to private sprite vertex array object member.
+		 * @return	pointer to sprite vertex array object.
+		 */
+		VertexArrayObject* Sprite::getVertexArray() const
+		{
+			return spriteVao;
+		}
+
 		/**
 		 * Setter for private position vector member.
 		 * @param	x is position vector x value.
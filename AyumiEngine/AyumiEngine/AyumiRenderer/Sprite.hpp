@@ -39,6 +39,7 @@ namespace AyumiEngine
 			AyumiUtils::VertexBufferObject* spriteVbo;
 			AyumiMath::Vector3D position;
 			AyumiMath::Vector3D size;
+			AyumiMath::Vector3D charsetOffset;
 			float alpha;
 			
 			void initializeSpriteMesh();
@@ -57,10 +58,12 @@ namespace AyumiEngine
 		
 			AyumiMath::Vector3D getPosition() const;
 			AyumiMath::Vector3D getSize() const;
+			AyumiMath::Vector3D getCharsetOffset() const;
 			AyumiResource::Texture* getTexture() const;
 			AyumiResource::Shader* getShader() const;
 			std::string getName() const;
 			float getAlpha() const;
+			AyumiUtils::VertexArrayObject* getVertexArray() const;
 			
 			void setPosition(const float x, const float y);
 			void setSize(const float width, const float height);
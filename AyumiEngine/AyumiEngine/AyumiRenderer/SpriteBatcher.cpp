@@ -0,0 +1,223 @@
+/**
+ * File contains definition of SpriteBatcher class.
+ * @file    SpriteBatcher.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-12
+ */
+
+#include <algorithm>
+
+#include "SpriteBatcher.hpp"
+#include "DefinedGeometry.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiMath;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		/**
+		 * Function is used to compare sprite quads by layer, texture and submit order.
+		 * @param	first is first sprite quad.
+		 * @param	second is second sprite quad.
+		 * @return	true if first quad is drawn before second.
+		 */
+		static bool compareSpriteQuads(const SpriteQuad& first, const SpriteQuad& second)
+		{
+			if(first.layer != second.layer)
+				return first.layer < second.layer;
+			if(first.texture != second.texture)
+				return first.texture < second.texture;
+			return first.order < second.order;
+		}
+
+		/**
+		 * Class default constructor. Buffers are created in initialization.
+		 */
+		SpriteBatcher::SpriteBatcher()
+		{
+			batchShader = nullptr;
+			vertexArray = 0;
+			vertexBuffer = 0;
+			indexBuffer = 0;
+			quadCapacity = 0;
+			drawAmount = 0;
+		}
+
+		/**
+		 * Class destructor, free buffer objects and vertex array.
+		 */
+		SpriteBatcher::~SpriteBatcher()
+		{
+			if(vertexArray != 0)
+			{
+				glDeleteVertexArrays(1,&vertexArray);
+				glDeleteBuffers(1,&vertexBuffer);
+				glDeleteBuffers(1,&indexBuffer);
+			}
+			quads.clear();
+			vertices.clear();
+		}
+
+		/**
+		 * Method is used to create stream vertex buffer, quad index buffer and vertex array.
+		 * @param	batchShader is pointer to sprite batch shader.
+		 */
+		void SpriteBatcher::initializeSpriteBatcher(Shader* batchShader)
+		{
+			this->batchShader = batchShader;
+			glGenVertexArrays(1,&vertexArray);
+			glGenBuffers(1,&vertexBuffer);
+			glGenBuffers(1,&indexBuffer);
+			resizeBuffers(SPRITE_BATCH_CAPACITY);
+
+			const GLint alphaPosition = glGetAttribLocation(batchShader->getShaderProgram(),"vertexAlpha");
+			glBindVertexArray(vertexArray);
+			glBindBuffer(GL_ARRAY_BUFFER,vertexBuffer);
+			glVertexAttribPointer(VERTEX_ATTRIBUTE,2,GL_FLOAT,GL_FALSE,sizeof(SpriteVertex),reinterpret_cast<const GLubyte *>(0) + 0);
+			glVertexAttribPointer(TEXCOORD_ATTRIBUTE,2,GL_FLOAT,GL_FALSE,sizeof(SpriteVertex),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*2);
+			glVertexAttribPointer(alphaPosition,1,GL_FLOAT,GL_FALSE,sizeof(SpriteVertex),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*4);
+			glEnableVertexAttribArray(VERTEX_ATTRIBUTE);
+			glEnableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+			glEnableVertexAttribArray(alphaPosition);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,indexBuffer);
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Method is used to add sprite quad to current frame batch.
+		 * @param	layer is sprite layer.
+		 * @param	texture is pointer to sprite rectangle texture.
+		 * @param	position is sprite position on screen.
+		 * @param	size is sprite size.
+		 * @param	texCoordOffset is offset of sprite in texture, used by font atlas glyphs.
+		 * @param	alpha is sprite alpha channel value.
+		 */
+		void SpriteBatcher::addSprite(const SpriteLayer layer, Texture* texture, const Vector3D& position, const Vector3D& size, const Vector3D& texCoordOffset, const float alpha)
+		{
+			SpriteQuad quad;
+			quad.layer = layer;
+			quad.texture = *texture->getTexture();
+			quad.order = quads.size();
+			quad.position = position;
+			quad.size = size;
+			quad.texCoordOffset = texCoordOffset;
+			quad.alpha = alpha;
+			quads.push_back(quad);
+		}
+
+		/**
+		 * Method is used to record batched sprites. Quads are sorted, written into vertex array and uploaded
+		 * by one stream upload. Each run of quads with the same texture is recorded as one draw command which
+		 * use base vertex to address its quads in shared index buffer.
+		 * @param	projectionMatrix is pointer to orthogonal projection matrix.
+		 * @param	buffer is reference to command buffer.
+		 */
+		void SpriteBatcher::recordSprites(const float* projectionMatrix, RenderCommandBuffer& buffer)
+		{
+			drawAmount = 0;
+			if(quads.empty())
+				return;
+
+			if(quads.size() > quadCapacity)
+			{
+				unsigned int capacity = quadCapacity;
+				while(capacity < quads.size())
+					capacity *= 2;
+				resizeBuffers(capacity);
+			}
+
+			sort(quads.begin(),quads.end(),compareSpriteQuads);
+			vertices.clear();
+			for(vector<SpriteQuad>::const_iterator it = quads.begin(); it != quads.end(); ++it)
+				addQuadVertices(*it);
+			buffer.addStreamUpload(GL_ARRAY_BUFFER,vertexBuffer,quadCapacity*SPRITE_QUAD_VERTICES*sizeof(SpriteVertex),vertices.size()*sizeof(SpriteVertex),&vertices[0]);
+
+			for(unsigned int first = 0, last = 0; first < quads.size(); first = last)
+			{
+				while(last < quads.size() && quads[last].layer == quads[first].layer && quads[last].texture == quads[first].texture)
+					last++;
+
+				buffer.addDrawElements(batchShader,vertexArray,(last-first)*SPRITE_QUAD_INDICES);
+				buffer.addIndexRange(0,first*SPRITE_QUAD_VERTICES);
+				buffer.addUniformMatrix4fv("projectionMatrix",projectionMatrix);
+				buffer.addUniformTexture("ColorMapSampler",0);
+				buffer.addTexture(GL_TEXTURE_RECTANGLE,quads[first].texture);
+				drawAmount++;
+			}
+		}
+
+		/**
+		 * Method is used to clear batched quads after they were recorded. Memory is kept for next frame.
+		 */
+		void SpriteBatcher::clearSprites()
+		{
+			quads.clear();
+		}
+
+		/**
+		 * Accessor to amount of quads batched in current frame.
+		 * @return	amount of quads.
+		 */
+		unsigned int SpriteBatcher::getQuadAmount() const
+		{
+			return quads.size();
+		}
+
+		/**
+		 * Accessor to amount of draw commands recorded in last frame.
+		 * @return	amount of sprite draws.
+		 */
+		unsigned int SpriteBatcher::getDrawAmount() const
+		{
+			return drawAmount;
+		}
+
+		/**
+		 * Private method which is used to resize quad index buffer and reserve vertex memory. Index buffer
+		 * store indices of all quads, so any run of quads can be drawn with base vertex.
+		 * @param	capacity is new quad capacity.
+		 */
+		void SpriteBatcher::resizeBuffers(const unsigned int capacity)
+		{
+			quadCapacity = capacity;
+			quads.reserve(quadCapacity);
+			vertices.reserve(quadCapacity*SPRITE_QUAD_VERTICES);
+
+			vector<unsigned int> indices(quadCapacity*SPRITE_QUAD_INDICES);
+			for(unsigned int i = 0; i < quadCapacity; ++i)
+				for(unsigned int j = 0; j < SPRITE_QUAD_INDICES; ++j)
+					indices[i*SPRITE_QUAD_INDICES+j] = quadIndices[j] + i*SPRITE_QUAD_VERTICES;
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,indexBuffer);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER,indices.size()*sizeof(unsigned int),&indices[0],GL_STATIC_DRAW);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
+			glBindBuffer(GL_ARRAY_BUFFER,vertexBuffer);
+			glBufferData(GL_ARRAY_BUFFER,quadCapacity*SPRITE_QUAD_VERTICES*sizeof(SpriteVertex),NULL,GL_STREAM_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Private method which is used to transform sprite quad into screen space vertices. Quad geometry and
+		 * texture coordinates match Sprite mesh, texture coordinates are scaled by sprite size because of
+		 * rectangle textures.
+		 * @param	quad is reference to sprite quad.
+		 */
+		void SpriteBatcher::addQuadVertices(const SpriteQuad& quad)
+		{
+			for(unsigned int i = 0; i < SPRITE_QUAD_VERTICES; ++i)
+			{
+				SpriteVertex vertex;
+				vertex.x = quad.position.x() + quadVertices[i*3]*quad.size.x();
+				vertex.y = quad.position.y() + quadVertices[i*3+1]*quad.size.y();
+				vertex.u = quadUV[i*2]*quad.size.x() + quad.texCoordOffset.x();
+				vertex.v = quadUV[i*2+1]*quad.size.y() + quad.texCoordOffset.y();
+				vertex.alpha = quad.alpha;
+				vertices.push_back(vertex);
+			}
+		}
+	}
+}
@@ -0,0 +1,99 @@
+/**
+ * File contains declaration of SpriteBatcher class.
+ * @file    SpriteBatcher.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-12
+ */
+
+#ifndef SPRITEBATCHER_HPP
+#define SPRITEBATCHER_HPP
+
+#include <vector>
+
+#include "RenderCommandBuffer.hpp"
+
+#include "../AyumiMath/CommonMath.hpp"
+#include "../AyumiResource/Texture.hpp"
+#include "../AyumiResource/Shader.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int SPRITE_BATCH_CAPACITY = 1024;
+		const unsigned int SPRITE_QUAD_VERTICES = 4;
+		const unsigned int SPRITE_QUAD_INDICES = 6;
+
+		/**
+		 * Enumeration represents sprite layers. Layers are drawn in order, text is always drawn over sprites.
+		 */
+		enum SpriteLayer
+		{
+			SPRITE_LAYER,
+			TEXT_LAYER
+		};
+
+		/**
+		 * Structure represents one sprite vertex streamed to GPU: screen position, rectangle texture
+		 * coordinates and alpha.
+		 */
+		struct SpriteVertex
+		{
+			float x, y;
+			float u, v;
+			float alpha;
+		};
+
+		/**
+		 * Structure represents one sprite quad submitted to batcher. Submit order is used to keep order of
+		 * quads with the same texture.
+		 */
+		struct SpriteQuad
+		{
+			SpriteLayer layer;
+			GLuint texture;
+			unsigned int order;
+			AyumiMath::Vector3D position;
+			AyumiMath::Vector3D size;
+			AyumiMath::Vector3D texCoordOffset;
+			float alpha;
+		};
+
+		/**
+		 * Class represents sprite and text batcher. Quads of one frame are sorted by layer and texture,
+		 * transformed on CPU and streamed into dynamic vertex buffer which is orphaned on each upload, so
+		 * driver never waits for previous frame. Each run of quads with the same texture is drawn by one
+		 * draw call - all text glyphs use font atlas texture, so whole text layer is one draw. Quad and
+		 * vertex arrays are reused between frames, so batching does not allocate in steady state.
+		 */
+		class SpriteBatcher : private AyumiUtils::Noncopyable
+		{
+		private:
+			std::vector<SpriteQuad> quads;
+			std::vector<SpriteVertex> vertices;
+			AyumiResource::Shader* batchShader;
+			GLuint vertexArray;
+			GLuint vertexBuffer;
+			GLuint indexBuffer;
+			unsigned int quadCapacity;
+			unsigned int drawAmount;
+
+			void resizeBuffers(const unsigned int capacity);
+			void addQuadVertices(const SpriteQuad& quad);
+
+		public:
+			SpriteBatcher();
+			~SpriteBatcher();
+
+			void initializeSpriteBatcher(AyumiResource::Shader* batchShader);
+			void addSprite(const SpriteLayer layer, AyumiResource::Texture* texture, const AyumiMath::Vector3D& position, const AyumiMath::Vector3D& size, const AyumiMath::Vector3D& texCoordOffset, const float alpha);
+			void recordSprites(const float* projectionMatrix, RenderCommandBuffer& buffer);
+			void clearSprites();
+
+			unsigned int getQuadAmount() const;
+			unsigned int getDrawAmount() const;
+		};
+	}
+}
+#endif
@@ -16,11 +16,12 @@ namespace AyumiEngine
 	namespace AyumiRenderer
 	{
 		/**
-		 * Class default constructor. Create Sprite rendering shader object.
+		 * Class default constructor. Create Sprite rendering shader objects.
 		 */
 		SpriteManager::SpriteManager()
 		{
 			spriteShader = new Shader("Sprite");
+			batchShader = new Shader("SpriteBatch");
 			fontCharset = nullptr;
 		}
 
@@ -34,14 +35,16 @@ namespace AyumiEngine
 			if(fontCharset != nullptr)
 				delete [] fontCharset;
 			delete spriteShader;
+			delete batchShader;
 		}
 
 		/**
-		 * Method is used to initialize SpriteManager. Init sprites rendering shader.
+		 * Method is used to initialize SpriteManager. Init sprites rendering shaders.
 		 */
 		void SpriteManager::initializeSpriteManager()
 		{
-			initializeSpriteShader();
+			initializeSpriteShader(spriteShader,spriteVertexShader,spriteFragmentShader);
+			initializeSpriteShader(batchShader,spriteBatchVertexShader,spriteBatchFragmentShader);
 		}
 
 		/**
@@ -132,22 +135,15 @@ namespace AyumiEngine
 		 */
 		void SpriteManager::createText(const string& name, const string& text, const Vector3D position)
 		{
-			vector<TextElement> chars;
-
-			for(unsigned int i = 0; i < text.length(); ++i)
-			{
-				int asciiNumber = text.at(i);
-				Sprite* charSprite = &fontCharset[asciiNumber];
-				Vector3D charPosition = position;
-				charPosition.setX(charPosition.x() + 32.0f * i);
-				chars.push_back(make_pair(charSprite,charPosition));
-			}
-
-			textCollection.push_back(make_pair(name,chars));
+			textCollection.push_back(Text());
+			textCollection.back().name = name;
+			textCollection.back().position = position;
+			setTextChars(textCollection.back(),text);
 		}
 
 		/**
 		 * Method is used to update text string for example displaying value of debug information, time, scores.
+		 * Text elements are updated in place.
 		 * @param	name is text sprite id.
 		 * @param	text is new text.
 		 */
@@ -155,23 +151,11 @@ namespace AyumiEngine
 		{
 			TextBatch::iterator it = textCollection.begin();
 			for(; it != textCollection.end(); ++it)
-				if((*it).first == name)
+				if((*it).name == name)
 					break;
 
 			if(it != textCollection.end())
-			{
-				vector<TextElement> chars;
-				
-				for(unsigned int i = 0; i < text.length(); ++i)
-				{
-					int asciiNumber = text.at(i);
-					Sprite* charSprite = &fontCharset[asciiNumber];
-					Vector3D charPosition = (*it).second.at(0).second;
-					charPosition.setX(charPosition.x() + 32.0f * i);
-					chars.push_back(make_pair(charSprite,charPosition));
-				}
-				(*it).second = chars;
-			}
+				setTextChars(*it,text);
 		}
 
 		/**
@@ -197,9 +181,9 @@ namespace AyumiEngine
 		 */
 		void SpriteManager::deleteText(const string& name)
 		{
-			TextBatch::const_iterator it = textCollection.begin();
+			TextBatch::iterator it = textCollection.begin();
 			for(; it != textCollection.end(); ++it)
-				if((*it).first == name)
+				if((*it).name == name)
 					break;
 
 			if(it != textCollection.end())
@@ -243,29 +227,56 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method which is used to load and compile sprites rendering shader.
+		 * Accessor to private batch shader member.
+		 * @return	pointer to sprite batch shader.
 		 */
-		void SpriteManager::initializeSpriteShader()
+		Shader* SpriteManager::getBatchShader() const
 		{
-			spriteShader->setVertexPath("null");
-			spriteShader->setFragmentPath("null");
-			spriteShader->createVertexShader();
-			spriteShader->createFragmentShader();
+			return batchShader;
+		}
 
-			const char* vertexShaderSource = spriteVertexShader;
-			const char* fragmentShaderSource = spriteFragmentShader;
+		/**
+		 * Private method which is used to load and compile sprites rendering shader.
+		 * @param	shader is pointer to sprite shader.
+		 * @param	vertexShaderSource is vertex shader source code.
+		 * @param	fragmentShaderSource is fragment shader source code.
+		 */
+		void SpriteManager::initializeSpriteShader(Shader* shader, const char* vertexShaderSource, const char* fragmentShaderSource)
+		{
+			shader->setVertexPath("null");
+			shader->setFragmentPath("null");
+			shader->createVertexShader();
+			shader->createFragmentShader();
 
 			if(vertexShaderSource == nullptr || fragmentShaderSource == nullptr)
 				Logger::getInstance()->saveLog(Log<string>("Sprite shader loading error detected: "));
 		
-			glShaderSource(spriteShader->getShaderVertex(),1,&vertexShaderSource,0);
-			glShaderSource(spriteShader->getShaderFragment(),1,&fragmentShaderSource,0);
-			glCompileShader(spriteShader->getShaderVertex());
-			glCompileShader(spriteShader->getShaderFragment());
-			spriteShader->createShaderProgram();
-			glAttachShader(spriteShader->getShaderProgram(),spriteShader->getShaderVertex());
-			glAttachShader(spriteShader->getShaderProgram(),spriteShader->getShaderFragment());
-			glLinkProgram(spriteShader->getShaderProgram());
+			glShaderSource(shader->getShaderVertex(),1,&vertexShaderSource,0);
+			glShaderSource(shader->getShaderFragment(),1,&fragmentShaderSource,0);
+			glCompileShader(shader->getShaderVertex());
+			glCompileShader(shader->getShaderFragment());
+			shader->createShaderProgram();
+			glAttachShader(shader->getShaderProgram(),shader->getShaderVertex());
+			glAttachShader(shader->getShaderProgram(),shader->getShaderFragment());
+			shader->linkShaderProgram();
+		}
+
+		/**
+		 * Private method which is used to set text chars. Existing text elements are reused, memory is
+		 * allocated only if new text is longer than text capacity.
+		 * @param	text is reference to updated text.
+		 * @param	chars is new text string.
+		 */
+		void SpriteManager::setTextChars(Text& text, const string& chars)
+		{
+			text.chars.resize(chars.length());
+			for(unsigned int i = 0; i < chars.length(); ++i)
+			{
+				const unsigned char asciiNumber = chars[i];
+				text.chars[i].first = &fontCharset[asciiNumber];
+				text.chars[i].second = text.position;
+				text.chars[i].second.setX(text.position.x() + 32.0f * i);
+			}
 		}
 	}
 }
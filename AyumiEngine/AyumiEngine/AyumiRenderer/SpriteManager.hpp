@@ -20,7 +20,18 @@ namespace AyumiEngine
 	namespace AyumiRenderer
 	{
 		typedef std::pair<Sprite*, AyumiMath::Vector3D> TextElement;
-		typedef std::pair<std::string,std::vector<TextElement>> Text;
+
+		/**
+		 * Structure represents text on screen. Text elements are reused when text is updated, so updating
+		 * text which is not longer than before does not allocate memory.
+		 */
+		struct Text
+		{
+			std::string name;
+			AyumiMath::Vector3D position;
+			std::vector<TextElement> chars;
+		};
+
 		typedef std::vector<Text> TextBatch;
 		typedef std::vector<Sprite*> SpriteBatch;
 	
@@ -37,8 +48,10 @@ namespace AyumiEngine
 			TextBatch textCollection;
 			Sprite* fontCharset;
 			AyumiResource::Shader* spriteShader;
+			AyumiResource::Shader* batchShader;
 
-			void initializeSpriteShader();
+			void initializeSpriteShader(AyumiResource::Shader* shader, const char* vertexShaderSource, const char* fragmentShaderSource);
+			void setTextChars(Text& text, const std::string& chars);
 
 		public:
 			SpriteManager();
@@ -60,6 +73,7 @@ namespace AyumiEngine
 		
 			SpriteBatch* getSpriteCollection();
 			TextBatch* getTextCollection();
+			AyumiResource::Shader* getBatchShader() const;
 		};
 	}
 }
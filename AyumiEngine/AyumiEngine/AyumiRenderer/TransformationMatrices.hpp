@@ -26,6 +26,25 @@ namespace AyumiEngine
 			AyumiMath::Matrix4D modelViewMatrix;
 			AyumiMath::Matrix3D normalMatrix;
 			AyumiMath::Matrix4D inverseViewMatrix;
+			AyumiResource::UniformHandle modelHandle;
+			AyumiResource::UniformHandle viewHandle;
+			AyumiResource::UniformHandle modelViewHandle;
+			AyumiResource::UniformHandle projectionHandle;
+			AyumiResource::UniformHandle inverseViewHandle;
+			AyumiResource::UniformHandle normalHandle;
+
+			/**
+			 * Structure default constructor. Calculate uniform handles of matrices once.
+			 */
+			TransformationMatrices()
+			{
+				modelHandle = AyumiResource::Shader::getUniformHandle("modelMatrix");
+				viewHandle = AyumiResource::Shader::getUniformHandle("viewMatrix");
+				modelViewHandle = AyumiResource::Shader::getUniformHandle("modelViewMatrix");
+				projectionHandle = AyumiResource::Shader::getUniformHandle("projectionMatrix");
+				inverseViewHandle = AyumiResource::Shader::getUniformHandle("inverseCameraMatrix");
+				normalHandle = AyumiResource::Shader::getUniformHandle("normalMatrix");
+			}
 
 			void reset()
 			{
@@ -46,17 +65,18 @@ namespace AyumiEngine
 			}
 
 			/**
-			 * Method is used to send matrices data to current shader.
+			 * Method is used to send matrices data to current shader. Unchanged matrices (view, projection)
+			 * are filtered by shader uniform shadow copy.
 			 * @param	shader is pointer to current using shader.
 			 */
 			void sendMatricesData(AyumiResource::Shader* shader)
 			{
-				shader->setUniformMatrix4fv("modelMatrix",modelMatrix.transpose().data());
-				shader->setUniformMatrix4fv("viewMatrix",transpose(viewMatrix).data());
-				shader->setUniformMatrix4fv("modelViewMatrix",modelViewMatrix.transpose().data());
-				shader->setUniformMatrix4fv("projectionMatrix",projectionMatrix.data());
-				shader->setUniformMatrix4fv("inverseCameraMatrix",inverseViewMatrix.data());
-				shader->setUniformMatrix3fv("normalMatrix",normalMatrix.data());
+				shader->setUniformMatrix4fv(modelHandle,transpose(modelMatrix).data());
+				shader->setUniformMatrix4fv(viewHandle,transpose(viewMatrix).data());
+				shader->setUniformMatrix4fv(modelViewHandle,transpose(modelViewMatrix).data());
+				shader->setUniformMatrix4fv(projectionHandle,projectionMatrix.data());
+				shader->setUniformMatrix4fv(inverseViewHandle,inverseViewMatrix.data());
+				shader->setUniformMatrix3fv(normalHandle,normalMatrix.data());
 			}
 		};
 	}
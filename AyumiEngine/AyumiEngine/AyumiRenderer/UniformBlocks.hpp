@@ -0,0 +1,122 @@
+/**
+ * File contains declaration of engine uniform block structures.
+ * @file    UniformBlocks.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-08
+ */
+
+#ifndef UNIFORMBLOCKS_HPP
+#define UNIFORMBLOCKS_HPP
+
+#include "../AyumiResource/Skeleton.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiRenderer
+	{
+		const unsigned int MAX_BLOCK_LIGHTS = 8;
+		const unsigned int MAX_BLOCK_SHADOWS = 8;
+		const unsigned int MAX_BLOCK_CASCADES = 4;
+		const unsigned int MAX_CLUSTER_LIGHTS = 4096;
+
+		/**
+		 * Structure represents CameraData uniform block in std140 layout. It is updated when camera
+		 * matrices change.
+		 */
+		struct CameraBlock
+		{
+			float viewMatrix[16];
+			float projectionMatrix[16];
+			float inverseCameraMatrix[16];
+		};
+
+		/**
+		 * Structure represents directional light in std140 layout.
+		 */
+		struct DirectionalLightBlock
+		{
+			float direction[3];
+			float padding;
+			float ambient[4];
+			float diffuse[4];
+			float specular[4];
+		};
+
+		/**
+		 * Structure represents point light in std140 layout.
+		 */
+		struct PointLightBlock
+		{
+			float position[3];
+			float radius;
+			float ambient[4];
+			float diffuse[4];
+			float specular[4];
+		};
+
+		/**
+		 * Structure represents spot light in std140 layout.
+		 */
+		struct SpotLightBlock
+		{
+			float position[3];
+			float range;
+			float direction[3];
+			float cosInnerCone;
+			float ambient[4];
+			float diffuse[4];
+			float specular[4];
+			float cosOuterCone;
+			float padding[3];
+		};
+
+		/**
+		 * Structure represents LightData uniform block in std140 layout. It is updated once per frame.
+		 * First three components of light amount store amount of directional, point and spot lights.
+		 * Cluster data store screen width, screen height, near and far plane of light clusters.
+		 */
+		struct LightBlock
+		{
+			int lightAmount[4];
+			DirectionalLightBlock directionalLight[MAX_BLOCK_LIGHTS];
+			PointLightBlock pointLight[MAX_BLOCK_LIGHTS];
+			SpotLightBlock spotLight[MAX_BLOCK_LIGHTS];
+			float clusterData[4];
+		};
+
+		/**
+		 * Structure represents ShadowData uniform block in std140 layout. It is updated once per frame.
+		 * Cascade splits store view depth which separate following shadow cascades.
+		 */
+		struct ShadowBlock
+		{
+			float shadowMatrix[MAX_BLOCK_SHADOWS][16];
+			float cascadeMatrix[MAX_BLOCK_CASCADES][16];
+			float cascadeSplits[MAX_BLOCK_CASCADES];
+		};
+
+		/**
+		 * Structure represents ObjectData uniform block in std140 layout. Normal matrix columns are
+		 * padded to four floats. Key frame data store first vertex of current and next frame in key
+		 * frame buffer, interpolation value and fade weight of animated entities, followed by frames of
+		 * cross-faded clip.
+		 */
+		struct ObjectBlock
+		{
+			float modelMatrix[16];
+			float modelViewMatrix[16];
+			float normalMatrix[12];
+			float keyFrameData[8];
+		};
+
+		/**
+		 * Structure represents SkinData uniform block in std140 layout. Skin matrices of skinned entity are
+		 * stored in column-major order, only matrices of skeleton joints are uploaded.
+		 */
+		struct SkinBlock
+		{
+			float skinMatrix[AyumiResource::MAX_SKIN_JOINTS][16];
+		};
+	}
+}
+#endif
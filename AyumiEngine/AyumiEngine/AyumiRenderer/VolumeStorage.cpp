@@ -68,7 +68,7 @@ namespace AyumiEngine
 			shader->createShaderProgram();
 			glAttachShader(shader->getShaderProgram(),shader->getShaderVertex());
 			glAttachShader(shader->getShaderProgram(),shader->getShaderFragment());
-			glLinkProgram(shader->getShaderProgram());
+			shader->linkShaderProgram();
 		}
 
 		/**
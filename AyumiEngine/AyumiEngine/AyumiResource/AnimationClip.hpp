@@ -0,0 +1,34 @@
+/**
+ * File contains declaration of AnimationClip structure.
+ * @file    AnimationClip.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-16
+ */
+
+#ifndef ANIMATIONCLIP_HPP
+#define ANIMATIONCLIP_HPP
+
+#include <string>
+#include <vector>
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Structure represents named range of mesh key frames. Clips are created from MD2 frame names or loaded
+		 * by mesh resource script.
+		 */
+		struct AnimationClip
+		{
+			std::string clipName;
+			int firstFrame;
+			int lastFrame;
+			float framePerSecond;
+			bool isLooped;
+		};
+
+		typedef std::vector<AnimationClip> AnimationClips;
+	}
+}
+#endif
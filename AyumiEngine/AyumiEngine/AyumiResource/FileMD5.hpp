@@ -0,0 +1,51 @@
+/**
+ * File contains declaration of MD5 format loading helper structures and constants.
+ * @file    FileMD5.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-17
+ */
+
+#ifndef FILEMD5
+#define FILEMD5
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Some useful identification tools.
+		 */
+		#define MD5_VERSION 10
+
+		/**
+		 * MD5 mesh vertex: texture coordinates and range of vertex weights.
+		 */
+		typedef struct
+		{
+			float st[2];
+			int startWeight;
+			int countWeight;
+		} md5_vertex_t;
+
+		/**
+		 * MD5 mesh weight: joint, bias and position in joint space.
+		 */
+		typedef struct
+		{
+			int joint;
+			float bias;
+			float pos[3];
+		} md5_weight_t;
+
+		/**
+		 * MD5 animation joint info: parent, animated components flags and index of first component.
+		 */
+		typedef struct
+		{
+			int parent;
+			int flags;
+			int startIndex;
+		} md5_joint_info_t;
+	}
+}
+#endif
@@ -0,0 +1,363 @@
+/**
+ * File contains definition of GeometryHeap class.
+ * @file    GeometryHeap.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-14
+ */
+
+#include "GeometryHeap.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiUtils;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class default constructor. Heap buffers are created in initialization.
+		 */
+		GeometryHeap::GeometryHeap()
+		{
+			vertexBuffer = 0;
+			indexBuffer = 0;
+			vertexArray = 0;
+			vertexCapacity = 0;
+			indexCapacity = 0;
+			defragmentations = 0;
+			heapGrowths = 0;
+		}
+
+		/**
+		 * Class destructor, free heap buffers and vertex array.
+		 */
+		GeometryHeap::~GeometryHeap()
+		{
+			if(vertexArray != 0)
+				glDeleteVertexArrays(1,&vertexArray);
+			if(vertexBuffer != 0)
+				glDeleteBuffers(1,&vertexBuffer);
+			if(indexBuffer != 0)
+				glDeleteBuffers(1,&indexBuffer);
+			allocations.clear();
+			freeHandles.clear();
+		}
+
+		/**
+		 * Method is used to create heap buffers with default capacity and heap vertex array.
+		 */
+		void GeometryHeap::initializeGeometryHeap()
+		{
+			glGenVertexArrays(1,&vertexArray);
+			rebuildHeap(GEOMETRY_HEAP_VERTICES,GEOMETRY_HEAP_INDICES);
+		}
+
+		/**
+		 * Method is used to suballocate mesh in heap and upload mesh data. If there is no free block big enough
+		 * heap is defragmented or, if free space is too small, heap grows.
+		 * @param	mesh is reference to mesh resource.
+		 * @return	allocation handle.
+		 */
+		unsigned int GeometryHeap::allocateGeometry(const Mesh& mesh)
+		{
+			const unsigned int vertexAmount = mesh.getVerticesAmount();
+			const unsigned int indexAmount = mesh.getTrianglesAmount()*3;
+
+			if(getLargestBlock(vertexBlocks) < vertexAmount || getLargestBlock(indexBlocks) < indexAmount)
+			{
+				if(getFreeAmount(vertexBlocks) >= vertexAmount && getFreeAmount(indexBlocks) >= indexAmount)
+					defragmentHeap();
+				else
+				{
+					unsigned int newVertexCapacity = vertexCapacity;
+					unsigned int newIndexCapacity = indexCapacity;
+					while(newVertexCapacity - (vertexCapacity - getFreeAmount(vertexBlocks)) < vertexAmount)
+						newVertexCapacity *= 2;
+					while(newIndexCapacity - (indexCapacity - getFreeAmount(indexBlocks)) < indexAmount)
+						newIndexCapacity *= 2;
+					heapGrowths++;
+					rebuildHeap(newVertexCapacity,newIndexCapacity);
+				}
+			}
+
+			GeometryAllocation allocation;
+			allocation.vertexAmount = vertexAmount;
+			allocation.indexAmount = indexAmount;
+			allocation.isUsed = true;
+			allocateBlock(vertexBlocks,vertexAmount,allocation.vertexFirst);
+			allocateBlock(indexBlocks,indexAmount,allocation.indexFirst);
+
+			unsigned int handle = allocations.size();
+			if(freeHandles.empty())
+				allocations.push_back(allocation);
+			else
+			{
+				handle = freeHandles.back();
+				freeHandles.pop_back();
+				allocations[handle] = allocation;
+			}
+
+			updateGeometry(handle,mesh);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,indexBuffer);
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER,allocation.indexFirst*sizeof(unsigned int),indexAmount*sizeof(unsigned int),mesh.getIndices());
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
+			return handle;
+		}
+
+		/**
+		 * Method is used to release mesh allocation. Freed blocks are merged with neighbour free blocks.
+		 * @param	handle is allocation handle.
+		 */
+		void GeometryHeap::releaseGeometry(const unsigned int handle)
+		{
+			GeometryAllocation& allocation = allocations[handle];
+			if(!allocation.isUsed)
+				return;
+
+			releaseBlock(vertexBlocks,allocation.vertexFirst,allocation.vertexAmount);
+			releaseBlock(indexBlocks,allocation.indexFirst,allocation.indexAmount);
+			allocation.isUsed = false;
+			freeHandles.push_back(handle);
+		}
+
+		/**
+		 * Method is used to upload modified mesh vertices to mesh allocation. Amount of vertices must not change.
+		 * @param	handle is allocation handle.
+		 * @param	mesh is reference to modified mesh resource.
+		 */
+		void GeometryHeap::updateGeometry(const unsigned int handle, const Mesh& mesh)
+		{
+			const GeometryAllocation& allocation = allocations[handle];
+			glBindBuffer(GL_ARRAY_BUFFER,vertexBuffer);
+			glBufferSubData(GL_ARRAY_BUFFER,allocation.vertexFirst*sizeof(Vertex<>),allocation.vertexAmount*sizeof(Vertex<>),mesh.getVertices());
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Method is used to defragment heap. Allocations are packed at the beginning of buffers, so all free
+		 * space is one block.
+		 */
+		void GeometryHeap::defragmentHeap()
+		{
+			defragmentations++;
+			rebuildHeap(vertexCapacity,indexCapacity);
+		}
+
+		/**
+		 * Accessor to mesh allocation.
+		 * @param	handle is allocation handle.
+		 * @return	reference to allocation.
+		 */
+		const GeometryAllocation& GeometryHeap::getAllocation(const unsigned int handle) const
+		{
+			return allocations[handle];
+		}
+
+		/**
+		 * Accessor to private heap vertex array member.
+		 * @return	vertex array object id.
+		 */
+		GLuint GeometryHeap::getVertexArray() const
+		{
+			return vertexArray;
+		}
+
+		/**
+		 * Method is used to get heap utilisation and fragmentation statistics.
+		 * @return	heap statistics.
+		 */
+		GeometryHeapStatistics GeometryHeap::getHeapStatistics() const
+		{
+			GeometryHeapStatistics statistics;
+			statistics.allocationAmount = allocations.size() - freeHandles.size();
+			statistics.vertexCapacity = vertexCapacity;
+			statistics.usedVertices = vertexCapacity - getFreeAmount(vertexBlocks);
+			statistics.vertexFreeBlocks = vertexBlocks.size();
+			statistics.largestVertexBlock = getLargestBlock(vertexBlocks);
+			statistics.indexCapacity = indexCapacity;
+			statistics.usedIndices = indexCapacity - getFreeAmount(indexBlocks);
+			statistics.indexFreeBlocks = indexBlocks.size();
+			statistics.largestIndexBlock = getLargestBlock(indexBlocks);
+			statistics.defragmentations = defragmentations;
+			statistics.heapGrowths = heapGrowths;
+
+			const unsigned int freeVertices = vertexCapacity - statistics.usedVertices;
+			const unsigned int freeIndices = indexCapacity - statistics.usedIndices;
+			statistics.vertexUtilisation = vertexCapacity > 0 ? static_cast<float>(statistics.usedVertices) / vertexCapacity : 0.0f;
+			statistics.indexUtilisation = indexCapacity > 0 ? static_cast<float>(statistics.usedIndices) / indexCapacity : 0.0f;
+			statistics.vertexFragmentation = freeVertices > 0 ? 1.0f - static_cast<float>(statistics.largestVertexBlock) / freeVertices : 0.0f;
+			statistics.indexFragmentation = freeIndices > 0 ? 1.0f - static_cast<float>(statistics.largestIndexBlock) / freeIndices : 0.0f;
+			return statistics;
+		}
+
+		/**
+		 * Private method which is used to allocate range from free blocks. First block big enough is used.
+		 * @param	blocks is reference to free blocks sorted by offset.
+		 * @param	amount is size of range.
+		 * @param	first is reference to first element of allocated range.
+		 * @return	true if range was allocated.
+		 */
+		bool GeometryHeap::allocateBlock(HeapBlocks& blocks, const unsigned int amount, unsigned int& first)
+		{
+			for(HeapBlocks::iterator it = blocks.begin(); it != blocks.end(); ++it)
+			{
+				if((*it).amount < amount)
+					continue;
+
+				first = (*it).first;
+				(*it).first += amount;
+				(*it).amount -= amount;
+				if((*it).amount == 0)
+					blocks.erase(it);
+				return true;
+			}
+
+			Logger::getInstance()->saveLog(Log<string>("Geometry heap allocation error occurred!"));
+			first = 0;
+			return false;
+		}
+
+		/**
+		 * Private method which is used to return range to free blocks. Range is merged with adjacent blocks.
+		 * @param	blocks is reference to free blocks sorted by offset.
+		 * @param	first is first element of released range.
+		 * @param	amount is size of released range.
+		 */
+		void GeometryHeap::releaseBlock(HeapBlocks& blocks, const unsigned int first, const unsigned int amount)
+		{
+			if(amount == 0)
+				return;
+
+			HeapBlocks::iterator it = blocks.begin();
+			while(it != blocks.end() && (*it).first < first)
+				++it;
+
+			HeapBlock block = {first,amount};
+			it = blocks.insert(it,block);
+
+			HeapBlocks::iterator next = it + 1;
+			if(next != blocks.end() && (*it).first + (*it).amount == (*next).first)
+			{
+				(*it).amount += (*next).amount;
+				blocks.erase(next);
+			}
+
+			if(it != blocks.begin())
+			{
+				HeapBlocks::iterator previous = it - 1;
+				if((*previous).first + (*previous).amount == (*it).first)
+				{
+					(*previous).amount += (*it).amount;
+					blocks.erase(it);
+				}
+			}
+		}
+
+		/**
+		 * Private method which is used to get amount of free elements.
+		 * @param	blocks is reference to free blocks.
+		 * @return	amount of free elements.
+		 */
+		unsigned int GeometryHeap::getFreeAmount(const HeapBlocks& blocks) const
+		{
+			unsigned int amount = 0;
+			for(HeapBlocks::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+				amount += (*it).amount;
+			return amount;
+		}
+
+		/**
+		 * Private method which is used to get size of the largest free block.
+		 * @param	blocks is reference to free blocks.
+		 * @return	size of the largest block.
+		 */
+		unsigned int GeometryHeap::getLargestBlock(const HeapBlocks& blocks) const
+		{
+			unsigned int amount = 0;
+			for(HeapBlocks::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+				if((*it).amount > amount)
+					amount = (*it).amount;
+			return amount;
+		}
+
+		/**
+		 * Private method which is used to rebuild heap buffers with new capacity. Used allocations are copied on
+		 * GPU to the beginning of new buffers in offset order, rest of buffers is one free block.
+		 * @param	vertexCapacity is new capacity of vertex buffer.
+		 * @param	indexCapacity is new capacity of index buffer.
+		 */
+		void GeometryHeap::rebuildHeap(const unsigned int vertexCapacity, const unsigned int indexCapacity)
+		{
+			GLuint buffers[2];
+			glGenBuffers(2,buffers);
+			glBindBuffer(GL_COPY_WRITE_BUFFER,buffers[0]);
+			glBufferData(GL_COPY_WRITE_BUFFER,vertexCapacity*sizeof(Vertex<>),NULL,GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER,buffers[1]);
+			glBufferData(GL_COPY_WRITE_BUFFER,indexCapacity*sizeof(unsigned int),NULL,GL_STATIC_DRAW);
+
+			vector<unsigned int> order;
+			for(unsigned int i = 0; i < allocations.size(); ++i)
+				if(allocations[i].isUsed)
+					order.push_back(i);
+			for(unsigned int i = 1; i < order.size(); ++i)
+				for(unsigned int j = i; j > 0 && allocations[order[j]].vertexFirst < allocations[order[j-1]].vertexFirst; --j)
+					swap(order[j],order[j-1]);
+
+			unsigned int vertexCursor = 0;
+			unsigned int indexCursor = 0;
+			for(vector<unsigned int>::const_iterator it = order.begin(); it != order.end(); ++it)
+			{
+				GeometryAllocation& allocation = allocations[(*it)];
+				glBindBuffer(GL_COPY_READ_BUFFER,vertexBuffer);
+				glBindBuffer(GL_COPY_WRITE_BUFFER,buffers[0]);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER,GL_COPY_WRITE_BUFFER,allocation.vertexFirst*sizeof(Vertex<>),vertexCursor*sizeof(Vertex<>),allocation.vertexAmount*sizeof(Vertex<>));
+				glBindBuffer(GL_COPY_READ_BUFFER,indexBuffer);
+				glBindBuffer(GL_COPY_WRITE_BUFFER,buffers[1]);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER,GL_COPY_WRITE_BUFFER,allocation.indexFirst*sizeof(unsigned int),indexCursor*sizeof(unsigned int),allocation.indexAmount*sizeof(unsigned int));
+
+				allocation.vertexFirst = vertexCursor;
+				allocation.indexFirst = indexCursor;
+				vertexCursor += allocation.vertexAmount;
+				indexCursor += allocation.indexAmount;
+			}
+			glBindBuffer(GL_COPY_READ_BUFFER,0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER,0);
+
+			if(vertexBuffer != 0)
+				glDeleteBuffers(1,&vertexBuffer);
+			if(indexBuffer != 0)
+				glDeleteBuffers(1,&indexBuffer);
+			vertexBuffer = buffers[0];
+			indexBuffer = buffers[1];
+			this->vertexCapacity = vertexCapacity;
+			this->indexCapacity = indexCapacity;
+
+			vertexBlocks.clear();
+			indexBlocks.clear();
+			releaseBlock(vertexBlocks,vertexCursor,vertexCapacity - vertexCursor);
+			releaseBlock(indexBlocks,indexCursor,indexCapacity - indexCursor);
+			configureVertexArray();
+		}
+
+		/**
+		 * Private method which is used to configure heap vertex array. Engine vertex attributes use fixed locations
+		 * bound before shader program link.
+		 */
+		void GeometryHeap::configureVertexArray()
+		{
+			glBindVertexArray(vertexArray);
+			glBindBuffer(GL_ARRAY_BUFFER,vertexBuffer);
+			glVertexAttribPointer(VERTEX_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + 0);
+			glVertexAttribPointer(NORMAL_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*3);
+			glVertexAttribPointer(TEXCOORD_ATTRIBUTE,2,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*6);
+			glVertexAttribPointer(TANGENT_ATTRIBUTE,4,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*8);
+			glEnableVertexAttribArray(VERTEX_ATTRIBUTE);
+			glEnableVertexAttribArray(NORMAL_ATTRIBUTE);
+			glEnableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+			glEnableVertexAttribArray(TANGENT_ATTRIBUTE);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,indexBuffer);
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/**
+ * File contains declaration of GeometryHeap class.
+ * @file    GeometryHeap.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-14
+ */
+
+#ifndef GEOMETRYHEAP_HPP
+#define GEOMETRYHEAP_HPP
+
+#include <vector>
+#include <GL/glew.h>
+
+#include "Mesh.hpp"
+#include "ShaderUniform.hpp"
+#include "../Logger.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int GEOMETRY_HEAP_VERTICES = 262144;
+		const unsigned int GEOMETRY_HEAP_INDICES = 786432;
+
+		/**
+		 * Structure represents free range of geometry heap buffer. Range is described in vertices or indices.
+		 */
+		struct HeapBlock
+		{
+			unsigned int first;
+			unsigned int amount;
+		};
+
+		typedef std::vector<HeapBlock> HeapBlocks;
+
+		/**
+		 * Structure represents mesh suballocation in geometry heap. Indices are stored unchanged, so draw
+		 * commands use first vertex as base vertex.
+		 */
+		struct GeometryAllocation
+		{
+			unsigned int vertexFirst;
+			unsigned int vertexAmount;
+			unsigned int indexFirst;
+			unsigned int indexAmount;
+			bool isUsed;
+		};
+
+		/**
+		 * Structure represents geometry heap statistics: utilisation and fragmentation of vertex and index
+		 * buffers. Fragmentation is part of free space which is not in the largest free block.
+		 */
+		struct GeometryHeapStatistics
+		{
+			unsigned int allocationAmount;
+			unsigned int vertexCapacity;
+			unsigned int usedVertices;
+			unsigned int vertexFreeBlocks;
+			unsigned int largestVertexBlock;
+			unsigned int indexCapacity;
+			unsigned int usedIndices;
+			unsigned int indexFreeBlocks;
+			unsigned int largestIndexBlock;
+			unsigned int defragmentations;
+			unsigned int heapGrowths;
+			float vertexUtilisation;
+			float indexUtilisation;
+			float vertexFragmentation;
+			float indexFragmentation;
+		};
+
+		/**
+		 * Class represents geometry heap - one large vertex buffer and one large index buffer which static meshes
+		 * are suballocated into by first-fit free-list allocator. All meshes share one vertex format, so heap use
+		 * one vertex array with fixed attribute locations and draws only differ by index offset and base vertex.
+		 * When free space is too fragmented heap is defragmented, when it is too small heap grows. Both operations
+		 * rebuild buffers by copying allocations on GPU, allocation handles stay valid.
+		 */
+		class GeometryHeap : private AyumiUtils::Noncopyable
+		{
+		private:
+			GLuint vertexBuffer;
+			GLuint indexBuffer;
+			GLuint vertexArray;
+			unsigned int vertexCapacity;
+			unsigned int indexCapacity;
+			HeapBlocks vertexBlocks;
+			HeapBlocks indexBlocks;
+			std::vector<GeometryAllocation> allocations;
+			std::vector<unsigned int> freeHandles;
+			unsigned int defragmentations;
+			unsigned int heapGrowths;
+
+			bool allocateBlock(HeapBlocks& blocks, const unsigned int amount, unsigned int& first);
+			void releaseBlock(HeapBlocks& blocks, const unsigned int first, const unsigned int amount);
+			unsigned int getFreeAmount(const HeapBlocks& blocks) const;
+			unsigned int getLargestBlock(const HeapBlocks& blocks) const;
+			void rebuildHeap(const unsigned int vertexCapacity, const unsigned int indexCapacity);
+			void configureVertexArray();
+
+		public:
+			GeometryHeap();
+			~GeometryHeap();
+
+			void initializeGeometryHeap();
+			unsigned int allocateGeometry(const Mesh& mesh);
+			void releaseGeometry(const unsigned int handle);
+			void updateGeometry(const unsigned int handle, const Mesh& mesh);
+			void defragmentHeap();
+
+			const GeometryAllocation& getAllocation(const unsigned int handle) const;
+			GLuint getVertexArray() const;
+			GeometryHeapStatistics getHeapStatistics() const;
+		};
+	}
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include "Mesh.hpp"
 #include <iostream>
+#include <algorithm>
 using namespace AyumiEngine::AyumiUtils;
 using namespace AyumiEngine::AyumiMath;
 
@@ -28,6 +29,7 @@ namespace AyumiEngine
 			verticesAmount = 0;
 			trianglesAmount = 0;
 			componentMesh = false;
+			componentAmount = 1;
 		}
 
 		/**
@@ -46,6 +48,7 @@ namespace AyumiEngine
 			verticesAmount = 0;
 			trianglesAmount = 0;
 			componentMesh = false;
+			componentAmount = 1;
 		}
 
 		/**
@@ -61,6 +64,9 @@ namespace AyumiEngine
 			trianglesAmount = mesh.trianglesAmount;
 			vertices = mesh.vertices;
 			indices = mesh.indices;
+			componentAmount = mesh.componentAmount;
+			animationClips = mesh.animationClips;
+			skeleton = mesh.skeleton;
 		}
 
 		/**
@@ -293,6 +299,55 @@ namespace AyumiEngine
 			return componentMesh;
 		}
 
+		/**
+		 * Accessor to private component amount member.
+		 * @return	amount of component meshes in mesh array, 1 for single mesh.
+		 */
+		int Mesh::getComponentAmount() const
+		{
+			return componentAmount;
+		}
+
+		/**
+		 * Accessor to private animation clips member.
+		 * @return	reference to animation clips of key frame mesh.
+		 */
+		const AnimationClips& Mesh::getAnimationClips() const
+		{
+			return animationClips;
+		}
+
+		/**
+		 * Method is used to find animation clip by name.
+		 * @param	clipName is animation clip name.
+		 * @return	pointer to animation clip or nullptr if mesh does not have such clip.
+		 */
+		const AnimationClip* Mesh::getAnimationClip(const std::string& clipName) const
+		{
+			for(AnimationClips::const_iterator it = animationClips.begin(); it != animationClips.end(); ++it)
+				if(it->clipName == clipName)
+					return &(*it);
+			return nullptr;
+		}
+
+		/**
+		 * Accessor to private skeleton member.
+		 * @return	pointer to mesh skeleton or nullptr if mesh is not skinned.
+		 */
+		Skeleton* Mesh::getSkeleton() const
+		{
+			return skeleton.get();
+		}
+
+		/**
+		 * Method is used to check if mesh has skeleton.
+		 * @return	true if mesh is skinned mesh.
+		 */
+		bool Mesh::isSkinnedMesh() const
+		{
+			return skeleton.get() != nullptr;
+		}
+
 		/**
 		 * Setter of mesh indices array element.
 		 * @param	arrayIndex is indieces array index.
@@ -335,10 +390,44 @@ namespace AyumiEngine
 
 		/**
 		 * Method is used to set mesh as component mesh. Part of something bigger.
+		 * @param	componentAmount is amount of component meshes in mesh array.
 		 */
-		void Mesh::setAsComponentMesh()
+		void Mesh::setAsComponentMesh(const int componentAmount)
 		{
 			componentMesh = true;
+			this->componentAmount = componentAmount;
+		}
+
+		/**
+		 * Method is used to add animation clip to key frame mesh. Clip with the same name is replaced and
+		 * frame range is clamped to mesh frames.
+		 * @param	clip is reference to new animation clip.
+		 */
+		void Mesh::addAnimationClip(const AnimationClip& clip)
+		{
+			AnimationClip newClip = clip;
+			newClip.firstFrame = std::min(std::max(newClip.firstFrame,0),componentAmount - 1);
+			newClip.lastFrame = std::min(std::max(newClip.lastFrame,newClip.firstFrame),componentAmount - 1);
+			newClip.framePerSecond = std::max(newClip.framePerSecond,0.001f);
+
+			for(AnimationClips::iterator it = animationClips.begin(); it != animationClips.end(); ++it)
+			{
+				if(it->clipName == newClip.clipName)
+				{
+					*it = newClip;
+					return;
+				}
+			}
+			animationClips.push_back(newClip);
+		}
+
+		/**
+		 * Method is used to set skeleton of skinned mesh.
+		 * @param	skeleton is shared pointer to skeleton.
+		 */
+		void Mesh::setSkeleton(SkeletonResource skeleton)
+		{
+			this->skeleton = skeleton;
 		}
 	}
 }
@@ -9,6 +9,8 @@
 #define MESH_HPP
 
 #include "Resource.hpp"
+#include "AnimationClip.hpp"
+#include "Skeleton.hpp"
 #include "../AyumiUtils/Vertex.hpp"
 #include "../AyumiMath/CommonMath.hpp"
 
@@ -23,6 +25,9 @@ namespace AyumiEngine
 		 * arrays of data, and also can calculate some necessary data like normals and tangents from
 		 * vertices and indices. It is also used to calculate Bounding Volumes. Mesh resource store
 		 * data in special Vertex<> structure.
+		 * Key frame meshes are arrays of component meshes - one for each frame. First component store
+		 * amount of frames and animation clips of whole array. Skinned meshes store bind pose vertices and
+		 * shared skeleton with joint influences and skeletal animations.
 		 */
 		class Mesh : public Resource
 		{
@@ -32,6 +37,9 @@ namespace AyumiEngine
 			int verticesAmount;
 			int trianglesAmount;
 			bool componentMesh;
+			int componentAmount;
+			AnimationClips animationClips;
+			SkeletonResource skeleton;
 		public:
 			Mesh();
 			Mesh(const Mesh& resource);
@@ -52,12 +60,19 @@ namespace AyumiEngine
 			int getVerticesAmount() const;
 			int getTrianglesAmount() const;
 			bool isComponentMesh() const;
+			int getComponentAmount() const;
+			const AnimationClips& getAnimationClips() const;
+			const AnimationClip* getAnimationClip(const std::string& clipName) const;
+			Skeleton* getSkeleton() const;
+			bool isSkinnedMesh() const;
 
 			void setIndex(const int arrayIndex, const unsigned int index);
 			void setVerticesAmount(const int verticesAmount);
 			void setTrianglesAmount(const int trianglesAmount);
 			void setResourceData(const char* name, const char* filePath);
-			void setAsComponentMesh();
+			void setAsComponentMesh(const int componentAmount);
+			void addAnimationClip(const AnimationClip& clip);
+			void setSkeleton(SkeletonResource skeleton);
 		};
 	}
 }
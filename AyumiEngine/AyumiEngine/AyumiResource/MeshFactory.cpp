@@ -5,6 +5,9 @@
  * @date    2011-08-10
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include "MeshFactory.hpp"
 
 using namespace std;
@@ -56,6 +59,8 @@ namespace AyumiEngine
 				meshResource = create3dsMesh(name,path);
 			else if(type == "MESH_MD2")
 				meshResource = createMD2Mesh(name,path);
+			else if(type == "MESH_MD5")
+				meshResource = createMD5Mesh(name,path);
 			else if(type == "RAW")
 				meshResource = createRawMesh(name,path);
 			else if(type == "PROCEDURAL")
@@ -341,7 +346,8 @@ namespace AyumiEngine
 
 		/**
 		 * Method is used to load and create *md2 binary format, one of Engine format. It was used in
-		 * Quake 2 for keyframe animation.
+		 * Quake 2 for keyframe animation. Each frame is stored as component mesh, animation clips are created
+		 * from frame names.
 		 * @param	name is resource name.
 		 * @param	path is resource file path.
 		 * @return	loaded and created mesh resource, or nullptr when and logger error type is
@@ -349,7 +355,7 @@ namespace AyumiEngine
 		 */
 		Mesh* MeshFactory::createMD2Mesh(const string& name, const string& path)
 		{
-			Mesh* meshResource = new Mesh[198];
+			Mesh* meshResource = nullptr;
 
 			md2_header_t m_kHeader;
 			md2_texCoord_t* m_pTexCoords;
@@ -362,10 +368,10 @@ namespace AyumiEngine
 			if(meshFile.is_open())
 			{
 				meshFile.read(reinterpret_cast<char*>(&m_kHeader),sizeof(md2_header_t));
-				if((m_kHeader.version != MD2_VERSION) || m_kHeader.ident != MD2_IDENT )
+				if((m_kHeader.version != MD2_VERSION) || m_kHeader.ident != MD2_IDENT || m_kHeader.num_frames <= 0)
 				{
 					Logger::getInstance()->saveLog(Log<string>("MD2 mesh file wrong version/identification!"));	
-					return meshResource;
+					return new Mesh();
 				}
 
 				m_pTexCoords = new md2_texCoord_t[m_kHeader.num_st];
@@ -390,18 +396,22 @@ namespace AyumiEngine
 
 			}
 			else
+			{
 				Logger::getInstance()->saveLog(Log<string>("Md2 mesh file opening error occurred!"));	
+				return new Mesh();
+			}
 				
 			meshFile.close();
+			meshResource = new Mesh[m_kHeader.num_frames];
 
-			for(int i = 0; i <198; ++i)
+			for(int i = 0; i < m_kHeader.num_frames; ++i)
 			{
 				md2_frame_t* frame = &m_pFrames[i];
 
 				meshResource[i].setVerticesAmount(m_kHeader.num_vertices);
 				meshResource[i].setTrianglesAmount(m_kHeader.num_tris);
 				meshResource[i].initializeDataArrays();
-				meshResource[i].setAsComponentMesh();
+				meshResource[i].setAsComponentMesh(m_kHeader.num_frames);
 				for(int j = 0; j <  m_kHeader.num_vertices; ++j)
 				{
 					vec3_t v;
@@ -469,6 +479,8 @@ namespace AyumiEngine
 				meshResource[i].calculateTangent();
 			}
 
+			createMD2Clips(meshResource,m_pFrames,m_kHeader.num_frames);
+
 			for( int i = 0; i < m_kHeader.num_frames; i++ )
 				delete [] m_pFrames[i].verts;
 
@@ -479,6 +491,53 @@ namespace AyumiEngine
 			return meshResource;
 		}
 
+		/**
+		 * Private method which is used to create animation clips of MD2 mesh from frame names. Frames are named
+		 * by animation and frame number (stand01, run1, pain101), so following frames with the same name and
+		 * next number belong to one clip. Repeated names get clip number suffix (pain, pain2, pain3).
+		 * @param	meshResource is pointer to first component mesh.
+		 * @param	frames is pointer to MD2 frames.
+		 * @param	frameAmount is amount of MD2 frames.
+		 */
+		void MeshFactory::createMD2Clips(Mesh* meshResource, const md2_frame_t* frames, const int frameAmount)
+		{
+			string previousName;
+			int previousNumber = -1;
+			AnimationClip clip;
+			clip.firstFrame = 0;
+			clip.lastFrame = -1;
+			clip.framePerSecond = MD2_CLIP_FRAME_RATE;
+			clip.isLooped = true;
+
+			for(int i = 0; i <= frameAmount; ++i)
+			{
+				string frameName;
+				int frameNumber = -1;
+				if(i < frameAmount)
+				{
+					frameName = string(frames[i].name,strnlen(frames[i].name,16));
+					const size_t digits = frameName.find_last_not_of("0123456789") + 1;
+					if(digits < frameName.size())
+						frameNumber = atoi(frameName.c_str() + digits);
+					frameName.erase(digits);
+				}
+
+				const bool isNextFrame = frameName == previousName && (frameNumber < 0 || frameNumber == previousNumber + 1);
+				if(i > 0 && (i == frameAmount || !isNextFrame))
+				{
+					const string clipName = previousName.empty() ? "frames" : previousName;
+					clip.clipName = clipName;
+					for(int j = 2; meshResource->getAnimationClip(clip.clipName) != nullptr; ++j)
+						clip.clipName = clipName + boost::lexical_cast<string>(j);
+					clip.lastFrame = i - 1;
+					meshResource->addAnimationClip(clip);
+					clip.firstFrame = i;
+				}
+				previousName = frameName;
+				previousNumber = frameNumber;
+			}
+		}
+
 		/**
 		 * Method is used to load and create *md3 binary format, one of Engine format. It was used in
 		 * Quake 3 for keyframe animation.
@@ -493,16 +552,385 @@ namespace AyumiEngine
 		}
 		
 		/**
-		 * Method is used to load and create *md5 binary format, one of Engine format. It was used in
-		 * Quake 4/Doom3 for skeletal animation.
+		 * Method is used to load and create *md5mesh text format, one of Engine format. It was used in
+		 * Quake 4/Doom3 for skeletal animation. All sub meshes are merged into one skinned mesh, bind pose
+		 * vertices are calculated from joint weights. Only four strongest weights of each vertex are kept.
 		 * @param	name is resource name.
 		 * @param	path is resource file path.
-		 * @return	loaded and created mesh resource, or nullptr when and logger error type is
-		 *			not supported.
+		 * @return	loaded and created mesh resource, or empty mesh when file can not be loaded.
 		 */
 		Mesh* MeshFactory::createMD5Mesh(const string& name, const string& path)
 		{
-			return nullptr;
+			stringstream meshFile;
+			if(!readMD5File(path,meshFile))
+			{
+				Logger::getInstance()->saveLog(Log<string>("MD5 mesh file opening error occurred!"));
+				return new Mesh();
+			}
+
+			SkeletonResource skeleton(new Skeleton());
+			vector<Vertex<>> vertices;
+			vector<VertexInfluence> influences;
+			vector<unsigned int> indices;
+			string token;
+			int integerData = 0;
+			int jointAmount = 0;
+
+			while(meshFile >> token)
+			{
+				if(token == "MD5Version")
+				{
+					meshFile >> integerData;
+					if(integerData != MD5_VERSION)
+					{
+						Logger::getInstance()->saveLog(Log<string>("MD5 mesh file wrong version!"));
+						return new Mesh();
+					}
+				}
+				else if(token == "commandline")
+					readMD5String(meshFile);
+				else if(token == "numJoints")
+					meshFile >> jointAmount;
+				else if(token == "joints")
+				{
+					meshFile >> token;
+					for(int i = 0; i < jointAmount; ++i)
+					{
+						JointPose pose;
+						const string jointName = readMD5String(meshFile);
+						meshFile >> integerData >> token >> pose.position[0] >> pose.position[1] >> pose.position[2] >> token;
+						meshFile >> token >> pose.orientation[0] >> pose.orientation[1] >> pose.orientation[2] >> token;
+						computeMD5Orientation(pose.orientation);
+						skeleton->addJoint(jointName,integerData,pose);
+					}
+					meshFile >> token;
+				}
+				else if(token == "mesh")
+					readMD5SubMesh(meshFile,*skeleton,vertices,influences,indices);
+			}
+
+			if(vertices.empty() || indices.empty() || skeleton->getJointAmount() == 0 || skeleton->getJointAmount() > MAX_SKIN_JOINTS)
+			{
+				Logger::getInstance()->saveLog(Log<string>("MD5 mesh file reading error occurred!"));
+				return new Mesh();
+			}
+
+			Mesh* meshResource = new Mesh(name.c_str(),path.c_str());
+			meshResource->setVerticesAmount(vertices.size());
+			meshResource->setTrianglesAmount(indices.size()/3);
+			meshResource->initializeDataArrays();
+			copy(vertices.begin(),vertices.end(),meshResource->getVertices());
+			for(unsigned int i = 0; i < indices.size(); ++i)
+				meshResource->setIndex(i,indices[i]);
+			meshResource->calculateNormals();
+			meshResource->calculateTangent();
+
+			skeleton->setInfluences(influences);
+			meshResource->setSkeleton(skeleton);
+			return meshResource;
+		}
+
+		/**
+		 * Method is used to load *md5anim text format and add it as skeletal animation of skinned mesh.
+		 * Animation joints must match mesh skeleton. Animated components of each frame override base frame.
+		 * @param	meshResource is pointer to skinned mesh.
+		 * @param	animationName is name of new animation.
+		 * @param	path is animation file path.
+		 * @return	true if animation was loaded.
+		 */
+		bool MeshFactory::loadMD5Animation(Mesh* meshResource, const string& animationName, const string& path)
+		{
+			Skeleton* skeleton = meshResource->getSkeleton();
+			stringstream animationFile;
+			if(skeleton == nullptr || !readMD5File(path,animationFile))
+			{
+				Logger::getInstance()->saveLog(Log<string>("MD5 animation file opening error occurred!"));
+				return false;
+			}
+
+			SkeletalAnimation animation;
+			animation.animationName = animationName;
+			animation.frameRate = 24.0f;
+			animation.frameAmount = 0;
+
+			vector<md5_joint_info_t> jointInfos;
+			SkeletonPose baseFrame;
+			vector<float> components;
+			string token;
+			int integerData = 0;
+			unsigned int jointAmount = 0;
+			unsigned int loadedFrames = 0;
+
+			while(animationFile >> token)
+			{
+				if(token == "MD5Version")
+				{
+					animationFile >> integerData;
+					if(integerData != MD5_VERSION)
+					{
+						Logger::getInstance()->saveLog(Log<string>("MD5 animation file wrong version!"));
+						return false;
+					}
+				}
+				else if(token == "commandline")
+					readMD5String(animationFile);
+				else if(token == "numFrames")
+					animationFile >> animation.frameAmount;
+				else if(token == "numJoints")
+				{
+					animationFile >> jointAmount;
+					if(jointAmount != skeleton->getJointAmount())
+					{
+						Logger::getInstance()->saveLog(Log<string>("MD5 animation does not match mesh skeleton: " + animationName));
+						return false;
+					}
+				}
+				else if(token == "frameRate")
+					animationFile >> animation.frameRate;
+				else if(token == "numAnimatedComponents")
+				{
+					animationFile >> integerData;
+					components.resize(max(integerData,0));
+				}
+				else if(token == "hierarchy")
+				{
+					animationFile >> token;
+					jointInfos.resize(jointAmount);
+					for(unsigned int i = 0; i < jointAmount; ++i)
+					{
+						const string jointName = readMD5String(animationFile);
+						animationFile >> jointInfos[i].parent >> jointInfos[i].flags >> jointInfos[i].startIndex;
+						if(jointName != skeleton->getJoint(i).jointName)
+						{
+							Logger::getInstance()->saveLog(Log<string>("MD5 animation does not match mesh skeleton: " + animationName));
+							return false;
+						}
+					}
+					animationFile >> token;
+				}
+				else if(token == "bounds")
+				{
+					while(animationFile >> token && token != "}");
+				}
+				else if(token == "baseframe")
+				{
+					animationFile >> token;
+					baseFrame.resize(jointAmount);
+					for(unsigned int i = 0; i < jointAmount; ++i)
+					{
+						JointPose& pose = baseFrame[i];
+						animationFile >> token >> pose.position[0] >> pose.position[1] >> pose.position[2] >> token;
+						animationFile >> token >> pose.orientation[0] >> pose.orientation[1] >> pose.orientation[2] >> token;
+					}
+					animationFile >> token;
+				}
+				else if(token == "frame")
+				{
+					animationFile >> integerData >> token;
+					for(unsigned int i = 0; i < components.size(); ++i)
+						animationFile >> components[i];
+					animationFile >> token;
+
+					if(integerData < 0 || static_cast<unsigned int>(integerData) >= animation.frameAmount || baseFrame.size() != jointAmount || jointInfos.size() != jointAmount)
+						continue;
+					animation.framePoses.resize(animation.frameAmount*jointAmount);
+					for(unsigned int i = 0; i < jointAmount; ++i)
+					{
+						JointPose pose = baseFrame[i];
+						int component = jointInfos[i].startIndex;
+						for(unsigned int j = 0; j < 6; ++j)
+						{
+							if(!(jointInfos[i].flags & (1 << j)) || component < 0 || component >= static_cast<int>(components.size()))
+								continue;
+							if(j < 3)
+								pose.position[j] = components[component++];
+							else
+								pose.orientation[j - 3] = components[component++];
+						}
+						computeMD5Orientation(pose.orientation);
+						animation.framePoses[integerData*jointAmount + i] = pose;
+					}
+					loadedFrames++;
+				}
+			}
+
+			if(animation.frameAmount == 0 || loadedFrames < animation.frameAmount || animation.frameRate <= 0.0f)
+			{
+				Logger::getInstance()->saveLog(Log<string>("MD5 animation file reading error occurred: " + animationName));
+				return false;
+			}
+			skeleton->addAnimation(animation);
+			return true;
+		}
+
+		/**
+		 * Private method which is used to read MD5 file into memory without comments. Doom 3 files end joint
+		 * and hierarchy lines with // comments, so text from // to end of line is skipped when it is not
+		 * inside quoted string.
+		 * @param	path is MD5 file path.
+		 * @param	file is reference to stream which store file content.
+		 * @return	true if file was read.
+		 */
+		bool MeshFactory::readMD5File(const string& path, stringstream& file)
+		{
+			ifstream sourceFile;
+			sourceFile.open(path);
+			if(!sourceFile.is_open())
+				return false;
+
+			string line;
+			while(getline(sourceFile,line))
+			{
+				bool quoted = false;
+				for(unsigned int i = 0; i < line.size(); ++i)
+				{
+					if(line[i] == '"')
+						quoted = !quoted;
+					else if(!quoted && line[i] == '/' && i + 1 < line.size() && line[i + 1] == '/')
+					{
+						line.erase(i);
+						break;
+					}
+				}
+				file << line << '\n';
+			}
+			sourceFile.close();
+			return true;
+		}
+
+		/**
+		 * Private method which is used to read one MD5 sub mesh and append it to merged mesh data.
+		 * @param	meshFile is reference to opened mesh file.
+		 * @param	skeleton is reference to mesh skeleton with bind pose.
+		 * @param	vertices is reference to merged bind pose vertices.
+		 * @param	influences is reference to merged joint influences.
+		 * @param	indices is reference to merged indices.
+		 */
+		void MeshFactory::readMD5SubMesh(istream& meshFile, const Skeleton& skeleton, vector<Vertex<>>& vertices, vector<VertexInfluence>& influences, vector<unsigned int>& indices)
+		{
+			const unsigned int firstVertex = vertices.size();
+			vector<md5_vertex_t> meshVertices;
+			vector<md5_weight_t> meshWeights;
+			string token;
+			int integerData = 0;
+
+			meshFile >> token;
+			while(meshFile >> token && token != "}")
+			{
+				if(token == "shader")
+					readMD5String(meshFile);
+				else if(token == "numverts")
+				{
+					meshFile >> integerData;
+					meshVertices.resize(max(integerData,0));
+				}
+				else if(token == "vert")
+				{
+					md5_vertex_t vertex;
+					meshFile >> integerData >> token >> vertex.st[0] >> vertex.st[1] >> token >> vertex.startWeight >> vertex.countWeight;
+					if(integerData >= 0 && integerData < static_cast<int>(meshVertices.size()))
+						meshVertices[integerData] = vertex;
+				}
+				else if(token == "tri")
+				{
+					unsigned int triangle[3];
+					meshFile >> integerData >> triangle[0] >> triangle[1] >> triangle[2];
+					if(triangle[0] < meshVertices.size() && triangle[1] < meshVertices.size() && triangle[2] < meshVertices.size())
+						for(unsigned int i = 0; i < 3; ++i)
+							indices.push_back(firstVertex + triangle[i]);
+				}
+				else if(token == "numweights")
+				{
+					meshFile >> integerData;
+					meshWeights.resize(max(integerData,0));
+				}
+				else if(token == "weight")
+				{
+					md5_weight_t weight;
+					meshFile >> integerData >> weight.joint >> weight.bias >> token >> weight.pos[0] >> weight.pos[1] >> weight.pos[2] >> token;
+					if(integerData >= 0 && integerData < static_cast<int>(meshWeights.size()))
+						meshWeights[integerData] = weight;
+				}
+			}
+
+			const SkeletonPose& bindPose = skeleton.getBindPose();
+			vector<pair<float,int>> jointWeights;
+			for(vector<md5_vertex_t>::const_iterator it = meshVertices.begin(); it != meshVertices.end(); ++it)
+			{
+				Vertex<> vertex;
+				memset(&vertex,0,sizeof(Vertex<>));
+				vertex.u = (*it).st[0];
+				vertex.v = (*it).st[1];
+
+				jointWeights.clear();
+				for(int i = (*it).startWeight; i < (*it).startWeight + (*it).countWeight; ++i)
+				{
+					if(i < 0 || i >= static_cast<int>(meshWeights.size()))
+						continue;
+					const md5_weight_t& weight = meshWeights[i];
+					if(weight.joint < 0 || weight.joint >= static_cast<int>(bindPose.size()))
+						continue;
+
+					float position[3];
+					const JointPose& joint = bindPose[weight.joint];
+					Skeleton::rotateVector(joint.orientation,weight.pos,position);
+					vertex.x += (joint.position[0] + position[0])*weight.bias;
+					vertex.y += (joint.position[1] + position[1])*weight.bias;
+					vertex.z += (joint.position[2] + position[2])*weight.bias;
+					jointWeights.push_back(make_pair(weight.bias,weight.joint));
+				}
+				sort(jointWeights.rbegin(),jointWeights.rend());
+
+				VertexInfluence influence;
+				memset(&influence,0,sizeof(VertexInfluence));
+				float weightSum = 0.0f;
+				for(unsigned int i = 0; i < jointWeights.size() && i < MAX_VERTEX_JOINTS; ++i)
+				{
+					influence.joints[i] = static_cast<float>(jointWeights[i].second);
+					influence.weights[i] = jointWeights[i].first;
+					weightSum += jointWeights[i].first;
+				}
+				if(weightSum > 0.0f)
+					for(unsigned int i = 0; i < MAX_VERTEX_JOINTS; ++i)
+						influence.weights[i] /= weightSum;
+				else
+					influence.weights[0] = 1.0f;
+
+				vertices.push_back(vertex);
+				influences.push_back(influence);
+			}
+		}
+
+		/**
+		 * Private method which is used to read quoted MD5 string. Quoted string can contain spaces.
+		 * @param	file is reference to opened MD5 file.
+		 * @return	string without quotes.
+		 */
+		string MeshFactory::readMD5String(istream& file)
+		{
+			string text;
+			file >> text;
+			if(text.empty() || text[0] != '"')
+				return text;
+			while(text.size() < 2 || text[text.size() - 1] != '"')
+			{
+				string part;
+				if(!(file >> part))
+					break;
+				text += " " + part;
+			}
+			return text.substr(1,text.size() > 1 ? text.size() - 2 : 0);
+		}
+
+		/**
+		 * Private method which is used to calculate w component of MD5 unit quaternion. MD5 files store only
+		 * x, y, z components.
+		 * @param	orientation is pointer to quaternion with x, y, z components.
+		 */
+		void MeshFactory::computeMD5Orientation(float* orientation)
+		{
+			const float t = 1.0f - orientation[0]*orientation[0] - orientation[1]*orientation[1] - orientation[2]*orientation[2];
+			orientation[3] = t < 0.0f ? 0.0f : -sqrt(t);
 		}
 
 		/**
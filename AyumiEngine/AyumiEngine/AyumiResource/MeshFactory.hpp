@@ -9,12 +9,14 @@
 #define MESHFACTORY_HPP
 
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <boost/lexical_cast.hpp>
 
 #include "Mesh.hpp"
 #include "FileMD2.hpp"
+#include "FileMD5.hpp"
 
 #include "../Logger.hpp"
 #include "../AyumiMath/CommonMath.hpp"
@@ -35,6 +37,8 @@ namespace AyumiEngine
 			float maxCoord;
 		};
 
+		const float MD2_CLIP_FRAME_RATE = 9.0f;
+
 		/**
 		 * Class represents one of Engine ResourceManager/MeshManager subclass - MeshFactory
 		 * which is used by MeshManager to load create all supported 3d model formats. Class has
@@ -50,8 +54,13 @@ namespace AyumiEngine
 			Mesh* createObjMesh(const std::string& name, const std::string& path);
 			Mesh* create3dsMesh(const std::string& name, const std::string& path);
 			Mesh* createMD2Mesh(const std::string& name, const std::string& path);
+			void createMD2Clips(Mesh* meshResource, const md2_frame_t* frames, const int frameAmount);
 			Mesh* createMD3Mesh(const std::string& name, const std::string& path); // TODO
-			Mesh* createMD5Mesh(const std::string& name, const std::string& path); // TODO
+			Mesh* createMD5Mesh(const std::string& name, const std::string& path);
+			bool readMD5File(const std::string& path, std::stringstream& file);
+			void readMD5SubMesh(std::istream& meshFile, const Skeleton& skeleton, std::vector<AyumiUtils::Vertex<>>& vertices, std::vector<VertexInfluence>& influences, std::vector<unsigned int>& indices);
+			std::string readMD5String(std::istream& file);
+			void computeMD5Orientation(float* orientation);
 			Mesh* createRawMesh(const std::string& name, const std::string& path);
 			Mesh* createProceduralMesh(const std::string& name, const float roughnes);
 
@@ -61,6 +70,7 @@ namespace AyumiEngine
 
 			Mesh* createMeshResource(const std::string& name, const std::string& type, const std::string& path);
 			void initRawParameters(const int size, const float rowScale, const float columnScale, const float heightScale, const float maxCoord);
+			bool loadMD5Animation(Mesh* meshResource, const std::string& animationName, const std::string& path);
 		};
 	}
 }
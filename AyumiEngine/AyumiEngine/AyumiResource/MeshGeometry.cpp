@@ -0,0 +1,325 @@
+/**
+ * File contains definition of MeshGeometry class.
+ * @file    MeshGeometry.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-12
+ */
+
+#include "MeshGeometry.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiUtils;
+using namespace AyumiEngine::AyumiMath;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class constructor with initialize parameters. Upload mesh data to geometry heap, vertex buffer, key
+		 * frame buffer or skin influence buffer and calculate bounding volumes of first mesh frame. Key frame
+		 * and skinned meshes bypass geometry heap, because their vertex shaders address vertices by vertex id.
+		 * @param	geometryMesh is pointer to mesh resource.
+		 * @param	geometryHeap is pointer to geometry heap or nullptr if mesh use own vertex buffers.
+		 */
+		MeshGeometry::MeshGeometry(Mesh* geometryMesh, GeometryHeap* geometryHeap) : geometryBox(*geometryMesh), geometrySphere(*geometryMesh,Vector3D(0.0f,0.0f,0.0f))
+		{
+			this->geometryMesh = geometryMesh;
+			this->geometryHeap = geometryMesh->isComponentMesh() || geometryMesh->isSkinnedMesh() ? nullptr : geometryHeap;
+			heapHandle = 0;
+			geometryBuffers = nullptr;
+			bufferAmount = 1;
+			vertexArray = 0;
+			keyFrameBuffer = 0;
+			keyFrameTexture = 0;
+			influenceBuffer = 0;
+			influenceTexture = 0;
+			frameAmount = geometryMesh->isComponentMesh() ? geometryMesh->getComponentAmount() : 1;
+
+			if(this->geometryHeap != nullptr)
+			{
+				heapHandle = this->geometryHeap->allocateGeometry(*geometryMesh);
+				bufferAmount = 0;
+				return;
+			}
+
+			geometryBuffers = new VertexBufferObject[bufferAmount];
+			geometryBuffers[0].initializeBufferObject(*geometryMesh);
+			if(geometryMesh->isComponentMesh())
+				initializeKeyFrames();
+			else if(geometryMesh->isSkinnedMesh())
+				initializeInfluences();
+		}
+
+		/**
+		 * Class destructor, free allocated memory. Release heap allocation or delete vertex buffers.
+		 */
+		MeshGeometry::~MeshGeometry()
+		{
+			if(geometryHeap != nullptr)
+				geometryHeap->releaseGeometry(heapHandle);
+			if(keyFrameTexture != 0)
+				glDeleteTextures(1,&keyFrameTexture);
+			if(keyFrameBuffer != 0)
+				glDeleteBuffers(1,&keyFrameBuffer);
+			if(influenceTexture != 0)
+				glDeleteTextures(1,&influenceTexture);
+			if(influenceBuffer != 0)
+				glDeleteBuffers(1,&influenceBuffer);
+			if(vertexArray != 0)
+				glDeleteVertexArrays(1,&vertexArray);
+			delete [] geometryBuffers;
+		}
+
+		/**
+		 * Method is used to upload modified mesh vertices to existing vertex buffers. Bounding volumes
+		 * are not recalculated.
+		 */
+		void MeshGeometry::updateGeometryData()
+		{
+			if(geometryHeap != nullptr)
+				geometryHeap->updateGeometry(heapHandle,*geometryMesh);
+			for(unsigned int i = 0; i < bufferAmount; ++i)
+				geometryBuffers[i].updateBufferObject(geometryMesh[i]);
+
+			if(keyFrameBuffer != 0)
+			{
+				vector<float> keyFrameData;
+				fillKeyFrameData(keyFrameData);
+				glBindBuffer(GL_TEXTURE_BUFFER,keyFrameBuffer);
+				glBufferSubData(GL_TEXTURE_BUFFER,0,keyFrameData.size()*sizeof(float),&keyFrameData[0]);
+				glBindBuffer(GL_TEXTURE_BUFFER,0);
+			}
+		}
+
+		/**
+		 * Accessor to private mesh resource member.
+		 * @return	pointer to mesh resource.
+		 */
+		Mesh* MeshGeometry::getMesh() const
+		{
+			return geometryMesh;
+		}
+
+		/**
+		 * Accessor to private vertex buffers member.
+		 * @return	pointer to first vertex buffer.
+		 */
+		VertexBufferObject* MeshGeometry::getBuffers() const
+		{
+			return geometryBuffers;
+		}
+
+		/**
+		 * Accessor to private buffer amount member.
+		 * @return	amount of vertex buffers.
+		 */
+		unsigned int MeshGeometry::getBufferAmount() const
+		{
+			return bufferAmount;
+		}
+
+		/**
+		 * Method is used to check if mesh is suballocated in geometry heap.
+		 * @return	true if mesh is stored in geometry heap.
+		 */
+		bool MeshGeometry::isHeapGeometry() const
+		{
+			return geometryHeap != nullptr;
+		}
+
+		/**
+		 * Accessor to vertex array shared by all entities: heap vertex array, key frame or skinned geometry vertex array.
+		 * @return	vertex array object id or 0 if mesh geometry does not have shared vertex array.
+		 */
+		GLuint MeshGeometry::getVertexArray() const
+		{
+			return geometryHeap != nullptr ? geometryHeap->getVertexArray() : vertexArray;
+		}
+
+		/**
+		 * Accessor to byte offset of mesh indices in heap index buffer.
+		 * @return	index offset.
+		 */
+		GLintptr MeshGeometry::getIndexOffset() const
+		{
+			return geometryHeap != nullptr ? geometryHeap->getAllocation(heapHandle).indexFirst*sizeof(unsigned int) : 0;
+		}
+
+		/**
+		 * Accessor to first vertex of mesh in heap vertex buffer, which is added to each mesh index.
+		 * @return	base vertex.
+		 */
+		GLint MeshGeometry::getBaseVertex() const
+		{
+			return geometryHeap != nullptr ? geometryHeap->getAllocation(heapHandle).vertexFirst : 0;
+		}
+
+		/**
+		 * Method is used to check if mesh frames are stored in key frame buffer.
+		 * @return	true if mesh is key frame animation.
+		 */
+		bool MeshGeometry::isKeyFrameGeometry() const
+		{
+			return keyFrameTexture != 0;
+		}
+
+		/**
+		 * Accessor to private key frame buffer texture member.
+		 * @return	buffer texture id or 0 if mesh is not key frame animation.
+		 */
+		GLuint MeshGeometry::getKeyFrameTexture() const
+		{
+			return keyFrameTexture;
+		}
+
+		/**
+		 * Accessor to private frame amount member.
+		 * @return	amount of mesh frames.
+		 */
+		unsigned int MeshGeometry::getFrameAmount() const
+		{
+			return frameAmount;
+		}
+
+		/**
+		 * Accessor to amount of vertices of one mesh frame.
+		 * @return	amount of frame vertices.
+		 */
+		unsigned int MeshGeometry::getFrameVertices() const
+		{
+			return geometryMesh->getVerticesAmount();
+		}
+
+		/**
+		 * Method is used to check if mesh joint influences are stored in influence buffer.
+		 * @return	true if mesh is skinned mesh.
+		 */
+		bool MeshGeometry::isSkinnedGeometry() const
+		{
+			return influenceTexture != 0;
+		}
+
+		/**
+		 * Accessor to private influence buffer texture member.
+		 * @return	buffer texture id or 0 if mesh is not skinned mesh.
+		 */
+		GLuint MeshGeometry::getInfluenceTexture() const
+		{
+			return influenceTexture;
+		}
+
+		/**
+		 * Accessor to private bounding box member.
+		 * @return	pointer to mesh bounding box.
+		 */
+		BoundingBox* MeshGeometry::getBoundingBox()
+		{
+			return &geometryBox;
+		}
+
+		/**
+		 * Accessor to private bounding sphere member.
+		 * @return	pointer to mesh bounding sphere.
+		 */
+		BoundingSphere* MeshGeometry::getBoundingSphere()
+		{
+			return &geometrySphere;
+		}
+
+		/**
+		 * Private method which is used to create key frame buffer texture and shared vertex array. First frame
+		 * vertex buffer provide texture coordinates, tangents and indices.
+		 */
+		void MeshGeometry::initializeKeyFrames()
+		{
+			vector<float> keyFrameData;
+			fillKeyFrameData(keyFrameData);
+
+			glGenBuffers(1,&keyFrameBuffer);
+			glBindBuffer(GL_TEXTURE_BUFFER,keyFrameBuffer);
+			glBufferData(GL_TEXTURE_BUFFER,keyFrameData.size()*sizeof(float),&keyFrameData[0],GL_STATIC_DRAW);
+			glBindBuffer(GL_TEXTURE_BUFFER,0);
+
+			glGenTextures(1,&keyFrameTexture);
+			glBindTexture(GL_TEXTURE_BUFFER,keyFrameTexture);
+			glTexBuffer(GL_TEXTURE_BUFFER,GL_RGBA32F,keyFrameBuffer);
+			glBindTexture(GL_TEXTURE_BUFFER,0);
+
+			initializeVertexArray();
+		}
+
+		/**
+		 * Private method which is used to create skin influence buffer texture and shared vertex array. Each
+		 * vertex use two RGBA texels: joint indices and joint weights.
+		 */
+		void MeshGeometry::initializeInfluences()
+		{
+			const vector<VertexInfluence>& influences = geometryMesh->getSkeleton()->getInfluences();
+			if(influences.empty())
+				return;
+
+			glGenBuffers(1,&influenceBuffer);
+			glBindBuffer(GL_TEXTURE_BUFFER,influenceBuffer);
+			glBufferData(GL_TEXTURE_BUFFER,influences.size()*sizeof(VertexInfluence),&influences[0],GL_STATIC_DRAW);
+			glBindBuffer(GL_TEXTURE_BUFFER,0);
+
+			glGenTextures(1,&influenceTexture);
+			glBindTexture(GL_TEXTURE_BUFFER,influenceTexture);
+			glTexBuffer(GL_TEXTURE_BUFFER,GL_RGBA32F,influenceBuffer);
+			glBindTexture(GL_TEXTURE_BUFFER,0);
+
+			initializeVertexArray();
+		}
+
+		/**
+		 * Private method which is used to create vertex array of own vertex buffer, engine attributes use
+		 * fixed locations.
+		 */
+		void MeshGeometry::initializeVertexArray()
+		{
+			geometryBuffers[0].vertexPosition = VERTEX_ATTRIBUTE;
+			geometryBuffers[0].normalPosition = NORMAL_ATTRIBUTE;
+			geometryBuffers[0].texCoordPosition = TEXCOORD_ATTRIBUTE;
+			geometryBuffers[0].tangentPosition = TANGENT_ATTRIBUTE;
+
+			glGenVertexArrays(1,&vertexArray);
+			glBindVertexArray(vertexArray);
+			geometryBuffers[0].bindBufferObject();
+			glVertexAttribPointer(VERTEX_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + 0);
+			glVertexAttribPointer(NORMAL_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*3);
+			glVertexAttribPointer(TEXCOORD_ATTRIBUTE,2,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*6);
+			glVertexAttribPointer(TANGENT_ATTRIBUTE,4,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*8);
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
+		/**
+		 * Private method which is used to pack positions and normals of all frames. Each vertex of each frame
+		 * use two RGBA texels: position with w = 1 and normal with w = 0.
+		 * @param	keyFrameData is reference to destination data.
+		 */
+		void MeshGeometry::fillKeyFrameData(vector<float>& keyFrameData) const
+		{
+			const unsigned int frameVertices = getFrameVertices();
+			keyFrameData.resize(frameAmount*frameVertices*8);
+
+			float* data = &keyFrameData[0];
+			for(unsigned int i = 0; i < frameAmount; ++i)
+			{
+				const Vertex<>* vertices = geometryMesh[i].getVertices();
+				for(unsigned int j = 0; j < frameVertices; ++j, data += 8)
+				{
+					data[0] = vertices[j].x;
+					data[1] = vertices[j].y;
+					data[2] = vertices[j].z;
+					data[3] = 1.0f;
+					data[4] = vertices[j].nx;
+					data[5] = vertices[j].ny;
+					data[6] = vertices[j].nz;
+					data[7] = 0.0f;
+				}
+			}
+		}
+	}
+}
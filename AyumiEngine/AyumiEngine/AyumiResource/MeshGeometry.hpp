@@ -0,0 +1,86 @@
+/**
+ * File contains declaration of MeshGeometry class.
+ * @file    MeshGeometry.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-12
+ */
+
+#ifndef MESHGEOMETRY_HPP
+#define MESHGEOMETRY_HPP
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "Mesh.hpp"
+#include "GeometryHeap.hpp"
+#include "../AyumiUtils/VertexBufferObject.hpp"
+#include "../AyumiUtils/BoundingBox.hpp"
+#include "../AyumiUtils/BoundingSphere.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int KEY_FRAME_DATA_SIZE = 8;
+
+		/**
+		 * Class represents GPU geometry data of one Mesh resource: vertex buffers and bounding volumes calculated
+		 * in mesh local space. It is shared by all scene entities which use the same mesh, so geometry is uploaded
+		 * and bounding volumes are calculated only once. Meshes are suballocated in geometry heap if it is given,
+		 * meshes without heap store own vertex buffer.
+		 * Component meshes (key frame animations) store first frame in vertex buffer with own vertex array and
+		 * positions and normals of all frames packed in one buffer texture. Animated entities select frames
+		 * in vertex shader, so key frames are uploaded once per mesh and entities do not own any GPU data.
+		 * Skinned meshes store bind pose in vertex buffer with own vertex array and joint influences of each
+		 * vertex in buffer texture read by skinning vertex shader.
+		 */
+		class MeshGeometry : private AyumiUtils::Noncopyable
+		{
+		private:
+			Mesh* geometryMesh;
+			GeometryHeap* geometryHeap;
+			unsigned int heapHandle;
+			AyumiUtils::VertexBufferObject* geometryBuffers;
+			unsigned int bufferAmount;
+			GLuint vertexArray;
+			GLuint keyFrameBuffer;
+			GLuint keyFrameTexture;
+			GLuint influenceBuffer;
+			GLuint influenceTexture;
+			unsigned int frameAmount;
+			AyumiUtils::BoundingBox geometryBox;
+			AyumiUtils::BoundingSphere geometrySphere;
+
+			void initializeKeyFrames();
+			void initializeInfluences();
+			void initializeVertexArray();
+			void fillKeyFrameData(std::vector<float>& keyFrameData) const;
+
+		public:
+			MeshGeometry(Mesh* geometryMesh, GeometryHeap* geometryHeap = nullptr);
+			~MeshGeometry();
+
+			void updateGeometryData();
+
+			Mesh* getMesh() const;
+			AyumiUtils::VertexBufferObject* getBuffers() const;
+			unsigned int getBufferAmount() const;
+			bool isHeapGeometry() const;
+			GLuint getVertexArray() const;
+			GLintptr getIndexOffset() const;
+			GLint getBaseVertex() const;
+			bool isKeyFrameGeometry() const;
+			GLuint getKeyFrameTexture() const;
+			unsigned int getFrameAmount() const;
+			unsigned int getFrameVertices() const;
+			bool isSkinnedGeometry() const;
+			GLuint getInfluenceTexture() const;
+			AyumiUtils::BoundingBox* getBoundingBox();
+			AyumiUtils::BoundingSphere* getBoundingSphere();
+		};
+
+		typedef boost::shared_ptr<MeshGeometry> GeometryResource;
+	}
+}
+#endif
@@ -65,6 +65,8 @@ namespace AyumiEngine
 				.def("releaseResource",&MeshManager::releaseResource)
 				.def("clearResources",&MeshManager::clearResources)
 				.def("setRawParameters",&MeshManager::setRawParameters)
+				.def("loadAnimationClip",&MeshManager::loadAnimationClip)
+				.def("loadSkeletalAnimation",&MeshManager::loadSkeletalAnimation)
 			];
 
 			luabind::globals(resourceScript->getVirtualMachine())["MeshManager"] = this;
@@ -131,5 +133,51 @@ namespace AyumiEngine
 		{
 			meshFactory->initRawParameters(size,rowScale,columnScale,heightScale,maxCoord);
 		}
+
+		/**
+		 * Private method which is used to add or replace animation clip of key frame mesh. It can be called from
+		 * Lua script after mesh registration.
+		 * @param	name is key frame mesh resource name id.
+		 * @param	clipName is animation clip name.
+		 * @param	firstFrame is first frame of clip.
+		 * @param	lastFrame is last frame of clip.
+		 * @param	framePerSecond is clip playback speed.
+		 * @param	isLooped is bool flag to determine if clip is played in loop.
+		 */
+		void MeshManager::loadAnimationClip(const string& name, const string& clipName, const int firstFrame, const int lastFrame, const float framePerSecond, const bool isLooped)
+		{
+			map<string,Mesh*>::const_iterator it = resourceMap.find(name);
+			if(it == resourceMap.end() || !(*it).second->isComponentMesh())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Animation clip loading error - key frame mesh not found: " + name));
+				return;
+			}
+
+			AnimationClip clip;
+			clip.clipName = clipName;
+			clip.firstFrame = firstFrame;
+			clip.lastFrame = lastFrame;
+			clip.framePerSecond = framePerSecond;
+			clip.isLooped = isLooped;
+			(*it).second->addAnimationClip(clip);
+		}
+
+		/**
+		 * Private method which is used to load skeletal animation of skinned mesh. It can be called from Lua
+		 * script after mesh registration.
+		 * @param	name is skinned mesh resource name id.
+		 * @param	animationName is animation name.
+		 * @param	path is animation file path.
+		 */
+		void MeshManager::loadSkeletalAnimation(const string& name, const string& animationName, const string& path)
+		{
+			map<string,Mesh*>::const_iterator it = resourceMap.find(name);
+			if(it == resourceMap.end() || !(*it).second->isSkinnedMesh())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Skeletal animation loading error - skinned mesh not found: " + name));
+				return;
+			}
+			meshFactory->loadMD5Animation((*it).second,animationName,path);
+		}
 	}
 }
@@ -37,6 +37,8 @@ namespace AyumiEngine
 			void releaseResource(const std::string& name);
 			void clearResources();
 			void setRawParameters(const int size, const float rowScale, const float columnScale, const float heightScale, const float maxCoord);
+			void loadAnimationClip(const std::string& name, const std::string& clipName, const int firstFrame, const int lastFrame, const float framePerSecond, const bool isLooped);
+			void loadSkeletalAnimation(const std::string& name, const std::string& animationName, const std::string& path);
 		public:
 			MeshManager(const char* scriptFileName);
 			~MeshManager();
@@ -22,6 +22,7 @@ namespace AyumiEngine
 			meshManager = new MeshManager(Configuration::getInstance()->getMeshScriptName()->c_str());
 			textureManager = new TextureManager(Configuration::getInstance()->getTextureScriptName()->c_str());	
 			shaderManager = new ShaderManager(Configuration::getInstance()->getShaderScriptName()->c_str());
+			geometryHeap = new GeometryHeap();
 
 			meshManager->initializeResources();
 			textureManager->initializeResources();
@@ -36,6 +37,8 @@ namespace AyumiEngine
 			delete textureManager;
 			delete shaderManager;
 			delete meshManager;
+			geometryCache.clear();
+			delete geometryHeap;
 		}
 
 		/**
@@ -56,6 +59,32 @@ namespace AyumiEngine
 			textureManager->updateResources(scriptPath);
 		}
 
+		/**
+		 * Method is used to upload decoded texture images with per-frame budget. Must be called on OpenGL thread
+		 * once per frame.
+		 * @return	amount of uploaded bytes.
+		 */
+		unsigned int ResourceManager::uploadTextureResources()
+		{
+			return textureManager->uploadTextures();
+		}
+
+		/**
+		 * Method is used to wait for all texture resources and upload them without budget.
+		 */
+		void ResourceManager::finishTextureResources()
+		{
+			textureManager->finishTextures();
+		}
+
+		/**
+		 * Method is used to finish all pending shader programs.
+		 */
+		void ResourceManager::finishShaderResources()
+		{
+			shaderManager->finishResources();
+		}
+
 		/**
 		 * Method is used to update shader resources collection by running resource control Lua script.
 		 * @param	scriptPath is path to Lua resource control script.
@@ -121,5 +150,59 @@ namespace AyumiEngine
 
 			return resource;
 		}
+
+		/**
+		 * Accessor to shader loading statistics, which compare programs loaded from program binary cache and
+		 * compiled programs.
+		 * @return	reference to shader loading statistics.
+		 */
+		const ShaderLoadingStatistics& ResourceManager::getShaderLoadingStatistics() const
+		{
+			return shaderManager->getLoadingStatistics();
+		}
+
+		/**
+		 * Accessor to shared GPU geometry of engine Mesh resource. Geometry is created on first request in geometry
+		 * heap and shared by all entities which use the same mesh. It is released when last entity drops its reference.
+		 * @param	name is mesh resource id.
+		 * @return	shared pointer to mesh geometry or empty pointer if mesh doesn't exist.
+		 */
+		GeometryResource ResourceManager::getGeometryResource(const string& name)
+		{
+			Mesh* mesh = getMeshResource(name);
+			if(mesh == nullptr)
+				return GeometryResource();
+
+			GeometryResource geometry = geometryCache[name].lock();
+			if(geometry == nullptr || geometry->getMesh() != mesh)
+			{
+				geometry = GeometryResource(new MeshGeometry(mesh,geometryHeap));
+				geometryCache[name] = geometry;
+			}
+
+			return geometry;
+		}
+
+		/**
+		 * Method is used to get amount of mesh geometries which are currently used by scene entities.
+		 * @return	amount of shared mesh geometries.
+		 */
+		unsigned int ResourceManager::getGeometryAmount() const
+		{
+			unsigned int amount = 0;
+			for(map<string,boost::weak_ptr<MeshGeometry> >::const_iterator it = geometryCache.begin(); it != geometryCache.end(); ++it)
+				if(!(*it).second.expired())
+					amount++;
+			return amount;
+		}
+
+		/**
+		 * Accessor to private geometry heap member.
+		 * @return	pointer to geometry heap.
+		 */
+		GeometryHeap* ResourceManager::getGeometryHeap() const
+		{
+			return geometryHeap;
+		}
 	}
 }
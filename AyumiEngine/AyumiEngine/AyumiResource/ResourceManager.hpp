@@ -11,6 +11,10 @@
 #include "TextureManager.hpp"
 #include "MeshManager.hpp"
 #include "ShaderManager.hpp"
+#include "MeshGeometry.hpp"
+
+#include <map>
+#include <boost/weak_ptr.hpp>
 
 #include "../Logger.hpp"
 #include "../AyumiCore/Configuration.hpp"
@@ -30,6 +34,8 @@ namespace AyumiEngine
 			MeshManager* meshManager;
 			TextureManager* textureManager;
 			ShaderManager* shaderManager;
+			GeometryHeap* geometryHeap;
+			std::map<std::string,boost::weak_ptr<MeshGeometry> > geometryCache;
 
 		public:
 			ResourceManager();
@@ -38,10 +44,17 @@ namespace AyumiEngine
 			void updateMeshResources(const std::string& scriptPath);
 			void updateTextureResources(const std::string& scriptPath);
 			void updateShaderResources(const std::string& scriptPath);
+			unsigned int uploadTextureResources();
+			void finishTextureResources();
+			void finishShaderResources();
 
 			Mesh* getMeshResource(const std::string& name);
 			TextureResource getTextureResource(const std::string& name);
 			ShaderResource getShaderResource(const std::string& name);
+			const ShaderLoadingStatistics& getShaderLoadingStatistics() const;
+			GeometryResource getGeometryResource(const std::string& name);
+			unsigned int getGeometryAmount() const;
+			GeometryHeap* getGeometryHeap() const;
 		};
 	}
 }
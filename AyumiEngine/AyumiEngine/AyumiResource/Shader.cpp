@@ -5,7 +5,13 @@
  * @date    2011-08-10
  */
 
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+
 #include "Shader.hpp"
+#include "../Logger.hpp"
 
 using namespace std;
 
@@ -13,6 +19,10 @@ namespace AyumiEngine
 {
 	namespace AyumiResource
 	{
+		unsigned int Shader::uniformCalls = 0;
+		unsigned int Shader::avoidedUniformCalls = 0;
+		unsigned int Shader::missingUniformCalls = 0;
+
 		/**
 		 * Class default constructor. Set object default values. 
 		 */
@@ -27,6 +37,9 @@ namespace AyumiEngine
 			geometryPath = nullptr;
 			resourceName = nullptr;
 			resourceType = SHADER;
+			uniformsReflected = false;
+			uniformBlocks = 0;
+			instanceAttribute = -1;
 		}
 
 		/** 
@@ -44,6 +57,9 @@ namespace AyumiEngine
 			vertexPath = nullptr;
 			fragmentPath = nullptr;
 			geometryPath = nullptr;
+			uniformsReflected = false;
+			uniformBlocks = 0;
+			instanceAttribute = -1;
 		}
 
 		/**
@@ -69,6 +85,7 @@ namespace AyumiEngine
 				glDeleteShader(shaderVertex);
 			}
 			glDeleteProgram(shaderProgram);
+			uniforms.clear();
 		}
 	
 		/**
@@ -119,6 +136,190 @@ namespace AyumiEngine
 			shaderFragment = glCreateShader(GL_FRAGMENT_SHADER);
 		}
 
+		/**
+		 * Method is used to link shader program and reflect all active uniform locations. Engine vertex
+		 * attributes are bound to fixed locations before link, light cluster samplers after link.
+		 */
+		void Shader::linkShaderProgram()
+		{
+			startLinkShaderProgram(false);
+			finishLinkShaderProgram();
+		}
+
+		/**
+		 * Method is used to bind engine vertex attributes to fixed locations and issue program link without
+		 * waiting for its result. Link is finished by finishLinkShaderProgram.
+		 * @param	binaryRetrievable is flag which is set when program binary will be read after link.
+		 */
+		void Shader::startLinkShaderProgram(const bool binaryRetrievable)
+		{
+			glBindAttribLocation(shaderProgram,VERTEX_ATTRIBUTE,"vertex");
+			glBindAttribLocation(shaderProgram,NORMAL_ATTRIBUTE,"normal");
+			glBindAttribLocation(shaderProgram,TEXCOORD_ATTRIBUTE,"texCoord");
+			glBindAttribLocation(shaderProgram,TANGENT_ATTRIBUTE,"tangent");
+			glBindAttribLocation(shaderProgram,INSTANCE_ATTRIBUTE,"instanceMatrix");
+			if(binaryRetrievable)
+				glProgramParameteri(shaderProgram,GL_PROGRAM_BINARY_RETRIEVABLE_HINT,GL_TRUE);
+			glLinkProgram(shaderProgram);
+		}
+
+		/**
+		 * Method is used to check link status of program and reflect all active uniform locations. Link errors
+		 * are saved in log with program info log.
+		 * @return	true if program was linked.
+		 */
+		bool Shader::finishLinkShaderProgram()
+		{
+			GLint linkStatus = GL_FALSE;
+			glGetProgramiv(shaderProgram,GL_LINK_STATUS,&linkStatus);
+			if(linkStatus != GL_TRUE)
+			{
+				GLint logLength = 0;
+				glGetProgramiv(shaderProgram,GL_INFO_LOG_LENGTH,&logLength);
+				vector<char> infoLog(max(logLength,1));
+				glGetProgramInfoLog(shaderProgram,infoLog.size(),nullptr,&infoLog[0]);
+				Logger::getInstance()->saveLog(Log<string>("Shader program linking error detected: "));
+				Logger::getInstance()->saveLog(Log<string>(resourceName));
+				Logger::getInstance()->saveLog(Log<string>(string(&infoLog[0])));
+			}
+
+			initializeLinkedProgram();
+			return linkStatus == GL_TRUE;
+		}
+
+		/**
+		 * Method is used to create program from program binary. Binary is rejected by driver when it was
+		 * created by other driver version, program can be compiled and linked later in that case.
+		 * @param	binaryFormat is driver specific binary format.
+		 * @param	binary is pointer to program binary.
+		 * @param	length is length of program binary.
+		 * @return	true if program was loaded.
+		 */
+		bool Shader::loadProgramBinary(const GLenum binaryFormat, const void* binary, const GLsizei length)
+		{
+			glProgramBinary(shaderProgram,binaryFormat,binary,length);
+
+			GLint linkStatus = GL_FALSE;
+			glGetProgramiv(shaderProgram,GL_LINK_STATUS,&linkStatus);
+			if(linkStatus != GL_TRUE)
+				return false;
+
+			initializeLinkedProgram();
+			return true;
+		}
+
+		/**
+		 * Method is used to read binary of linked program.
+		 * @param	binaryFormat is reference to driver specific binary format.
+		 * @param	binary is reference to program binary.
+		 * @return	false if driver does not return program binary.
+		 */
+		bool Shader::getProgramBinary(GLenum& binaryFormat, vector<unsigned char>& binary) const
+		{
+			GLint length = 0;
+			glGetProgramiv(shaderProgram,GL_PROGRAM_BINARY_LENGTH,&length);
+			if(length <= 0)
+				return false;
+
+			binary.resize(length);
+			GLsizei writtenLength = 0;
+			glGetProgramBinary(shaderProgram,length,&writtenLength,&binaryFormat,&binary[0]);
+			binary.resize(writtenLength);
+			return writtenLength > 0;
+		}
+
+		/**
+		 * Method is used to reflect active uniforms of linked shader program. Location of each uniform is
+		 * queried once and stored under hashed name. Array uniforms are also stored under base name and
+		 * names of each element. Previous shadow copies are discarded.
+		 */
+		void Shader::reflectUniforms()
+		{
+			uniforms.clear();
+			namedUniforms.clear();
+			uniformsReflected = true;
+			reflectUniformBlocks();
+
+			GLint uniformAmount = 0;
+			GLint maxLength = 0;
+			glGetProgramiv(shaderProgram,GL_ACTIVE_UNIFORMS,&uniformAmount);
+			glGetProgramiv(shaderProgram,GL_ACTIVE_UNIFORM_MAX_LENGTH,&maxLength);
+			if(uniformAmount <= 0 || maxLength <= 0)
+				return;
+
+			vector<char> nameBuffer(maxLength + 1);
+			UniformNames names;
+			for(GLint i = 0; i < uniformAmount; ++i)
+			{
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(shaderProgram,i,maxLength,&length,&size,&type,&nameBuffer[0]);
+				string name(&nameBuffer[0],length);
+				GLint location = glGetUniformLocation(shaderProgram,name.c_str());
+				if(location < 0)
+					continue;
+				addUniform(name,location,type,names);
+
+				if(name.size() > 3 && name.compare(name.size()-3,3,"[0]") == 0)
+				{
+					string baseName = name.substr(0,name.size()-3);
+					addUniform(baseName,location,type,names);
+					for(GLint j = 1; j < size; ++j)
+					{
+						string elementName = baseName + "[" + boost::lexical_cast<string>(j) + "]";
+						addUniform(elementName,glGetUniformLocation(shaderProgram,elementName.c_str()),type,names);
+					}
+				}
+			}
+		}
+
+		/**
+		 * Method is used to bind engine uniform blocks used by linked shader program to fixed binding points.
+		 * Blocks which are not used by program are skipped.
+		 */
+		void Shader::reflectUniformBlocks()
+		{
+			static const char* blockNames[MAX_UNIFORM_BLOCKS] = {"CameraData","LightData","ShadowData","ObjectData","SkinData"};
+			uniformBlocks = 0;
+
+			for(unsigned int i = 0; i < MAX_UNIFORM_BLOCKS; ++i)
+			{
+				GLuint blockIndex = glGetUniformBlockIndex(shaderProgram,blockNames[i]);
+				if(blockIndex == GL_INVALID_INDEX)
+					continue;
+				glUniformBlockBinding(shaderProgram,blockIndex,i);
+				uniformBlocks |= 1 << i;
+			}
+		}
+
+		/**
+		 * Method is used to set shadow cascade and light cluster samplers used by linked shader program to
+		 * fixed texture units. Samplers which are not used by program are skipped.
+		 */
+		void Shader::bindFixedSamplers()
+		{
+			static const char* samplerNames[4] = {"cascadeShadowTexture","clusterGrid","clusterIndices","clusterLights"};
+			glUseProgram(shaderProgram);
+			for(unsigned int i = 0; i < 4; ++i)
+			{
+				GLint location = glGetUniformLocation(shaderProgram,samplerNames[i]);
+				if(location >= 0)
+					glUniform1i(location,CASCADE_SHADOW_UNIT + i);
+			}
+			glUseProgram(0);
+		}
+
+		/**
+		 * Method is used to check if shader program use engine uniform block.
+		 * @param	binding is uniform block binding point.
+		 * @return	true if program use uniform block.
+		 */
+		bool Shader::hasUniformBlock(const UniformBlockBinding binding) const
+		{
+			return (uniformBlocks & (1 << binding)) != 0;
+		}
+
 		/**
 		 * Method is used to set uniform float value to shader program.
 		 * @param	name is uniform name which is used to shader program.
@@ -126,7 +327,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniformf(const string& name, const float value)
 		{
-			glUniform1f(glGetUniformLocation(shaderProgram,name.c_str()),value);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,&value,sizeof(float)))
+				glUniform1f(uniform->location,value);
 		}
 
 		/**
@@ -136,7 +339,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniformi(const string& name, const int value)
 		{
-			glUniform1i(glGetUniformLocation(shaderProgram,name.c_str()),value);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,&value,sizeof(int)))
+				glUniform1i(uniform->location,value);
 		}
 
 		/**
@@ -147,7 +352,10 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniform2f(const string& name, const float value, const float value2)
 		{
-			glUniform2f(glGetUniformLocation(shaderProgram,name.c_str()),value,value2);
+			const float valueArray[2] = {value,value2};
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,valueArray,2*sizeof(float)))
+				glUniform2f(uniform->location,value,value2);
 		}
 
 		/**
@@ -157,7 +365,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniform3fv(const string& name, const float* valueArray)
 		{
-			glUniform3fv(glGetUniformLocation(shaderProgram,name.c_str()),1,valueArray);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,valueArray,3*sizeof(float)))
+				glUniform3fv(uniform->location,1,valueArray);
 		}
 
 		/**
@@ -167,7 +377,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniform4fv(const string&name, const float* valueArray)
 		{
-			glUniform4fv(glGetUniformLocation(shaderProgram,name.c_str()),1,valueArray);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,valueArray,4*sizeof(float)))
+				glUniform4fv(uniform->location,1,valueArray);
 		}
 
 		/**
@@ -177,7 +389,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniformTexture(const string& name, const int unit)
 		{
-			glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), unit);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,&unit,sizeof(int)))
+				glUniform1i(uniform->location,unit);
 		}
 
 		/**
@@ -187,7 +401,9 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniformMatrix3fv(const string& name,const float* valueArray)
 		{
-			glUniformMatrix3fv(glGetUniformLocation(shaderProgram,name.c_str()),1,GL_FALSE,valueArray);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,valueArray,9*sizeof(float)))
+				glUniformMatrix3fv(uniform->location,1,GL_FALSE,valueArray);
 		}
 
 		/**
@@ -197,7 +413,161 @@ namespace AyumiEngine
 		 */
 		void Shader::setUniformMatrix4fv(const string& name, const float* valueArray)
 		{
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram,name.c_str()),1,GL_FALSE,valueArray);
+			ShaderUniform* uniform = findUniform(name);
+			if(isUniformChanged(uniform,valueArray,16*sizeof(float)))
+				glUniformMatrix4fv(uniform->location,1,GL_FALSE,valueArray);
+		}
+
+		/**
+		 * Method is used to set uniform float value to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	value is uniform value.
+		 */
+		void Shader::setUniformf(const UniformHandle handle, const float value)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,&value,sizeof(float)))
+				glUniform1f(uniform->location,value);
+		}
+
+		/**
+		 * Method is used to set uniform int value to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	value is uniform value.
+		 */
+		void Shader::setUniformi(const UniformHandle handle, const int value)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,&value,sizeof(int)))
+				glUniform1i(uniform->location,value);
+		}
+
+		/**
+		 * Method is used to set uniform float vec2 to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	value is uniform vec2 first value.
+		 * @param	value is uniform vec2 second value.
+		 */
+		void Shader::setUniform2f(const UniformHandle handle, const float value, const float value2)
+		{
+			const float valueArray[2] = {value,value2};
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,valueArray,2*sizeof(float)))
+				glUniform2f(uniform->location,value,value2);
+		}
+
+		/**
+		 * Method is used to set uniform float 3-element array to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	valueArray is pointer to uniform float array.
+		 */
+		void Shader::setUniform3fv(const UniformHandle handle, const float* valueArray)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,valueArray,3*sizeof(float)))
+				glUniform3fv(uniform->location,1,valueArray);
+		}
+
+		/**
+		 * Method is used to set uniform float 4-element array to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	valueArray is pointer to uniform float array.
+		 */
+		void Shader::setUniform4fv(const UniformHandle handle, const float* valueArray)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,valueArray,4*sizeof(float)))
+				glUniform4fv(uniform->location,1,valueArray);
+		}
+
+		/**
+		 * Method is used to set uniform texture unit to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	unit is uniform texture unit.
+		 */
+		void Shader::setUniformTexture(const UniformHandle handle, const int unit)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,&unit,sizeof(int)))
+				glUniform1i(uniform->location,unit);
+		}
+
+		/**
+		 * Method is used to set uniform float 3x3 matrix to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	valueArray is pointer to uniform float array.
+		 */
+		void Shader::setUniformMatrix3fv(const UniformHandle handle, const float* valueArray)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,valueArray,9*sizeof(float)))
+				glUniformMatrix3fv(uniform->location,1,GL_FALSE,valueArray);
+		}
+
+		/**
+		 * Method is used to set uniform float 4x4 matrix to shader program.
+		 * @param	handle is pre-hashed uniform name.
+		 * @param	valueArray is pointer to uniform float array.
+		 */
+		void Shader::setUniformMatrix4fv(const UniformHandle handle, const float* valueArray)
+		{
+			ShaderUniform* uniform = findUniform(handle);
+			if(isUniformChanged(uniform,valueArray,16*sizeof(float)))
+				glUniformMatrix4fv(uniform->location,1,GL_FALSE,valueArray);
+		}
+
+		/**
+		 * Method is used to calculate uniform handle - FNV-1a hash of uniform name. Handles can be calculated
+		 * once and stored by shader users instead of uniform names.
+		 * @param	name is uniform name.
+		 * @return	uniform handle.
+		 */
+		UniformHandle Shader::getUniformHandle(const char* name)
+		{
+			UniformHandle hash = 2166136261u;
+			for(; *name != '\0'; ++name)
+			{
+				hash ^= static_cast<unsigned char>(*name);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		/**
+		 * Accessor to amount of all uniform set calls of all shaders.
+		 * @return	amount of uniform set calls.
+		 */
+		unsigned int Shader::getUniformCalls()
+		{
+			return uniformCalls;
+		}
+
+		/**
+		 * Accessor to amount of uniform set calls which was not send to OpenGL because value was unchanged.
+		 * @return	amount of avoided uniform calls.
+		 */
+		unsigned int Shader::getAvoidedUniformCalls()
+		{
+			return avoidedUniformCalls;
+		}
+
+		/**
+		 * Accessor to amount of uniform set calls of uniforms which are not active in program.
+		 * @return	amount of missing uniform calls.
+		 */
+		unsigned int Shader::getMissingUniformCalls()
+		{
+			return missingUniformCalls;
+		}
+
+		/**
+		 * Method is used to reset uniform calls counters.
+		 */
+		void Shader::resetUniformStatistics()
+		{
+			uniformCalls = 0;
+			avoidedUniformCalls = 0;
+			missingUniformCalls = 0;
 		}
 
 		/**
@@ -209,6 +579,16 @@ namespace AyumiEngine
 			return shaderProgram;
 		}
 
+		/**
+		 * Accessor to instance matrix attribute location. Shaders which support hardware instancing read
+		 * model matrix from instanceMatrix attribute (four locations).
+		 * @return	attribute location or -1 if shader do not support instancing.
+		 */
+		GLint Shader::getInstanceAttribute() const
+		{
+			return instanceAttribute;
+		}
+
 		/**
 		 * Accessor to shader vertex program private member.
 		 * @return	vertex shader program.
@@ -262,5 +642,114 @@ namespace AyumiEngine
 		{
 			geometryPath = path;
 		}
+
+		/**
+		 * Private method which is used to add reflected uniform to uniform collection. If handle of uniform
+		 * name is equal to handle of other uniform name, collision is logged and both uniforms are moved to
+		 * collection of uniforms found by name, so handle does not select wrong uniform.
+		 * @param	name is uniform name.
+		 * @param	location is uniform location in program.
+		 * @param	type is uniform OpenGL type.
+		 * @param	names is reference to names of uniforms added by reflection, stored under their handles.
+		 */
+		void Shader::addUniform(const string& name, const GLint location, const GLenum type, UniformNames& names)
+		{
+			ShaderUniform uniform;
+			uniform.location = location;
+			uniform.type = type;
+			uniform.initialized = false;
+			memset(uniform.value,0,sizeof(uniform.value));
+			const UniformHandle handle = getUniformHandle(name.c_str());
+			pair<UniformNames::iterator,bool> result = names.insert(make_pair(handle,name));
+			if(result.second)
+			{
+				uniforms.insert(make_pair(handle,uniform));
+				return;
+			}
+			if((*result.first).second == name)
+				return;
+
+			Logger::getInstance()->saveLog(Log<string>("Shader uniform handle collision detected: "));
+			Logger::getInstance()->saveLog(Log<string>(resourceName));
+			Logger::getInstance()->saveLog(Log<string>((*result.first).second + " and " + name));
+			ShaderUniforms::iterator it = uniforms.find(handle);
+			if(it != uniforms.end())
+			{
+				namedUniforms.insert(make_pair((*result.first).second,(*it).second));
+				uniforms.erase(it);
+			}
+			namedUniforms.insert(make_pair(name,uniform));
+		}
+
+		/**
+		 * Private method which is used to find reflected uniform. If program was linked outside of Shader
+		 * class uniforms are reflected at first use.
+		 * @param	handle is pre-hashed uniform name.
+		 * @return	pointer to uniform or nullptr if uniform is not active in program.
+		 */
+		ShaderUniform* Shader::findUniform(const UniformHandle handle)
+		{
+			if(!uniformsReflected)
+				reflectUniforms();
+			ShaderUniforms::iterator it = uniforms.find(handle);
+			if(it == uniforms.end())
+				return nullptr;
+			return &(*it).second;
+		}
+
+		/**
+		 * Private method which is used to find reflected uniform by name. Uniforms which handles collide are
+		 * found by name, other uniforms are found by handle.
+		 * @param	name is uniform name.
+		 * @return	pointer to uniform or nullptr if uniform is not active in program.
+		 */
+		ShaderUniform* Shader::findUniform(const string& name)
+		{
+			if(!uniformsReflected)
+				reflectUniforms();
+			if(!namedUniforms.empty())
+			{
+				NamedShaderUniforms::iterator it = namedUniforms.find(name);
+				if(it != namedUniforms.end())
+					return &(*it).second;
+			}
+			return findUniform(getUniformHandle(name.c_str()));
+		}
+
+		/**
+		 * Private method which is used to compare new uniform value with shadow copy and update it.
+		 * @param	uniform is pointer to reflected uniform.
+		 * @param	value is pointer to new value.
+		 * @param	size is size of value in bytes.
+		 * @return	true if value must be send to program.
+		 */
+		bool Shader::isUniformChanged(ShaderUniform* uniform, const void* value, const unsigned int size)
+		{
+			uniformCalls++;
+			if(uniform == nullptr)
+			{
+				missingUniformCalls++;
+				return false;
+			}
+			if(uniform->initialized && memcmp(uniform->value,value,size) == 0)
+			{
+				avoidedUniformCalls++;
+				return false;
+			}
+			memcpy(uniform->value,value,size);
+			uniform->initialized = true;
+			return true;
+		}
+
+		/**
+		 * Private method which is used to reflect linked program - uniform locations, uniform blocks, fixed
+		 * samplers and instance attribute.
+		 */
+		void Shader::initializeLinkedProgram()
+		{
+			reflectUniforms();
+			bindFixedSamplers();
+			instanceAttribute = glGetAttribLocation(shaderProgram,"instanceMatrix");
+		}
 	}
 }
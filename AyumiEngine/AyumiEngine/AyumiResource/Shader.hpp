@@ -10,8 +10,12 @@
 
 #include <GL/glew.h>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "Resource.hpp"
+#include "ShaderUniform.hpp"
 
 namespace AyumiEngine
 {
@@ -22,6 +26,12 @@ namespace AyumiEngine
 		 * language which is used to communicate with GPU. There are three types of shaders: vertex,
 		 * geometry and fragment. There are used to render and rasterize geoemtry, create all kind of
 		 * spiecial effects, post-processing, lights, material, geoemtry etc. 
+		 * Uniform locations are reflected once after program link and uniforms can be addressed by pre-hashed
+		 * handles. Shader keep shadow copy of uniform values and skip upload of unchanged data. Engine uniform
+		 * blocks used by program are bound to fixed binding points. Uniforms which names have equal handles are
+		 * logged and stored only under their names, so they must be set by name.
+		 * Program can be linked in two steps, so links of many programs are issued before their status is
+		 * queried, or it can be created from program binary.
 		 */
 		class Shader : public Resource
 		{
@@ -33,6 +43,20 @@ namespace AyumiEngine
 			const char* vertexPath;
 			const char* fragmentPath;
 			const char* geometryPath;
+			ShaderUniforms uniforms;
+			NamedShaderUniforms namedUniforms;
+			bool uniformsReflected;
+			unsigned int uniformBlocks;
+			GLint instanceAttribute;
+			static unsigned int uniformCalls;
+			static unsigned int avoidedUniformCalls;
+			static unsigned int missingUniformCalls;
+
+			void addUniform(const std::string& name, const GLint location, const GLenum type, UniformNames& names);
+			ShaderUniform* findUniform(const UniformHandle handle);
+			ShaderUniform* findUniform(const std::string& name);
+			bool isUniformChanged(ShaderUniform* uniform, const void* value, const unsigned int size);
+			void initializeLinkedProgram();
 
 		public:
 			Shader();
@@ -45,6 +69,15 @@ namespace AyumiEngine
 			void createVertexShader();
 			void createGeometryShader();
 			void createFragmentShader();
+			void linkShaderProgram();
+			void startLinkShaderProgram(const bool binaryRetrievable);
+			bool finishLinkShaderProgram();
+			bool loadProgramBinary(const GLenum binaryFormat, const void* binary, const GLsizei length);
+			bool getProgramBinary(GLenum& binaryFormat, std::vector<unsigned char>& binary) const;
+			void reflectUniforms();
+			void reflectUniformBlocks();
+			void bindFixedSamplers();
+			bool hasUniformBlock(const UniformBlockBinding binding) const;
 			void setUniformf(const std::string& name, const float value);
 			void setUniformi(const std::string& name, const int value);
 			void setUniform2f(const std::string& name, const float value, const float value2);
@@ -53,15 +86,32 @@ namespace AyumiEngine
 			void setUniformTexture(const std::string& name, const int unit);
 			void setUniformMatrix3fv(const std::string& name,const float* valueArray);
 			void setUniformMatrix4fv(const std::string& name,const float* valueArray);
+			void setUniformf(const UniformHandle handle, const float value);
+			void setUniformi(const UniformHandle handle, const int value);
+			void setUniform2f(const UniformHandle handle, const float value, const float value2);
+			void setUniform3fv(const UniformHandle handle, const float* valueArray);
+			void setUniform4fv(const UniformHandle handle, const float* valueArray);
+			void setUniformTexture(const UniformHandle handle, const int unit);
+			void setUniformMatrix3fv(const UniformHandle handle, const float* valueArray);
+			void setUniformMatrix4fv(const UniformHandle handle, const float* valueArray);
+
+			static UniformHandle getUniformHandle(const char* name);
+			static unsigned int getUniformCalls();
+			static unsigned int getAvoidedUniformCalls();
+			static unsigned int getMissingUniformCalls();
+			static void resetUniformStatistics();
 
 			unsigned int getShaderProgram() const;
 			unsigned int getShaderVertex() const;
 			unsigned int getShaderGeometry() const;
 			unsigned int getShaderFragment() const;
+			GLint getInstanceAttribute() const;
 			void setVertexPath(const char* path);
 			void setFragmentPath(const char* path);
 			void setGeometryPath(const char* path);
 		};
+
+		typedef boost::shared_ptr<Shader> ShaderResource;
 	}
 }
 #endif
@@ -0,0 +1,183 @@
+/**
+ * File contains definition of ShaderCache class.
+ * @file    ShaderCache.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-22
+ */
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <boost/filesystem.hpp>
+
+#include "ShaderCache.hpp"
+
+using namespace std;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	cacheDirectory is path of directory with cache files, it must end with separator.
+		 */
+		ShaderCache::ShaderCache(const string& cacheDirectory)
+		{
+			this->cacheDirectory = cacheDirectory;
+			cacheEnabled = false;
+		}
+
+		/**
+		 * Class destructor. Nothing to delete.
+		 */
+		ShaderCache::~ShaderCache()
+		{
+
+		}
+
+		/**
+		 * Method is used to create cache directory. Cache is disabled when directory can not be created.
+		 * @param	driverName is string which identify driver - vendor, renderer and version.
+		 */
+		void ShaderCache::initializeCache(const string& driverName)
+		{
+			this->driverName = driverName;
+
+			boost::system::error_code error;
+			boost::filesystem::create_directories(cacheDirectory,error);
+			cacheEnabled = !error;
+			if(!cacheEnabled)
+				Logger::getInstance()->saveLog(Log<string>("Shader cache directory creating error occurred: " + cacheDirectory));
+		}
+
+		/**
+		 * Method is used to calculate program key. Key is 64-bit FNV-1a hash of program sources, cache version
+		 * and driver string.
+		 * @param	vertexSource is vertex shader source.
+		 * @param	geometrySource is geometry shader source, empty when program has no geometry shader.
+		 * @param	fragmentSource is fragment shader source.
+		 * @return	program key.
+		 */
+		unsigned long long ShaderCache::getProgramKey(const string& vertexSource, const string& geometrySource, const string& fragmentSource) const
+		{
+			const string* sources[4] = {&vertexSource, &geometrySource, &fragmentSource, &driverName};
+			unsigned long long hash = 14695981039346656037ULL;
+			for(unsigned int i = 0; i < 4; ++i)
+			{
+				const string& source = *sources[i];
+				for(unsigned int j = 0; j < source.size(); ++j)
+					hash = (hash ^ static_cast<unsigned char>(source[j]))*1099511628211ULL;
+				hash = (hash ^ 0xFF)*1099511628211ULL;
+			}
+			hash = (hash ^ SHADER_CACHE_VERSION)*1099511628211ULL;
+			return hash;
+		}
+
+		/**
+		 * Method is used to create program of shader from cached binary.
+		 * @param	programKey is program key.
+		 * @param	shader is pointer to shader with created program object.
+		 * @return	false if there is no valid cached binary or driver rejected it.
+		 */
+		bool ShaderCache::loadProgram(const unsigned long long programKey, Shader* shader) const
+		{
+			if(!cacheEnabled)
+				return false;
+
+			ifstream cacheFile(getCachePath(programKey).c_str(),ios::in | ios::binary);
+			if(!cacheFile.is_open())
+				return false;
+
+			char magic[4];
+			unsigned int version = 0;
+			unsigned long long cachedKey = 0;
+			unsigned int driverLength = 0;
+			cacheFile.read(magic,4);
+			cacheFile.read(reinterpret_cast<char*>(&version),sizeof(version));
+			cacheFile.read(reinterpret_cast<char*>(&cachedKey),sizeof(cachedKey));
+			cacheFile.read(reinterpret_cast<char*>(&driverLength),sizeof(driverLength));
+			if(!cacheFile || memcmp(magic,"AYPB",4) != 0 || version != SHADER_CACHE_VERSION || cachedKey != programKey || driverLength != driverName.size())
+				return false;
+
+			string cachedDriver(driverLength,'\0');
+			if(driverLength > 0)
+				cacheFile.read(&cachedDriver[0],driverLength);
+			if(!cacheFile || cachedDriver != driverName)
+				return false;
+
+			GLenum binaryFormat = 0;
+			GLsizei length = 0;
+			cacheFile.read(reinterpret_cast<char*>(&binaryFormat),sizeof(binaryFormat));
+			cacheFile.read(reinterpret_cast<char*>(&length),sizeof(length));
+			if(!cacheFile || length <= 0)
+				return false;
+
+			vector<unsigned char> binary(length);
+			cacheFile.read(reinterpret_cast<char*>(&binary[0]),length);
+			if(!cacheFile)
+				return false;
+
+			return shader->loadProgramBinary(binaryFormat,&binary[0],length);
+		}
+
+		/**
+		 * Method is used to save binary of linked program into cache. Binary is written into temporary file
+		 * which replace cache file.
+		 * @param	programKey is program key.
+		 * @param	shader is pointer to shader with linked program.
+		 */
+		void ShaderCache::saveProgram(const unsigned long long programKey, Shader* shader) const
+		{
+			GLenum binaryFormat = 0;
+			vector<unsigned char> binary;
+			if(!cacheEnabled || !shader->getProgramBinary(binaryFormat,binary))
+				return;
+
+			const string cachePath = getCachePath(programKey);
+			const string temporaryPath = cachePath + ".tmp";
+			ofstream cacheFile(temporaryPath.c_str(),ios::out | ios::binary | ios::trunc);
+			if(!cacheFile.is_open())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Shader cache file opening error occurred: " + cachePath));
+				return;
+			}
+
+			const unsigned int driverLength = driverName.size();
+			const GLsizei length = binary.size();
+			cacheFile.write("AYPB",4);
+			cacheFile.write(reinterpret_cast<const char*>(&SHADER_CACHE_VERSION),sizeof(SHADER_CACHE_VERSION));
+			cacheFile.write(reinterpret_cast<const char*>(&programKey),sizeof(programKey));
+			cacheFile.write(reinterpret_cast<const char*>(&driverLength),sizeof(driverLength));
+			cacheFile.write(driverName.c_str(),driverLength);
+			cacheFile.write(reinterpret_cast<const char*>(&binaryFormat),sizeof(binaryFormat));
+			cacheFile.write(reinterpret_cast<const char*>(&length),sizeof(length));
+			cacheFile.write(reinterpret_cast<const char*>(&binary[0]),length);
+			const bool written = cacheFile.good();
+			cacheFile.close();
+
+			boost::system::error_code error;
+			if(written)
+				boost::filesystem::rename(temporaryPath,cachePath,error);
+			if(!written || error)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Shader cache writing error occurred: " + cachePath));
+				boost::filesystem::remove(temporaryPath,error);
+			}
+		}
+
+		/**
+		 * Private method which is used to get cache file path of program.
+		 * @param	programKey is program key.
+		 * @return	cache file path.
+		 */
+		string ShaderCache::getCachePath(const unsigned long long programKey) const
+		{
+			ostringstream cachePath;
+			cachePath << cacheDirectory << hex << setw(16) << setfill('0') << programKey << ".program";
+			return cachePath.str();
+		}
+	}
+}
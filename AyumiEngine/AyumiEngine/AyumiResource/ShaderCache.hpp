@@ -0,0 +1,50 @@
+/**
+ * File contains declaration of ShaderCache class.
+ * @file    ShaderCache.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-22
+ */
+
+#ifndef SHADERCACHE_HPP
+#define SHADERCACHE_HPP
+
+#include <string>
+
+#include "Shader.hpp"
+
+#include "../Logger.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int SHADER_CACHE_VERSION = 1;
+
+		/**
+		 * Class represents on-disk cache of linked program binaries. Program key is hash of shader sources
+		 * (with resolved includes), engine attribute layout version and driver string, so binaries are not
+		 * reused after shader or driver update. Driver string is also stored in cache file and compared
+		 * before binary is passed to driver.
+		 */
+		class ShaderCache : private AyumiUtils::Noncopyable
+		{
+		private:
+			std::string cacheDirectory;
+			std::string driverName;
+			bool cacheEnabled;
+
+			std::string getCachePath(const unsigned long long programKey) const;
+
+		public:
+			ShaderCache(const std::string& cacheDirectory);
+			~ShaderCache();
+
+			void initializeCache(const std::string& driverName);
+			unsigned long long getProgramKey(const std::string& vertexSource, const std::string& geometrySource, const std::string& fragmentSource) const;
+			bool loadProgram(const unsigned long long programKey, Shader* shader) const;
+			void saveProgram(const unsigned long long programKey, Shader* shader) const;
+		};
+	}
+}
+#endif
@@ -5,6 +5,9 @@
  * @date    2011-08-10
  */
 
+#include <cstring>
+#include <algorithm>
+
 #include "ShaderFactory.hpp"
 
 using namespace std;
@@ -14,11 +17,12 @@ namespace AyumiEngine
 	namespace AyumiResource
 	{
 		/**
-		 * Class default constructor. Nothing to do.
+		 * Class default constructor. Program binaries are cached in Data/Cache directory.
 		 */
-		ShaderFactory::ShaderFactory()
+		ShaderFactory::ShaderFactory() : shaderCache("Data/Cache/")
 		{
-
+			memset(&statistics,0,sizeof(ShaderLoadingStatistics));
+			binarySupported = false;
 		}
 
 		/**
@@ -29,6 +33,37 @@ namespace AyumiEngine
 
 		}
 
+		/**
+		 * Method is used to initialize shader factory. Program binary cache is used when driver support at
+		 * least one program binary format, driver shader compiler threads are enabled when driver support
+		 * parallel shader compilation.
+		 */
+		void ShaderFactory::initializeFactory()
+		{
+			if(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+			{
+				GLint binaryFormats = 0;
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS,&binaryFormats);
+				binarySupported = binaryFormats > 0;
+			}
+
+			string driverName;
+			const GLenum driverStrings[4] = {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION};
+			for(unsigned int i = 0; i < 4; ++i)
+			{
+				const GLubyte* driverString = glGetString(driverStrings[i]);
+				if(driverString != nullptr)
+					driverName += reinterpret_cast<const char*>(driverString);
+				driverName += '|';
+			}
+			shaderCache.initializeCache(driverName);
+
+#ifdef GL_KHR_parallel_shader_compile
+			if(GLEW_KHR_parallel_shader_compile)
+				glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+#endif
+		}
+
 		/**
 		 * Method is used to create shader resource. It implement Factory Method, depends on resource name
 		 * factory choose creating method.
@@ -40,155 +75,261 @@ namespace AyumiEngine
 		 * @return	loaded and created shader resource, or nullptr when and logger error type is
 		 *			not supported.
 		 */
-		Shader* ShaderFactory::createShaderResource(const string& name, const string& type, const string& vertPath, const string& geomPath, const string& fragPath)
+		ShaderResource ShaderFactory::createShaderResource(const string& name, const string& type, const string& vertPath, const string& geomPath, const string& fragPath)
 		{
-			Shader* shaderResource = nullptr;
+			ShaderResource shaderResource;
 
 			if(type == "VertexFragment")
 				shaderResource = createVertexFragmentShader(name,vertPath,fragPath);
 			else if(type == "VertexGeometryFragment")
 				shaderResource = createVertexGeometryFragmentShader(name,vertPath,geomPath,fragPath);
 			else
-			{
 				Logger::getInstance()->saveLog(Log<string>("Undefined shader type requested!"));
-				shaderResource = nullptr;
-			}
 
 			return shaderResource;
 		}
 
 		/**
-		 * Method is used to create Shader object. Create Vertex and Fragment shaders, validate it, compile
-		 * and create shader program.
+		 * Method is used to finish all pending programs. Links are issued for all programs first, compile and
+		 * link status are queried afterwards, so driver is not waited for after each program. Linked programs
+		 * are saved in program binary cache.
+		 */
+		void ShaderFactory::finishShaders()
+		{
+			for(vector<PendingShader>::iterator it = pendingShaders.begin(); it != pendingShaders.end(); ++it)
+				(*it).shader->startLinkShaderProgram(binarySupported);
+
+			for(vector<PendingShader>::iterator it = pendingShaders.begin(); it != pendingShaders.end(); ++it)
+			{
+				Shader* shader = (*it).shader.get();
+				bool compiled = checkShaderCompile(shader->getShaderVertex(),(*it).name);
+				if(shader->getShaderGeometry() != 0)
+					compiled &= checkShaderCompile(shader->getShaderGeometry(),(*it).name);
+				compiled &= checkShaderCompile(shader->getShaderFragment(),(*it).name);
+
+				if(shader->finishLinkShaderProgram() && compiled)
+				{
+					statistics.compiledPrograms++;
+					if(binarySupported)
+						shaderCache.saveProgram((*it).programKey,shader);
+				}
+				else
+					statistics.failedPrograms++;
+			}
+			pendingShaders.clear();
+		}
+
+		/**
+		 * Method is used to add time of shader resource script to loading statistics.
+		 * @param	loadingTime is loading time in seconds.
+		 */
+		void ShaderFactory::addLoadingTime(const float loadingTime)
+		{
+			statistics.loadingTime += loadingTime;
+		}
+
+		/**
+		 * Accessor to shader loading statistics.
+		 * @return	reference to loading statistics.
+		 */
+		const ShaderLoadingStatistics& ShaderFactory::getLoadingStatistics() const
+		{
+			return statistics;
+		}
+
+		/**
+		 * Method is used to create Shader object. Load Vertex and Fragment shaders sources and create shader
+		 * program.
 		 * @param	name is shader name.
 		 * @param	vertPath is source code of Vertex Shader.
 		 * @param	fragPath is source code of Fragment Shader.
-		 * @return	loaded and created shader resource, or nullptr when and logger error type is
-		 *			not supported.
+		 * @return	created shader resource.
 		 */	
-		Shader* ShaderFactory::createVertexFragmentShader(const string& name, const string& vertPath, const string& fragPath)
+		ShaderResource ShaderFactory::createVertexFragmentShader(const string& name, const string& vertPath, const string& fragPath)
 		{
-			Shader* shaderResource = nullptr;
-
-			shaderResource = new Shader(name.c_str());
+			ShaderResource shaderResource(new Shader(name.c_str()));
 			shaderResource->setVertexPath(vertPath.c_str());
 			shaderResource->setFragmentPath(fragPath.c_str());
 
-			shaderResource->createVertexShader();
-			shaderResource->createFragmentShader();
-			
-			const char* vertexShaderSource = loadShaderSource(vertPath.c_str());
-			const char* fragmentShaderSource = loadShaderSource(fragPath.c_str());
-
-			if(vertexShaderSource == nullptr || fragmentShaderSource == nullptr)
+			string vertexShaderSource;
+			string fragmentShaderSource;
+			if(!loadShaderSource(vertPath,vertexShaderSource) || !loadShaderSource(fragPath,fragmentShaderSource))
 			{
 				Logger::getInstance()->saveLog(Log<string>("Shader loading error detected: "));
 				Logger::getInstance()->saveLog(Log<string>(name));
 			}
-			
-			glShaderSource(shaderResource->getShaderVertex(),1,&vertexShaderSource,0);
-			glShaderSource(shaderResource->getShaderFragment(),1,&fragmentShaderSource,0);	
-			glCompileShader(shaderResource->getShaderVertex());
-			glCompileShader(shaderResource->getShaderFragment());
-			shaderResource->createShaderProgram();
-			glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderVertex());
-			glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderFragment());
-			glLinkProgram(shaderResource->getShaderProgram());
 
-			delete vertexShaderSource;
-			delete fragmentShaderSource;
-
-			return shaderResource;
+			return createShaderProgram(shaderResource,name,vertexShaderSource,string(),fragmentShaderSource);
 		}
 
 		/**
-		 * Method is used to create Shader object. Create Vertex, Geometry and Fragment shaders, validate it, compile
-		 * and create shader program.
+		 * Method is used to create Shader object. Load Vertex, Geometry and Fragment shaders sources and create
+		 * shader program.
 		 * @param	name is shader name.
 		 * @param	vertPath is source code of Vertex Shader.
 		 * @param	geomPath is source code of Geometry Shader.
 		 * @param	fragPath is source code of Fragment Shader.
-		 * @return	loaded and created shader resource, or nullptr when and logger error type is
-		 *			not supported.
+		 * @return	created shader resource.
 		 */	
-		Shader* ShaderFactory::createVertexGeometryFragmentShader(const string& name, const string& vertPath, const string& geomPath, const string& fragPath)
+		ShaderResource ShaderFactory::createVertexGeometryFragmentShader(const string& name, const string& vertPath, const string& geomPath, const string& fragPath)
 		{
-			Shader* shaderResource = nullptr;
-			
-			shaderResource = new Shader(name.c_str());
+			ShaderResource shaderResource(new Shader(name.c_str()));
 			shaderResource->setVertexPath(vertPath.c_str());
 			shaderResource->setGeometryPath(geomPath.c_str());
 			shaderResource->setFragmentPath(fragPath.c_str());
 
-			shaderResource->createVertexShader();
-			shaderResource->createGeometryShader();
-			shaderResource->createFragmentShader();
-			
-			const char* vertexShaderSource = loadShaderSource(vertPath.c_str());
-			const char* geometryShaderSource = loadShaderSource(geomPath.c_str());
-			const char* fragmentShaderSource = loadShaderSource(fragPath.c_str());
-
-			if(vertexShaderSource == nullptr || geometryShaderSource == nullptr || fragmentShaderSource == nullptr)
+			string vertexShaderSource;
+			string geometryShaderSource;
+			string fragmentShaderSource;
+			if(!loadShaderSource(vertPath,vertexShaderSource) || !loadShaderSource(geomPath,geometryShaderSource) || !loadShaderSource(fragPath,fragmentShaderSource))
 			{
 				Logger::getInstance()->saveLog(Log<string>("Shader loading error detected: "));
 				Logger::getInstance()->saveLog(Log<string>(name));
 			}
-			
+
+			return createShaderProgram(shaderResource,name,vertexShaderSource,geometryShaderSource,fragmentShaderSource);
+		}
+
+		/**
+		 * Private method which is used to create shader program. Program is loaded from program binary cache,
+		 * otherwise shaders are compiled and program is added to pending programs which are linked by
+		 * finishShaders.
+		 * @param	shaderResource is shader resource.
+		 * @param	name is shader name.
+		 * @param	vertexSource is vertex shader source.
+		 * @param	geometrySource is geometry shader source, empty when program has no geometry shader.
+		 * @param	fragmentSource is fragment shader source.
+		 * @return	created shader resource.
+		 */
+		ShaderResource ShaderFactory::createShaderProgram(ShaderResource shaderResource, const string& name, const string& vertexSource, const string& geometrySource, const string& fragmentSource)
+		{
+			shaderResource->createShaderProgram();
+
+			const unsigned long long programKey = shaderCache.getProgramKey(vertexSource,geometrySource,fragmentSource);
+			if(binarySupported && shaderCache.loadProgram(programKey,shaderResource.get()))
+			{
+				statistics.cachedPrograms++;
+				return shaderResource;
+			}
+
+			const char* vertexShaderSource = vertexSource.c_str();
+			const char* geometryShaderSource = geometrySource.c_str();
+			const char* fragmentShaderSource = fragmentSource.c_str();
+
+			shaderResource->createVertexShader();
+			shaderResource->createFragmentShader();
 			glShaderSource(shaderResource->getShaderVertex(),1,&vertexShaderSource,0);
-			glShaderSource(shaderResource->getShaderGeometry(),1,&geometryShaderSource,0);
 			glShaderSource(shaderResource->getShaderFragment(),1,&fragmentShaderSource,0);
 			glCompileShader(shaderResource->getShaderVertex());
-			glCompileShader(shaderResource->getShaderGeometry());
 			glCompileShader(shaderResource->getShaderFragment());
-			shaderResource->createShaderProgram();
 			glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderVertex());
-			glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderGeometry());
 			glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderFragment());
-			glLinkProgram(shaderResource->getShaderProgram());
 
-			delete vertexShaderSource;
-			delete geometryShaderSource;
-			delete fragmentShaderSource;
+			if(!geometrySource.empty())
+			{
+				shaderResource->createGeometryShader();
+				glShaderSource(shaderResource->getShaderGeometry(),1,&geometryShaderSource,0);
+				glCompileShader(shaderResource->getShaderGeometry());
+				glAttachShader(shaderResource->getShaderProgram(),shaderResource->getShaderGeometry());
+			}
 
+			PendingShader pendingShader = {shaderResource, name, programKey};
+			pendingShaders.push_back(pendingShader);
 			return shaderResource;
 		}
 
 		/**
-		 * Method is used to load Shader source code from file.
+		 * Private method which is used to check compile status of shader. Compile errors are saved in log
+		 * with shader info log.
+		 * @param	shader is shader object id.
+		 * @param	name is shader resource name.
+		 * @return	true if shader was compiled.
+		 */
+		bool ShaderFactory::checkShaderCompile(const GLuint shader, const string& name)
+		{
+			GLint compileStatus = GL_FALSE;
+			glGetShaderiv(shader,GL_COMPILE_STATUS,&compileStatus);
+			if(compileStatus == GL_TRUE)
+				return true;
+
+			GLint logLength = 0;
+			glGetShaderiv(shader,GL_INFO_LOG_LENGTH,&logLength);
+			vector<char> infoLog(max(logLength,1));
+			glGetShaderInfoLog(shader,infoLog.size(),nullptr,&infoLog[0]);
+			Logger::getInstance()->saveLog(Log<string>("Shader compiling error detected: " + name));
+			Logger::getInstance()->saveLog(Log<string>(string(&infoLog[0])));
+			return false;
+		}
+
+		/**
+		 * Private method which is used to load Shader source code from file. Include directives are resolved.
 		 * @param	shaderFileName is path to shader program source code.
-		 * @return	loaded shader source code string.
+		 * @param	source is reference to loaded shader source code.
+		 * @return	false if file or included file could not be loaded.
 		 */
-		char* ShaderFactory::loadShaderSource(const char* shaderFileName)
+		bool ShaderFactory::loadShaderSource(const string& shaderFileName, string& source)
 		{
-			char* shaderSource = nullptr;
-    
-			if(shaderFileName != nullptr)
+			source.clear();
+			return appendShaderSource(shaderFileName,source,0) && !source.empty();
+		}
+
+		/**
+		 * Private method which is used to append shader source file to source code. Lines #include "file" are
+		 * replaced by included file content, path is relative to directory of including file. Shared
+		 * declarations (e.g. uniform blocks) are kept in one file this way.
+		 * @param	shaderFileName is path to shader source file.
+		 * @param	source is reference to destination source code.
+		 * @param	depth is current include depth.
+		 * @return	true if file and all included files were loaded.
+		 */
+		bool ShaderFactory::appendShaderSource(const string& shaderFileName, string& source, const unsigned int depth)
+		{
+			if(depth > MAX_INCLUDE_DEPTH)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Shader include depth exceeded: "));
+				Logger::getInstance()->saveLog(Log<string>(shaderFileName));
+				return false;
+			}
+
+			ifstream file;
+			file.open(shaderFileName.c_str(), ios::binary);
+			if(!file.is_open())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Shader source file loading error detected: "));
+				Logger::getInstance()->saveLog(Log<string>(shaderFileName));
+				return false;
+			}
+
+			const string::size_type separator = shaderFileName.find_last_of("/\\");
+			const string directory = separator == string::npos ? "" : shaderFileName.substr(0,separator + 1);
+			bool result = true;
+			string line;
+
+			while(getline(file,line))
 			{
-				ifstream file;
-				file.open(shaderFileName, ios::binary);
-		
-				if(file.is_open())
+				const string::size_type first = line.find_first_not_of(" \t");
+				if(first != string::npos && line.compare(first,8,"#include") == 0)
 				{
-					file.seekg(0,ios::end);
-					int count = static_cast<int>(file.tellg());
-					file.seekg(0,ios::beg);
-			
-					if(count > 0)
+					const string::size_type begin = line.find('"',first);
+					const string::size_type end = begin == string::npos ? string::npos : line.find('"',begin + 1);
+					if(end == string::npos)
 					{
-						shaderSource = new char[count + 1];
-						file.read(shaderSource, count * sizeof(char));
-						shaderSource[count] = '\0';
+						Logger::getInstance()->saveLog(Log<string>("Shader include directive error detected: "));
+						Logger::getInstance()->saveLog(Log<string>(shaderFileName));
+						result = false;
+						continue;
 					}
+					result &= appendShaderSource(directory + line.substr(begin + 1,end - begin - 1),source,depth + 1);
 				}
 				else
 				{
-					Logger::getInstance()->saveLog(Log<string>("Shader source file loading error detected: "));
-					Logger::getInstance()->saveLog(Log<string>(string(shaderFileName)));
+					source += line;
+					source += '\n';
 				}
-				file.close();
 			}
+			file.close();
 
-			return shaderSource;
+			return result;
 		}
 	}
 }
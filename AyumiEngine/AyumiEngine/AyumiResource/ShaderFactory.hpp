@@ -9,33 +9,74 @@
 #define SHADERFACTORY_HPP
 
 #include <string>
+#include <vector>
 
 #include "Shader.hpp"
+#include "ShaderCache.hpp"
 #include "../Logger.hpp"
 
 namespace AyumiEngine
 {
 	namespace AyumiResource	
 	{
+		const unsigned int MAX_INCLUDE_DEPTH = 8;
+
+		/**
+		 * Structure represents shader program which was compiled, but its link and status check were
+		 * deferred till all programs of loading script are compiled.
+		 */
+		struct PendingShader
+		{
+			ShaderResource shader;
+			std::string name;
+			unsigned long long programKey;
+		};
+
+		/**
+		 * Structure represents shader loading statistics. Loading time store time of resource scripts in
+		 * seconds, so cold (compiled) and warm (cached) startup can be compared.
+		 */
+		struct ShaderLoadingStatistics
+		{
+			unsigned int cachedPrograms;
+			unsigned int compiledPrograms;
+			unsigned int failedPrograms;
+			float loadingTime;
+		};
+
 		/**
 		 * Class represents one of Engine ResourceManager/ShaderManager subclass - ShaderFactory
 		 * which is used by ShaderManager to create all supported types of shader programs:
 		 * vertex+fragment, vertex+geometry+fragment. Class has methods to load and compile
 		 * all kind of shader resources and store it in ShaderManager class. It is implementation of
 		 * simple Factory design pattern.
+		 * Programs are loaded from program binary cache when it is possible. Other programs are compiled when
+		 * they are created and linked together in finishShaders, so driver can compile them in parallel.
 		 */
 		class ShaderFactory
 		{
 		private:
-			Shader* createVertexFragmentShader(const std::string& name, const std::string& vertPath, const std::string& fragPath);
-			Shader* createVertexGeometryFragmentShader(const std::string& names, const std::string& vertPath, const std::string& geomPath, const std::string& fragPath);
-			char* loadShaderSource(const char* shaderFileName);
+			ShaderCache shaderCache;
+			std::vector<PendingShader> pendingShaders;
+			ShaderLoadingStatistics statistics;
+			bool binarySupported;
+
+			ShaderResource createVertexFragmentShader(const std::string& name, const std::string& vertPath, const std::string& fragPath);
+			ShaderResource createVertexGeometryFragmentShader(const std::string& names, const std::string& vertPath, const std::string& geomPath, const std::string& fragPath);
+			ShaderResource createShaderProgram(ShaderResource shaderResource, const std::string& name, const std::string& vertexSource, const std::string& geometrySource, const std::string& fragmentSource);
+			bool checkShaderCompile(const GLuint shader, const std::string& name);
+			bool loadShaderSource(const std::string& shaderFileName, std::string& source);
+			bool appendShaderSource(const std::string& shaderFileName, std::string& source, const unsigned int depth);
 
 		public:
 			ShaderFactory();
 			~ShaderFactory();
 
-			Shader* createShaderResource(const std::string& name, const std::string& type, const std::string& vertPath, const std::string& geomPath, const std::string& fragPath);
+			void initializeFactory();
+			ShaderResource createShaderResource(const std::string& name, const std::string& type, const std::string& vertPath, const std::string& geomPath, const std::string& fragPath);
+			void finishShaders();
+			void addLoadingTime(const float loadingTime);
+			const ShaderLoadingStatistics& getLoadingStatistics() const;
 		};
 	}
 }
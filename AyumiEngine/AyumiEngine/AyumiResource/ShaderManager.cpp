@@ -5,9 +5,13 @@
  * @date    2011-07-12
  */
 
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
 #include "ShaderManager.hpp"
 
 using namespace std;
+using namespace boost::posix_time;
 
 namespace AyumiEngine
 {
@@ -22,6 +26,8 @@ namespace AyumiEngine
 			shaderFactory = new ShaderFactory();
 			resourceScript = new AyumiScript(scriptFileName);
 			prepareResourceScript();	
+
+			shaderFactory->initializeFactory();
 		}
 
 		/**
@@ -35,11 +41,18 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Method is used to execute resource loading script.
+		 * Method is used to execute resource loading script and finish programs compiled by script. Loading
+		 * time is stored in loading statistics and statistics of script are logged.
 		 */
 		void ShaderManager::initializeResources()
 		{
+			const ShaderLoadingStatistics previous = shaderFactory->getLoadingStatistics();
+			const ptime startTime = microsec_clock::universal_time();
 			resourceScript->executeScript();
+			shaderFactory->finishShaders();
+			const float loadingTime = (microsec_clock::universal_time() - startTime).total_microseconds()*0.000001f;
+			shaderFactory->addLoadingTime(loadingTime);
+			logLoadingStatistics(previous,loadingTime);
 		}
 
 		/**
@@ -48,8 +61,61 @@ namespace AyumiEngine
 		 */
 		void ShaderManager::updateResources(const string& scriptPath)
 		{
+			const ShaderLoadingStatistics previous = shaderFactory->getLoadingStatistics();
+			const ptime startTime = microsec_clock::universal_time();
 			resourceScript->setScriptFile(scriptPath.c_str());
 			resourceScript->executeScript();
+			shaderFactory->finishShaders();
+			const float loadingTime = (microsec_clock::universal_time() - startTime).total_microseconds()*0.000001f;
+			shaderFactory->addLoadingTime(loadingTime);
+			logLoadingStatistics(previous,loadingTime);
+		}
+
+		/**
+		 * Method is used to finish programs which are still compiled or linked by driver. Statistics are logged
+		 * only when some programs were finished.
+		 */
+		void ShaderManager::finishResources()
+		{
+			const ShaderLoadingStatistics previous = shaderFactory->getLoadingStatistics();
+			const ptime startTime = microsec_clock::universal_time();
+			shaderFactory->finishShaders();
+			const float loadingTime = (microsec_clock::universal_time() - startTime).total_microseconds()*0.000001f;
+			shaderFactory->addLoadingTime(loadingTime);
+			const ShaderLoadingStatistics& current = shaderFactory->getLoadingStatistics();
+			if(current.compiledPrograms != previous.compiledPrograms || current.failedPrograms != previous.failedPrograms)
+				logLoadingStatistics(previous,loadingTime);
+		}
+
+		/**
+		 * Accessor to shader loading statistics - amount of cached, compiled and failed programs and loading
+		 * time of resource scripts.
+		 * @return	reference to loading statistics.
+		 */
+		const ShaderLoadingStatistics& ShaderManager::getLoadingStatistics() const
+		{
+			return shaderFactory->getLoadingStatistics();
+		}
+
+		/**
+		 * Private method which is used to log amount of programs loaded from program binary cache, compiled
+		 * and failed since previous statistics and loading time, so cold and warm startup can be compared.
+		 * @param	previous is copy of loading statistics taken before loading.
+		 * @param	loadingTime is loading time in seconds.
+		 */
+		void ShaderManager::logLoadingStatistics(const ShaderLoadingStatistics& previous, const float loadingTime) const
+		{
+			const ShaderLoadingStatistics& current = shaderFactory->getLoadingStatistics();
+			string log = "Shader programs loaded, cached: ";
+			log += boost::lexical_cast<string>(current.cachedPrograms - previous.cachedPrograms);
+			log += ", compiled: ";
+			log += boost::lexical_cast<string>(current.compiledPrograms - previous.compiledPrograms);
+			log += ", failed: ";
+			log += boost::lexical_cast<string>(current.failedPrograms - previous.failedPrograms);
+			log += ", loading time: ";
+			log += boost::lexical_cast<string>(static_cast<unsigned int>(loadingTime*1000.0f));
+			log += " ms";
+			Logger::getInstance()->saveLog(Log<string>(log));
 		}
 
 		/**
@@ -78,9 +144,7 @@ namespace AyumiEngine
 		 */
 		void ShaderManager::registerResource(const string& name, const string& type, const string& vertPath, const string& fragPath)
 		{
-			Shader* shaderResource = nullptr;
-			shaderResource = shaderFactory->createShaderResource(name,type,vertPath,string(),fragPath);
-			addResource(name,ShaderResource(shaderResource));
+			addResource(name,shaderFactory->createShaderResource(name,type,vertPath,string(),fragPath));
 		}
 
 		/**
@@ -93,9 +157,7 @@ namespace AyumiEngine
 		 */
 		void ShaderManager::registerResource(const string& name, const string& type, const string& vertPath, const string& fragPath, const string& geomPath)
 		{
-			Shader* shaderResource = nullptr;
-			shaderResource = shaderFactory->createShaderResource(name,type,vertPath,geomPath,fragPath);
-			addResource(name,ShaderResource(shaderResource));
+			addResource(name,shaderFactory->createShaderResource(name,type,vertPath,geomPath,fragPath));
 		}
 
 		/**
@@ -18,12 +18,12 @@ namespace AyumiEngine
 {
 	namespace AyumiResource
 	{
-		typedef boost::shared_ptr<Shader> ShaderResource;
-
 		/**
 		 * Class represnets one of Engine ResourceManager subclass.  ShaderManager extends templated Manager pattern.
 		 * It is used to load and store Shader objects. It support loading of classic vertex and fragment shader and
 		 * building shader program. It use ShaderFactory to load supported resources. 
+		 * Programs registered by resource script are linked together after script is executed. Amount of cached,
+		 * compiled and failed programs and loading time are logged after each loading script.
 		 */
 		class ShaderManager : public AyumiUtils::Manager<std::string,ShaderResource>
 		{
@@ -36,12 +36,15 @@ namespace AyumiEngine
 			void registerResource(const std::string& name, const std::string& type, const std::string& vertPath, const std::string& fragPath, const std::string& geomPath);
 			void releaseResource(const std::string& name);
 			void clearResources();
+			void logLoadingStatistics(const ShaderLoadingStatistics& previous, const float loadingTime) const;
 		public:
 			ShaderManager(const char* scriptFileName);
 			~ShaderManager();
 
 			void initializeResources();
 			void updateResources(const std::string& scriptPath);
+			void finishResources();
+			const ShaderLoadingStatistics& getLoadingStatistics() const;
 		};
 	}
 }
@@ -0,0 +1,78 @@
+/**
+ * File contains declaration of ShaderUniform structure.
+ * @file    ShaderUniform.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-06
+ */
+
+#ifndef SHADERUNIFORM_HPP
+#define SHADERUNIFORM_HPP
+
+#include <string>
+#include <GL/glew.h>
+#include <boost/unordered_map.hpp>
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		typedef unsigned int UniformHandle;
+
+		/**
+		 * Enumeration represents fixed binding points of engine uniform blocks. Shader blocks are bound to
+		 * them by name after program link: CameraData, LightData, ShadowData, ObjectData and SkinData.
+		 */
+		enum UniformBlockBinding
+		{
+			CAMERA_BLOCK,
+			LIGHT_BLOCK,
+			SHADOW_BLOCK,
+			OBJECT_BLOCK,
+			SKIN_BLOCK,
+			MAX_UNIFORM_BLOCKS
+		};
+
+		/**
+		 * Enumeration represents fixed vertex attribute locations. Engine geometry attributes are bound to them
+		 * by name before program link: vertex, normal, texCoord, tangent and instanceMatrix (four locations).
+		 */
+		enum VertexAttributeLocation
+		{
+			VERTEX_ATTRIBUTE,
+			NORMAL_ATTRIBUTE,
+			TEXCOORD_ATTRIBUTE,
+			TANGENT_ATTRIBUTE,
+			INSTANCE_ATTRIBUTE
+		};
+
+		/**
+		 * Enumeration represents fixed texture units of engine textures which stay bound for all draws: shadow
+		 * cascades array and light cluster buffer textures. Shader samplers are set to them by name after
+		 * program link: cascadeShadowTexture, clusterGrid, clusterIndices and clusterLights.
+		 */
+		enum FixedTextureUnit
+		{
+			CASCADE_SHADOW_UNIT = 12,
+			CLUSTER_GRID_UNIT,
+			CLUSTER_INDEX_UNIT,
+			CLUSTER_LIGHT_UNIT
+		};
+
+		/**
+		 * Structure represents reflected shader program uniform. It store uniform location and shadow copy
+		 * of last value which was send to program, so unchanged values are not send again.
+		 */
+		struct ShaderUniform
+		{
+			GLint location;
+			GLenum type;
+			bool initialized;
+			GLfloat value[16];
+		};
+
+		typedef boost::unordered_map<UniformHandle,ShaderUniform> ShaderUniforms;
+		typedef boost::unordered_map<std::string,ShaderUniform> NamedShaderUniforms;
+		typedef boost::unordered_map<UniformHandle,std::string> UniformNames;
+	}
+}
+#endif
@@ -0,0 +1,416 @@
+/**
+ * File contains definition of Skeleton class.
+ * @file    Skeleton.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-17
+ */
+
+#include <cmath>
+#include <xmmintrin.h>
+
+#include "Skeleton.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiUtils;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class default constructor. Joints and animations are added by mesh factory.
+		 */
+		Skeleton::Skeleton()
+		{
+
+		}
+
+		/**
+		 * Class destructor, free allocated memory.
+		 */
+		Skeleton::~Skeleton()
+		{
+			joints.clear();
+			bindPose.clear();
+			inverseBindPose.clear();
+			influences.clear();
+			animations.clear();
+		}
+
+		/**
+		 * Method is used to add joint to skeleton hierarchy. Parent joint must be added before its children.
+		 * Inverse bind pose is calculated once, so skin matrices need only one quaternion product per joint.
+		 * @param	jointName is name of joint.
+		 * @param	parentJoint is id of parent joint or -1 for root joint.
+		 * @param	modelPose is model space bind pose of joint.
+		 */
+		void Skeleton::addJoint(const string& jointName, const int parentJoint, const JointPose& modelPose)
+		{
+			SkeletonJoint joint;
+			joint.jointName = jointName;
+			joint.parentJoint = parentJoint < static_cast<int>(joints.size()) ? parentJoint : -1;
+			joints.push_back(joint);
+
+			JointPose pose = modelPose;
+			normalizeQuaternion(pose.orientation);
+			bindPose.push_back(pose);
+
+			JointPose inversePose;
+			inversePose.orientation[0] = -pose.orientation[0];
+			inversePose.orientation[1] = -pose.orientation[1];
+			inversePose.orientation[2] = -pose.orientation[2];
+			inversePose.orientation[3] = pose.orientation[3];
+			rotateVector(inversePose.orientation,pose.position,inversePose.position);
+			for(unsigned int i = 0; i < 3; ++i)
+				inversePose.position[i] = -inversePose.position[i];
+			inverseBindPose.push_back(inversePose);
+		}
+
+		/**
+		 * Method is used to add skeletal animation. Animation with the same name is replaced.
+		 * @param	animation is reference to animation with local poses of all skeleton joints.
+		 */
+		void Skeleton::addAnimation(const SkeletalAnimation& animation)
+		{
+			for(vector<SkeletalAnimation>::iterator it = animations.begin(); it != animations.end(); ++it)
+				if((*it).animationName == animation.animationName)
+				{
+					*it = animation;
+					return;
+				}
+			animations.push_back(animation);
+		}
+
+		/**
+		 * Method is used to set joint influences of mesh vertices.
+		 * @param	influences is reference to influences of each mesh vertex.
+		 */
+		void Skeleton::setInfluences(const vector<VertexInfluence>& influences)
+		{
+			this->influences = influences;
+		}
+
+		/**
+		 * Method is used to sample local pose of animation. Looped animation interpolate last frame with
+		 * first one, not looped animation stop at last frame.
+		 * @param	animation is reference to sampled animation.
+		 * @param	animationTime is time from animation start in seconds.
+		 * @param	isLooped is animation loop flag.
+		 * @param	localPose is reference to destination local pose.
+		 */
+		void Skeleton::samplePose(const SkeletalAnimation& animation, const float animationTime, const bool isLooped, SkeletonPose& localPose) const
+		{
+			const unsigned int jointAmount = joints.size();
+			localPose.resize(jointAmount);
+			if(animation.frameAmount == 0 || animation.framePoses.size() < animation.frameAmount*jointAmount)
+				return;
+
+			float frame = animationTime*animation.frameRate;
+			unsigned int currentFrame = 0;
+			unsigned int nextFrame = 0;
+			if(isLooped)
+			{
+				frame = fmod(frame,static_cast<float>(animation.frameAmount));
+				if(frame < 0.0f)
+					frame += animation.frameAmount;
+				currentFrame = min(static_cast<unsigned int>(frame),animation.frameAmount - 1);
+				nextFrame = (currentFrame + 1) % animation.frameAmount;
+			}
+			else
+			{
+				frame = min(max(frame,0.0f),static_cast<float>(animation.frameAmount - 1));
+				currentFrame = static_cast<unsigned int>(frame);
+				nextFrame = min(currentFrame + 1,animation.frameAmount - 1);
+			}
+
+			const float interpolation = frame - currentFrame;
+			const JointPose* current = &animation.framePoses[currentFrame*jointAmount];
+			const JointPose* next = &animation.framePoses[nextFrame*jointAmount];
+			for(unsigned int i = 0; i < jointAmount; ++i)
+				interpolateJoint(current[i],next[i],interpolation,localPose[i]);
+		}
+
+		/**
+		 * Method is used to evaluate joint hierarchy - transform local pose into model space. Parents
+		 * precede children, so hierarchy is evaluated in one pass.
+		 * @param	localPose is reference to local pose.
+		 * @param	modelPose is reference to destination model space pose.
+		 */
+		void Skeleton::computeModelPose(const SkeletonPose& localPose, SkeletonPose& modelPose) const
+		{
+			const unsigned int jointAmount = joints.size();
+			modelPose.resize(jointAmount);
+			for(unsigned int i = 0; i < jointAmount; ++i)
+			{
+				const int parent = joints[i].parentJoint;
+				if(parent < 0)
+				{
+					modelPose[i] = localPose[i];
+					continue;
+				}
+
+				const JointPose& parentPose = modelPose[parent];
+				float rotated[3];
+				rotateVector(parentPose.orientation,localPose[i].position,rotated);
+				for(unsigned int j = 0; j < 3; ++j)
+					modelPose[i].position[j] = parentPose.position[j] + rotated[j];
+				multiplyQuaternions(parentPose.orientation,localPose[i].orientation,modelPose[i].orientation);
+				normalizeQuaternion(modelPose[i].orientation);
+			}
+		}
+
+		/**
+		 * Method is used to calculate skin matrices (model pose * inverse bind pose) of all joints in
+		 * column-major order.
+		 * @param	modelPose is reference to model space pose.
+		 * @param	skinMatrices is pointer to destination array of joint amount * 16 floats.
+		 */
+		void Skeleton::computeSkinMatrices(const SkeletonPose& modelPose, float* skinMatrices) const
+		{
+			const unsigned int jointAmount = joints.size();
+			for(unsigned int i = 0; i < jointAmount; ++i, skinMatrices += SKIN_MATRIX_SIZE)
+			{
+				float q[4];
+				float t[3];
+				multiplyQuaternions(modelPose[i].orientation,inverseBindPose[i].orientation,q);
+				rotateVector(modelPose[i].orientation,inverseBindPose[i].position,t);
+
+				const float xx = q[0]*q[0], yy = q[1]*q[1], zz = q[2]*q[2];
+				const float xy = q[0]*q[1], xz = q[0]*q[2], yz = q[1]*q[2];
+				const float wx = q[3]*q[0], wy = q[3]*q[1], wz = q[3]*q[2];
+
+				skinMatrices[0] = 1.0f - 2.0f*(yy + zz);
+				skinMatrices[1] = 2.0f*(xy + wz);
+				skinMatrices[2] = 2.0f*(xz - wy);
+				skinMatrices[3] = 0.0f;
+				skinMatrices[4] = 2.0f*(xy - wz);
+				skinMatrices[5] = 1.0f - 2.0f*(xx + zz);
+				skinMatrices[6] = 2.0f*(yz + wx);
+				skinMatrices[7] = 0.0f;
+				skinMatrices[8] = 2.0f*(xz + wy);
+				skinMatrices[9] = 2.0f*(yz - wx);
+				skinMatrices[10] = 1.0f - 2.0f*(xx + yy);
+				skinMatrices[11] = 0.0f;
+				skinMatrices[12] = modelPose[i].position[0] + t[0];
+				skinMatrices[13] = modelPose[i].position[1] + t[1];
+				skinMatrices[14] = modelPose[i].position[2] + t[2];
+				skinMatrices[15] = 1.0f;
+			}
+		}
+
+		/**
+		 * Method is used to blend two local poses. Positions are interpolated linearly, orientations by
+		 * normalized linear interpolation along shorter arc. Result can be one of source poses.
+		 * @param	first is reference to first pose.
+		 * @param	second is reference to second pose.
+		 * @param	weight is weight of second pose.
+		 * @param	result is reference to destination pose.
+		 */
+		void Skeleton::blendPoses(const SkeletonPose& first, const SkeletonPose& second, const float weight, SkeletonPose& result)
+		{
+			const unsigned int jointAmount = min(first.size(),second.size());
+			result.resize(jointAmount);
+			for(unsigned int i = 0; i < jointAmount; ++i)
+				interpolateJoint(first[i],second[i],weight,result[i]);
+		}
+
+		/**
+		 * Method is used to skin range of vertices with SSE. Skin matrix of each vertex is weighted sum of
+		 * four joint matrices, positions, normals and tangents are transformed by blended matrix. Method does
+		 * not use any shared state, so vertex ranges can be skinned on many threads.
+		 * @param	source is pointer to bind pose vertices.
+		 * @param	influences is pointer to joint influences of vertices.
+		 * @param	skinMatrices is pointer to skin matrices.
+		 * @param	destination is pointer to skinned vertices.
+		 * @param	first is first skinned vertex.
+		 * @param	last is vertex after last skinned vertex.
+		 */
+		void Skeleton::skinVertices(const Vertex<>* source, const VertexInfluence* influences, const float* skinMatrices, Vertex<>* destination, const unsigned int first, const unsigned int last)
+		{
+			for(unsigned int i = first; i < last; ++i)
+			{
+				const VertexInfluence& influence = influences[i];
+				__m128 column[4];
+				const float* matrix = skinMatrices + static_cast<unsigned int>(influence.joints[0])*SKIN_MATRIX_SIZE;
+				__m128 weight = _mm_set1_ps(influence.weights[0]);
+				for(unsigned int c = 0; c < 4; ++c)
+					column[c] = _mm_mul_ps(_mm_loadu_ps(matrix + c*4),weight);
+
+				for(unsigned int j = 1; j < MAX_VERTEX_JOINTS; ++j)
+				{
+					if(influence.weights[j] <= 0.0f)
+						continue;
+					matrix = skinMatrices + static_cast<unsigned int>(influence.joints[j])*SKIN_MATRIX_SIZE;
+					weight = _mm_set1_ps(influence.weights[j]);
+					for(unsigned int c = 0; c < 4; ++c)
+						column[c] = _mm_add_ps(column[c],_mm_mul_ps(_mm_loadu_ps(matrix + c*4),weight));
+				}
+
+				const Vertex<>& vertex = source[i];
+				const __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column[0],_mm_set1_ps(vertex.x)),_mm_mul_ps(column[1],_mm_set1_ps(vertex.y))),_mm_add_ps(_mm_mul_ps(column[2],_mm_set1_ps(vertex.z)),column[3]));
+				const __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column[0],_mm_set1_ps(vertex.nx)),_mm_mul_ps(column[1],_mm_set1_ps(vertex.ny))),_mm_mul_ps(column[2],_mm_set1_ps(vertex.nz)));
+				const __m128 tangent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column[0],_mm_set1_ps(vertex.tx)),_mm_mul_ps(column[1],_mm_set1_ps(vertex.ty))),_mm_mul_ps(column[2],_mm_set1_ps(vertex.tz)));
+
+				float result[12];
+				_mm_storeu_ps(result,position);
+				_mm_storeu_ps(result + 4,normal);
+				_mm_storeu_ps(result + 8,tangent);
+
+				Vertex<>& skinned = destination[i];
+				skinned.x = result[0];
+				skinned.y = result[1];
+				skinned.z = result[2];
+				skinned.nx = result[4];
+				skinned.ny = result[5];
+				skinned.nz = result[6];
+				skinned.u = vertex.u;
+				skinned.v = vertex.v;
+				skinned.tx = result[8];
+				skinned.ty = result[9];
+				skinned.tz = result[10];
+				skinned.tw = vertex.tw;
+			}
+		}
+
+		/**
+		 * Accessor to amount of skeleton joints.
+		 * @return	amount of joints.
+		 */
+		unsigned int Skeleton::getJointAmount() const
+		{
+			return joints.size();
+		}
+
+		/**
+		 * Accessor to skeleton joint.
+		 * @param	id is joint id.
+		 * @return	reference to joint.
+		 */
+		const SkeletonJoint& Skeleton::getJoint(const unsigned int id) const
+		{
+			return joints[id];
+		}
+
+		/**
+		 * Method is used to find joint by name.
+		 * @param	jointName is name of joint.
+		 * @return	joint id or -1 if joint does not exist.
+		 */
+		int Skeleton::findJoint(const string& jointName) const
+		{
+			for(unsigned int i = 0; i < joints.size(); ++i)
+				if(joints[i].jointName == jointName)
+					return i;
+			return -1;
+		}
+
+		/**
+		 * Accessor to private bind pose member.
+		 * @return	reference to model space bind pose.
+		 */
+		const SkeletonPose& Skeleton::getBindPose() const
+		{
+			return bindPose;
+		}
+
+		/**
+		 * Accessor to private influences member.
+		 * @return	reference to joint influences of mesh vertices.
+		 */
+		const vector<VertexInfluence>& Skeleton::getInfluences() const
+		{
+			return influences;
+		}
+
+		/**
+		 * Method is used to find skeletal animation by name.
+		 * @param	animationName is name of animation.
+		 * @return	pointer to animation or nullptr if animation does not exist.
+		 */
+		const SkeletalAnimation* Skeleton::getAnimation(const string& animationName) const
+		{
+			for(vector<SkeletalAnimation>::const_iterator it = animations.begin(); it != animations.end(); ++it)
+				if((*it).animationName == animationName)
+					return &(*it);
+			return nullptr;
+		}
+
+		/**
+		 * Method is used to get time of last animation frame.
+		 * @param	animation is reference to animation.
+		 * @return	animation length in seconds.
+		 */
+		float Skeleton::getAnimationLength(const SkeletalAnimation& animation)
+		{
+			return animation.frameAmount > 1 && animation.frameRate > 0.0f ? (animation.frameAmount - 1)/animation.frameRate : 0.0f;
+		}
+
+		/**
+		 * Method is used to multiply two quaternions.
+		 * @param	first is pointer to first quaternion.
+		 * @param	second is pointer to second quaternion.
+		 * @param	result is pointer to destination quaternion, it must not be one of source quaternions.
+		 */
+		void Skeleton::multiplyQuaternions(const float* first, const float* second, float* result)
+		{
+			result[0] = first[3]*second[0] + first[0]*second[3] + first[1]*second[2] - first[2]*second[1];
+			result[1] = first[3]*second[1] - first[0]*second[2] + first[1]*second[3] + first[2]*second[0];
+			result[2] = first[3]*second[2] + first[0]*second[1] - first[1]*second[0] + first[2]*second[3];
+			result[3] = first[3]*second[3] - first[0]*second[0] - first[1]*second[1] - first[2]*second[2];
+		}
+
+		/**
+		 * Method is used to rotate vector by unit quaternion.
+		 * @param	orientation is pointer to quaternion.
+		 * @param	vector is pointer to source vector.
+		 * @param	result is pointer to destination vector, it must not be source vector.
+		 */
+		void Skeleton::rotateVector(const float* orientation, const float* vector, float* result)
+		{
+			const float tx = 2.0f*(orientation[1]*vector[2] - orientation[2]*vector[1]);
+			const float ty = 2.0f*(orientation[2]*vector[0] - orientation[0]*vector[2]);
+			const float tz = 2.0f*(orientation[0]*vector[1] - orientation[1]*vector[0]);
+			result[0] = vector[0] + orientation[3]*tx + orientation[1]*tz - orientation[2]*ty;
+			result[1] = vector[1] + orientation[3]*ty + orientation[2]*tx - orientation[0]*tz;
+			result[2] = vector[2] + orientation[3]*tz + orientation[0]*ty - orientation[1]*tx;
+		}
+
+		/**
+		 * Method is used to normalize quaternion.
+		 * @param	orientation is pointer to quaternion.
+		 */
+		void Skeleton::normalizeQuaternion(float* orientation)
+		{
+			const float length = sqrt(orientation[0]*orientation[0] + orientation[1]*orientation[1] + orientation[2]*orientation[2] + orientation[3]*orientation[3]);
+			if(length <= 0.0f)
+			{
+				orientation[0] = orientation[1] = orientation[2] = 0.0f;
+				orientation[3] = 1.0f;
+				return;
+			}
+			for(unsigned int i = 0; i < 4; ++i)
+				orientation[i] /= length;
+		}
+
+		/**
+		 * Private method which is used to interpolate two joint poses. Orientation is interpolated along
+		 * shorter arc and normalized.
+		 * @param	first is reference to first pose.
+		 * @param	second is reference to second pose.
+		 * @param	weight is weight of second pose.
+		 * @param	result is reference to destination pose, it can be one of source poses.
+		 */
+		void Skeleton::interpolateJoint(const JointPose& first, const JointPose& second, const float weight, JointPose& result)
+		{
+			const float dot = first.orientation[0]*second.orientation[0] + first.orientation[1]*second.orientation[1] + first.orientation[2]*second.orientation[2] + first.orientation[3]*second.orientation[3];
+			const float secondWeight = dot < 0.0f ? -weight : weight;
+			const float firstWeight = 1.0f - weight;
+
+			for(unsigned int i = 0; i < 3; ++i)
+				result.position[i] = first.position[i]*firstWeight + second.position[i]*weight;
+			for(unsigned int i = 0; i < 4; ++i)
+				result.orientation[i] = first.orientation[i]*firstWeight + second.orientation[i]*secondWeight;
+			normalizeQuaternion(result.orientation);
+		}
+	}
+}
@@ -0,0 +1,115 @@
+/**
+ * File contains declaration of Skeleton class.
+ * @file    Skeleton.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-17
+ */
+
+#ifndef SKELETON_HPP
+#define SKELETON_HPP
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "../AyumiUtils/Vertex.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int MAX_VERTEX_JOINTS = 4;
+		const unsigned int MAX_SKIN_JOINTS = 128;
+		const unsigned int SKIN_MATRIX_SIZE = 16;
+
+		/**
+		 * Structure represents one joint of skeleton hierarchy. Parent joint always precede its children,
+		 * root joints have parent equal -1.
+		 */
+		struct SkeletonJoint
+		{
+			std::string jointName;
+			int parentJoint;
+		};
+
+		/**
+		 * Structure represents position and orientation quaternion (x, y, z, w) of one joint.
+		 */
+		struct JointPose
+		{
+			float position[3];
+			float orientation[4];
+		};
+
+		/**
+		 * Structure represents four joint influences of one vertex. Joint indices are stored as floats,
+		 * so influences are uploaded directly as two RGBA texels of skin influence buffer texture.
+		 */
+		struct VertexInfluence
+		{
+			float joints[MAX_VERTEX_JOINTS];
+			float weights[MAX_VERTEX_JOINTS];
+		};
+
+		typedef std::vector<JointPose> SkeletonPose;
+
+		/**
+		 * Structure represents skeletal animation. Frame poses store local (parent space) pose of each joint,
+		 * frame after frame.
+		 */
+		struct SkeletalAnimation
+		{
+			std::string animationName;
+			float frameRate;
+			unsigned int frameAmount;
+			SkeletonPose framePoses;
+		};
+
+		/**
+		 * Class represents skeleton of skinned mesh: joint hierarchy, model space bind pose, joint influences
+		 * of mesh vertices and skeletal animations. Pose pipeline is split into pure steps which do not touch
+		 * GPU: sampling of local pose, blending of local poses, evaluation of hierarchy from local to model
+		 * space and calculation of skin matrices (model pose * inverse bind pose). Skin matrices are used by
+		 * GPU skinning vertex shader or by SSE CPU skinning, which skin vertex range and can run on many threads.
+		 */
+		class Skeleton
+		{
+		private:
+			std::vector<SkeletonJoint> joints;
+			SkeletonPose bindPose;
+			SkeletonPose inverseBindPose;
+			std::vector<VertexInfluence> influences;
+			std::vector<SkeletalAnimation> animations;
+
+			static void interpolateJoint(const JointPose& first, const JointPose& second, const float weight, JointPose& result);
+
+		public:
+			Skeleton();
+			~Skeleton();
+
+			void addJoint(const std::string& jointName, const int parentJoint, const JointPose& modelPose);
+			void addAnimation(const SkeletalAnimation& animation);
+			void setInfluences(const std::vector<VertexInfluence>& influences);
+
+			void samplePose(const SkeletalAnimation& animation, const float animationTime, const bool isLooped, SkeletonPose& localPose) const;
+			void computeModelPose(const SkeletonPose& localPose, SkeletonPose& modelPose) const;
+			void computeSkinMatrices(const SkeletonPose& modelPose, float* skinMatrices) const;
+			static void blendPoses(const SkeletonPose& first, const SkeletonPose& second, const float weight, SkeletonPose& result);
+			static void multiplyQuaternions(const float* first, const float* second, float* result);
+			static void rotateVector(const float* orientation, const float* vector, float* result);
+			static void normalizeQuaternion(float* orientation);
+			static void skinVertices(const AyumiUtils::Vertex<>* source, const VertexInfluence* influences, const float* skinMatrices, AyumiUtils::Vertex<>* destination, const unsigned int first, const unsigned int last);
+
+			unsigned int getJointAmount() const;
+			const SkeletonJoint& getJoint(const unsigned int id) const;
+			int findJoint(const std::string& jointName) const;
+			const SkeletonPose& getBindPose() const;
+			const std::vector<VertexInfluence>& getInfluences() const;
+			const SkeletalAnimation* getAnimation(const std::string& animationName) const;
+			static float getAnimationLength(const SkeletalAnimation& animation);
+		};
+
+		typedef boost::shared_ptr<Skeleton> SkeletonResource;
+	}
+}
+#endif
@@ -18,6 +18,9 @@ namespace AyumiEngine
 		{
 			resourceType = TEXTURE;
 			type = UNKNOWN;
+			compression = NO_COMPRESSION;
+			texture = 0;
+			textureLoaded = false;
 		}
 
 		/**
@@ -31,6 +34,9 @@ namespace AyumiEngine
 			resourceName = name;
 			resourceType = TEXTURE;
 			type = UNKNOWN;
+			compression = NO_COMPRESSION;
+			texture = 0;
+			textureLoaded = false;
 		}
 
 		/**
@@ -43,7 +49,9 @@ namespace AyumiEngine
 			resourceName = texture.resourceName;
 			resourceType = TEXTURE;
 			type = texture.getType();
+			compression = texture.getCompression();
 			this->texture = texture.texture;
+			textureLoaded = texture.textureLoaded;
 		}
 
 		/**
@@ -72,6 +80,24 @@ namespace AyumiEngine
 			this->type = type;
 		}
 
+		/**
+		 * Setter of private texture compression enumeration.
+		 * @param	compression is new texture compression enumeration.
+		 */
+		void Texture::setTextureCompression(const TextureCompression& compression)
+		{
+			this->compression = compression;
+		}
+
+		/**
+		 * Setter of private texture loaded flag. It is set when decoded image replace placeholder.
+		 * @param	loaded is texture loaded flag.
+		 */
+		void Texture::setTextureLoaded(const bool loaded)
+		{
+			textureLoaded = loaded;
+		}
+
 		/**
 		 * Accessor to texture variable.
 		 * @return	value of texture variable.
@@ -89,5 +115,23 @@ namespace AyumiEngine
 		{
 			return type;
 		}
+
+		/**
+		 * Accessor to texture compression member.
+		 * @return	texture compression enumeration.
+		 */
+		TextureCompression Texture::getCompression() const
+		{
+			return compression;
+		}
+
+		/**
+		 * Method is used to check if texture image was uploaded or texture still contains placeholder.
+		 * @return	true if texture image is loaded.
+		 */
+		bool Texture::isTextureLoaded() const
+		{
+			return textureLoaded;
+		}
 	}
 }
@@ -8,6 +8,8 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
+#include <boost/shared_ptr.hpp>
+
 #include "Resource.hpp"
 #include "TextureType.hpp"
 
@@ -19,12 +21,15 @@ namespace AyumiEngine
 		 * Class represents one of basic Engine resource - Texture resource. Texture is bacis
 		 * element of all 3D engine and games, where it is used in geometry mesh mapping. In Engine,
 		 * textures are used in Entity Materials, 2D Sprites, Canvas and post-process effects.
+		 * Texture object exists from registration - till image is decoded and uploaded it contains placeholder.
 		 */
 		class Texture : public Resource
 		{
 		protected:
 			GLuint texture;
 			TextureType type;
+			TextureCompression compression;
+			bool textureLoaded;
 		public:
 			Texture();
 			Texture(const char* name, const char* filePath);
@@ -33,10 +38,16 @@ namespace AyumiEngine
 
 			void setTexture(const GLuint texture);
 			void setTextureType(const TextureType& type);
+			void setTextureCompression(const TextureCompression& compression);
+			void setTextureLoaded(const bool loaded);
 			
 			GLuint* getTexture();
 			TextureType getType() const;
+			TextureCompression getCompression() const;
+			bool isTextureLoaded() const;
 		};
+
+		typedef boost::shared_ptr<Texture> TextureResource;
 	}
 }
 #endif
@@ -0,0 +1,202 @@
+/**
+ * File contains definition of TextureCache class.
+ * @file    TextureCache.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-21
+ */
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <boost/thread.hpp>
+#include <boost/filesystem.hpp>
+
+#include "TextureCache.hpp"
+
+using namespace std;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	cacheDirectory is path of directory with cache files, it must end with separator.
+		 */
+		TextureCache::TextureCache(const string& cacheDirectory)
+		{
+			this->cacheDirectory = cacheDirectory;
+			cacheEnabled = false;
+		}
+
+		/**
+		 * Class destructor. Nothing to delete.
+		 */
+		TextureCache::~TextureCache()
+		{
+
+		}
+
+		/**
+		 * Method is used to create cache directory. Cache is disabled when directory can not be created.
+		 */
+		void TextureCache::initializeCache()
+		{
+			boost::system::error_code error;
+			boost::filesystem::create_directories(cacheDirectory,error);
+			cacheEnabled = !error;
+			if(!cacheEnabled)
+				Logger::getInstance()->saveLog(Log<string>("Texture cache directory creating error occurred: " + cacheDirectory));
+		}
+
+		/**
+		 * Method is used to load cached compressed image. Cache file is rejected when source file was modified
+		 * after image was cached.
+		 * @param	path is source image file path.
+		 * @param	compression is texture compression enumeration.
+		 * @param	image is reference to loaded image.
+		 * @return	false if there is no valid cached image.
+		 */
+		bool TextureCache::loadImage(const string& path, const TextureCompression compression, TextureImage& image) const
+		{
+			time_t sourceTime;
+			if(!cacheEnabled || !getSourceTime(path,sourceTime))
+				return false;
+
+			ifstream cacheFile(getCachePath(path,compression).c_str(),ios::in | ios::binary);
+			if(!cacheFile.is_open())
+				return false;
+
+			char magic[4];
+			unsigned int version = 0;
+			long long cachedTime = 0;
+			unsigned int pathLength = 0;
+			cacheFile.read(magic,4);
+			cacheFile.read(reinterpret_cast<char*>(&version),sizeof(version));
+			cacheFile.read(reinterpret_cast<char*>(&cachedTime),sizeof(cachedTime));
+			cacheFile.read(reinterpret_cast<char*>(&pathLength),sizeof(pathLength));
+			if(!cacheFile || memcmp(magic,"AYTC",4) != 0 || version != TEXTURE_CACHE_VERSION || cachedTime != static_cast<long long>(sourceTime) || pathLength != path.size())
+				return false;
+
+			string cachedPath(pathLength,'\0');
+			cacheFile.read(&cachedPath[0],pathLength);
+			if(!cacheFile || cachedPath != path)
+				return false;
+
+			GLsizei width = 0;
+			GLsizei height = 0;
+			GLsizei levels = 0;
+			GLenum format = 0;
+			unsigned int size = 0;
+			cacheFile.read(reinterpret_cast<char*>(&width),sizeof(width));
+			cacheFile.read(reinterpret_cast<char*>(&height),sizeof(height));
+			cacheFile.read(reinterpret_cast<char*>(&levels),sizeof(levels));
+			cacheFile.read(reinterpret_cast<char*>(&format),sizeof(format));
+			cacheFile.read(reinterpret_cast<char*>(&size),sizeof(size));
+			if(!cacheFile || size == 0)
+				return false;
+
+			image.pixels.resize(size);
+			cacheFile.read(reinterpret_cast<char*>(&image.pixels[0]),size);
+			if(!cacheFile)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Texture cache reading error occurred: " + path));
+				image.pixels.clear();
+				return false;
+			}
+
+			image.width = width;
+			image.height = height;
+			image.depth = 1;
+			image.levels = levels;
+			image.components = format;
+			image.format = format;
+			image.compressed = true;
+			return true;
+		}
+
+		/**
+		 * Method is used to save compressed image into cache. Image is written into temporary file which
+		 * replace cache file, so other workers never read partially written file.
+		 * @param	path is source image file path.
+		 * @param	compression is texture compression enumeration.
+		 * @param	image is reference to compressed image.
+		 */
+		void TextureCache::saveImage(const string& path, const TextureCompression compression, const TextureImage& image) const
+		{
+			time_t sourceTime;
+			if(!cacheEnabled || !image.compressed || image.pixels.empty() || !getSourceTime(path,sourceTime))
+				return;
+
+			const string cachePath = getCachePath(path,compression);
+			ostringstream temporaryPath;
+			temporaryPath << cachePath << "." << boost::this_thread::get_id();
+
+			ofstream cacheFile(temporaryPath.str().c_str(),ios::out | ios::binary | ios::trunc);
+			if(!cacheFile.is_open())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Texture cache file opening error occurred: " + path));
+				return;
+			}
+
+			const long long cachedTime = static_cast<long long>(sourceTime);
+			const unsigned int pathLength = path.size();
+			const unsigned int size = image.pixels.size();
+			cacheFile.write("AYTC",4);
+			cacheFile.write(reinterpret_cast<const char*>(&TEXTURE_CACHE_VERSION),sizeof(TEXTURE_CACHE_VERSION));
+			cacheFile.write(reinterpret_cast<const char*>(&cachedTime),sizeof(cachedTime));
+			cacheFile.write(reinterpret_cast<const char*>(&pathLength),sizeof(pathLength));
+			cacheFile.write(path.c_str(),pathLength);
+			cacheFile.write(reinterpret_cast<const char*>(&image.width),sizeof(image.width));
+			cacheFile.write(reinterpret_cast<const char*>(&image.height),sizeof(image.height));
+			cacheFile.write(reinterpret_cast<const char*>(&image.levels),sizeof(image.levels));
+			cacheFile.write(reinterpret_cast<const char*>(&image.format),sizeof(image.format));
+			cacheFile.write(reinterpret_cast<const char*>(&size),sizeof(size));
+			cacheFile.write(reinterpret_cast<const char*>(&image.pixels[0]),size);
+			const bool written = cacheFile.good();
+			cacheFile.close();
+
+			boost::system::error_code error;
+			if(written)
+				boost::filesystem::rename(temporaryPath.str(),cachePath,error);
+			if(!written || error)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Texture cache writing error occurred: " + path));
+				boost::filesystem::remove(temporaryPath.str(),error);
+			}
+		}
+
+		/**
+		 * Private method which is used to get cache file path. File name is FNV-1a hash of source path and
+		 * compression.
+		 * @param	path is source image file path.
+		 * @param	compression is texture compression enumeration.
+		 * @return	cache file path.
+		 */
+		string TextureCache::getCachePath(const string& path, const TextureCompression compression) const
+		{
+			unsigned int hash = 2166136261u;
+			for(unsigned int i = 0; i < path.size(); ++i)
+				hash = (hash ^ static_cast<unsigned char>(path[i]))*16777619u;
+			hash = (hash ^ static_cast<unsigned int>(compression))*16777619u;
+
+			ostringstream cachePath;
+			cachePath << cacheDirectory << hex << setw(8) << setfill('0') << hash << ".tex";
+			return cachePath.str();
+		}
+
+		/**
+		 * Private method which is used to get modification time of source file.
+		 * @param	path is source image file path.
+		 * @param	sourceTime is reference to modification time.
+		 * @return	false if source file does not exist.
+		 */
+		bool TextureCache::getSourceTime(const string& path, time_t& sourceTime) const
+		{
+			boost::system::error_code error;
+			sourceTime = boost::filesystem::last_write_time(path,error);
+			return !error;
+		}
+	}
+}
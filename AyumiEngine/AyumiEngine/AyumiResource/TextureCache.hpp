@@ -0,0 +1,51 @@
+/**
+ * File contains declaration of TextureCache class.
+ * @file    TextureCache.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-21
+ */
+
+#ifndef TEXTURECACHE_HPP
+#define TEXTURECACHE_HPP
+
+#include <string>
+#include <ctime>
+
+#include "TextureType.hpp"
+#include "TextureImage.hpp"
+
+#include "../Logger.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int TEXTURE_CACHE_VERSION = 1;
+
+		/**
+		 * Class represents on-disk cache of compressed texture images. Cache file is named by hash of source
+		 * path and compression, its header store source path and source modification time, so cached image
+		 * is used only when source file was not changed. Cached images are loaded without decoding and
+		 * compression. Methods can be called by many decode workers at the same time.
+		 */
+		class TextureCache : private AyumiUtils::Noncopyable
+		{
+		private:
+			std::string cacheDirectory;
+			bool cacheEnabled;
+
+			std::string getCachePath(const std::string& path, const TextureCompression compression) const;
+			bool getSourceTime(const std::string& path, std::time_t& sourceTime) const;
+
+		public:
+			TextureCache(const std::string& cacheDirectory);
+			~TextureCache();
+
+			void initializeCache();
+			bool loadImage(const std::string& path, const TextureCompression compression, TextureImage& image) const;
+			void saveImage(const std::string& path, const TextureCompression compression, const TextureImage& image) const;
+		};
+	}
+}
+#endif
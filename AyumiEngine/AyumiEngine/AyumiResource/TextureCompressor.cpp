@@ -0,0 +1,356 @@
+/**
+ * File contains definition of TextureCompressor class.
+ * @file    TextureCompressor.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-21
+ */
+
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/bind.hpp>
+
+#include "TextureCompressor.hpp"
+
+#include "../AyumiCore/WorkerPool.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiCore;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class default constructor. Nothing to do.
+		 */
+		TextureCompressor::TextureCompressor()
+		{
+
+		}
+
+		/**
+		 * Class destructor. Nothing to delete.
+		 */
+		TextureCompressor::~TextureCompressor()
+		{
+
+		}
+
+		/**
+		 * Method is used to choose block compression format of RGBA image. Color images without transparent
+		 * pixels are compressed to BC1, images with alpha to BC3 and normal maps to BC5.
+		 * @param	pixels is pointer to RGBA image pixels.
+		 * @param	width is image width.
+		 * @param	height is image height.
+		 * @param	compression is texture compression enumeration.
+		 * @return	compressed internal format.
+		 */
+		GLenum TextureCompressor::chooseFormat(const unsigned char* pixels, const GLsizei width, const GLsizei height, const TextureCompression compression) const
+		{
+			if(compression == NORMAL_COMPRESSION)
+				return GL_COMPRESSED_RG_RGTC2;
+
+			const unsigned int pixelAmount = width*height;
+			for(unsigned int i = 0; i < pixelAmount; ++i)
+				if(pixels[i*4 + 3] != 255)
+					return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		}
+
+		/**
+		 * Method is used to compress one RGBA mip level into blocks. Levels with many blocks are split into
+		 * ranges of block rows run by WorkerPool, first range is compressed by calling thread.
+		 * @param	pixels is pointer to RGBA level pixels.
+		 * @param	width is level width.
+		 * @param	height is level height.
+		 * @param	format is compressed internal format.
+		 * @param	blocks is pointer to output blocks, it must have getLevelSize bytes.
+		 */
+		void TextureCompressor::compressLevel(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLenum format, unsigned char* blocks) const
+		{
+			const unsigned int blockRows = (height + 3) / 4;
+			const unsigned int blockAmount = blockRows*((width + 3) / 4);
+			unsigned int workers = 1;
+			if(blockAmount >= COMPRESS_PARALLEL_BLOCKS)
+				workers = max(1u,min(MAX_COMPRESS_WORKERS,WorkerPool::getInstance()->getThreadAmount()));
+
+			if(workers == 1)
+				compressRange(pixels,width,height,format,blocks,0,blockRows);
+			else
+			{
+				const unsigned int rowsPerWorker = (blockRows + workers - 1) / workers;
+				WorkerJobs jobs;
+				for(unsigned int i = 0; i < workers && i*rowsPerWorker < blockRows; ++i)
+					jobs.push_back(boost::bind(&TextureCompressor::compressRange,this,pixels,width,height,format,blocks,i*rowsPerWorker,min((i+1)*rowsPerWorker,blockRows)));
+				WorkerPool::getInstance()->runJobs(jobs);
+			}
+		}
+
+		/**
+		 * Method is used to generate next mip level by 2x2 box filter. Odd sizes clamp last row and column.
+		 * Normal map texels are renormalized after filtering.
+		 * @param	pixels is pointer to RGBA level pixels.
+		 * @param	width is level width.
+		 * @param	height is level height.
+		 * @param	normalMap is flag which is set for normal maps.
+		 * @param	mipmap is reference to output RGBA pixels of next level.
+		 */
+		void TextureCompressor::generateMipmap(const unsigned char* pixels, const GLsizei width, const GLsizei height, const bool normalMap, vector<unsigned char>& mipmap) const
+		{
+			const GLsizei mipWidth = max(1,width / 2);
+			const GLsizei mipHeight = max(1,height / 2);
+			mipmap.resize(mipWidth*mipHeight*4);
+
+			for(GLsizei y = 0; y < mipHeight; ++y)
+			{
+				const unsigned char* row0 = pixels + min(y*2,height - 1)*width*4;
+				const unsigned char* row1 = pixels + min(y*2 + 1,height - 1)*width*4;
+				for(GLsizei x = 0; x < mipWidth; ++x)
+				{
+					const GLsizei x0 = min(x*2,width - 1)*4;
+					const GLsizei x1 = min(x*2 + 1,width - 1)*4;
+					unsigned char* texel = &mipmap[(y*mipWidth + x)*4];
+					for(unsigned int c = 0; c < 4; ++c)
+						texel[c] = static_cast<unsigned char>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+
+					if(normalMap)
+					{
+						float normal[3];
+						for(unsigned int c = 0; c < 3; ++c)
+							normal[c] = texel[c] / 127.5f - 1.0f;
+						const float length = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+						if(length > 0.0f)
+							for(unsigned int c = 0; c < 3; ++c)
+								texel[c] = static_cast<unsigned char>(min(255.0f,max(0.0f,(normal[c] / length + 1.0f)*127.5f + 0.5f)));
+					}
+				}
+			}
+		}
+
+		/**
+		 * Method is used to get size of compressed level.
+		 * @param	format is compressed internal format.
+		 * @param	width is level width.
+		 * @param	height is level height.
+		 * @return	size of level blocks in bytes.
+		 */
+		unsigned int TextureCompressor::getLevelSize(const GLenum format, const GLsizei width, const GLsizei height) const
+		{
+			const unsigned int blockSize = format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+			return ((width + 3) / 4)*((height + 3) / 4)*blockSize;
+		}
+
+		/**
+		 * Method is used to get amount of levels of full mip chain.
+		 * @param	width is base level width.
+		 * @param	height is base level height.
+		 * @return	amount of mip levels.
+		 */
+		unsigned int TextureCompressor::getLevelAmount(const GLsizei width, const GLsizei height) const
+		{
+			unsigned int levels = 1;
+			for(GLsizei size = max(width,height); size > 1; size /= 2)
+				levels++;
+			return levels;
+		}
+
+		/**
+		 * Private method which is used to compress range of block rows. It is run by WorkerPool threads.
+		 * @param	pixels is pointer to RGBA level pixels.
+		 * @param	width is level width.
+		 * @param	height is level height.
+		 * @param	format is compressed internal format.
+		 * @param	blocks is pointer to output blocks of whole level.
+		 * @param	firstRow is first compressed block row.
+		 * @param	lastRow is block row after last compressed row.
+		 */
+		void TextureCompressor::compressRange(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLenum format, unsigned char* blocks, const unsigned int firstRow, const unsigned int lastRow) const
+		{
+			const unsigned int blockColumns = (width + 3) / 4;
+			const unsigned int blockSize = format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+			unsigned char block[64];
+
+			for(unsigned int row = firstRow; row < lastRow; ++row)
+			{
+				for(unsigned int column = 0; column < blockColumns; ++column)
+				{
+					fetchBlock(pixels,width,height,column*4,row*4,block);
+					unsigned char* output = blocks + (row*blockColumns + column)*blockSize;
+					switch(format)
+					{
+					case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+						compressColorBlock(block,output);
+						break;
+					case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+						compressChannelBlock(block,3,output);
+						compressColorBlock(block,output + 8);
+						break;
+					case GL_COMPRESSED_RG_RGTC2:
+						compressChannelBlock(block,0,output);
+						compressChannelBlock(block,1,output + 8);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+
+		/**
+		 * Private method which is used to copy 4x4 RGBA block of level. Texels outside of level repeat last
+		 * row and column.
+		 * @param	pixels is pointer to RGBA level pixels.
+		 * @param	width is level width.
+		 * @param	height is level height.
+		 * @param	x is block first column.
+		 * @param	y is block first row.
+		 * @param	block is pointer to 64 byte output block.
+		 */
+		void TextureCompressor::fetchBlock(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLsizei x, const GLsizei y, unsigned char* block) const
+		{
+			for(GLsizei j = 0; j < 4; ++j)
+			{
+				const unsigned char* row = pixels + min(y + j,height - 1)*width*4;
+				for(GLsizei i = 0; i < 4; ++i)
+				{
+					const unsigned char* texel = row + min(x + i,width - 1)*4;
+					for(unsigned int c = 0; c < 4; ++c)
+						block[(j*4 + i)*4 + c] = texel[c];
+				}
+			}
+		}
+
+		/**
+		 * Private method which is used to compress color of block into 8 byte BC1 block. Endpoints are corners
+		 * of color bounding box inset by 1/16 of its size, block is always encoded in four color mode.
+		 * @param	block is pointer to 64 byte RGBA block.
+		 * @param	output is pointer to 8 byte output block.
+		 */
+		void TextureCompressor::compressColorBlock(const unsigned char* block, unsigned char* output) const
+		{
+			int minColor[3] = {255, 255, 255};
+			int maxColor[3] = {0, 0, 0};
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				for(unsigned int c = 0; c < 3; ++c)
+				{
+					minColor[c] = min(minColor[c],static_cast<int>(block[i*4 + c]));
+					maxColor[c] = max(maxColor[c],static_cast<int>(block[i*4 + c]));
+				}
+			}
+
+			for(unsigned int c = 0; c < 3; ++c)
+			{
+				const int inset = (maxColor[c] - minColor[c]) >> 4;
+				minColor[c] += inset;
+				maxColor[c] -= inset;
+			}
+
+			unsigned short color0 = static_cast<unsigned short>((((maxColor[0]*31 + 127) / 255) << 11) | (((maxColor[1]*63 + 127) / 255) << 5) | ((maxColor[2]*31 + 127) / 255));
+			unsigned short color1 = static_cast<unsigned short>((((minColor[0]*31 + 127) / 255) << 11) | (((minColor[1]*63 + 127) / 255) << 5) | ((minColor[2]*31 + 127) / 255));
+			if(color0 < color1)
+				swap(color0,color1);
+
+			int palette[4][3];
+			const unsigned short endpoints[2] = {color0, color1};
+			for(unsigned int e = 0; e < 2; ++e)
+			{
+				const int red = (endpoints[e] >> 11) & 31;
+				const int green = (endpoints[e] >> 5) & 63;
+				const int blue = endpoints[e] & 31;
+				palette[e][0] = (red << 3) | (red >> 2);
+				palette[e][1] = (green << 2) | (green >> 4);
+				palette[e][2] = (blue << 3) | (blue >> 2);
+			}
+			for(unsigned int c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2*palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2*palette[1][c]) / 3;
+			}
+
+			unsigned int indices = 0;
+			if(color0 != color1)
+			{
+				for(unsigned int i = 0; i < 16; ++i)
+				{
+					unsigned int bestIndex = 0;
+					int bestDistance = INT_MAX;
+					for(unsigned int p = 0; p < 4; ++p)
+					{
+						int distance = 0;
+						for(unsigned int c = 0; c < 3; ++c)
+						{
+							const int delta = block[i*4 + c] - palette[p][c];
+							distance += delta*delta;
+						}
+						if(distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= bestIndex << (i*2);
+				}
+			}
+
+			output[0] = color0 & 0xFF;
+			output[1] = color0 >> 8;
+			output[2] = color1 & 0xFF;
+			output[3] = color1 >> 8;
+			for(unsigned int i = 0; i < 4; ++i)
+				output[4 + i] = (indices >> (i*8)) & 0xFF;
+		}
+
+		/**
+		 * Private method which is used to compress one channel of block into 8 byte BC4 block, which is alpha
+		 * block of BC3 and channel block of BC5. Endpoints are channel minimum and maximum, block is always
+		 * encoded in eight value mode.
+		 * @param	block is pointer to 64 byte RGBA block.
+		 * @param	channel is compressed channel id.
+		 * @param	output is pointer to 8 byte output block.
+		 */
+		void TextureCompressor::compressChannelBlock(const unsigned char* block, const unsigned int channel, unsigned char* output) const
+		{
+			int minValue = 255;
+			int maxValue = 0;
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				minValue = min(minValue,static_cast<int>(block[i*4 + channel]));
+				maxValue = max(maxValue,static_cast<int>(block[i*4 + channel]));
+			}
+
+			unsigned long long indices = 0;
+			if(maxValue != minValue)
+			{
+				int palette[8];
+				palette[0] = maxValue;
+				palette[1] = minValue;
+				for(int p = 1; p < 7; ++p)
+					palette[p + 1] = ((7 - p)*maxValue + p*minValue) / 7;
+
+				for(unsigned int i = 0; i < 16; ++i)
+				{
+					unsigned long long bestIndex = 0;
+					int bestDistance = INT_MAX;
+					for(unsigned int p = 0; p < 8; ++p)
+					{
+						const int distance = abs(block[i*4 + channel] - palette[p]);
+						if(distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= bestIndex << (i*3);
+				}
+			}
+
+			output[0] = static_cast<unsigned char>(maxValue);
+			output[1] = static_cast<unsigned char>(minValue);
+			for(unsigned int i = 0; i < 6; ++i)
+				output[2 + i] = (indices >> (i*8)) & 0xFF;
+		}
+	}
+}
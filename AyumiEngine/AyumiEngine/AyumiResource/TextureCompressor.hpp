@@ -0,0 +1,52 @@
+/**
+ * File contains declaration of TextureCompressor class.
+ * @file    TextureCompressor.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-21
+ */
+
+#ifndef TEXTURECOMPRESSOR_HPP
+#define TEXTURECOMPRESSOR_HPP
+
+#include <vector>
+#include <GL/glew.h>
+
+#include "TextureType.hpp"
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int MAX_COMPRESS_WORKERS = 4;
+		const unsigned int COMPRESS_PARALLEL_BLOCKS = 4096;
+
+		/**
+		 * Class represents CPU block compression encoder. RGBA images are encoded into BC1 (DXT1), BC3 (DXT5)
+		 * or BC5 (RGTC2) 4x4 blocks. Endpoints are chosen by inset bounding box of block colors, indices by
+		 * nearest palette entry, so encoder is fast enough to run during loading. Large levels are split into
+		 * block rows encoded by WorkerPool threads. Class also generate mip chain by 2x2 box filter.
+		 */
+		class TextureCompressor : private AyumiUtils::Noncopyable
+		{
+		private:
+			void compressRange(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLenum format, unsigned char* blocks, const unsigned int firstRow, const unsigned int lastRow) const;
+			void fetchBlock(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLsizei x, const GLsizei y, unsigned char* block) const;
+			void compressColorBlock(const unsigned char* block, unsigned char* output) const;
+			void compressChannelBlock(const unsigned char* block, const unsigned int channel, unsigned char* output) const;
+
+		public:
+			TextureCompressor();
+			~TextureCompressor();
+
+			GLenum chooseFormat(const unsigned char* pixels, const GLsizei width, const GLsizei height, const TextureCompression compression) const;
+			void compressLevel(const unsigned char* pixels, const GLsizei width, const GLsizei height, const GLenum format, unsigned char* blocks) const;
+			void generateMipmap(const unsigned char* pixels, const GLsizei width, const GLsizei height, const bool normalMap, std::vector<unsigned char>& mipmap) const;
+
+			unsigned int getLevelSize(const GLenum format, const GLsizei width, const GLsizei height) const;
+			unsigned int getLevelAmount(const GLsizei width, const GLsizei height) const;
+		};
+	}
+}
+#endif
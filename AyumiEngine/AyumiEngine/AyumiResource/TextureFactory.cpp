@@ -5,6 +5,10 @@
  * @date    2011-08-02
  */
 
+#include <cctype>
+#include <iterator>
+#include <algorithm>
+
 #include "TextureFactory.hpp"
 
 using namespace std;
@@ -14,11 +18,13 @@ namespace AyumiEngine
 	namespace AyumiResource
 	{
 		/**
-		 * Class default constructor. Nothing to do.
+		 * Class default constructor. Compressed images are cached in Data/Cache directory.
 		 */
-		TextureFactory::TextureFactory()
+		TextureFactory::TextureFactory() : textureCache("Data/Cache/")
 		{
-
+			colorCompressionSupported = false;
+			normalCompressionSupported = false;
+			fallbackDecodes = 0;
 		}
 
 		/**
@@ -30,44 +36,53 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Method is used to create texture resource. It implement Factory Method, depends on resource name
-		 * factory choose creating method.
+		 * Method is used to create texture resource. It implement Factory Method, depends on resource type
+		 * factory create texture object with 1x1 placeholder image. Texture image is decoded and uploaded later.
+		 * Texture 2d is compressed to BC1/BC3, normal map is texture 2d compressed to BC5.
 		 * @param	name is resource name.
 		 * @param	path is resource file path.
-		 * @param	path2 is resource file layer path.
-		 * @param	path3 is resource file layer path.
-		 * @param	path4 is resource file layer path.
-		 * @param	path5 is resource file layer path.
-		 * @param	path6 is resource file layer path.
 		 * @param	type is name of resource type.
-		 * @return	loaded and created texture resource, or nullptr when and logger error type is
-		 *			not supported.
+		 * @return	created texture resource, or nullptr when and logger error type is not supported.
 		 */
-		Texture* TextureFactory::createTextureResource(const string& name, const string& path, const string& path2, const string& path3,const string& path4, const string& path5, const string& path6, const string& type)
+		Texture* TextureFactory::createTextureResource(const string& name, const string& path, const string& type)
 		{
-			Texture* textureResource = nullptr;
+			TextureType textureType = UNKNOWN;
+			TextureCompression textureCompression = NO_COMPRESSION;
 
 			if(type == "TEXTURE1D")
-				textureResource = createTexture1D(name,path);
+				textureType = TEXTURE1D;
 			else if(type == "TEXTURE2D")
-				textureResource = createTexture2D(name,path);
+			{
+				textureType = TEXTURE2D;
+				textureCompression = COLOR_COMPRESSION;
+			}
+			else if(type == "NORMALMAP")
+			{
+				textureType = TEXTURE2D;
+				textureCompression = NORMAL_COMPRESSION;
+			}
 			else if(type == "TEXTURE3D")
-				textureResource = createTexture3D(name,path);
+				textureType = TEXTURE3D;
 			else if(type == "TEXTURE_RECT")
-				textureResource = createRectangleTexture(name,path);
+				textureType = RECTANGLE;
 			else if(type == "CUBEMAP")
-				textureResource = createCubeMapTexture(name,path,path2,path3,path4,path5,path6);
+				textureType = CUBE_MAP;
 			else
 			{
 				Logger::getInstance()->saveLog(Log<string>("Undefined texture type requested!"));
-				textureResource = nullptr;
+				return nullptr;
 			}
 
+			Texture* textureResource = new Texture(name.c_str(),path.c_str());
+			textureResource->setTextureType(textureType);
+			textureResource->setTextureCompression(textureCompression);
+			createPlaceholder(textureResource);
 			return textureResource;
 		}
 
 		/**
-		 * Method is used to initialize tetxure facotry by initializing DevIL library.
+		 * Method is used to initialize tetxure facotry by initializing DevIL library, checking support of
+		 * compressed formats and creating texture cache directory.
 		 */
 		void TextureFactory::initializeFactory()
 		{
@@ -76,345 +91,389 @@ namespace AyumiEngine
 			
 			ilInit();
 			glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+
+			colorCompressionSupported = GLEW_EXT_texture_compression_s3tc != 0;
+			normalCompressionSupported = GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+			textureCache.initializeCache();
 		}
 
 		/**
-		 * Method is used to load and create texture 1d which can be used in Toon/Cartoon mapping.
+		 * Method is used to decode texture image file. Method is thread-safe - file reading, texture cache,
+		 * PNG and JPEG decoding of texture 2d and rectangle images and block compression run without lock. Other
+		 * images, and images which SFML image loader rejects, are decoded by DevIL guarded by decode mutex.
+		 * Texture 2D and rectangle images are
+		 * converted to RGBA, 3D and cube map images to RGB. Compressed texture 2d image is loaded from texture
+		 * cache when source file was not modified, otherwise it is compressed after decoding and cached.
 		 * @param	name is resource name.
-		 * @param	path is resource file path.
-		 * @return	pointer to loaded and created TEXTURE1D resource.
+		 * @param	path is image file path.
+		 * @param	type is texture type.
+		 * @param	compression is texture compression.
+		 * @param	image is reference to decoded image.
+		 * @return	false if image could not be loaded.
 		 */
-		Texture* TextureFactory::createTexture1D(const string& name, const string& path)
+		bool TextureFactory::decodeTextureImage(const string& name, const string& path, const TextureType type, const TextureCompression compression, TextureImage& image)
 		{
-			Texture* texture1D = new Texture(name.c_str(),path.c_str());
-			texture1D->setTextureType(TEXTURE1D);
+			if(type == TEXTURE1D)
+				return decodeTexture1D(path,image);
 
-			ifstream textureFile;
-			textureFile.open(path);
+			const bool compressed = isCompressionSupported(type,compression);
+			if(compressed && textureCache.loadImage(path,compression,image))
+				return true;
 
-			if(textureFile.is_open())
+			ifstream imageFile(path.c_str(),ios::in | ios::binary);
+			if(!imageFile.is_open())
 			{
-				int sampleAmount = 0;
-				int colorComponentAmount = 0;
-				int inputData = 0;
-
-				GLubyte* textureData = nullptr;
-
-				textureFile >> sampleAmount;
-				textureFile >> colorComponentAmount; 
-
-				textureData = new GLubyte[sampleAmount*colorComponentAmount];
-
-				for(int i = 0; i < sampleAmount*colorComponentAmount; ++i)
-				{
-					textureFile >> inputData;
-					textureData[i] = inputData % 256;
-				}
+				Logger::getInstance()->saveLog(Log<string>("Texture file opening error occurred: " + name));
+				return false;
+			}
 
-				glPixelStorei(GL_UNPACK_ALIGNMENT,1);					
-				glGenTextures(1,texture1D->getTexture());
-				glBindTexture(GL_TEXTURE_1D,*texture1D->getTexture());
+			vector<char> fileData((istreambuf_iterator<char>(imageFile)),istreambuf_iterator<char>());
+			imageFile.close();
+			if(fileData.empty())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Texture file reading error occurred: " + name));
+				return false;
+			}
 
-				glTexImage1D(GL_TEXTURE_1D,0,GL_RGB, sampleAmount,0,GL_RGB,GL_UNSIGNED_BYTE,textureData);
-				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+			bool decoded = false;
+			if((type == TEXTURE2D || type == RECTANGLE) && isReentrantFormat(path))
+				decoded = decodeReentrantImage(fileData,image);
+			if(!decoded)
+				decoded = decodeFallbackImage(name,path,type,fileData,image);
 
-				delete [] textureData;
+			if(decoded && compressed)
+			{
+				compressTextureImage(image,compression);
+				textureCache.saveImage(path,compression,image);
 			}
-			else
-				Logger::getInstance()->saveLog(Log<string>("Texture1D file opening error occurred!!"));
-			
-			textureFile.close();
-
-			return texture1D;
+			return decoded;
 		}
 
 		/**
-		 * Method is used to load and create texture 2d which can be used in all kind of materials.
-		 * @param	name is resource name.
-		 * @param	path is resource file path.
-		 * @return	pointer to loaded and created TEXTURE2D resource.
+		 * Method is used to upload decoded image into texture, placeholder is replaced. Must be called on OpenGL
+		 * thread. If pixel unpack buffer is bound, pixels is offset in that buffer. Compressed texture 2d levels
+		 * are uploaded one after another, mipmaps of uncompressed texture 2d are generated by driver. Mipmaps of
+		 * cube map are generated after last face.
+		 * @param	texture is pointer to texture resource.
+		 * @param	image is reference to decoded image.
+		 * @param	face is cube map face id, 0 for other types.
+		 * @param	pixels is pointer to image pixels or offset in bound pixel unpack buffer.
 		 */
-		Texture* TextureFactory::createTexture2D(const string& name, const string& path)
+		void TextureFactory::uploadTextureImage(Texture* texture, const TextureImage& image, const unsigned int face, const GLvoid* pixels)
 		{
-			Texture* texture2D = new Texture(name.c_str(),path.c_str());
-			texture2D->setTextureType(TEXTURE2D);
+			glBindTexture(texture->getType(),*texture->getTexture());
 
-			ILuint texID;
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path.c_str()))
+			switch(texture->getType())
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture2D loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
-
-			if(!ilConvertImage(IL_RGBA,IL_UNSIGNED_BYTE))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture2D converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+			case TEXTURE1D:
+				glTexImage1D(GL_TEXTURE_1D,0,image.components,image.width,0,image.format,GL_UNSIGNED_BYTE,pixels);
+				break;
+			case TEXTURE2D:
+				if(image.compressed)
+				{
+					const GLubyte* levelPixels = static_cast<const GLubyte*>(pixels);
+					for(GLsizei level = 0; level < image.levels; ++level)
+					{
+						const GLsizei width = max(1,image.width >> level);
+						const GLsizei height = max(1,image.height >> level);
+						const GLsizei size = textureCompressor.getLevelSize(image.format,width,height);
+						glCompressedTexImage2D(GL_TEXTURE_2D,level,image.format,width,height,0,size,levelPixels);
+						levelPixels += size;
+					}
+					glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAX_LEVEL,image.levels - 1);
+				}
+				else
+				{
+					glTexImage2D(GL_TEXTURE_2D,0,image.components,image.width,image.height,0,image.format,GL_UNSIGNED_BYTE,pixels);
+					glGenerateMipmap(GL_TEXTURE_2D);
+				}
+				glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR_MIPMAP_LINEAR);
+				break;
+			case RECTANGLE:
+				glTexImage2D(GL_TEXTURE_RECTANGLE,0,image.components,image.width,image.height,0,image.format,GL_UNSIGNED_BYTE,pixels);
+				break;
+			case TEXTURE3D:
+				glTexImage3D(GL_TEXTURE_3D,0,image.components,image.width,image.height,image.depth,0,image.format,GL_UNSIGNED_BYTE,pixels);
+				break;
+			case CUBE_MAP:
+				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,0,image.components,image.width,image.height,0,image.format,GL_UNSIGNED_BYTE,pixels);
+				if(face == 5)
+					glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+				break;
+			default:
+				break;
 			}
 
-			glGenTextures(1,texture2D->getTexture());
-			glBindTexture(GL_TEXTURE_2D,*texture2D->getTexture());
-
-			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-
-			float maximumAnisotropy;
-			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT,&maximumAnisotropy);
-
-			glTexParameterf(GL_TEXTURE_2D,GL_TEXTURE_MAX_ANISOTROPY_EXT,maximumAnisotropy);
-
-			glTexImage2D(GL_TEXTURE_2D,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				  ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-			
-			ilDeleteImages(1,&texID);
+			glBindTexture(texture->getType(),0);
+		}
 
-			return texture2D;
+		/**
+		 * Accessor to amount of images decoded by DevIL fallback since factory was created.
+		 * @return	amount of fallback decodes.
+		 */
+		unsigned int TextureFactory::getFallbackDecodes()
+		{
+			boost::mutex::scoped_lock lock(decodeLock);
+			return fallbackDecodes;
 		}
 
 		/**
-		 * Method is used to load and create texture 3d which can be used in terrain mapping, volumetri
-		 * effects etc.
-		 * @param	name is resource name.
-		 * @param	path is resource file path.
-		 * @return	pointer to loaded and created TEXTURE3D resource.
+		 * Private method which is used to create texture object with 1x1 placeholder image and set texture
+		 * parameters of texture type.
+		 * @param	texture is pointer to texture resource.
 		 */
-		Texture* TextureFactory::createTexture3D(const string& name, const string& path)
+		void TextureFactory::createPlaceholder(Texture* texture)
 		{
-			Texture* texture3D = new Texture(name.c_str(),path.c_str());
-			texture3D->setTextureType(TEXTURE3D);
+			const GLubyte placeholder[4] = {128, 128, 128, 255};
 
-			ILuint texID;
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path.c_str()))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture3D loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
+			glGenTextures(1,texture->getTexture());
+			glBindTexture(texture->getType(),*texture->getTexture());
 
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
+			switch(texture->getType())
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture3D converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+			case TEXTURE1D:
+				glTexImage1D(GL_TEXTURE_1D,0,GL_RGB,1,0,GL_RGB,GL_UNSIGNED_BYTE,placeholder);
+				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+				break;
+			case TEXTURE2D:
+			{
+				glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA,1,1,0,GL_RGBA,GL_UNSIGNED_BYTE,placeholder);
+				glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
+				glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
+				glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+
+				float maximumAnisotropy;
+				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT,&maximumAnisotropy);
+				glTexParameterf(GL_TEXTURE_2D,GL_TEXTURE_MAX_ANISOTROPY_EXT,maximumAnisotropy);
+				break;
+			}
+			case TEXTURE3D:
+				glTexImage3D(GL_TEXTURE_3D,0,GL_RGB,1,1,1,0,GL_RGB,GL_UNSIGNED_BYTE,placeholder);
+				glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_BORDER);
+				glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_BORDER);
+				glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_BORDER);
+				glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_LINEAR_MIPMAP_LINEAR);
+				glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+				break;
+			case RECTANGLE:
+				glTexImage2D(GL_TEXTURE_RECTANGLE,0,GL_RGBA,1,1,0,GL_RGBA,GL_UNSIGNED_BYTE,placeholder);
+				glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_WRAP_S,GL_CLAMP);
+				glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_WRAP_T,GL_CLAMP);
+				glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+				break;
+			case CUBE_MAP:
+				for(unsigned int i = 0; i < 6; ++i)
+					glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,0,GL_RGB,1,1,0,GL_RGB,GL_UNSIGNED_BYTE,placeholder);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_EDGE);
+				break;
+			default:
+				break;
 			}
 
-			glGenTextures(1,texture3D->getTexture());
-			glBindTexture(GL_TEXTURE_3D,*texture3D->getTexture());
-			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_BORDER);
-			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_BORDER);
-			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_BORDER);
-			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-
-			glTexImage3D(GL_TEXTURE_3D,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				  ilGetInteger(IL_IMAGE_HEIGHT),ilGetInteger(IL_IMAGE_DEPTH),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-			
-			ilDeleteImages(1,&texID);
-
-			return texture3D;
+			glBindTexture(texture->getType(),0);
 		}
 
 		/**
-		 * Method is used to load and create texture rect which can be used in Sprite and text rendering.
-		 * @param	name is resource name.
+		 * Private method which is used to decode texture 1d which can be used in Toon/Cartoon mapping. Texture 1d
+		 * file is text file with sample amount, color component amount and samples.
 		 * @param	path is resource file path.
-		 * @return	pointer to loaded and created RECTANGLE resource.
+		 * @param	image is reference to decoded image.
+		 * @return	false if file could not be opened.
 		 */
-		Texture* TextureFactory::createRectangleTexture(const string& name, const string& path)
+		bool TextureFactory::decodeTexture1D(const string& path, TextureImage& image)
 		{
-			Texture* textureRect = new Texture(name.c_str(),path.c_str());
-			textureRect->setTextureType(RECTANGLE);
+			ifstream textureFile;
+			textureFile.open(path);
 
-			ILuint texID;
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path.c_str()))
+			if(!textureFile.is_open())
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Rectangle loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				Logger::getInstance()->saveLog(Log<string>("Texture1D file opening error occurred!!"));
+				return false;
 			}
 
-			if(!ilConvertImage(IL_RGBA,IL_UNSIGNED_BYTE))
+			int sampleAmount = 0;
+			int colorComponentAmount = 0;
+			int inputData = 0;
+
+			textureFile >> sampleAmount;
+			textureFile >> colorComponentAmount; 
+
+			image.width = sampleAmount;
+			image.height = 1;
+			image.depth = 1;
+			image.levels = 1;
+			image.components = GL_RGB;
+			image.format = GL_RGB;
+			image.compressed = false;
+			image.pixels.resize(sampleAmount*colorComponentAmount);
+			for(int i = 0; i < sampleAmount*colorComponentAmount; ++i)
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Rectangle converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				textureFile >> inputData;
+				image.pixels[i] = inputData % 256;
 			}
+			
+			textureFile.close();
+			return true;
+		}
 
-			glGenTextures(1,textureRect->getTexture());
-			glBindTexture(GL_TEXTURE_RECTANGLE,*textureRect->getTexture());
-
-			glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_WRAP_S,GL_CLAMP);
-			glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_WRAP_T,GL_CLAMP);
-			glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_RECTANGLE,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+		/**
+		 * Private method which is used to check if image file can be decoded by SFML image loader without
+		 * decode lock. Only PNG and JPEG files are accepted, DevIL keeps their rows top to bottom too, so
+		 * both decoders give the same image.
+		 * @param	path is image file path.
+		 * @return	true if image file extension is png, jpg or jpeg.
+		 */
+		bool TextureFactory::isReentrantFormat(const string& path) const
+		{
+			const string::size_type dot = path.find_last_of('.');
+			if(dot == string::npos)
+				return false;
 
-			glTexImage2D(GL_TEXTURE_RECTANGLE,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				  ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-		
-			ilDeleteImages(1, &texID);
+			string extension = path.substr(dot + 1);
+			transform(extension.begin(),extension.end(),extension.begin(),::tolower);
+			return extension == "png" || extension == "jpg" || extension == "jpeg";
+		}
 
-			return textureRect;
+		/**
+		 * Private method which is used to decode image file by SFML image loader. Loader keeps no shared state,
+		 * so many workers decode images at the same time. Image is always decoded to RGBA.
+		 * @param	fileData is reference to image file content.
+		 * @param	image is reference to decoded image.
+		 * @return	false if SFML image loader could not decode image.
+		 */
+		bool TextureFactory::decodeReentrantImage(const vector<char>& fileData, TextureImage& image)
+		{
+			sf::Image decodedImage;
+			if(!decodedImage.loadFromMemory(&fileData[0],fileData.size()))
+				return false;
+
+			image.width = decodedImage.getSize().x;
+			image.height = decodedImage.getSize().y;
+			image.depth = 1;
+			image.levels = 1;
+			image.components = GL_RGBA;
+			image.format = GL_RGBA;
+			image.compressed = false;
+			const sf::Uint8* pixels = decodedImage.getPixelsPtr();
+			image.pixels.assign(pixels,pixels + image.width*image.height*4);
+			return true;
 		}
 
 		/**
-		 * Method is used to load and create cube map texture which can be used in sky mapping and cube mapping
+		 * Private method which is used to decode image file by DevIL. DevIL is not thread-safe, so decoding
+		 * and conversion are guarded by decode mutex. Texture 2D and rectangle images are converted to RGBA,
+		 * 3D and cube map images to RGB.
 		 * @param	name is resource name.
-		 * @param	path is resource file path.
-		 * @param	path2 is resource file path2.
-		 * @param	path3 is resource file path3.
-		 * @param	path4 is resource file path4.
-		 * @param	path5 is resource file path5.
-		 * @param	path6 is resource file path6.
-		 * @return	pointer to loaded and created CUBE_MAP resource.
+		 * @param	path is image file path.
+		 * @param	type is texture type.
+		 * @param	fileData is reference to image file content.
+		 * @param	image is reference to decoded image.
+		 * @return	false if image could not be decoded.
 		 */
-		Texture* TextureFactory::createCubeMapTexture(const string& name, const string& path, const string& path2, const string& path3, const string& path4, const string& path5, const string& path6)
+		bool TextureFactory::decodeFallbackImage(const string& name, const string& path, const TextureType type, const vector<char>& fileData, TextureImage& image)
 		{
-			Texture* cubeMap = new Texture(name.c_str(), path.c_str());
-			cubeMap->setTextureType(CUBE_MAP);
+			const ILenum format = (type == TEXTURE2D || type == RECTANGLE) ? IL_RGBA : IL_RGB;
+			bool decoded = true;
 
-			string filePath; 
+			boost::mutex::scoped_lock lock(decodeLock);
+			fallbackDecodes++;
 			ILuint texID;
-
-			glGenTextures(1,cubeMap->getTexture());
-			glBindTexture(GL_TEXTURE_CUBE_MAP,*cubeMap->getTexture());
 			ilGenImages(1,&texID);
 			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path.c_str()))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
 
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
+			if(!ilLoadL(ilTypeFromExt(path.c_str()),&fileData[0],fileData.size()))
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				Logger::getInstance()->saveLog(Log<string>("Texture loading error occurred: " + name));
+				decoded = false;
 			}
-
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-
-			ilDeleteImages(1, &texID);
-
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path2.c_str()))
+			else if(!ilConvertImage(format,IL_UNSIGNED_BYTE))
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				Logger::getInstance()->saveLog(Log<string>("Texture converting error occurred: " + name));
+				decoded = false;
 			}
-
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
+			else
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				image.width = ilGetInteger(IL_IMAGE_WIDTH);
+				image.height = ilGetInteger(IL_IMAGE_HEIGHT);
+				image.depth = ilGetInteger(IL_IMAGE_DEPTH);
+				image.levels = 1;
+				image.components = ilGetInteger(IL_IMAGE_BPP);
+				image.format = ilGetInteger(IL_IMAGE_FORMAT);
+				image.compressed = false;
+				const ILubyte* pixels = ilGetData();
+				image.pixels.assign(pixels,pixels + ilGetInteger(IL_IMAGE_SIZE_OF_DATA));
 			}
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-
 			ilDeleteImages(1,&texID);
+			return decoded;
+		}
 
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path3.c_str()))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
-
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
-
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-
-			ilDeleteImages(1, &texID);
-
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path4.c_str()))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
-
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
-
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-
-			ilDeleteImages(1, &texID);
-
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path5.c_str()))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
+		/**
+		 * Private method which is used to check if texture image should be block compressed.
+		 * @param	type is texture type.
+		 * @param	compression is texture compression.
+		 * @return	true if texture is texture 2d and its compressed format is supported.
+		 */
+		bool TextureFactory::isCompressionSupported(const TextureType type, const TextureCompression compression) const
+		{
+			if(type != TEXTURE2D)
+				return false;
+			if(compression == COLOR_COMPRESSION)
+				return colorCompressionSupported;
+			if(compression == NORMAL_COMPRESSION)
+				return normalCompressionSupported;
+			return false;
+		}
 
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
+		/**
+		 * Private method which is used to replace decoded RGBA image by compressed blocks of full mip chain.
+		 * Next level is filtered from uncompressed previous level, so compression error does not accumulate.
+		 * @param	image is reference to decoded RGBA image.
+		 * @param	compression is texture compression.
+		 */
+		void TextureFactory::compressTextureImage(TextureImage& image, const TextureCompression compression)
+		{
+			const GLenum format = textureCompressor.chooseFormat(&image.pixels[0],image.width,image.height,compression);
+			const GLsizei levels = textureCompressor.getLevelAmount(image.width,image.height);
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
+			unsigned int blocksSize = 0;
+			for(GLsizei level = 0; level < levels; ++level)
+				blocksSize += textureCompressor.getLevelSize(format,max(1,image.width >> level),max(1,image.height >> level));
 
-			ilDeleteImages(1, &texID);
+			vector<unsigned char> blocks(blocksSize);
+			vector<unsigned char> levelPixels;
+			vector<unsigned char> mipmapPixels;
+			levelPixels.swap(image.pixels);
 
-			ilGenImages(1,&texID);
-			ilBindImage(texID);
-			
-			if(!ilLoadImage((const ILstring)path6.c_str()))
+			unsigned int offset = 0;
+			for(GLsizei level = 0; level < levels; ++level)
 			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap loading error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
-			}
+				const GLsizei width = max(1,image.width >> level);
+				const GLsizei height = max(1,image.height >> level);
+				textureCompressor.compressLevel(&levelPixels[0],width,height,format,&blocks[offset]);
+				offset += textureCompressor.getLevelSize(format,width,height);
 
-			if(!ilConvertImage(IL_RGB,IL_UNSIGNED_BYTE))
-			{
-				Logger::getInstance()->saveLog(Log<string>("Texture Cubemap converting error occurred!"));
-				Logger::getInstance()->saveLog(Log<string>(name));
+				if(level + 1 < levels)
+				{
+					textureCompressor.generateMipmap(&levelPixels[0],width,height,compression == NORMAL_COMPRESSION,mipmapPixels);
+					levelPixels.swap(mipmapPixels);
+				}
 			}
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z,0,ilGetInteger(IL_IMAGE_BPP),ilGetInteger(IL_IMAGE_WIDTH),
-				ilGetInteger(IL_IMAGE_HEIGHT),0,ilGetInteger(IL_IMAGE_FORMAT),GL_UNSIGNED_BYTE,ilGetData());
-
-			ilDeleteImages(1,&texID);
-
-			glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_CUBE_MAP,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_EDGE);
-			glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-
-			return cubeMap;
+			image.depth = 1;
+			image.levels = levels;
+			image.components = format;
+			image.format = format;
+			image.compressed = true;
+			image.pixels.swap(blocks);
 		}
 	}
 }
@@ -10,10 +10,16 @@
 
 #include <IL/il.h>
 #include <string>
+#include <vector>
 #include <fstream>
+#include <boost/thread.hpp>
+#include <SFML/Graphics/Image.hpp>
 
 #include "Texture.hpp"
 #include "TextureType.hpp"
+#include "TextureImage.hpp"
+#include "TextureCache.hpp"
+#include "TextureCompressor.hpp"
 
 #include "../Logger.hpp"
 
@@ -24,29 +30,42 @@ namespace AyumiEngine
 		/**
 		 * Class represents one of Engine ResourceManager/TextureManager subclass - TextureFactory
 		 * which is used by TextureManager to create all supported types of texture:
-		 * texture 1d/2d/3d, cube maps and rectangle texture. Class has methods to
-		 * load all kind of texture resources and store it in TextureManager class.
+		 * texture 1d/2d/3d, cube maps and rectangle texture. Texture creation is split into three stages:
+		 * texture object with placeholder image is created on OpenGL thread, image is decoded into
+		 * TextureImage on any thread and decoded image is uploaded on OpenGL thread. PNG and JPEG images of
+		 * texture 2d and rectangle are decoded by SFML image loader which keeps no shared state, so they are
+		 * decoded in parallel. DevIL keeps global image state and is not thread-safe, so it is used only as
+		 * fallback for other formats and types and its decoding is serialized by mutex. Texture 2d images are block
+		 * compressed with full mip chain when hardware support it, compressed images are kept in texture cache,
+		 * so next loading skip decoding.
 		 * It is implementation of simple Factory design pattern.
 		 */
 		class TextureFactory
 		{
 		private:
-			Texture* createTexture1D(const std::string& name, const std::string& path);
-			Texture* createTexture2D(const std::string& name, const std::string& path);
-			Texture* createTexture3D(const std::string& name, const std::string& path);
-			Texture* createRectangleTexture(const std::string& name, const std::string& path);
-			Texture* createCubeMapTexture(const std::string& name, const std::string& path, const std::string& path2,
-									const std::string& path3, const std::string& path4, const std::string& path5,
-									const std::string& path6);
+			boost::mutex decodeLock;
+			TextureCompressor textureCompressor;
+			TextureCache textureCache;
+			bool colorCompressionSupported;
+			bool normalCompressionSupported;
+			unsigned int fallbackDecodes;
+
+			void createPlaceholder(Texture* texture);
+			bool decodeTexture1D(const std::string& path, TextureImage& image);
+			bool isReentrantFormat(const std::string& path) const;
+			bool decodeReentrantImage(const std::vector<char>& fileData, TextureImage& image);
+			bool decodeFallbackImage(const std::string& name, const std::string& path, const TextureType type, const std::vector<char>& fileData, TextureImage& image);
+			bool isCompressionSupported(const TextureType type, const TextureCompression compression) const;
+			void compressTextureImage(TextureImage& image, const TextureCompression compression);
 		public:
 			TextureFactory();
 			~TextureFactory();
 
 			void initializeFactory();
-			Texture* createTextureResource(const std::string& name, const std::string& path, const std::string& path2,
-									const std::string& path3, const std::string& path4, const std::string& path5,
-									const std::string& path6, const std::string& type);
-
+			Texture* createTextureResource(const std::string& name, const std::string& path, const std::string& type);
+			bool decodeTextureImage(const std::string& name, const std::string& path, const TextureType type, const TextureCompression compression, TextureImage& image);
+			void uploadTextureImage(Texture* texture, const TextureImage& image, const unsigned int face, const GLvoid* pixels);
+			unsigned int getFallbackDecodes();
 		};
 	}
 }
@@ -0,0 +1,36 @@
+/**
+ * File contains declaration of TextureImage structure.
+ * @file    TextureImage.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-21
+ */
+
+#ifndef TEXTUREIMAGE_HPP
+#define TEXTUREIMAGE_HPP
+
+#include <vector>
+#include <GL/glew.h>
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Structure represents decoded CPU-side texture image. Pixels are tightly packed, components store
+		 * internal format used by upload. Compressed images store blocks of all mip levels one after another,
+		 * uncompressed images store only base level.
+		 */
+		struct TextureImage
+		{
+			GLsizei width;
+			GLsizei height;
+			GLsizei depth;
+			GLsizei levels;
+			GLint components;
+			GLenum format;
+			bool compressed;
+			std::vector<unsigned char> pixels;
+		};
+	}
+}
+#endif
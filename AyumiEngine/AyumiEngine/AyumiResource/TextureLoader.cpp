@@ -0,0 +1,277 @@
+/**
+ * File contains definition of TextureLoader class.
+ * @file    TextureLoader.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-20
+ */
+
+#include <set>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "TextureLoader.hpp"
+
+using namespace std;
+using namespace boost::posix_time;
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		/**
+		 * Class constructor with initialize parameters. Workers are started in initialization.
+		 * @param	textureFactory is pointer to factory which decode and upload images.
+		 */
+		TextureLoader::TextureLoader(TextureFactory* textureFactory)
+		{
+			this->textureFactory = textureFactory;
+			pendingJobs = 0;
+			stopWorkers = false;
+			pixelBuffer = 0;
+			fallbackStart = 0;
+			memset(&statistics,0,sizeof(statistics));
+		}
+
+		/**
+		 * Class destructor, stop decode workers and free not uploaded jobs and pixel buffer.
+		 */
+		TextureLoader::~TextureLoader()
+		{
+			{
+				boost::mutex::scoped_lock lock(jobLock);
+				stopWorkers = true;
+			}
+			jobCondition.notify_all();
+			decodeWorkers.join_all();
+
+			set<TextureJob*> jobs;
+			for(deque<DecodeTask>::const_iterator it = decodeTasks.begin(); it != decodeTasks.end(); ++it)
+				jobs.insert((*it).job);
+			jobs.insert(readyJobs.begin(),readyJobs.end());
+			for(set<TextureJob*>::const_iterator it = jobs.begin(); it != jobs.end(); ++it)
+				delete (*it);
+			decodeTasks.clear();
+			readyJobs.clear();
+
+			if(pixelBuffer != 0)
+				glDeleteBuffers(1,&pixelBuffer);
+		}
+
+		/**
+		 * Method is used to start decode workers and create pixel buffer object if it is supported.
+		 */
+		void TextureLoader::initializeLoader()
+		{
+			const unsigned int workers = max(1u,min(MAX_DECODE_WORKERS,boost::thread::hardware_concurrency()));
+			for(unsigned int i = 0; i < workers; ++i)
+				decodeWorkers.create_thread(boost::bind(&TextureLoader::decodeImages,this));
+
+			if(GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object)
+				glGenBuffers(1,&pixelBuffer);
+		}
+
+		/**
+		 * Method is used to add texture loading job. Each job image is decoded by first free worker. Job added
+		 * to idle loader starts new loading batch.
+		 * @param	texture is shared pointer to texture with placeholder image.
+		 * @param	name is texture resource name.
+		 * @param	paths is collection of image file paths, six paths for cube map.
+		 */
+		void TextureLoader::addTexture(TextureResource texture, const string& name, const vector<string>& paths)
+		{
+			TextureJob* job = new TextureJob();
+			job->texture = texture;
+			job->name = name;
+			job->paths = paths;
+			job->images.resize(paths.size());
+			job->decoded.resize(paths.size(),false);
+			job->decodedImages = 0;
+			job->uploadedImages = 0;
+
+			{
+				boost::mutex::scoped_lock lock(jobLock);
+				if(pendingJobs == 0)
+				{
+					memset(&statistics,0,sizeof(statistics));
+					loadingStart = microsec_clock::universal_time();
+					fallbackStart = textureFactory->getFallbackDecodes();
+				}
+				for(unsigned int i = 0; i < paths.size(); ++i)
+				{
+					DecodeTask task = {job,i};
+					decodeTasks.push_back(task);
+				}
+				pendingJobs++;
+			}
+			jobCondition.notify_all();
+		}
+
+		/**
+		 * Method is used to upload decoded images on OpenGL thread. Images are uploaded till byte budget is
+		 * exceeded, at least one image is uploaded per call, so large images are not starved.
+		 * @param	byteBudget is maximum amount of uploaded bytes.
+		 * @return	amount of uploaded bytes.
+		 */
+		unsigned int TextureLoader::uploadTextures(const unsigned int byteBudget)
+		{
+			unsigned int uploadedBytes = 0;
+			while(uploadedBytes < byteBudget)
+			{
+				TextureJob* job = nullptr;
+				{
+					boost::mutex::scoped_lock lock(jobLock);
+					if(readyJobs.empty())
+						break;
+					job = readyJobs.front();
+				}
+
+				uploadedBytes += uploadImage(job);
+				if(job->uploadedImages == job->images.size())
+				{
+					job->texture->setTextureLoaded(true);
+					boost::mutex::scoped_lock lock(jobLock);
+					readyJobs.pop_front();
+					delete job;
+					if(--pendingJobs == 0)
+						logLoadingStatistics();
+				}
+			}
+			return uploadedBytes;
+		}
+
+		/**
+		 * Method is used to wait for all pending jobs and upload them without budget. It can be used when
+		 * textures must be ready before first frame.
+		 */
+		void TextureLoader::finishTextures()
+		{
+			while(getPendingTextures() > 0)
+			{
+				{
+					boost::mutex::scoped_lock lock(jobLock);
+					while(readyJobs.empty() && pendingJobs > 0)
+						readyCondition.wait(lock);
+				}
+				uploadTextures(UINT_MAX);
+			}
+		}
+
+		/**
+		 * Method is used to get amount of textures which are not uploaded yet.
+		 * @return	amount of pending textures.
+		 */
+		unsigned int TextureLoader::getPendingTextures()
+		{
+			boost::mutex::scoped_lock lock(jobLock);
+			return pendingJobs;
+		}
+
+		/**
+		 * Method is used to get statistics of last loading batch.
+		 * @return	copy of loading statistics.
+		 */
+		TextureLoadingStatistics TextureLoader::getLoadingStatistics()
+		{
+			boost::mutex::scoped_lock lock(jobLock);
+			return statistics;
+		}
+
+		/**
+		 * Private method which is used as decode worker thread loop. Worker takes decode task, decode image
+		 * without holding job lock and move job to ready queue when all its images are decoded. Only DevIL
+		 * fallback decoding waits for TextureFactory decode mutex. Decode time is added to loading statistics.
+		 */
+		void TextureLoader::decodeImages()
+		{
+			for(;;)
+			{
+				DecodeTask task;
+				{
+					boost::mutex::scoped_lock lock(jobLock);
+					while(decodeTasks.empty() && !stopWorkers)
+						jobCondition.wait(lock);
+					if(stopWorkers)
+						return;
+					task = decodeTasks.front();
+					decodeTasks.pop_front();
+				}
+
+				TextureJob* job = task.job;
+				const ptime decodeStart = microsec_clock::universal_time();
+				const bool decoded = textureFactory->decodeTextureImage(job->name,job->paths[task.image],job->texture->getType(),job->texture->getCompression(),job->images[task.image]);
+
+				const float decodeTime = (microsec_clock::universal_time() - decodeStart).total_microseconds()*0.000001f;
+
+				boost::mutex::scoped_lock lock(jobLock);
+				statistics.decodedImages++;
+				statistics.decodeTime += decodeTime;
+				job->decoded[task.image] = decoded;
+				if(++job->decodedImages == job->images.size())
+				{
+					readyJobs.push_back(job);
+					readyCondition.notify_all();
+				}
+			}
+		}
+
+		/**
+		 * Private method which is used to upload next image of decoded job. Pixels are copied into orphaned pixel
+		 * buffer and texture image is specified from buffer. Images which failed to decode keep placeholder.
+		 * @param	job is pointer to decoded texture job.
+		 * @return	amount of uploaded bytes.
+		 */
+		unsigned int TextureLoader::uploadImage(TextureJob* job)
+		{
+			const unsigned int id = job->uploadedImages++;
+			TextureImage& image = job->images[id];
+			const unsigned int size = image.pixels.size();
+			if(!job->decoded[id] || size == 0)
+				return 0;
+
+			if(pixelBuffer != 0)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER,pixelBuffer);
+				glBufferData(GL_PIXEL_UNPACK_BUFFER,size,NULL,GL_STREAM_DRAW);
+				void* bufferData = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,0,size,GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+				if(bufferData != nullptr)
+				{
+					memcpy(bufferData,&image.pixels[0],size);
+					glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+					textureFactory->uploadTextureImage(job->texture.get(),image,id,reinterpret_cast<const GLvoid*>(0));
+				}
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER,0);
+				if(bufferData == nullptr)
+					textureFactory->uploadTextureImage(job->texture.get(),image,id,&image.pixels[0]);
+			}
+			else
+				textureFactory->uploadTextureImage(job->texture.get(),image,id,&image.pixels[0]);
+
+			vector<unsigned char>().swap(image.pixels);
+			return size;
+		}
+
+		/**
+		 * Private method which is used to finish loading batch statistics and log them. It is called with job
+		 * lock held when last pending texture is uploaded.
+		 */
+		void TextureLoader::logLoadingStatistics()
+		{
+			statistics.loadingTime = (microsec_clock::universal_time() - loadingStart).total_microseconds()*0.000001f;
+			statistics.fallbackImages = textureFactory->getFallbackDecodes() - fallbackStart;
+
+			string log = "Texture loading finished, images: ";
+			log += boost::lexical_cast<string>(statistics.decodedImages);
+			log += " (DevIL fallback: ";
+			log += boost::lexical_cast<string>(statistics.fallbackImages);
+			log += "), decode time: ";
+			log += boost::lexical_cast<string>(static_cast<unsigned int>(statistics.decodeTime*1000.0f));
+			log += " ms, loading time: ";
+			log += boost::lexical_cast<string>(static_cast<unsigned int>(statistics.loadingTime*1000.0f));
+			log += " ms";
+			Logger::getInstance()->saveLog(Log<string>(log));
+		}
+	}
+}
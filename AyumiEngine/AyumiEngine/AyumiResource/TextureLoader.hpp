@@ -0,0 +1,107 @@
+/**
+ * File contains declaration of TextureLoader class.
+ * @file    TextureLoader.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-20
+ */
+
+#ifndef TEXTURELOADER_HPP
+#define TEXTURELOADER_HPP
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <boost/thread.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "TextureFactory.hpp"
+
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiResource
+	{
+		const unsigned int MAX_DECODE_WORKERS = 4;
+		const unsigned int TEXTURE_UPLOAD_BUDGET = 4194304;
+
+		/**
+		 * Structure represents texture loading job. Job keeps texture alive till all images are uploaded,
+		 * cube maps have six images which are decoded independently.
+		 */
+		struct TextureJob
+		{
+			TextureResource texture;
+			std::string name;
+			std::vector<std::string> paths;
+			std::vector<TextureImage> images;
+			std::vector<bool> decoded;
+			unsigned int decodedImages;
+			unsigned int uploadedImages;
+		};
+
+		/**
+		 * Structure represents statistics of last loading batch - textures added while loader was idle till
+		 * all of them are uploaded. Decode time is sum of decode times of all images in seconds, loading time
+		 * is wall time of batch, so parallel decoding makes loading time shorter than decode time.
+		 */
+		struct TextureLoadingStatistics
+		{
+			unsigned int decodedImages;
+			unsigned int fallbackImages;
+			float decodeTime;
+			float loadingTime;
+		};
+
+		/**
+		 * Structure represents decode task of one job image.
+		 */
+		struct DecodeTask
+		{
+			TextureJob* job;
+			unsigned int image;
+		};
+
+		/**
+		 * Class represents asynchronous texture loader. Texture images are loaded by pool of worker threads
+		 * into CPU-side images, so OpenGL thread never waits for image files. PNG and JPEG images are decoded
+		 * by workers in parallel, DevIL fallback decoding is serialized by TextureFactory. Loading statistics
+		 * are logged when all pending textures are uploaded. Decoded jobs are uploaded on OpenGL thread with per-frame byte budget. Uploads
+		 * use pixel buffer object when it is available, so driver can copy pixels asynchronously. Textures
+		 * contain placeholder image till their images are uploaded.
+		 */
+		class TextureLoader : private AyumiUtils::Noncopyable
+		{
+		private:
+			TextureFactory* textureFactory;
+			boost::thread_group decodeWorkers;
+			boost::mutex jobLock;
+			boost::condition_variable jobCondition;
+			boost::condition_variable readyCondition;
+			std::deque<DecodeTask> decodeTasks;
+			std::deque<TextureJob*> readyJobs;
+			unsigned int pendingJobs;
+			bool stopWorkers;
+			GLuint pixelBuffer;
+			TextureLoadingStatistics statistics;
+			boost::posix_time::ptime loadingStart;
+			unsigned int fallbackStart;
+
+			void decodeImages();
+			unsigned int uploadImage(TextureJob* job);
+			void logLoadingStatistics();
+
+		public:
+			TextureLoader(TextureFactory* textureFactory);
+			~TextureLoader();
+
+			void initializeLoader();
+			void addTexture(TextureResource texture, const std::string& name, const std::vector<std::string>& paths);
+			unsigned int uploadTextures(const unsigned int byteBudget = TEXTURE_UPLOAD_BUDGET);
+			void finishTextures();
+			unsigned int getPendingTextures();
+			TextureLoadingStatistics getLoadingStatistics();
+		};
+	}
+}
+#endif
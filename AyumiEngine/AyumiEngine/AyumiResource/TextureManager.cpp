@@ -20,17 +20,21 @@ namespace AyumiEngine
 		TextureManager::TextureManager(const char* scriptFileName)
 		{
 			textureFactory = new TextureFactory();
+			textureLoader = new TextureLoader(textureFactory);
 			resourceScript = new AyumiScript(scriptFileName);
 			prepareResourceScript();
 
 			textureFactory->initializeFactory();
+			textureLoader->initializeLoader();
 		}
 
 		/**
-		 * Class destructor, free allocated memory for loading script.
+		 * Class destructor, free allocated memory for loading script. Loader is deleted first, so decode workers
+		 * are stopped before textures and factory are released.
 		 */
 		TextureManager::~TextureManager()
 		{
+			delete textureLoader;
 			clearResourceMap();
 			delete textureFactory;
 			delete resourceScript;
@@ -54,6 +58,32 @@ namespace AyumiEngine
 			resourceScript->executeScript();
 		}
 
+		/**
+		 * Method is used to upload decoded texture images with per-frame budget. Must be called on OpenGL thread.
+		 * @return	amount of uploaded bytes.
+		 */
+		unsigned int TextureManager::uploadTextures()
+		{
+			return textureLoader->uploadTextures();
+		}
+
+		/**
+		 * Method is used to wait for all registered textures and upload them.
+		 */
+		void TextureManager::finishTextures()
+		{
+			textureLoader->finishTextures();
+		}
+
+		/**
+		 * Method is used to get amount of textures which still contain placeholder.
+		 * @return	amount of pending textures.
+		 */
+		unsigned int TextureManager::getPendingTextures()
+		{
+			return textureLoader->getPendingTextures();
+		}
+
 		/** 
 		 * Private method which is used to prepare loading script. By using Luabind engine register Manager class
 		 * to Lua namespace and bind global pointer to manager object.
@@ -79,9 +109,10 @@ namespace AyumiEngine
 		 */
 		void TextureManager::registerResource(const string& name, const string& path, const string& type)
 		{
-			Texture* textureResource = nullptr;
-			textureResource = textureFactory->createTextureResource(name,path,string(),string(),string(),string(),string(),type);
-			addResource(name,TextureResource(textureResource));
+			TextureResource textureResource(textureFactory->createTextureResource(name,path,type));
+			addResource(name,textureResource);
+			if(textureResource != nullptr)
+				textureLoader->addTexture(textureResource,name,vector<string>(1,path));
 		}
 
 		/**
@@ -97,9 +128,21 @@ namespace AyumiEngine
 		 */
 		void TextureManager::registerResource(const string& name, const string& path, const string& path2, const string& path3,const string& path4, const string& path5, const string& path6, const string& type)
 		{
-			Texture* textureResource = nullptr;
-			textureResource = textureFactory->createTextureResource(name,path,path2,path3,path4,path5,path6,type);
-			addResource(name,TextureResource(textureResource));
+			TextureResource textureResource(textureFactory->createTextureResource(name,path,type));
+			addResource(name,textureResource);
+			if(textureResource == nullptr)
+				return;
+
+			vector<string> paths(1,path);
+			if(textureResource->getType() == CUBE_MAP)
+			{
+				paths.push_back(path2);
+				paths.push_back(path3);
+				paths.push_back(path4);
+				paths.push_back(path5);
+				paths.push_back(path6);
+			}
+			textureLoader->addTexture(textureResource,name,paths);
 		}
 
 		/**
@@ -10,7 +10,7 @@
 
 #include <boost/shared_ptr.hpp>
 
-#include "TextureFactory.hpp"
+#include "TextureLoader.hpp"
 #include "../AyumiScript.hpp"
 #include "../AyumiUtils/Manager.hpp"
 
@@ -18,18 +18,18 @@ namespace AyumiEngine
 {
 	namespace AyumiResource
 	{
-		typedef boost::shared_ptr<Texture> TextureResource;
-
 		/**
 		 * Class represnets one of Engine ResourceManager subclass. TextureManager extends templated Manager pattern.
 		 * It is used to load and store Texture objects using AyumiScript. It can load any format that is supported
 		 * by Devil library and translate it to any texture type that is descriped in Engine documentation. It use
-		 * TextureFactory to load supported resources.
+		 * TextureFactory to load supported resources. Registered textures are available immediately with placeholder
+		 * image, their images are decoded by TextureLoader workers and uploaded with per-frame budget.
 		 */
 		class TextureManager : public AyumiUtils::Manager<std::string,TextureResource>
 		{
 		private:
 			TextureFactory* textureFactory;
+			TextureLoader* textureLoader;
 			AyumiScript* resourceScript;
 			
 			void prepareResourceScript();
@@ -45,6 +45,9 @@ namespace AyumiEngine
 
 			void initializeResources();
 			void updateResources(const std::string& scriptPath);
+			unsigned int uploadTextures();
+			void finishTextures();
+			unsigned int getPendingTextures();
 		};
 	}
 }
@@ -26,6 +26,17 @@ namespace AyumiEngine
 			CUBE_MAP = GL_TEXTURE_CUBE_MAP,
 			RECTANGLE = GL_TEXTURE_RECTANGLE
 		};
+
+		/**
+		 * Enumeration represents block compression of texture 2d images. Color textures are compressed to BC1,
+		 * or BC3 when image has alpha, normal maps are compressed to two-channel BC5.
+		 */
+		enum TextureCompression
+		{
+			NO_COMPRESSION,
+			COLOR_COMPRESSION,
+			NORMAL_COMPRESSION
+		};
 	}
 }
 #endif
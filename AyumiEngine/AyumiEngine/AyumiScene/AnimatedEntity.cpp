@@ -5,6 +5,8 @@
  * @date    2011-08-24
  */
 
+#include <cstring>
+
 #include "AnimatedEntity.hpp"
 
 using namespace std;
@@ -23,16 +25,16 @@ namespace AyumiEngine
 		 */
 		AnimatedEntity::AnimatedEntity(const string& entityName, const string& meshName, const string& materialName) : SceneEntity(entityName,meshName,materialName)
 		{
-
+			animationSystem = nullptr;
+			animationId = 0;
 		}
 
 		/**
-		 * Class constructor, free allocated memeory. Delete created vertex buffers collection.
+		 * Class destructor. Key frame vertex buffers are shared, they are released with mesh geometry.
 		 */
 		AnimatedEntity::~AnimatedEntity()
 		{
-			delete [] entityGeometry.geomteryVbo;
-			entityGeometry.geomteryVbo = nullptr;
+
 		}
 
 		/**
@@ -46,105 +48,107 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Method is used to update animation state. Update current animation and configure 
-		 * vertex buffers data. Animation interpolation is made in vertex shader.
-		 * @param	elapsedTime is time between two frames.
+		 * Method is used to create entity animation state in scene animation system. Selected animation is
+		 * started, first mesh clip is used if animation was not selected or mesh does not have it.
+		 * @param	animationSystem is pointer to scene animation system.
 		 */
-		void AnimatedEntity::updateAnimation(const float elapsedTime)
+		void AnimatedEntity::attachAnimationSystem(AnimationSystem* animationSystem)
 		{
-			animationState.currentTime += elapsedTime;
-
-			if(animationState.currentTime > (1.0 / animationState.framePerSecond))
+			if(entityGeometry.geometryData == nullptr || !entityGeometry.geometryData->isKeyFrameGeometry())
 			{
-				animationState.currentFrame = animationState.nextFrame;
-				animationState.nextFrame++;
+				Logger::getInstance()->saveLog(Log<string>("Animated entity without key frame geometry: " + entityName));
+				return;
+			}
 
-				if(animationState.nextFrame > animationState.endFrame)
-					animationState.nextFrame = animationState.startFrame;
+			this->animationSystem = animationSystem;
+			animationId = animationSystem->createState(entityGeometry.geometryData->getFrameVertices());
 
-				animationState.currentTime = 0.0f;
-				animationState.interpolatonValue = 0.0f;
-			}
+			const AnimationClips& clips = entityGeometry.geometryMesh->getAnimationClips();
+			if(entityGeometry.geometryMesh->getAnimationClip(animationName) == nullptr && !clips.empty())
+				animationName = clips.front().clipName;
+			playAnimation(animationName);
+		}
 
-			if(animationState.currentFrame > (198 - 1))
-				animationState.currentFrame = 0;
+		/**
+		 * Method is used to release entity animation state.
+		 */
+		void AnimatedEntity::detachAnimationSystem()
+		{
+			if(animationSystem != nullptr)
+				animationSystem->releaseState(animationId);
+			animationSystem = nullptr;
+		}
 
-			if(animationState.nextFrame> (198 - 1))
-				animationState.nextFrame = 0;
+		/**
+		 * Method is used to play animation clip of entity mesh.
+		 * @param	clipName is animation clip name.
+		 * @param	fadeTime is cross-fade time from current clip in seconds.
+		 * @return	false if mesh does not have such clip.
+		 */
+		bool AnimatedEntity::playAnimation(const string& clipName, const float fadeTime)
+		{
+			if(animationSystem == nullptr)
+			{
+				animationName = clipName;
+				return true;
+			}
 
-			animationState.interpolatonValue +=  elapsedTime;
-			configureGeometryAttributes();	
+			const AnimationClip* clip = entityGeometry.geometryMesh->getAnimationClip(clipName);
+			if(clip == nullptr)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Animation clip not found: " + clipName + " in entity: " + entityName));
+				return false;
+			}
+
+			animationName = clipName;
+			animationSystem->playClip(animationId,*clip,fadeTime);
+			return true;
 		}
 
 		/**
-		 * Method is used to set and configrue animation state.
+		 * Method is used to play one of standard md2 animations.
 		 * @param	type is enum of new animation state.
+		 * @param	fadeTime is cross-fade time from current clip in seconds.
 		 */
-		void AnimatedEntity::setAnimation(AnimationType type)
+		void AnimatedEntity::setAnimation(AnimationType type, const float fadeTime)
 		{
-			if((type < STAND) || (type > MAX_ANIMATIONS))
+			if((type < STAND) || (type >= MAX_ANIMATIONS))
 				type = STAND;
 
-			animationState.startFrame = animationList[type].firstFrame;
-			animationState.endFrame = animationList[type].lastFrame;
-			animationState.currentFrame = animationList[type].firstFrame;
-			animationState.nextFrame = animationList[type].firstFrame + 1;
-			animationState.framePerSecond = animationList[type].framePerSecond;
-			animationState.type = type;
-			animationState.interpolatonValue = 0.0f;
-			animationState.currentTime = 0.0f;
+			playAnimation(animationNames[type],fadeTime);
 		}
 
 		/**
-		 * Method is used to set geometry data of AnimatedEntity. Create EntityGeometry struct of VAO/VBO and Bounding
-		 * Volumes based on poniter to entity geometry mesh object.
-		 * @param	geometryMesh is pointer to scene eneity geometry mesh object.
+		 * Method is used to check if current clip which is not looped reached last frame.
+		 * @return	true if clip is finished.
 		 */
-		void AnimatedEntity::setGeometryData(AyumiResource::Mesh* geometryMesh)
+		bool AnimatedEntity::isAnimationFinished() const
 		{
-			entityGeometry.geometryMesh = geometryMesh;
-			entityGeometry.geometryVao = new VertexArrayObject();
-			entityGeometry.geomteryVbo = new VertexBufferObject[198];
-			entityGeometry.geometryBox = new BoundingBox(geometryMesh[0]);
-			entityGeometry.geometrySphere = new BoundingSphere(geometryMesh[0],entityState.position);
-
-			for(int i = 0; i < 198; ++i)
-				entityGeometry.geomteryVbo[i].initializeBufferObject(entityGeometry.geometryMesh[i]);
+			return animationSystem != nullptr && animationSystem->isClipFinished(animationId);
 		}
 
 		/**
-		 * Method is used to configure animated scene entity geometry buffers attributes. Create AnimatedEntity
-		 * VAO and initialize VBO. In this case we need to configure current and next frame buffers to do interpolation
-		 * in vertex shader.
+		 * Accessor to name of current animation clip.
+		 * @return	animation clip name.
 		 */
-		void AnimatedEntity::configureGeometryAttributes()
+		const string& AnimatedEntity::getAnimationName() const
 		{
-			entityGeometry.geometryVao->bindVertexArray();
-
-			entityGeometry.geomteryVbo[animationState.currentFrame].vertexPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(), "vertex" );
-			entityGeometry.geomteryVbo[animationState.currentFrame].normalPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(), "normal" );
-			entityGeometry.geomteryVbo[animationState.currentFrame].texCoordPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(), "texCoord" );
-			entityGeometry.geomteryVbo[animationState.currentFrame].tangentPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(), "tangent" );
-
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.currentFrame].vertexPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + 0);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.currentFrame].normalPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*3);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.currentFrame].texCoordPosition, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*6);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.currentFrame].tangentPosition, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*8);
-
-			entityGeometry.geomteryVbo[animationState.currentFrame].bindBufferObject();
-
-			entityGeometry.geomteryVbo[animationState.nextFrame].vertexPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"vertex2");
-			entityGeometry.geomteryVbo[animationState.nextFrame].normalPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"normal2");
-			entityGeometry.geomteryVbo[animationState.nextFrame].texCoordPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"texCoord2");
-			entityGeometry.geomteryVbo[animationState.nextFrame].tangentPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"tangent2");
+			return animationName;
+		}
 
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.nextFrame].vertexPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + 0);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.nextFrame].normalPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*3);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.nextFrame].texCoordPosition, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*6);
-			glVertexAttribPointer(entityGeometry.geomteryVbo[animationState.nextFrame].tangentPosition, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex<>), reinterpret_cast<const GLubyte *>(0) + sizeof(float)*8);
+		/**
+		 * Method is used to get key frame data of current animation state: first vertices, interpolation and
+		 * fade weight of current clip and previous clip frames.
+		 * @param	keyFrameData is pointer to KEY_FRAME_DATA_SIZE floats destination.
+		 * @return	true if entity has animation state.
+		 */
+		bool AnimatedEntity::getKeyFrameData(float* keyFrameData) const
+		{
+			if(animationSystem == nullptr)
+				return false;
 
-			entityGeometry.geomteryVbo[animationState.nextFrame].bindBufferObject();
-			entityMaterial.entityShader->setUniformf("interpolate",animationState.interpolatonValue);
+			memcpy(keyFrameData,animationSystem->getKeyFrameData(animationId),KEY_FRAME_DATA_SIZE*sizeof(float));
+			return true;
 		}
 	}
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "SceneEntity.hpp"
 #include "KeyFrameAnimation.hpp"
+#include "AnimationSystem.hpp"
 
 namespace AyumiEngine
 {
@@ -17,21 +18,30 @@ namespace AyumiEngine
 	{
 		/**
 		 * Class represents base element of engine scene - AnimatedEntity. It extends SceneEntity class. AnimatedEntity
-		 * use md2 file formats for creating key frame animation.
+		 * use md2 file formats for creating key frame animation. Key frames are shared by all entities with the
+		 * same mesh, entity store only animation state which select and interpolate frames in vertex shader.
+		 * Animation clips are taken from entity mesh, animation state is stored and advanced by scene
+		 * AnimationSystem.
 		 */
 		class AnimatedEntity : public SceneEntity
 		{
-		public:
-			AnimationState animationState;
+		private:
+			AnimationSystem* animationSystem;
+			unsigned int animationId;
+			std::string animationName;
 
+		public:
 			AnimatedEntity(const std::string& entityName, const std::string& meshName, const std::string& materialName);
 			~AnimatedEntity();
 
 			void initializeAnimatedEntity();
-			void updateAnimation(const float elapsedTime);
-			void setAnimation(AnimationType type);
-			void setGeometryData(AyumiResource::Mesh* geometryMesh);
-			void configureGeometryAttributes();
+			void attachAnimationSystem(AnimationSystem* animationSystem);
+			void detachAnimationSystem();
+			bool playAnimation(const std::string& clipName, const float fadeTime = 0.0f);
+			void setAnimation(AnimationType type, const float fadeTime = 0.0f);
+			bool isAnimationFinished() const;
+			const std::string& getAnimationName() const;
+			bool getKeyFrameData(float* keyFrameData) const;
 		};
 	}
 }
@@ -0,0 +1,338 @@
+/**
+ * File contains definition of AnimationSystem class.
+ * @file    AnimationSystem.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-16
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <xmmintrin.h>
+#include <boost/bind.hpp>
+
+#include "AnimationSystem.hpp"
+
+#include "../AyumiCore/WorkerPool.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiCore;
+using namespace AyumiEngine::AyumiResource;
+
+namespace AyumiEngine
+{
+	namespace AyumiScene
+	{
+		/**
+		 * Function is used to round four floats down with SSE. Values are rounded to nearest integer by adding
+		 * and subtracting 1.5 * 2^23, so they must be smaller than 2^22, results above source are decreased.
+		 * @param	value is vector of rounded values.
+		 * @return	vector of values rounded down.
+		 */
+		static __m128 floorVector(const __m128 value)
+		{
+			const __m128 magic = _mm_set1_ps(12582912.0f);
+			const __m128 rounded = _mm_sub_ps(_mm_add_ps(value,magic),magic);
+			return _mm_sub_ps(rounded,_mm_and_ps(_mm_cmpgt_ps(rounded,value),_mm_set1_ps(1.0f)));
+		}
+
+		/**
+		 * Class default constructor.
+		 */
+		AnimationSystem::AnimationSystem()
+		{
+			stateAmount = 0;
+		}
+
+		/**
+		 * Class destructor.
+		 */
+		AnimationSystem::~AnimationSystem()
+		{
+			clearStates();
+		}
+
+		/**
+		 * Method is used to create animation state. Released states are reused. New state shows first frame
+		 * until clip is played.
+		 * @param	frameVertices is amount of vertices of one mesh frame.
+		 * @return	animation state id.
+		 */
+		unsigned int AnimationSystem::createState(const unsigned int frameVertices)
+		{
+			unsigned int id = stateAmount;
+			if(!freeStates.empty())
+			{
+				id = freeStates.back();
+				freeStates.pop_back();
+			}
+			else
+			{
+				stateAmount++;
+				resizeTracks(playTracks,stateAmount);
+				resizeTracks(fadeTracks,stateAmount);
+				fadeWeight.resize(stateAmount);
+				fadeSpeed.resize(stateAmount);
+				this->frameVertices.resize(stateAmount);
+				keyFrameData.resize(stateAmount*KEY_FRAME_DATA_SIZE);
+			}
+
+			AnimationClip clip;
+			clip.firstFrame = 0;
+			clip.lastFrame = 0;
+			clip.framePerSecond = 1.0f;
+			clip.isLooped = true;
+			this->frameVertices[id] = static_cast<float>(frameVertices);
+			setTrackClip(playTracks,id,clip);
+			setTrackClip(fadeTracks,id,clip);
+			fadeWeight[id] = 1.0f;
+			fadeSpeed[id] = 0.0f;
+			updateStates(id,id + 1,0.0f);
+			return id;
+		}
+
+		/**
+		 * Method is used to release animation state. State stays in arrays and is reused by next created state.
+		 * @param	id is animation state id.
+		 */
+		void AnimationSystem::releaseState(const unsigned int id)
+		{
+			if(id < stateAmount)
+				freeStates.push_back(id);
+		}
+
+		/**
+		 * Method is used to release all animation states.
+		 */
+		void AnimationSystem::clearStates()
+		{
+			stateAmount = 0;
+			resizeTracks(playTracks,0);
+			resizeTracks(fadeTracks,0);
+			fadeWeight.clear();
+			fadeSpeed.clear();
+			frameVertices.clear();
+			keyFrameData.clear();
+			freeStates.clear();
+		}
+
+		/**
+		 * Method is used to play animation clip. Current clip is moved to fade track and faded out during fade
+		 * time, clip is switched immediately if fade time is zero.
+		 * @param	id is animation state id.
+		 * @param	clip is reference to new animation clip.
+		 * @param	fadeTime is cross-fade time in seconds.
+		 */
+		void AnimationSystem::playClip(const unsigned int id, const AnimationClip& clip, const float fadeTime)
+		{
+			if(id >= stateAmount)
+				return;
+
+			copyTrack(playTracks,fadeTracks,id);
+			setTrackClip(playTracks,id,clip);
+			fadeWeight[id] = fadeTime > 0.0f ? 0.0f : 1.0f;
+			fadeSpeed[id] = fadeTime > 0.0f ? 1.0f / fadeTime : 0.0f;
+			updateStates(id,id + 1,0.0f);
+		}
+
+		/**
+		 * Method is used to advance all animation states. States are split between WorkerPool threads if there are
+		 * enough of them. Worker ranges are aligned, so workers do not write the same cache lines.
+		 * @param	elapsedTime is time between two frames.
+		 */
+		void AnimationSystem::updateAnimations(const float elapsedTime)
+		{
+			unsigned int workers = 1;
+			if(stateAmount >= ANIMATION_PARALLEL_STATES)
+				workers = max(1u,min(MAX_ANIMATION_WORKERS,WorkerPool::getInstance()->getThreadAmount()));
+
+			if(workers == 1)
+				updateStates(0,stateAmount,elapsedTime);
+			else
+			{
+				unsigned int statesPerWorker = (stateAmount + workers - 1) / workers;
+				statesPerWorker = (statesPerWorker + ANIMATION_WORKER_ALIGNMENT - 1) / ANIMATION_WORKER_ALIGNMENT * ANIMATION_WORKER_ALIGNMENT;
+				WorkerJobs jobs;
+				for(unsigned int i = 0; i < workers && i*statesPerWorker < stateAmount; ++i)
+					jobs.push_back(boost::bind(&AnimationSystem::updateStates,this,i*statesPerWorker,min((i+1)*statesPerWorker,stateAmount),elapsedTime));
+				WorkerPool::getInstance()->runJobs(jobs);
+			}
+		}
+
+		/**
+		 * Accessor to key frame data of animation state: first vertex of current and next frame, interpolation
+		 * and fade weight of play track, then the same frame data of fade track.
+		 * @param	id is animation state id.
+		 * @return	pointer to KEY_FRAME_DATA_SIZE floats.
+		 */
+		const float* AnimationSystem::getKeyFrameData(const unsigned int id) const
+		{
+			return &keyFrameData[id*KEY_FRAME_DATA_SIZE];
+		}
+
+		/**
+		 * Method is used to check if clip which is not looped reached last frame.
+		 * @param	id is animation state id.
+		 * @return	true if clip is finished.
+		 */
+		bool AnimationSystem::isClipFinished(const unsigned int id) const
+		{
+			if(id >= stateAmount || playTracks.isLooped[id] > 0.0f)
+				return false;
+			return playTracks.clipTime[id]*playTracks.framePerSecond[id] >= playTracks.frameAmount[id] - 1.0f;
+		}
+
+		/**
+		 * Accessor to amount of animation states, released states included.
+		 * @return	amount of animation states.
+		 */
+		unsigned int AnimationSystem::getStateAmount() const
+		{
+			return stateAmount;
+		}
+
+		/**
+		 * Private method which is used to resize all arrays of animation tracks.
+		 * @param	tracks is reference to animation tracks.
+		 * @param	size is new amount of tracks.
+		 */
+		void AnimationSystem::resizeTracks(AnimationTracks& tracks, const unsigned int size)
+		{
+			tracks.clipTime.resize(size);
+			tracks.framePerSecond.resize(size);
+			tracks.firstFrame.resize(size);
+			tracks.frameAmount.resize(size);
+			tracks.isLooped.resize(size);
+			tracks.currentFrame.resize(size);
+			tracks.nextFrame.resize(size);
+			tracks.interpolation.resize(size);
+		}
+
+		/**
+		 * Private method which is used to start animation clip on track.
+		 * @param	tracks is reference to animation tracks.
+		 * @param	id is animation state id.
+		 * @param	clip is reference to animation clip.
+		 */
+		void AnimationSystem::setTrackClip(AnimationTracks& tracks, const unsigned int id, const AnimationClip& clip)
+		{
+			tracks.clipTime[id] = 0.0f;
+			tracks.framePerSecond[id] = max(clip.framePerSecond,0.001f);
+			tracks.firstFrame[id] = static_cast<float>(clip.firstFrame);
+			tracks.frameAmount[id] = static_cast<float>(max(clip.lastFrame - clip.firstFrame + 1,1));
+			tracks.isLooped[id] = clip.isLooped ? 1.0f : 0.0f;
+		}
+
+		/**
+		 * Private method which is used to copy one track between track sets.
+		 * @param	source is reference to source tracks.
+		 * @param	destination is reference to destination tracks.
+		 * @param	id is animation state id.
+		 */
+		void AnimationSystem::copyTrack(const AnimationTracks& source, AnimationTracks& destination, const unsigned int id)
+		{
+			destination.clipTime[id] = source.clipTime[id];
+			destination.framePerSecond[id] = source.framePerSecond[id];
+			destination.firstFrame[id] = source.firstFrame[id];
+			destination.frameAmount[id] = source.frameAmount[id];
+			destination.isLooped[id] = source.isLooped[id];
+			destination.currentFrame[id] = source.currentFrame[id];
+			destination.nextFrame[id] = source.nextFrame[id];
+			destination.interpolation[id] = source.interpolation[id];
+		}
+
+		/**
+		 * Private method which is used to advance range of tracks with SSE. Four tracks are updated at once
+		 * without branches, looped and not looped clips are selected by masks. Tracks which do not fill whole
+		 * vector are updated by scalar loop. Looped clips wrap clip time, other clips stop on last frame.
+		 * @param	tracks is reference to animation tracks.
+		 * @param	first is first track id.
+		 * @param	last is track id after last updated track.
+		 * @param	elapsedTime is time between two frames.
+		 */
+		void AnimationSystem::updateTracks(AnimationTracks& tracks, const unsigned int first, const unsigned int last, const float elapsedTime)
+		{
+			if(first >= last)
+				return;
+
+			float* clipTime = &tracks.clipTime[0];
+			const float* framePerSecond = &tracks.framePerSecond[0];
+			const float* firstFrame = &tracks.firstFrame[0];
+			const float* frameAmount = &tracks.frameAmount[0];
+			const float* isLooped = &tracks.isLooped[0];
+			float* currentFrame = &tracks.currentFrame[0];
+			float* nextFrame = &tracks.nextFrame[0];
+			float* interpolation = &tracks.interpolation[0];
+
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 time = _mm_set1_ps(elapsedTime);
+			unsigned int i = first;
+			for(; i + 4 <= last; i += 4)
+			{
+				const __m128 fps = _mm_loadu_ps(framePerSecond + i);
+				const __m128 amount = _mm_loadu_ps(frameAmount + i);
+				const __m128 looped = _mm_loadu_ps(isLooped + i);
+				const __m128 loopMask = _mm_cmpgt_ps(looped,zero);
+				const __m128 clipLength = _mm_div_ps(amount,fps);
+				const __m128 trackTime = _mm_add_ps(_mm_loadu_ps(clipTime + i),time);
+				const __m128 loopTime = _mm_sub_ps(trackTime,_mm_mul_ps(floorVector(_mm_div_ps(trackTime,clipLength)),clipLength));
+				const __m128 clip = _mm_or_ps(_mm_and_ps(loopMask,loopTime),_mm_andnot_ps(loopMask,_mm_min_ps(trackTime,clipLength)));
+				_mm_storeu_ps(clipTime + i,clip);
+
+				const __m128 frame = _mm_mul_ps(clip,fps);
+				const __m128 current = _mm_min_ps(floorVector(frame),_mm_sub_ps(amount,one));
+				const __m128 following = _mm_add_ps(current,one);
+				const __m128 hasNext = _mm_cmplt_ps(following,amount);
+				const __m128 next = _mm_or_ps(_mm_and_ps(hasNext,following),_mm_andnot_ps(hasNext,_mm_mul_ps(current,_mm_sub_ps(one,looped))));
+				const __m128 firstFrames = _mm_loadu_ps(firstFrame + i);
+				_mm_storeu_ps(currentFrame + i,_mm_add_ps(firstFrames,current));
+				_mm_storeu_ps(nextFrame + i,_mm_add_ps(firstFrames,next));
+				_mm_storeu_ps(interpolation + i,_mm_min_ps(_mm_sub_ps(frame,current),one));
+			}
+
+			for(; i < last; ++i)
+			{
+				const float clipLength = frameAmount[i] / framePerSecond[i];
+				const float time = clipTime[i] + elapsedTime;
+				const float loopTime = time - floor(time / clipLength) * clipLength;
+				clipTime[i] = isLooped[i] > 0.0f ? loopTime : min(time,clipLength);
+
+				const float frame = clipTime[i] * framePerSecond[i];
+				const float current = min(floor(frame),frameAmount[i] - 1.0f);
+				const float next = current + 1.0f < frameAmount[i] ? current + 1.0f : current * (1.0f - isLooped[i]);
+				currentFrame[i] = firstFrame[i] + current;
+				nextFrame[i] = firstFrame[i] + next;
+				interpolation[i] = min(frame - current,1.0f);
+			}
+		}
+
+		/**
+		 * Private method which is used to advance range of animation states: play and fade tracks, fade weights
+		 * and key frame data.
+		 * @param	first is first state id.
+		 * @param	last is state id after last updated state.
+		 * @param	elapsedTime is time between two frames.
+		 */
+		void AnimationSystem::updateStates(const unsigned int first, const unsigned int last, const float elapsedTime)
+		{
+			updateTracks(playTracks,first,last,elapsedTime);
+			updateTracks(fadeTracks,first,last,elapsedTime);
+
+			for(unsigned int i = first; i < last; ++i)
+				fadeWeight[i] = min(fadeWeight[i] + elapsedTime * fadeSpeed[i],1.0f);
+
+			for(unsigned int i = first; i < last; ++i)
+			{
+				float* data = &keyFrameData[i*KEY_FRAME_DATA_SIZE];
+				data[0] = playTracks.currentFrame[i] * frameVertices[i];
+				data[1] = playTracks.nextFrame[i] * frameVertices[i];
+				data[2] = playTracks.interpolation[i];
+				data[3] = fadeWeight[i];
+				data[4] = fadeTracks.currentFrame[i] * frameVertices[i];
+				data[5] = fadeTracks.nextFrame[i] * frameVertices[i];
+				data[6] = fadeTracks.interpolation[i];
+				data[7] = 0.0f;
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ * File contains declaration of AnimationSystem class.
+ * @file    AnimationSystem.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-16
+ */
+
+#ifndef ANIMATIONSYSTEM_HPP
+#define ANIMATIONSYSTEM_HPP
+
+#include <vector>
+
+#include "../AyumiResource/AnimationClip.hpp"
+#include "../AyumiResource/MeshGeometry.hpp"
+#include "../AyumiUtils/Noncopyable.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiScene
+	{
+		const unsigned int ANIMATION_PARALLEL_STATES = 512;
+		const unsigned int MAX_ANIMATION_WORKERS = 4;
+		const unsigned int ANIMATION_WORKER_ALIGNMENT = 16;
+
+		/**
+		 * Structure represents clip playback tracks in structure of arrays layout. Frames are stored as floats,
+		 * so track update is plain arithmetic over contiguous arrays.
+		 */
+		struct AnimationTracks
+		{
+			std::vector<float> clipTime;
+			std::vector<float> framePerSecond;
+			std::vector<float> firstFrame;
+			std::vector<float> frameAmount;
+			std::vector<float> isLooped;
+			std::vector<float> currentFrame;
+			std::vector<float> nextFrame;
+			std::vector<float> interpolation;
+		};
+
+		/**
+		 * Class represents key frame animation states of all animated entities. Each state has play track and
+		 * fade track - previous clip which is cross-faded out after clip change. All states are advanced in one
+		 * batch by branch-free loops over arrays, big batches are split between WorkerPool threads. Result is key
+		 * frame data of each state (first vertices of frames, interpolation and fade weight) ready for upload.
+		 */
+		class AnimationSystem : private AyumiUtils::Noncopyable
+		{
+		private:
+			AnimationTracks playTracks;
+			AnimationTracks fadeTracks;
+			std::vector<float> fadeWeight;
+			std::vector<float> fadeSpeed;
+			std::vector<float> frameVertices;
+			std::vector<float> keyFrameData;
+			std::vector<unsigned int> freeStates;
+			unsigned int stateAmount;
+
+			void resizeTracks(AnimationTracks& tracks, const unsigned int size);
+			void setTrackClip(AnimationTracks& tracks, const unsigned int id, const AyumiResource::AnimationClip& clip);
+			void copyTrack(const AnimationTracks& source, AnimationTracks& destination, const unsigned int id);
+			void updateTracks(AnimationTracks& tracks, const unsigned int first, const unsigned int last, const float elapsedTime);
+			void updateStates(const unsigned int first, const unsigned int last, const float elapsedTime);
+
+		public:
+			AnimationSystem();
+			~AnimationSystem();
+
+			unsigned int createState(const unsigned int frameVertices);
+			void releaseState(const unsigned int id);
+			void clearStates();
+			void playClip(const unsigned int id, const AyumiResource::AnimationClip& clip, const float fadeTime);
+			void updateAnimations(const float elapsedTime);
+
+			const float* getKeyFrameData(const unsigned int id) const;
+			bool isClipFinished(const unsigned int id) const;
+			unsigned int getStateAmount() const;
+		};
+	}
+}
+#endif
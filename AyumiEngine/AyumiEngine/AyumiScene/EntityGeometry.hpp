@@ -9,6 +9,7 @@
 #define ENTITYGEOMETRY_HPP
 
 #include "../AyumiResource/Mesh.hpp"
+#include "../AyumiResource/MeshGeometry.hpp"
 #include "../AyumiUtils/VertexArrayObject.hpp"
 #include "../AyumiUtils/VertexBufferObject.hpp"
 #include "../AyumiUtils/BoundingBox.hpp"
@@ -20,11 +21,13 @@ namespace AyumiEngine
 	{
 		/**
 		 * Structure represents SceneEntity geometry data: Vertex Buffers, Mesh data
-		 * and bounding volumes, which will be used in geometry rendering.
+		 * and bounding volumes, which will be used in geometry rendering. Vertex buffers and bounding
+		 * volumes point to shared mesh geometry, only vertex array is owned by entity.
 		 */
 		struct EntityGeometry
 		{
 			AyumiResource::Mesh* geometryMesh;
+			AyumiResource::GeometryResource geometryData;
 			AyumiUtils::VertexArrayObject* geometryVao;
 			AyumiUtils::VertexBufferObject* geomteryVbo;
 			AyumiUtils::BoundingBox* geometryBox;
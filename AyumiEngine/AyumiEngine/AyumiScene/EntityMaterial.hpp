@@ -20,7 +20,7 @@ namespace AyumiEngine
 		/**
 		 * Structure represents ScenEntity Material which store material name, texture layeres, rendering shader
 		 * and all additional parameters. Beside of entity geometry structure this is basic part of all engine
-		 * scene entities.
+		 * scene entities. Optional depth shader is used to draw entity in depth pre-pass.
 		 */
 		struct EntityMaterial
 		{
@@ -28,6 +28,7 @@ namespace AyumiEngine
 			std::vector<AyumiResource::Texture*> materialLayers;
 			AyumiRenderer::MaterialProperties materialProperties;
 			AyumiResource::Shader* entityShader;
+			AyumiResource::Shader* depthShader;
 			IntegerUniforms integers;
 			FloatUniforms floats;
 			TextureUniforms textures;
@@ -37,6 +38,7 @@ namespace AyumiEngine
 			std::string updateFunctorName;
 			bool depthTest;
 			bool backfaceCull;
+			bool instancing;
 		};
 	}
 }
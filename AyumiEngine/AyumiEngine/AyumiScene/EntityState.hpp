@@ -16,7 +16,8 @@ namespace AyumiEngine
 	{
 		/**
 		 * Structure represents SceneEntity state data like physics parameters and flags,
-		 * which will be used in entity update.
+		 * which will be used in entity update. Static entities never move and can be baked
+		 * into static batch - batched entities are drawn by batch instead of themselves.
 		 */
 		struct EntityState
 		{
@@ -26,6 +27,8 @@ namespace AyumiEngine
 			AyumiMath::Vector3D scale;
 			bool isVisible;
 			bool isDead;
+			bool isStatic;
+			bool isBatched;
 		};
 	}
 }
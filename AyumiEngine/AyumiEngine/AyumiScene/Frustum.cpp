@@ -56,12 +56,19 @@ namespace AyumiEngine
 		{
 			Matrix4D projectionMatrix;
 			Matrix4D viewMatrix;
-			Matrix4D clip;
 
 			currentCamera->setProjectionMatrix(&projectionMatrix);
 			currentCamera->setViewMatrix(&viewMatrix);
+			calculateFrustum(projectionMatrix * viewMatrix);
+		}
 
-			clip = transpose(projectionMatrix * viewMatrix);
+		/**
+		 * Method is used to calculate frustum of any view and projection, for example shadow light frustum.
+		 * @param	viewProjectionMatrix is product of projection and view matrix.
+		 */
+		void Frustum::calculateFrustum(const Matrix4D& viewProjectionMatrix)
+		{
+			const Matrix4D clip = transpose(viewProjectionMatrix);
 
 			frustumPlanes[RIGHT][0] = clip[ 3] - clip[ 0];
 			frustumPlanes[RIGHT][1] = clip[ 7] - clip[ 4];
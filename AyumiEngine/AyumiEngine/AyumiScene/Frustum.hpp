@@ -69,6 +69,7 @@ namespace AyumiEngine
 			~Frustum();
 
 			void calculateFrustum(Camera* currentCamera);
+			void calculateFrustum(const AyumiMath::Matrix4D& viewProjectionMatrix);
 			bool isPointInFrustum(const float x, const float y, const float z);
 			FrustumTestResult isSphereInFrustum(const float x, const float y, const float z, const float radius);
 			FrustumTestResult isCubeInFrustum(const float x, const float y, const float z, const  float size);
@@ -6,7 +6,7 @@
  */
 
 #ifndef KEYFRAMEANIMATION_HPP
-#define KEYGRAMEANIMATION_HPP
+#define KEYFRAMEANIMATION_HPP
 
 namespace AyumiEngine
 {
@@ -42,57 +42,31 @@ namespace AyumiEngine
 		};
 
 		/**
-		 * Structure represents base data of key frame animation.
+		 * Static array represents names of standard md2 animation clips created from frame names.
 		 */
-		struct Animation
+		static const char* animationNames[MAX_ANIMATIONS] =
 		{
-			int firstFrame;
-			int lastFrame;
-			int framePerSecond;
-		};
-
-		/**
-		 * Structure represents data of key frame animation state.
-		 */
-		struct AnimationState
-		{
-			int startFrame;
-			int endFrame;
-			int framePerSecond;
-			float currentTime;
-			float oldTime;
-			float interpolatonValue;
-			AnimationType type;
-			int currentFrame;
-			int nextFrame;
-		};
-
-		/**
-		 * Static array represents lists of md2 animation base data.
-		 */
-		static Animation animationList[21] =
-		{
-			{   1,  39,  9 },   // STAND
-			{  40,  45, 10 },   // RUN
-			{  46,  53, 10 },   // ATTACK
-			{  54,  57,  7 },   // PAIN_A
-			{  58,  61,  7 },   // PAIN_B
-			{  62,  65,  7 },   // PAIN_C
-			{  66,  71,  7 },   // JUMP
-			{  72,  83,  7 },   // FLIP
-			{  84,  94,  7 },   // SALUTE
-			{  95, 111, 10 },   // FALLBACK
-			{ 112, 122,  7 },   // WAVE
-			{ 123, 134,  6 },   // POINT
-			{ 135, 153, 10 },   // CROUCH_STAND
-			{ 154, 159,  7 },   // CROUCH_WALK
-			{ 160, 168, 10 },   // CROUCH_ATTACK
-			{ 196, 172,  7 },   // CROUCH_PAIN
-			{ 173, 177,  5 },   // CROUCH_DEATH
-			{ 178, 183,  7 },   // DEATH_FALLBACK
-			{ 184, 189,  7 },   // DEATH_FALLFORWARD
-			{ 190, 197,  7 },   // DEATH_FALLBACKSLOW
-			{ 198, 198,  5 },   // BOOM
+			"stand",	// STAND
+			"run",		// RUN
+			"attack",	// ATTACK
+			"pain",		// PAIN_A
+			"pain2",	// PAIN_B
+			"pain3",	// PAIN_C
+			"jump",		// JUMP
+			"flip",		// FLIP
+			"salute",	// SALUTE
+			"taunt",	// FALLBACK
+			"wave",		// WAVE
+			"point",	// POINT
+			"crstnd",	// CROUCH_STAND
+			"crwalk",	// CROUCH_WALK
+			"crattak",	// CROUCH_ATTACK
+			"crpain",	// CROUCH_PAIN
+			"crdeath",	// CROUCH_DEATH
+			"death",	// DEATH_FALLBACK
+			"death2",	// DEATH_FALLFORWARD
+			"death3",	// DEATH_FALLBACKSLOW
+			"boom",		// BOOM
 		};
 	}
 }
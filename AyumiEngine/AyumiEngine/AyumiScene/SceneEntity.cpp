@@ -28,6 +28,7 @@ namespace AyumiEngine
 			this->entityName = entityName;
 			this->geometryName = meshName;
 			this->materialName = materialName;
+			entityGeometry.geometryMesh = nullptr;
 			entityGeometry.geometryBox = nullptr;
 			entityGeometry.geometrySphere = nullptr;
 			entityGeometry.geometryVao = nullptr;
@@ -37,15 +38,12 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Class destructor, free allocated memory. Delete entity geoemtry bufferes and script modules if used.
+		 * Class destructor, free allocated memory. Delete entity vertex array and script modules if used. Shared
+		 * geometry is released with last entity reference.
 		 */
 		SceneEntity::~SceneEntity()
 		{
 			delete entityGeometry.geometryVao;
-			if(entityGeometry.geomteryVbo != nullptr)
-				delete entityGeometry.geomteryVbo;
-			delete entityGeometry.geometryBox;
-			delete entityGeometry.geometrySphere;
 
 			if(entityLogic.updateScript != nullptr)
 				delete entityLogic.updateScript;
@@ -60,6 +58,8 @@ namespace AyumiEngine
 		{
 			entityState.isVisible = true;
 			entityState.isDead = false;
+			entityState.isStatic = false;
+			entityState.isBatched = false;
 			entityState.position.set(0.0f,0.0f,0.0f);
 			entityState.rotation.set(0.0f,0.0f,0.0f);
 			entityState.scale.set(1.0f,1.0f,1.0f);
@@ -71,24 +71,30 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Method is used to set geometry data of ScenEntity. Create EntityGeometry struct of VAO/VBO and Bounding
-		 * Volumes based on poniter to entity geometry mesh object.
-		 * @param	geometryMesh is pointer to scene eneity geometry mesh object.
+		 * Method is used to set geometry data of ScenEntity. Fill EntityGeometry struct with shared vertex buffers
+		 * and bounding volumes of entity mesh. Entity VAO is created only if mesh geometry does not have shared VAO
+		 * (geometry heap or key frame geometry).
+		 * @param	geometryData is shared pointer to scene entity mesh geometry.
 		 */
-		void SceneEntity::setGeometryData(Mesh* geometryMesh)
+		void SceneEntity::setGeometryData(GeometryResource geometryData)
 		{
-			entityGeometry.geometryMesh = geometryMesh;
-			entityGeometry.geometryVao = new VertexArrayObject();
-			entityGeometry.geomteryVbo = new VertexBufferObject(*entityGeometry.geometryMesh);
-			entityGeometry.geometryBox = new BoundingBox(*geometryMesh);
-			entityGeometry.geometrySphere = new BoundingSphere(*geometryMesh,entityState.position);
+			entityGeometry.geometryData = geometryData;
+			entityGeometry.geometryMesh = geometryData->getMesh();
+			if(geometryData->getVertexArray() == 0)
+				entityGeometry.geometryVao = new VertexArrayObject();
+			entityGeometry.geomteryVbo = geometryData->getBuffers();
+			entityGeometry.geometryBox = geometryData->getBoundingBox();
+			entityGeometry.geometrySphere = geometryData->getBoundingSphere();
 		}
 
 		/**
 		 * Method is used to configure scene entity geometry buffers attributes. Create SceneEntity VAO and initialize VBO.
+		 * Shared geometry VAO use fixed attribute locations, so there is nothing to configure.
 		 */
 		void SceneEntity::configureGeometryAttributes()
 		{
+			if(entityGeometry.geometryVao == nullptr)
+				return;
 			entityGeometry.geometryVao->bindVertexArray();
 			entityGeometry.geomteryVbo->vertexPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"vertex");
 			entityGeometry.geomteryVbo->normalPosition = glGetAttribLocation(entityMaterial.entityShader->getShaderProgram(),"normal");
@@ -107,7 +113,10 @@ namespace AyumiEngine
 		void SceneEntity::attachMaterial()
 		{
 			entityMaterial.entityShader->bindShader();
-			entityGeometry.geometryVao->bindVertexArray();
+			if(entityGeometry.geometryVao != nullptr)
+				entityGeometry.geometryVao->bindVertexArray();
+			else
+				glBindVertexArray(entityGeometry.geometryData->getVertexArray());
 		}
 
 		/**
@@ -116,7 +125,7 @@ namespace AyumiEngine
 		void SceneEntity::detachMaterial()
 		{
 			entityMaterial.entityShader->unbindShader();
-			entityGeometry.geometryVao->unbindVertexArray();
+			glBindVertexArray(0);
 		}
 
 		/**
@@ -68,8 +68,10 @@ namespace AyumiEngine
 			virtual ~SceneEntity();
 
 			virtual void updateEntity(const float elapsedTime) {};
+			virtual bool getKeyFrameData(float* keyFrameData) const { return false; };
+			virtual const float* getSkinMatrices(unsigned int& jointAmount) const { return nullptr; };
 			void initializeSceneEntity();
-			void setGeometryData(AyumiResource::Mesh* geometryMesh);
+			void setGeometryData(AyumiResource::GeometryResource geometryData);
 			void configureGeometryAttributes();
 			void attachMaterial();
 			void detachMaterial();
@@ -12,6 +12,7 @@
 
 #include "SceneEntity.hpp"
 #include "AnimatedEntity.hpp"
+#include "SkinnedEntity.hpp"
 
 namespace AyumiEngine
 {
@@ -20,14 +21,16 @@ namespace AyumiEngine
 		/**
 		 * Struture represents engine scene graph which is defined by trees of SceneEntity objects.
 		 * Base structure of AyumiEngine SceneGraph is set of lists: one for static entities, independent entities which
-		 * is forbidden for culling and animated entities. Each SceneEntity extends SceneNode so user can create
-		 * tree representation of scene.
+		 * is forbidden for culling, animated entities and skinned entities. Static batches store merged geometry of baked static entities.
+		 * Each SceneEntity extends SceneNode so user can create tree representation of scene.
 		 */
 		struct SceneGraph
 		{
 			std::vector<SceneEntity*> sceneEntities;
 			std::vector<SceneEntity*> independentEntities;
 			std::vector<AnimatedEntity*> animatedEntities;
+			std::vector<SkinnedEntity*> skinnedEntities;
+			std::vector<SceneEntity*> staticBatches;
 		};
 	}
 }
@@ -5,8 +5,15 @@
  * @date    2011-10-09
  */
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+
 #include "SceneManager.hpp"
 
+#include "../AyumiCore/WorkerPool.hpp"
+
 using namespace std;
 using namespace boost;
 //using namespace tbb;
@@ -55,9 +62,12 @@ namespace AyumiEngine
 		{
 			sceneGraph = new SceneGraph();
 			frustumCulling = new Frustum();
+			shadowCulling = new Frustum();
+			animationSystem = new AnimationSystem();
 			octTree = new OctTree(&sceneGraph->sceneEntities,MINENTITY);
 			sceneCamera = new StaticCamera();
 			deltaTime = 0.0f;
+			batchClusterSize = 0.0f;
 
 			//task_scheduler_init init;
 		}
@@ -67,6 +77,7 @@ namespace AyumiEngine
 		 */
 		SceneManager::~SceneManager()
 		{
+			clearStaticBatch();
 			for(vector<AnimatedEntity*>::const_iterator it = sceneGraph->animatedEntities.begin(); it != sceneGraph->animatedEntities.end(); ++it)
 			{
 				vector<SceneEntity*>::const_iterator it2 = sceneGraph->sceneEntities.begin();
@@ -76,6 +87,11 @@ namespace AyumiEngine
 				sceneGraph->sceneEntities.erase(it2);			
 				delete (*it);
 			}
+			for(vector<SkinnedEntity*>::const_iterator it = sceneGraph->skinnedEntities.begin(); it != sceneGraph->skinnedEntities.end(); ++it)
+			{
+				sceneGraph->sceneEntities.erase(remove(sceneGraph->sceneEntities.begin(),sceneGraph->sceneEntities.end(),*it),sceneGraph->sceneEntities.end());
+				delete (*it);
+			}
 			for(vector<SceneEntity*>::const_iterator it = sceneGraph->independentEntities.begin(); it != sceneGraph->independentEntities.end(); ++it)
 				delete (*it);
 			for(vector<SceneEntity*>::const_iterator it = sceneGraph->sceneEntities.begin(); it != sceneGraph->sceneEntities.end(); ++it)
@@ -83,11 +99,14 @@ namespace AyumiEngine
 			
 			sceneGraph->independentEntities.clear();	
 			sceneGraph->animatedEntities.clear();
+			sceneGraph->skinnedEntities.clear();
 			updateQueue.clear();
 			delete sceneGraph;
 			delete sceneCamera;
 			delete frustumCulling;
+			delete shadowCulling;
 			delete octTree;
+			delete animationSystem;
 		}
 
 		/**
@@ -95,6 +114,8 @@ namespace AyumiEngine
 		 */
 		void SceneManager::initializeSceneManager()
 		{
+			updateQueue.push_back(make_pair("updateAnimations",boost::bind(&SceneManager::updateAnimations,this)));
+			updateQueue.push_back(make_pair("updateSkeletons",boost::bind(&SceneManager::updateSkeletons,this)));
 			updateQueue.push_back(make_pair("updateEntities",boost::bind(&SceneManager::updateEntities,this)));
 		}
 
@@ -214,19 +235,35 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Method is used to add new animated scene entity to engine scene.
+		 * Method is used to add new animated scene entity to engine scene. Entity animation state is created
+		 * in scene animation system.
 		 * @param	entity is pointer to new animated scene entity.
 		 */
 		void SceneManager::addAnimatedEntity(AnimatedEntity* entity)
 		{
+			entity->attachAnimationSystem(animationSystem);
 			sceneGraph->animatedEntities.push_back(entity);
 			sceneGraph->sceneEntities.push_back(entity);
 			if(entity->entityLogic.updateType == SCRIPT)
 				prepareEntityVirtualMachine(entity);
 		}
+
+		/**
+		 * Method is used to add new skinned scene entity to engine scene. Entity skeleton is updated by scene
+		 * update task, rendering data must be prepared by renderer before.
+		 * @param	entity is pointer to new skinned scene entity.
+		 */
+		void SceneManager::addSkinnedEntity(SkinnedEntity* entity)
+		{
+			sceneGraph->skinnedEntities.push_back(entity);
+			sceneGraph->sceneEntities.push_back(entity);
+			if(entity->entityLogic.updateType == SCRIPT)
+				prepareEntityVirtualMachine(entity);
+		}
 		
 		/**
-		 * Method is used to delete scene entity from engine scene
+		 * Method is used to delete scene entity from engine scene. When entity is baked into static batch,
+		 * static batches are baked again without it, so its geometry is not rendered any more.
 		 * @param	name is entity name id.
 		 */
 		void SceneManager::deleteSceneEntity(const string& name)
@@ -238,8 +275,11 @@ namespace AyumiEngine
 			
 			if(it != sceneGraph->sceneEntities.end())
 			{
+				SceneEntity* entity = (*it);
 				sceneGraph->sceneEntities.erase(it);
-				delete (*it);
+				if(entity->entityState.isBatched)
+					bakeStaticBatch(batchClusterSize);
+				delete entity;
 			}
 		}
 
@@ -256,8 +296,9 @@ namespace AyumiEngine
 			
 			if(it != sceneGraph->independentEntities.end())
 			{
+				SceneEntity* entity = (*it);
 				sceneGraph->independentEntities.erase(it);
-				delete (*it);
+				delete entity;
 			}
 		}
 
@@ -274,8 +315,31 @@ namespace AyumiEngine
 			
 			if(it != sceneGraph->animatedEntities.end())
 			{
+				AnimatedEntity* entity = (*it);
 				sceneGraph->animatedEntities.erase(it);
-				delete (*it);
+				sceneGraph->sceneEntities.erase(remove(sceneGraph->sceneEntities.begin(),sceneGraph->sceneEntities.end(),entity),sceneGraph->sceneEntities.end());
+				entity->detachAnimationSystem();
+				delete entity;
+			}
+		}
+
+		/**
+		 * Method is used to delete skinned scene entity from engine scene
+		 * @param	name is entity name id.
+		 */
+		void SceneManager::deleteSkinnedEntity(const string& name)
+		{
+			vector<SkinnedEntity*>::const_iterator it = sceneGraph->skinnedEntities.begin();
+			for(; it != sceneGraph->skinnedEntities.end(); ++it)
+				if((*it)->entityName == name)
+					break;
+
+			if(it != sceneGraph->skinnedEntities.end())
+			{
+				SkinnedEntity* entity = (*it);
+				sceneGraph->skinnedEntities.erase(it);
+				sceneGraph->sceneEntities.erase(remove(sceneGraph->sceneEntities.begin(),sceneGraph->sceneEntities.end(),entity),sceneGraph->sceneEntities.end());
+				delete entity;
 			}
 		}
 
@@ -284,9 +348,143 @@ namespace AyumiEngine
 		 */
 		void SceneManager::clearScene()
 		{
+			clearStaticBatch();
 			sceneGraph->sceneEntities.clear();
 			sceneGraph->independentEntities.clear();	
 			sceneGraph->animatedEntities.clear();
+			sceneGraph->skinnedEntities.clear();
+			animationSystem->clearStates();
+		}
+
+		/**
+		 * Method is used to bake static scene entities into static batches. Static entities which share material
+		 * are grouped into spatial clusters and each cluster is merged into one pre-transformed vertex and index
+		 * buffer, so cluster is drawn by one draw call and culled by own bounding volume. Original entities stay in
+		 * scene for picking and physics, but they are not rendered. Baked entities must not move - batch has to be
+		 * baked again after static entities change. Cluster size is saved, so batches can be baked again when
+		 * batched entity is deleted.
+		 * @param	clusterSize is size of spatial cluster cell.
+		 * @return	amount of created static batches.
+		 */
+		unsigned int SceneManager::bakeStaticBatch(const float clusterSize)
+		{
+			clearStaticBatch();
+			if(clusterSize <= 0.0f)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Static batch cluster size must be positive!"));
+				return 0;
+			}
+
+			batchClusterSize = clusterSize;
+			map<string,vector<SceneEntity*> > clusters;
+			for(vector<SceneEntity*>::const_iterator it = sceneGraph->sceneEntities.begin(); it != sceneGraph->sceneEntities.end(); ++it)
+			{
+				SceneEntity* entity = (*it);
+				if(!entity->entityState.isStatic || entity->entityLogic.updateType != NONE || entity->entityMaterial.instancing)
+					continue;
+				if(entity->entityGeometry.geometryMesh == nullptr || entity->entityGeometry.geometryMesh->isComponentMesh())
+					continue;
+
+				string key = entity->materialName;
+				for(int i = 0; i < 3; ++i)
+				{
+					key += "_";
+					key += lexical_cast<string>(static_cast<int>(floor(entity->entityState.position[i] / clusterSize)));
+				}
+				clusters[key].push_back(entity);
+			}
+
+			unsigned int batchedAmount = 0;
+			for(map<string,vector<SceneEntity*> >::const_iterator it = clusters.begin(); it != clusters.end(); ++it)
+			{
+				if((*it).second.size() < 2)
+					continue;
+				sceneGraph->staticBatches.push_back(createStaticBatch("StaticBatch_" + (*it).first,(*it).second));
+				batchedAmount += (*it).second.size();
+			}
+
+			string log = "Static batch baked, draw calls: ";
+			log += lexical_cast<string>(batchedAmount);
+			log += " -> ";
+			log += lexical_cast<string>(sceneGraph->staticBatches.size());
+			Logger::getInstance()->saveLog(Log<string>(log));
+			return sceneGraph->staticBatches.size();
+		}
+
+		/**
+		 * Method is used to delete static batches. Baked entities are rendered again as single entities.
+		 */
+		void SceneManager::clearStaticBatch()
+		{
+			for(vector<SceneEntity*>::const_iterator it = sceneGraph->staticBatches.begin(); it != sceneGraph->staticBatches.end(); ++it)
+				delete (*it);
+			for(vector<Mesh*>::const_iterator it = batchMeshes.begin(); it != batchMeshes.end(); ++it)
+				delete (*it);
+			for(vector<SceneEntity*>::const_iterator it = sceneGraph->sceneEntities.begin(); it != sceneGraph->sceneEntities.end(); ++it)
+				(*it)->entityState.isBatched = false;
+
+			sceneGraph->staticBatches.clear();
+			batchMeshes.clear();
+			batchClusterSize = 0.0f;
+		}
+
+		/**
+		 * Method is used to collect shadow casters of light frustum. Entities are tested by the same bounding
+		 * cube as in camera frustum culling, static batches replace their batched entities. Collection is
+		 * cleared, so caller can reuse its memory between frames.
+		 * @param	viewProjectionMatrix is product of light projection and light view matrix.
+		 * @param	casters is reference to collection of entities which cast shadow into light frustum.
+		 * @return	amount of animated casters, which change shadow every frame.
+		 */
+		unsigned int SceneManager::performShadowCasterCulling(const Matrix4D& viewProjectionMatrix, vector<SceneEntity*>& casters)
+		{
+			shadowCulling->calculateFrustum(viewProjectionMatrix);
+			casters.clear();
+
+			for(vector<SceneEntity*>::const_iterator i = sceneGraph->sceneEntities.begin(); i != sceneGraph->sceneEntities.end(); ++i)
+			{
+				if((*i)->entityState.isBatched)
+					continue;
+
+				BoundingBox* volume = (*i)->entityGeometry.geometryBox;
+				const Vector3D& position = (*i)->entityState.position;
+				const float size = (volume->max.x() - volume->min.x())*(*i)->entityState.scale.x();
+
+				if(shadowCulling->isCubeInFrustum(position.x(),position.y(),position.z(),size) != OUTSIDE)
+					casters.push_back(*i);
+			}
+
+			for(vector<SceneEntity*>::const_iterator i = sceneGraph->staticBatches.begin(); i != sceneGraph->staticBatches.end(); ++i)
+			{
+				BoundingBox* volume = (*i)->entityGeometry.geometryBox;
+				const Vector3D extent = (volume->max - volume->min)*0.5f;
+				const float size = max(extent.x(),max(extent.y(),extent.z()));
+				const Vector3D& position = (*i)->entityState.position;
+
+				if(shadowCulling->isCubeInFrustum(position.x(),position.y(),position.z(),size) != OUTSIDE)
+					casters.push_back(*i);
+			}
+
+			unsigned int animatedAmount = 0;
+			for(vector<AnimatedEntity*>::const_iterator i = sceneGraph->animatedEntities.begin(); i != sceneGraph->animatedEntities.end(); ++i)
+			{
+				BoundingBox* volume = (*i)->entityGeometry.geometryBox;
+				const Vector3D& position = (*i)->entityState.position;
+				const float size = (volume->max.x() - volume->min.x())*(*i)->entityState.scale.x();
+
+				if(shadowCulling->isCubeInFrustum(position.x(),position.y(),position.z(),size) != OUTSIDE)
+					animatedAmount++;
+			}
+			for(vector<SkinnedEntity*>::const_iterator i = sceneGraph->skinnedEntities.begin(); i != sceneGraph->skinnedEntities.end(); ++i)
+			{
+				BoundingBox* volume = (*i)->entityGeometry.geometryBox;
+				const Vector3D& position = (*i)->entityState.position;
+				const float size = (volume->max.x() - volume->min.x())*(*i)->entityState.scale.x();
+
+				if(shadowCulling->isCubeInFrustum(position.x(),position.y(),position.z(),size) != OUTSIDE)
+					animatedAmount++;
+			}
+			return animatedAmount;
 		}
 
 		/**
@@ -326,6 +524,15 @@ namespace AyumiEngine
 			return octTree;
 		}
 
+		/**
+		 * Accessor to private animation system member.
+		 * @return	pointer to scene animation system.
+		 */
+		AnimationSystem* SceneManager::getAnimationSystem() const
+		{
+			return animationSystem;
+		}
+
 		/**
 		 * Accessor to private scene delta time member.
 		 * @return	delta time.
@@ -386,6 +593,24 @@ namespace AyumiEngine
 			return entity;
 		}
 
+		/**
+		 * Accessor to private skinned scene entity member.
+		 * @return	pointer to skinned scene entity by name.
+		 */
+		SkinnedEntity* SceneManager::getSkinnedEntity(const string& name)
+		{
+			SkinnedEntity* entity = nullptr;
+			vector<SkinnedEntity*>::const_iterator it = sceneGraph->skinnedEntities.begin();
+			for(; it != sceneGraph->skinnedEntities.end(); ++it)
+				if((*it)->entityName == name)
+					break;
+
+			if(it != sceneGraph->skinnedEntities.end())
+				entity = (*it);
+
+			return entity;
+		}
+
 		/**
 		 *  Private method which is used to rebuild scene OctTree to deal with dynamic scene entities.
 		 */
@@ -417,6 +642,7 @@ namespace AyumiEngine
 				if(frustumCulling->isCubeInFrustum(x,y,z,size) == OUTSIDE)
 					(*i)->entityState.isVisible = false;
 			}
+			performBatchFrustumCulling();
 		}
 
 		/**
@@ -431,6 +657,7 @@ namespace AyumiEngine
 				(*i)->entityState.isVisible = false;
 
 			performNodeFrustumCulling(octTree->getRoot());
+			performBatchFrustumCulling();
 		}
 
 		/**
@@ -466,7 +693,25 @@ namespace AyumiEngine
 		}
 
 		/**
-		 * Private method which is used to update engine scene entities.
+		 * Private method which is used to perform frustum culling on static batches. Each batch cluster is tested
+		 * by own bounding box.
+		 */
+		void SceneManager::performBatchFrustumCulling()
+		{
+			for(vector<SceneEntity*>::const_iterator i = sceneGraph->staticBatches.begin(); i != sceneGraph->staticBatches.end(); ++i)
+			{
+				BoundingBox* volume = (*i)->entityGeometry.geometryBox;
+				const Vector3D extent = (volume->max - volume->min)*0.5f;
+				const float size = max(extent.x(),max(extent.y(),extent.z()));
+				const Vector3D& position = (*i)->entityState.position;
+
+				(*i)->entityState.isVisible = frustumCulling->isCubeInFrustum(position.x(),position.y(),position.z(),size) != OUTSIDE;
+			}
+		}
+
+		/**
+		 * Private method which is used to update engine scene entities. Animated entities are updated with
+		 * scene entities, their animations are advanced by separate update task.
 		 */
 		void SceneManager::updateEntities()
 		{
@@ -491,20 +736,51 @@ namespace AyumiEngine
 				else if((*i)->entityLogic.updateType == SCRIPT)
 					(*i)->entityLogic.updateScript->executeScript();
 			}
-			
-			for(vector<AnimatedEntity*>::const_iterator i = sceneGraph->animatedEntities.begin(); i != sceneGraph->animatedEntities.end(); ++i)
-			{
-				(*i)->updateAnimation(deltaTime);
+		}
 
-				if((*i)->entityLogic.updateType == EXTENDING)
-					(*i)->updateEntity(deltaTime);
-				else if((*i)->entityLogic.updateType == FUNCTION)
-					(*i)->entityLogic.updateFunction((*i),deltaTime);
-				else if((*i)->entityLogic.updateType == SCRIPT)
-					(*i)->entityLogic.updateScript->executeScript();	
+		/**
+		 * Private method which is used to advance animation states of all animated entities in one batch.
+		 */
+		void SceneManager::updateAnimations()
+		{
+			animationSystem->updateAnimations(deltaTime);
+		}
+
+		/**
+		 * Private method which is used to update skeletons of all skinned entities: sample and blend poses,
+		 * calculate skin matrices and skin vertices of CPU skinning entities. Entities are split between WorkerPool
+		 * threads, first range is updated on calling thread.
+		 */
+		void SceneManager::updateSkeletons()
+		{
+			const unsigned int entityAmount = sceneGraph->skinnedEntities.size();
+			unsigned int workers = 1;
+			if(entityAmount >= SKELETON_PARALLEL_ENTITIES)
+				workers = max(1u,min(MAX_SKELETON_WORKERS,WorkerPool::getInstance()->getThreadAmount()));
+
+			if(workers == 1)
+				updateSkeletonRange(0,entityAmount);
+			else
+			{
+				const unsigned int entitiesPerWorker = (entityAmount + workers - 1) / workers;
+				WorkerJobs jobs;
+				for(unsigned int i = 0; i < workers && i*entitiesPerWorker < entityAmount; ++i)
+					jobs.push_back(boost::bind(&SceneManager::updateSkeletonRange,this,i*entitiesPerWorker,min((i+1)*entitiesPerWorker,entityAmount)));
+				WorkerPool::getInstance()->runJobs(jobs);
 			}
 		}
 
+		/**
+		 * Private method which is used to update skeletons of range of skinned entities.
+		 * @param	first is first updated entity.
+		 * @param	last is entity after last updated entity.
+		 */
+		void SceneManager::updateSkeletonRange(const unsigned int first, const unsigned int last)
+		{
+			for(unsigned int i = first; i < last; ++i)
+				sceneGraph->skinnedEntities[i]->updateSkeleton(deltaTime);
+		}
+
 		/**
 		 * Private method which is used to prepare entity virtual machine in order to update script
 		 * can access delta time value.
@@ -519,5 +795,113 @@ namespace AyumiEngine
 
 			luabind::globals(entity->entityLogic.virtualMachine)["Scene"] = this;
 		}
+
+		/**
+		 * Private method which is used to create static batch entity from cluster of static entities. Entity vertices
+		 * are transformed to world space and stored relative to cluster center, which is batch entity position.
+		 * @param	name is static batch entity name.
+		 * @param	entities is cluster of static entities which share material.
+		 * @return	pointer to static batch entity.
+		 */
+		SceneEntity* SceneManager::createStaticBatch(const string& name, const vector<SceneEntity*>& entities)
+		{
+			int verticesAmount = 0;
+			int trianglesAmount = 0;
+			for(vector<SceneEntity*>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+			{
+				verticesAmount += (*it)->entityGeometry.geometryMesh->getVerticesAmount();
+				trianglesAmount += (*it)->entityGeometry.geometryMesh->getTrianglesAmount();
+			}
+
+			Mesh* mesh = new Mesh();
+			mesh->setVerticesAmount(verticesAmount);
+			mesh->setTrianglesAmount(trianglesAmount);
+			mesh->initializeDataArrays();
+			Vertex<>* vertices = mesh->getVertices();
+			unsigned int* indices = mesh->getIndices();
+
+			Vector3D minimum(numeric_limits<float>::max(),numeric_limits<float>::max(),numeric_limits<float>::max());
+			Vector3D maximum(-numeric_limits<float>::max(),-numeric_limits<float>::max(),-numeric_limits<float>::max());
+			int vertexFirst = 0;
+			int indexFirst = 0;
+
+			for(vector<SceneEntity*>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+			{
+				SceneEntity* entity = (*it);
+				const Mesh* source = entity->entityGeometry.geometryMesh;
+
+				Matrix4D modelMatrix;
+				modelMatrix.LoadIdentity();
+				modelMatrix.Translatef(entity->entityState.position);
+				modelMatrix *= entity->entityState.orientation.matrix4();
+				modelMatrix.Scalef(entity->entityState.scale);
+				const Matrix4D normalMatrix = inverse(modelMatrix);
+				const Matrix4D& m = modelMatrix;
+				const Matrix4D& n = normalMatrix;
+
+				const Vector3D axisX(m[0],m[4],m[8]);
+				const Vector3D axisY(m[1],m[5],m[9]);
+				const Vector3D axisZ(m[2],m[6],m[10]);
+				const float handedness = dot3(axisX,cross3(axisY,axisZ)) < 0.0f ? -1.0f : 1.0f;
+
+				for(int i = 0; i < source->getVerticesAmount(); ++i)
+				{
+					const Vertex<>& vertex = (*source)[i];
+					Vertex<>& batchVertex = vertices[vertexFirst+i];
+
+					const Vector4D position = modelMatrix * Vector4D(vertex.x,vertex.y,vertex.z,1.0f);
+					const Vector3D normal = normalize(Vector3D(n[0]*vertex.nx + n[4]*vertex.ny + n[8]*vertex.nz,
+																n[1]*vertex.nx + n[5]*vertex.ny + n[9]*vertex.nz,
+																n[2]*vertex.nx + n[6]*vertex.ny + n[10]*vertex.nz));
+					const Vector3D tangent = normalize(Vector3D(m[0]*vertex.tx + m[1]*vertex.ty + m[2]*vertex.tz,
+																m[4]*vertex.tx + m[5]*vertex.ty + m[6]*vertex.tz,
+																m[8]*vertex.tx + m[9]*vertex.ty + m[10]*vertex.tz));
+
+					batchVertex.x = position[0];
+					batchVertex.y = position[1];
+					batchVertex.z = position[2];
+					batchVertex.nx = normal[0];
+					batchVertex.ny = normal[1];
+					batchVertex.nz = normal[2];
+					batchVertex.u = vertex.u;
+					batchVertex.v = vertex.v;
+					batchVertex.tx = tangent[0];
+					batchVertex.ty = tangent[1];
+					batchVertex.tz = tangent[2];
+					batchVertex.tw = vertex.tw*handedness;
+
+					for(int j = 0; j < 3; ++j)
+					{
+						minimum[j] = min(minimum[j],position[j]);
+						maximum[j] = max(maximum[j],position[j]);
+					}
+				}
+
+				for(int i = 0; i < source->getTrianglesAmount()*3; ++i)
+					indices[indexFirst+i] = source->getIndices()[i] + vertexFirst;
+
+				vertexFirst += source->getVerticesAmount();
+				indexFirst += source->getTrianglesAmount()*3;
+				entity->entityState.isBatched = true;
+			}
+
+			const Vector3D center = (minimum + maximum)*0.5f;
+			for(int i = 0; i < verticesAmount; ++i)
+			{
+				vertices[i].x -= center[0];
+				vertices[i].y -= center[1];
+				vertices[i].z -= center[2];
+			}
+
+			SceneEntity* batch = new SceneEntity(name,name,entities[0]->materialName);
+			batch->initializeSceneEntity();
+			batch->entityState.position = center;
+			batch->entityState.isStatic = true;
+			batch->entityMaterial = entities[0]->entityMaterial;
+			batch->setGeometryData(GeometryResource(new MeshGeometry(mesh)));
+			batch->configureGeometryAttributes();
+			batchMeshes.push_back(mesh);
+			return batch;
+		}
 	}
 }
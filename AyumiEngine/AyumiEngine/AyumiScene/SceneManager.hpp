@@ -9,6 +9,7 @@
 #define SCENEMANAGER_HPP
 
 #include <deque>
+#include <map>
 #include <boost/function.hpp>
 #include <string>
 
@@ -21,6 +22,8 @@
 #include "FlightCamera.hpp"
 #include "ThirdPersonCamera.hpp"
 
+#include "../Logger.hpp"
+
 //#include <tbb/task_scheduler_init.h>
 //#include <tbb/parallel_for.h>
 //#include <tbb/blocked_range.h>
@@ -32,12 +35,17 @@ namespace AyumiEngine
 		typedef std::pair<std::string, boost::function<void()>> UpdateTask;
 		typedef std::deque<UpdateTask> UpdateQueue;
 
+		const unsigned int SKELETON_PARALLEL_ENTITIES = 4;
+		const unsigned int MAX_SKELETON_WORKERS = 4;
+
 		/**
 		 * Class represents one of main Engine modules which is used to store and update 2D/3D scene objects.
 		 * SceneManager store entities in SceneGraph and use such techniques as OctTree and Frustum culling to 
 		 * entities visiblity tests and update them. Each entity can be updated in three possible way: extending,
 		 * functor and Lua script. Renderer use SceneManager to render visible entities. Pipeline is done by
-		 * task queue.
+		 * task queue. Animations of all animated entities are advanced by one AnimationSystem task, separately
+		 * from entity logic update. Skeletons of skinned entities are updated by one task, which split entities
+		 * between WorkerPool threads when scene has enough of them.
 		 */
 		class SceneManager
 		{
@@ -47,9 +55,13 @@ namespace AyumiEngine
 			OctTree* octTree;
 			Camera* sceneCamera;
 			Frustum* frustumCulling;
+			Frustum* shadowCulling;
+			AnimationSystem* animationSystem;
 			float deltaTime;
 			double accum;
 			int counter;
+			float batchClusterSize;
+			std::vector<AyumiResource::Mesh*> batchMeshes;
 
 			//WGK tests
 			UpdateQueue preUpdateQueue;
@@ -60,8 +72,13 @@ namespace AyumiEngine
 			void performFrustumCulling();
 			void performTreeFrustumCulling();
 			void performNodeFrustumCulling(OctNode* node);
+			void performBatchFrustumCulling();
 			void updateEntities();
+			void updateAnimations();
+			void updateSkeletons();
+			void updateSkeletonRange(const unsigned int first, const unsigned int last);
 			void prepareEntityVirtualMachine(SceneEntity* entity);
+			SceneEntity* createStaticBatch(const std::string& name, const std::vector<SceneEntity*>& entities);
 			
 		public:
 			SceneManager();
@@ -75,21 +92,28 @@ namespace AyumiEngine
 			void addSceneEntity(SceneEntity* entity);			
 			void addIndependentEntity(SceneEntity* entity);
 			void addAnimatedEntity(AnimatedEntity* entity);
+			void addSkinnedEntity(SkinnedEntity* entity);
 
 			void deleteSceneEntity(const std::string& name);
 			void deleteIndependentEntity(const std::string& name);
 			void deleteAnimatedEntity(const std::string& name);
+			void deleteSkinnedEntity(const std::string& name);
 			void clearScene();
+			unsigned int bakeStaticBatch(const float clusterSize);
+			void clearStaticBatch();
+			unsigned int performShadowCasterCulling(const AyumiMath::Matrix4D& viewProjectionMatrix, std::vector<SceneEntity*>& casters);
 
 			void addCamera(Camera* sceneCamera);
 
 			SceneGraph* getSceneGraph() const;
 			Camera* getWorldCamera() const;
 			OctTree* getOctTree() const;
+			AnimationSystem* getAnimationSystem() const;
 			float getDeltaTime() const;
 
 			SceneEntity* getEntity(const std::string& name);
 			AnimatedEntity* getAnimatedEntity(const std::string& name);
+			SkinnedEntity* getSkinnedEntity(const std::string& name);
 		};
 	}
 }
@@ -0,0 +1,254 @@
+/**
+ * File contains definition of SkinnedEntity class.
+ * @file	SkinnedEntity.cpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-17
+ */
+
+#include <cstring>
+
+#include "SkinnedEntity.hpp"
+
+using namespace std;
+using namespace AyumiEngine::AyumiResource;
+using namespace AyumiEngine::AyumiUtils;
+
+namespace AyumiEngine
+{
+	namespace AyumiScene
+	{
+		/**
+		 * Class constructor with initialize parameters.
+		 * @param	entityName is skinned entity name.
+		 * @param	meshName is skinned entity mesh resource id.
+		 * @param	materialName is skinned entity material resource id.
+		 * @param	skinningMode is skinning path of entity.
+		 */
+		SkinnedEntity::SkinnedEntity(const string& entityName, const string& meshName, const string& materialName, const SkinningMode skinningMode) : SceneEntity(entityName,meshName,materialName)
+		{
+			this->skinningMode = skinningMode;
+			skeleton = nullptr;
+			animation = nullptr;
+			fadeAnimation = nullptr;
+			animationTime = 0.0f;
+			fadeAnimationTime = 0.0f;
+			fadeWeight = 1.0f;
+			fadeSpeed = 0.0f;
+			isLooped = true;
+			isFadeLooped = true;
+			skinnedBuffer = nullptr;
+		}
+
+		/**
+		 * Class destructor, free allocated memory. Delete own vertex buffer of CPU skinning entity, skeleton is
+		 * released with mesh.
+		 */
+		SkinnedEntity::~SkinnedEntity()
+		{
+			delete skinnedBuffer;
+			skinMatrices.clear();
+			skinnedVertices.clear();
+		}
+
+		/**
+		 * Method is used to initialize skinned entity. Initialize base class data.
+		 */
+		void SkinnedEntity::initializeSkinnedEntity()
+		{
+			initializeSceneEntity();
+		}
+
+		/**
+		 * Method is used to prepare skinning data after entity geometry was set. Skin matrices are set to bind
+		 * pose. CPU skinning entity create own vertex buffer with bind pose vertices and vertex array with fixed
+		 * attribute locations. Selected animation is started, if it was chosen before.
+		 */
+		void SkinnedEntity::initializeSkinning()
+		{
+			if(entityGeometry.geometryMesh == nullptr || !entityGeometry.geometryMesh->isSkinnedMesh())
+			{
+				Logger::getInstance()->saveLog(Log<string>("Skinned entity without skinned geometry: " + entityName));
+				return;
+			}
+
+			skeleton = entityGeometry.geometryMesh->getSkeleton();
+			skinMatrices.assign(skeleton->getJointAmount()*SKIN_MATRIX_SIZE,0.0f);
+			for(unsigned int i = 0; i < skeleton->getJointAmount(); ++i)
+				for(unsigned int j = 0; j < 4; ++j)
+					skinMatrices[i*SKIN_MATRIX_SIZE + j*5] = 1.0f;
+
+			if(skinningMode == CPU_SKINNING)
+			{
+				const Vertex<>* vertices = entityGeometry.geometryMesh->getVertices();
+				skinnedVertices.assign(vertices,vertices + entityGeometry.geometryMesh->getVerticesAmount());
+
+				skinnedBuffer = new VertexBufferObject();
+				skinnedBuffer->initializeBufferObject(*entityGeometry.geometryMesh);
+				skinnedBuffer->vertexPosition = VERTEX_ATTRIBUTE;
+				skinnedBuffer->normalPosition = NORMAL_ATTRIBUTE;
+				skinnedBuffer->texCoordPosition = TEXCOORD_ATTRIBUTE;
+				skinnedBuffer->tangentPosition = TANGENT_ATTRIBUTE;
+
+				entityGeometry.geomteryVbo = skinnedBuffer;
+				entityGeometry.geometryVao = new VertexArrayObject();
+				entityGeometry.geometryVao->bindVertexArray();
+				skinnedBuffer->bindBufferObject();
+				glVertexAttribPointer(VERTEX_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + 0);
+				glVertexAttribPointer(NORMAL_ATTRIBUTE,3,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*3);
+				glVertexAttribPointer(TEXCOORD_ATTRIBUTE,2,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*6);
+				glVertexAttribPointer(TANGENT_ATTRIBUTE,4,GL_FLOAT,GL_FALSE,sizeof(Vertex<>),reinterpret_cast<const GLubyte *>(0) + sizeof(float)*8);
+				glBindVertexArray(0);
+				glBindBuffer(GL_ARRAY_BUFFER,0);
+			}
+
+			if(!animationName.empty())
+				playAnimation(animationName);
+		}
+
+		/**
+		 * Method is used to start skeletal animation of entity mesh. Current animation is cross-faded into new
+		 * one during fade time.
+		 * @param	animationName is name of skeletal animation.
+		 * @param	fadeTime is cross-fade time in seconds, 0 switch animation immediately.
+		 * @param	isLooped is bool flag to determine if animation is played in loop.
+		 * @return	false if mesh does not have such animation.
+		 */
+		bool SkinnedEntity::playAnimation(const string& animationName, const float fadeTime, const bool isLooped)
+		{
+			this->animationName = animationName;
+			if(skeleton == nullptr)
+				return false;
+
+			const SkeletalAnimation* newAnimation = skeleton->getAnimation(animationName);
+			if(newAnimation == nullptr)
+			{
+				Logger::getInstance()->saveLog(Log<string>("Skeletal animation not found: " + animationName));
+				return false;
+			}
+
+			if(fadeTime > 0.0f && animation != nullptr)
+			{
+				fadeAnimation = animation;
+				fadeAnimationTime = animationTime;
+				isFadeLooped = this->isLooped;
+				fadeWeight = 0.0f;
+				fadeSpeed = 1.0f / fadeTime;
+			}
+			else
+			{
+				fadeAnimation = nullptr;
+				fadeWeight = 1.0f;
+			}
+
+			animation = newAnimation;
+			animationTime = 0.0f;
+			this->isLooped = isLooped;
+			return true;
+		}
+
+		/**
+		 * Method is used to advance animation and calculate skin matrices of current pose. CPU skinning entity
+		 * skin its vertices too. Method use only entity data and shared read-only skeleton, so different
+		 * entities can be updated on many threads.
+		 * @param	elapsedTime is time from last update in seconds.
+		 */
+		void SkinnedEntity::updateSkeleton(const float elapsedTime)
+		{
+			if(skeleton == nullptr || animation == nullptr)
+				return;
+
+			animationTime += elapsedTime;
+			skeleton->samplePose(*animation,animationTime,isLooped,localPose);
+			if(fadeAnimation != nullptr)
+			{
+				fadeAnimationTime += elapsedTime;
+				fadeWeight += elapsedTime*fadeSpeed;
+				if(fadeWeight >= 1.0f)
+				{
+					fadeAnimation = nullptr;
+					fadeWeight = 1.0f;
+				}
+				else
+				{
+					skeleton->samplePose(*fadeAnimation,fadeAnimationTime,isFadeLooped,fadePose);
+					Skeleton::blendPoses(fadePose,localPose,fadeWeight,localPose);
+				}
+			}
+
+			skeleton->computeModelPose(localPose,modelPose);
+			skeleton->computeSkinMatrices(modelPose,&skinMatrices[0]);
+
+			if(skinningMode == CPU_SKINNING && !skinnedVertices.empty())
+				Skeleton::skinVertices(entityGeometry.geometryMesh->getVertices(),&skeleton->getInfluences()[0],&skinMatrices[0],&skinnedVertices[0],0,skinnedVertices.size());
+		}
+
+		/**
+		 * Method is used to check if animation which is not looped reached last frame.
+		 * @return	true if animation is finished.
+		 */
+		bool SkinnedEntity::isAnimationFinished() const
+		{
+			if(animation == nullptr || isLooped)
+				return false;
+			return animationTime >= Skeleton::getAnimationLength(*animation);
+		}
+
+		/**
+		 * Accessor to private animation name member.
+		 * @return	name of current animation.
+		 */
+		const string& SkinnedEntity::getAnimationName() const
+		{
+			return animationName;
+		}
+
+		/**
+		 * Accessor to private skinning mode member.
+		 * @return	skinning path of entity.
+		 */
+		SkinningMode SkinnedEntity::getSkinningMode() const
+		{
+			return skinningMode;
+		}
+
+		/**
+		 * Method is used to get skin matrices which are send to skinning vertex shader.
+		 * @param	jointAmount is reference to destination amount of skin matrices.
+		 * @return	pointer to skin matrices or nullptr if entity use CPU skinning.
+		 */
+		const float* SkinnedEntity::getSkinMatrices(unsigned int& jointAmount) const
+		{
+			if(skinningMode != GPU_SKINNING || skinMatrices.empty())
+				return nullptr;
+			jointAmount = skinMatrices.size() / SKIN_MATRIX_SIZE;
+			return &skinMatrices[0];
+		}
+
+		/**
+		 * Accessor to own vertex buffer of CPU skinning entity.
+		 * @return	vertex buffer object id or 0 if entity use GPU skinning.
+		 */
+		GLuint SkinnedEntity::getSkinnedBuffer() const
+		{
+			return skinnedBuffer != nullptr ? skinnedBuffer->getVertexBuffer() : 0;
+		}
+
+		/**
+		 * Accessor to private skinned vertices member.
+		 * @return	pointer to skinned vertices of CPU skinning entity.
+		 */
+		const Vertex<>* SkinnedEntity::getSkinnedVertices() const
+		{
+			return skinnedVertices.empty() ? nullptr : &skinnedVertices[0];
+		}
+
+		/**
+		 * Accessor to amount of skinned vertices.
+		 * @return	amount of skinned vertices, 0 if entity use GPU skinning.
+		 */
+		unsigned int SkinnedEntity::getSkinnedVerticesAmount() const
+		{
+			return skinnedVertices.size();
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/**
+ * File contains declaration of SkinnedEntity class.
+ * @file	SkinnedEntity.hpp
+ * @author  Szymon "Veldrin" Jaboski
+ * @date    2012-02-17
+ */
+
+#ifndef SKINNEDENTITY_HPP
+#define SKINNEDENTITY_HPP
+
+#include <vector>
+
+#include "SceneEntity.hpp"
+
+#include "../AyumiResource/Skeleton.hpp"
+
+namespace AyumiEngine
+{
+	namespace AyumiScene
+	{
+		/**
+		 * Enumeration represents skinning path of skinned entity.
+		 */
+		enum SkinningMode
+		{
+			GPU_SKINNING,
+			CPU_SKINNING
+		};
+
+		/**
+		 * Class represents skinned scene entity. It extends SceneEntity class. SkinnedEntity use md5 meshes with
+		 * skeleton shared by all entities with the same mesh, entity store only animation state and own pose.
+		 * Pose is sampled, cross-faded and converted into skin matrices by scene update. GPU skinning entities
+		 * send skin matrices to skinning vertex shader and use shared mesh geometry. CPU skinning entities skin
+		 * vertices with SSE during scene update and stream them into own vertex buffer, so they can be drawn by
+		 * any engine shader.
+		 */
+		class SkinnedEntity : public SceneEntity
+		{
+		private:
+			SkinningMode skinningMode;
+			const AyumiResource::Skeleton* skeleton;
+			const AyumiResource::SkeletalAnimation* animation;
+			const AyumiResource::SkeletalAnimation* fadeAnimation;
+			std::string animationName;
+			float animationTime;
+			float fadeAnimationTime;
+			float fadeWeight;
+			float fadeSpeed;
+			bool isLooped;
+			bool isFadeLooped;
+			AyumiResource::SkeletonPose localPose;
+			AyumiResource::SkeletonPose fadePose;
+			AyumiResource::SkeletonPose modelPose;
+			std::vector<float> skinMatrices;
+			std::vector<AyumiUtils::Vertex<>> skinnedVertices;
+			AyumiUtils::VertexBufferObject* skinnedBuffer;
+
+		public:
+			SkinnedEntity(const std::string& entityName, const std::string& meshName, const std::string& materialName, const SkinningMode skinningMode = GPU_SKINNING);
+			~SkinnedEntity();
+
+			void initializeSkinnedEntity();
+			void initializeSkinning();
+			bool playAnimation(const std::string& animationName, const float fadeTime = 0.0f, const bool isLooped = true);
+			void updateSkeleton(const float elapsedTime);
+			bool isAnimationFinished() const;
+			const std::string& getAnimationName() const;
+			SkinningMode getSkinningMode() const;
+			const float* getSkinMatrices(unsigned int& jointAmount) const;
+			GLuint getSkinnedBuffer() const;
+			const AyumiUtils::Vertex<>* getSkinnedVertices() const;
+			unsigned int getSkinnedVerticesAmount() const;
+		};
+	}
+}
+#endif
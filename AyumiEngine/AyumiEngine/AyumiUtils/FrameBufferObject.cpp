@@ -11,6 +11,8 @@ namespace AyumiEngine
 {
 	namespace AyumiUtils
 	{
+		GLuint FrameBufferObject::defaultFrameBuffer = 0;
+
 		/**
 		 * Constructor with initialize parameters. Create empty FrameBufferObject.
 		 * @param	width is frame buffer width.
@@ -97,7 +99,7 @@ namespace AyumiEngine
 			}
 
 			GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glBindFramebuffer(GL_FRAMEBUFFER,defaultFrameBuffer);
 
 			return status == GL_FRAMEBUFFER_COMPLETE;
 		}
@@ -148,7 +150,7 @@ namespace AyumiEngine
 			}
 
 			glFlush();
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glBindFramebuffer(GL_FRAMEBUFFER,defaultFrameBuffer);
 			glViewport(saveViewport[0],saveViewport[1],saveViewport[2],saveViewport[3]);
 
 			return true;
@@ -417,6 +419,16 @@ namespace AyumiEngine
 			return depthBuffer;
 		}
 
+		/**
+		 * Accessor to Frame Buffer Object private frame buffer member. It is used to record frame buffer
+		 * binding into command buffer.
+		 * @return	id of Frame Buffer Object.
+		 */
+		GLuint FrameBufferObject::getFrameBuffer() const
+		{
+			return frameBuffer;
+		}
+
 		/**
 		 * Static method is used to get maximum color attachments amount of Frame Buffer Object.
 		 * @return	maximum amount of color attachments.
@@ -438,5 +450,24 @@ namespace AyumiEngine
 			glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE,&size);
 			return size;
 		}
+
+		/**
+		 * Static method is used to set frame buffer which replace window frame buffer, e.g. screen FBO of
+		 * off-screen context.
+		 * @param	frameBuffer is default frame buffer name, 0 is window frame buffer.
+		 */
+		void FrameBufferObject::setDefaultFrameBuffer(const GLuint frameBuffer)
+		{
+			defaultFrameBuffer = frameBuffer;
+		}
+
+		/**
+		 * Static method is used to get frame buffer which is bound instead of window frame buffer.
+		 * @return	default frame buffer name.
+		 */
+		GLuint FrameBufferObject::getDefaultFrameBuffer()
+		{
+			return defaultFrameBuffer;
+		}
 	}
 }
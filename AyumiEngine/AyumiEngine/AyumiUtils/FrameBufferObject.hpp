@@ -46,7 +46,8 @@ namespace AyumiEngine
 		 * colour buffers, depth buffer, stencil buffer and accumulation buffer. By default, OpenGL uses the 
 		 * framebuffer as a rendering destination that is created and managed entirely by the window system.
 		 * FrameBufferObject is used to do off-screen rendering, including rendering to a texture, which will
-		 * be used to manage post-process effects like shadows, blurs etc.
+		 * be used to manage post-process effects like shadows, blurs etc. Unbound FBO restore default frame
+		 * buffer, which is window frame buffer or screen FBO of off-screen context.
 		 */
 		class FrameBufferObject
 		{
@@ -60,6 +61,7 @@ namespace AyumiEngine
 			GLuint depthBuffer;
 			GLuint stencilBuffer; 
 			GLint saveViewport[4];
+			static GLuint defaultFrameBuffer;
 
 		public:
 			FrameBufferObject(const int width, const int height, const int flags = 0);
@@ -84,8 +86,11 @@ namespace AyumiEngine
 			bool hasDepth () const;
 			unsigned getColorBuffer ( int no = 0 ) const;
 			unsigned getDepthBuffer () const;
+			GLuint getFrameBuffer() const;
 			static int maxColorAttachemnts();
 			static int maxSize();
+			static void setDefaultFrameBuffer(const GLuint frameBuffer);
+			static GLuint getDefaultFrameBuffer();
 		};
 	}
 }
@@ -78,6 +78,18 @@ namespace AyumiEngine
 			glBufferData(GL_ELEMENT_ARRAY_BUFFER,entityMesh.getTrianglesAmount()*3*sizeof(unsigned int),entityMesh.getIndices(),GL_STATIC_DRAW);
 		}
 
+		/**
+		 * Method is used to update vertex buffer data of already initialized buffer object. Amount of mesh
+		 * vertices must not change.
+		 * @param	entityMesh is modified geometry data.
+		 */
+		void VertexBufferObject::updateBufferObject(const AyumiResource::Mesh& entityMesh)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER,vertexBuffer);
+			glBufferSubData(GL_ARRAY_BUFFER,0,entityMesh.getVerticesAmount()*12*sizeof(float),entityMesh.getVertices());
+			glBindBuffer(GL_ARRAY_BUFFER,0);
+		}
+
 		/**
 		 * Method is used to bind object buffers - vertices and indices - and enable vertex attrib array of
 		 * vertex, normal, texCoord and tanget positions.
@@ -104,5 +116,14 @@ namespace AyumiEngine
 			glDisableVertexAttribArray(texCoordPosition);
 			glDisableVertexAttribArray(tangentPosition);
 		}
+
+		/**
+		 * Accessor to private vertex buffer member.
+		 * @return	vertex buffer object id.
+		 */
+		GLuint VertexBufferObject::getVertexBuffer() const
+		{
+			return vertexBuffer;
+		}
 	}
 }
@@ -38,8 +38,10 @@ namespace AyumiEngine
 			~VertexBufferObject();
 
 			void initializeBufferObject(const AyumiResource::Mesh& entityMesh);
+			void updateBufferObject(const AyumiResource::Mesh& entityMesh);
 			void bindBufferObject();
 			void unbindBufferObject();
+			GLuint getVertexBuffer() const;
 		};
 	}
 }
@@ -38,8 +38,8 @@ namespace AyumiEngine
 	{		
 		mainQueue.clear();
 		delete engineInput;
-		delete engineRenderer;
 		delete engineScene;
+		delete engineRenderer;
 		delete engineMainTimer;
 		delete enginePhysicsTimer;
 		delete engineContext;
@@ -208,7 +208,7 @@ namespace AyumiEngine
 		}
 			
 		engineRenderer->renderScene();
-		engineContext->getContextWindow()->display();
+		engineContext->displayFrame();
 	}
 
 	/**
@@ -12,6 +12,7 @@
 
 #include "AyumiCore/ContextManager.hpp"
 #include "AyumiCore/Timer.hpp"
+#include "AyumiCore/WorkerPool.hpp"
 #include "AyumiRenderer/Renderer.hpp"
 #include "AyumiScene/SceneManager.hpp"
 #include "AyumiInput/InputManager.hpp"
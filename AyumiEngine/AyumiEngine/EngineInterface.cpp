@@ -28,6 +28,7 @@ void EngineInterface::createEngine(const string& configPath, const bool physicsU
 	Configuration::getInstance()->configureEngine(configPath);
 //	Logger::getInstance()->saveLog(Log<string>("Engine creation started"));
 	VirtualMachine::getInstance();
+	WorkerPool::getInstance();
 	engine = new Engine();
 	engine->initializeEngine(physicsUsage);
 //	Logger::getInstance()->saveLog(Log<string>("Engine creation ended"));	
@@ -39,6 +40,7 @@ void EngineInterface::releaseEngine()
 	Logger::getInstance()->saveLog(Log<string>("Engine release started"));
 	delete engine;
 	Logger::getInstance()->saveLog(Log<string>("Engine release ended"));
+	WorkerPool::killInstance();
 	Configuration::killInstance();
 	Logger::killInstance();
 	VirtualMachine::killInstance();
@@ -49,7 +51,7 @@ void EngineInterface::runGameLoop(bool* runCondition, const bool startPhysics)
 	if(startPhysics)
 		engine->runPhysicsThread();
 
-	while(*runCondition == true && engine->getEngineContext()->getContextWindow()->isOpen())
+	while(*runCondition == true && engine->getEngineContext()->isContextOpen())
 		engine->mainThread();
 }
 
@@ -176,6 +178,12 @@ void EngineInterface::addAnimatedEntityToScene(AnimatedEntity* entity)
 	engine->getEngineScene()->addAnimatedEntity(entity);
 }
 
+void EngineInterface::addSkinnedEntityToScene(SkinnedEntity* entity)
+{
+	engine->getEngineRenderer()->prepareSkinnedEntity(entity);
+	engine->getEngineScene()->addSkinnedEntity(entity);
+}
+
 void EngineInterface::deleteEntityFromScene(const string& name)
 {
 	engine->getEngineScene()->deleteSceneEntity(name);
@@ -193,11 +201,22 @@ void EngineInterface::deleteAnimatedEntityFromScene(const string& name)
 	engine->getEngineRenderer()->releaseEntity();
 }
 
+void EngineInterface::deleteSkinnedEntityFromScene(const string& name)
+{
+	engine->getEngineScene()->deleteSkinnedEntity(name);
+	engine->getEngineRenderer()->releaseEntity();
+}
+
 void EngineInterface::clearScene()
 {
 	engine->getEngineScene()->clearScene();
 }
 
+unsigned int EngineInterface::bakeStaticBatch(const float clusterSize)
+{
+	return engine->getEngineScene()->bakeStaticBatch(clusterSize);
+}
+
 SceneEntity* EngineInterface::getEntity(const string& name)
 {
 	return engine->getEngineScene()->getEntity(name);
@@ -208,6 +227,11 @@ AnimatedEntity* EngineInterface::getAnimatedEntity(const string& name)
 	return engine->getEngineScene()->getAnimatedEntity(name);
 }
 
+SkinnedEntity* EngineInterface::getSkinnedEntity(const string& name)
+{
+	return engine->getEngineScene()->getSkinnedEntity(name);
+}
+
 Camera* EngineInterface::getCamera()
 {
 	return engine->getEngineScene()->getWorldCamera();
@@ -328,6 +352,11 @@ void EngineInterface::updateShadowSource(const int id, const Vector3D& position,
 	engine->getEngineRenderer()->updateShadowSource(id,position,direction);
 }
 
+void EngineInterface::updateCascadeSource(const Vector3D& direction)
+{
+	engine->getEngineRenderer()->updateCascadeSource(direction);
+}
+
 DirectionalLight* EngineInterface::getDirLight(const int id)
 {
 	return engine->getEngineRenderer()->getLightManager()->getDirectionalLights()->at(id).first;
@@ -408,6 +437,12 @@ void EngineInterface::updateShaderResources(const string& scriptPath)
 	engine->getEngineRenderer()->getEngineResource()->updateShaderResources(scriptPath);
 }
 
+void EngineInterface::finishResources()
+{
+	engine->getEngineRenderer()->getEngineResource()->finishShaderResources();
+	engine->getEngineRenderer()->getEngineResource()->finishTextureResources();
+}
+
 DestructibleTerrain* EngineInterface::createDestructibleTerrain(SceneEntity* entity, const string& path, const Vector4D& params, PxU32 filterGroup, PxU32 filterMask)
 {
 	DestructibleTerrain* terrain = new DestructibleTerrain();
@@ -444,9 +479,7 @@ void EngineInterface::executeTerrainDestruction(DestructibleTerrain* terrain, Ve
 		}		
 	}
 	
-	delete terrain->entity->entityGeometry.geomteryVbo;
-	terrain->entity->entityGeometry.geomteryVbo = new VertexBufferObject(*terrain->entity->entityGeometry.geometryMesh);
-	terrain->entity->configureGeometryAttributes();
+	terrain->entity->entityGeometry.geometryData->updateGeometryData();
 	
 	deleteStaticActors(terrain->entity->entityName);
 	addHeightFieldActor(terrain->entity,terrain->fileData,terrain->params,terrain->filterGroup,terrain->filterMask);
@@ -504,3 +537,68 @@ int EngineInterface::getVisibleObjects()
 
 	return x;
 }
+
+const TaskTimings& EngineInterface::getRenderTimings()
+{
+	return engine->getEngineRenderer()->getRenderProfiler()->getTaskTimings();
+}
+
+const ShaderLoadingStatistics& EngineInterface::getShaderLoadingStatistics()
+{
+	return engine->getEngineRenderer()->getEngineResource()->getShaderLoadingStatistics();
+}
+
+float EngineInterface::getFrameCpuTime()
+{
+	return engine->getEngineRenderer()->getRenderProfiler()->getFrameCpuTime();
+}
+
+float EngineInterface::getFrameGpuTime()
+{
+	return engine->getEngineRenderer()->getRenderProfiler()->getFrameGpuTime();
+}
+
+const StateMachineStatistics& EngineInterface::getStateStatistics()
+{
+	return engine->getEngineRenderer()->getRenderProfiler()->getStateStatistics();
+}
+
+const UniformCallStatistics& EngineInterface::getUniformStatistics()
+{
+	return engine->getEngineRenderer()->getRenderProfiler()->getUniformStatistics();
+}
+
+void EngineInterface::captureFrame(vector<unsigned char>& pixels)
+{
+	engine->getEngineContext()->readScreenPixels(pixels);
+}
+
+void EngineInterface::setRenderBackend(RenderBackend* backend)
+{
+	engine->getEngineRenderer()->setRenderBackend(backend);
+}
+
+void EngineInterface::setDepthPrePassEnabled(const bool enabled)
+{
+	Configuration::getInstance()->setDepthPrePassEnabled(enabled);
+}
+
+const DepthPrePassStatistics& EngineInterface::getDepthPrePassStatistics()
+{
+	return engine->getEngineRenderer()->getDepthPrePass()->getStatistics();
+}
+
+void EngineInterface::setDynamicResolutionEnabled(const bool enabled)
+{
+	Configuration::getInstance()->setDynamicResolutionEnabled(enabled);
+}
+
+void EngineInterface::setTargetFrameTime(const float time)
+{
+	Configuration::getInstance()->setTargetFrameTime(time);
+}
+
+const ResolutionScalerStatistics& EngineInterface::getResolutionScalerStatistics()
+{
+	return engine->getEngineRenderer()->getResolutionScaler()->getStatistics();
+}
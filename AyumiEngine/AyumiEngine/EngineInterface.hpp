@@ -53,12 +53,16 @@ public:
 	static void addEntityToScene(AyumiEngine::AyumiScene::SceneEntity* entity);
 	static void addIndependentToScene(AyumiEngine::AyumiScene::SceneEntity* entity);
 	static void addAnimatedEntityToScene(AyumiEngine::AyumiScene::AnimatedEntity* entity);
+	static void addSkinnedEntityToScene(AyumiEngine::AyumiScene::SkinnedEntity* entity);
 	static void deleteEntityFromScene(const std::string& name);
 	static void deleteIndependentFromScene(const std::string& name);
 	static void clearScene();
+	static unsigned int bakeStaticBatch(const float clusterSize);
 	static void deleteAnimatedEntityFromScene(const std::string& name);
+	static void deleteSkinnedEntityFromScene(const std::string& name);
 	static AyumiEngine::AyumiScene::SceneEntity* getEntity(const std::string& name);
 	static AyumiEngine::AyumiScene::AnimatedEntity* getAnimatedEntity(const std::string& name);
+	static AyumiEngine::AyumiScene::SkinnedEntity* getSkinnedEntity(const std::string& name);
 	static AyumiEngine::AyumiScene::Camera* getCamera();
 	
 	//Engine PhysicsManager API
@@ -86,6 +90,7 @@ public:
 	static void updateMaterials(const std::string& scriptPath);
 	static void updateEffects(const std::string& scriptPath);
 	static void updateShadowSource(const int id, const AyumiEngine::AyumiMath::Vector3D& position, const AyumiEngine::AyumiMath::Vector3D& direction);
+	static void updateCascadeSource(const AyumiEngine::AyumiMath::Vector3D& direction);
 	
 	static AyumiEngine::AyumiRenderer::DirectionalLight* getDirLight(const int id);
 	static AyumiEngine::AyumiRenderer::PointLight* getPointLight(const int id);
@@ -107,6 +112,7 @@ public:
 	static void updateMeshResources(const std::string& scriptPath);
 	static void updateTextureResources(const std::string& scriptPath);
 	static void updateShaderResources(const std::string& scriptPath);
+	static void finishResources();
 	
 	// Engine AyumiDestruction API
 	static AyumiEngine::AyumiDestruction::DestructibleTerrain* createDestructibleTerrain(AyumiEngine::AyumiScene::SceneEntity* entity, const std::string& path, const AyumiEngine::AyumiMath::Vector4D& params, PxU32 filterGroup, PxU32 filterMask);
@@ -118,5 +124,18 @@ public:
 
 	// Engine Debug functions
 	static int getVisibleObjects();
+	static const AyumiEngine::AyumiRenderer::TaskTimings& getRenderTimings();
+	static const AyumiEngine::AyumiResource::ShaderLoadingStatistics& getShaderLoadingStatistics();
+	static float getFrameCpuTime();
+	static float getFrameGpuTime();
+	static const AyumiEngine::AyumiCore::StateMachineStatistics& getStateStatistics();
+	static const AyumiEngine::AyumiRenderer::UniformCallStatistics& getUniformStatistics();
+	static void captureFrame(std::vector<unsigned char>& pixels);
+	static void setRenderBackend(AyumiEngine::AyumiRenderer::RenderBackend* backend);
+	static void setDepthPrePassEnabled(const bool enabled);
+	static const AyumiEngine::AyumiRenderer::DepthPrePassStatistics& getDepthPrePassStatistics();
+	static void setDynamicResolutionEnabled(const bool enabled);
+	static void setTargetFrameTime(const float time);
+	static const AyumiEngine::AyumiRenderer::ResolutionScalerStatistics& getResolutionScalerStatistics();
 };
 #endif
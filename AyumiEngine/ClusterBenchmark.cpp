@@ -0,0 +1,189 @@
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "ClusterBenchmark.hpp"
+
+using namespace std;
+using namespace boost;
+using namespace AyumiEngine;
+using namespace AyumiEngine::AyumiRenderer;
+
+/**
+ * Class constructor with initialize parameters. Cluster frustum has 60 degrees vertical field of view and
+ * 16:9 aspect ratio like default harness resolution.
+ * @param	lightAmount is amount of generated light bounding spheres.
+ * @param	iterations is amount of timed binning calls.
+ */
+ClusterBenchmark::ClusterBenchmark(const unsigned int lightAmount, const unsigned int iterations)
+{
+	this->lightAmount = lightAmount;
+	this->iterations = max(1u,iterations);
+	tanHalfHeight = tan(30.0f * 3.14159265f / 180.0f);
+	tanHalfWidth = tanHalfHeight * 16.0f / 9.0f;
+	nearPlane = 1.0f;
+	farPlane = 1000.0f;
+	clusters = new LightClusters();
+}
+
+/**
+ * Class destructor, free allocated memory.
+ */
+ClusterBenchmark::~ClusterBenchmark()
+{
+	delete clusters;
+}
+
+/**
+ * Method is used to run cluster check. Spheres are binned once and index lists are checked, then binning
+ * is timed. Result is written into engine log and kept in summary.
+ * @return	true if cluster index lists are correct.
+ */
+bool ClusterBenchmark::runBenchmark()
+{
+	createSpheres();
+	clusters->setClusterFrustum(tanHalfWidth,tanHalfHeight,nearPlane,farPlane);
+	clusters->binLights(spheres);
+	const bool passed = checkIndexLists() && checkLightCoverage();
+
+	posix_time::ptime start = posix_time::microsec_clock::universal_time();
+	for(unsigned int i = 0; i < iterations; ++i)
+	{
+		clusters->setClusterFrustum(tanHalfWidth,tanHalfHeight,nearPlane,farPlane);
+		clusters->binLights(spheres);
+	}
+	const float binningTime = (posix_time::microsec_clock::universal_time() - start).total_microseconds()*0.001f/iterations;
+
+	summary = "Light clusters benchmark, lights: " + lexical_cast<string>(lightAmount);
+	summary += ", light indices: " + lexical_cast<string>(clusters->getIndexAmount());
+	summary += ", binning time: " + lexical_cast<string>(binningTime) + " ms";
+	summary += passed ? ", index lists are correct" : ", index lists are incorrect";
+	Logger::getInstance()->saveLog(Log<string>(summary));
+	return passed;
+}
+
+/**
+ * Accessor to result of last benchmark run.
+ * @return	reference to benchmark summary.
+ */
+const string& ClusterBenchmark::getSummary() const
+{
+	return summary;
+}
+
+/**
+ * Private method which is used to generate light bounding spheres in view space. Generator is seeded with
+ * constant value, so each run bins the same lights. Spheres are placed in first 200 units of view frustum.
+ */
+void ClusterBenchmark::createSpheres()
+{
+	srand(1);
+	spheres.resize(lightAmount);
+	for(unsigned int i = 0; i < lightAmount; ++i)
+	{
+		const float depth = nearPlane + (200.0f - nearPlane) * rand() / RAND_MAX;
+		spheres[i].x = (2.0f * rand() / RAND_MAX - 1.0f) * tanHalfWidth * depth;
+		spheres[i].y = (2.0f * rand() / RAND_MAX - 1.0f) * tanHalfHeight * depth;
+		spheres[i].z = -depth;
+		spheres[i].radius = 1.0f + 9.0f * rand() / RAND_MAX;
+	}
+}
+
+/**
+ * Private method which is used to check cluster index lists. Lists must contain valid light indices in
+ * ascending order without repetitions and their lengths must sum to amount of all light indices.
+ * @return	true if index lists are correct.
+ */
+bool ClusterBenchmark::checkIndexLists() const
+{
+	unsigned int indexAmount = 0;
+	for(unsigned int i = 0; i < CLUSTER_AMOUNT; ++i)
+	{
+		const unsigned int amount = clusters->getClusterLightAmount(i);
+		const unsigned int* lights = clusters->getClusterLights(i);
+		for(unsigned int j = 0; j < amount; ++j)
+		{
+			if(lights[j] >= lightAmount || (j > 0 && lights[j] <= lights[j-1]))
+			{
+				Logger::getInstance()->saveLog(Log<string>("Light clusters benchmark invalid index list of cluster: " + lexical_cast<string>(i)));
+				return false;
+			}
+		}
+		indexAmount += amount;
+	}
+
+	if(indexAmount != clusters->getIndexAmount())
+	{
+		Logger::getInstance()->saveLog(Log<string>("Light clusters benchmark index amount mismatch: " + lexical_cast<string>(indexAmount)));
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Private method which is used to check that binning is conservative. Center of each sphere and points
+ * near its surface along view axes are mapped to clusters, light must be listed in each cluster of point
+ * inside view frustum.
+ * @return	true if all sampled clusters contain their lights.
+ */
+bool ClusterBenchmark::checkLightCoverage() const
+{
+	const float offsets[7][3] = {{0.0f,0.0f,0.0f},{1.0f,0.0f,0.0f},{-1.0f,0.0f,0.0f},{0.0f,1.0f,0.0f},{0.0f,-1.0f,0.0f},{0.0f,0.0f,1.0f},{0.0f,0.0f,-1.0f}};
+	for(unsigned int i = 0; i < spheres.size(); ++i)
+	{
+		const float radius = spheres[i].radius * 0.99f;
+		for(unsigned int j = 0; j < 7; ++j)
+		{
+			unsigned int cluster = 0;
+			if(getPointCluster(spheres[i].x + offsets[j][0] * radius,spheres[i].y + offsets[j][1] * radius,spheres[i].z + offsets[j][2] * radius,cluster) && !isClusterLight(cluster,i))
+			{
+				Logger::getInstance()->saveLog(Log<string>("Light clusters benchmark light " + lexical_cast<string>(i) + " is missing in cluster: " + lexical_cast<string>(cluster)));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Private method which is used to check if light is listed in cluster.
+ * @param	cluster is cluster index.
+ * @param	light is light index.
+ * @return	true if cluster index list contains light.
+ */
+bool ClusterBenchmark::isClusterLight(const unsigned int cluster, const unsigned int light) const
+{
+	const unsigned int amount = clusters->getClusterLightAmount(cluster);
+	const unsigned int* lights = clusters->getClusterLights(cluster);
+	return amount > 0 && binary_search(lights,lights + amount,light);
+}
+
+/**
+ * Private method which is used to find cluster of view space point. Screen tile is taken from projected
+ * point and depth slice is exponential like in shaders.
+ * @param	x is point x coordinate.
+ * @param	y is point y coordinate.
+ * @param	z is point z coordinate, negative in front of camera.
+ * @param	cluster is reference to result cluster index.
+ * @return	false if point is outside view frustum.
+ */
+bool ClusterBenchmark::getPointCluster(const float x, const float y, const float z, unsigned int& cluster) const
+{
+	const float depth = -z;
+	if(depth < nearPlane || depth > farPlane)
+		return false;
+
+	const float screenX = x / depth / tanHalfWidth;
+	const float screenY = y / depth / tanHalfHeight;
+	if(fabs(screenX) > 1.0f || fabs(screenY) > 1.0f)
+		return false;
+
+	const unsigned int tileX = min(static_cast<unsigned int>((screenX + 1.0f) * 0.5f * CLUSTER_X),CLUSTER_X - 1);
+	const unsigned int tileY = min(static_cast<unsigned int>((screenY + 1.0f) * 0.5f * CLUSTER_Y),CLUSTER_Y - 1);
+	const float slice = log(depth / nearPlane) / log(farPlane / nearPlane) * CLUSTER_Z;
+	const unsigned int sliceZ = min(static_cast<unsigned int>(max(0.0f,slice)),CLUSTER_Z - 1);
+	cluster = clusters->getClusterIndex(tileX,tileY,sliceZ);
+	return true;
+}
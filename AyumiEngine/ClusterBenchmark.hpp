@@ -0,0 +1,44 @@
+#ifndef CLUSTERBENCHMARK_HPP
+#define CLUSTERBENCHMARK_HPP
+
+#include <string>
+#include <vector>
+
+#include "AyumiEngine/EngineInterface.hpp"
+
+/**
+ * Class represents headless check of light clusters binning. Random light bounding spheres are generated in
+ * view frustum and binned by LightClusters without OpenGL context. Cluster index lists are checked for valid,
+ * sorted and unique light indices and each light must be listed in clusters of points sampled inside its
+ * sphere. Binning is repeated and average time is written into engine log and summary. Check is started by
+ * --cluster-benchmark command line option, process exit code is 0 when index lists are correct.
+ */
+class ClusterBenchmark
+{
+private:
+	AyumiEngine::AyumiRenderer::LightClusters* clusters;
+	std::vector<AyumiEngine::AyumiRenderer::ClusterSphere> spheres;
+	unsigned int lightAmount;
+	unsigned int iterations;
+	float tanHalfWidth;
+	float tanHalfHeight;
+	float nearPlane;
+	float farPlane;
+	std::string summary;
+
+	void createSpheres();
+	bool checkIndexLists() const;
+	bool checkLightCoverage() const;
+	bool isClusterLight(const unsigned int cluster, const unsigned int light) const;
+	bool getPointCluster(const float x, const float y, const float z, unsigned int& cluster) const;
+
+public:
+	ClusterBenchmark(const unsigned int lightAmount = 1000, const unsigned int iterations = 100);
+	~ClusterBenchmark();
+
+	bool runBenchmark();
+
+	const std::string& getSummary() const;
+};
+
+#endif
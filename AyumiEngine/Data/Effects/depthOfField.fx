@@ -37,6 +37,7 @@ Effect:endEffectPass()
 Effect:startEffectPass()
 Effect:loadFrameBufferParams(renderTarget,renderTargetWidth,renderTargetHeight,textureType)
 Effect:loadEffectShader("DepthOfFieldFXPass2")
+Effect:loadRenderTargetScale(0.5)
 Effect:loadOffScreenRenderingScene(false)
 Effect:loadOffScreenRenderingPrevious(true)
 Effect:loadFinalRendering(false)
@@ -33,4 +33,5 @@ Effect:loadOffScreenRenderingScene(false)
 Effect:loadOffScreenRenderingPrevious(false)
 Effect:loadFinalRendering(true)
 Effect:loadClearBeforeFinal(true)
+Effect:loadColorFilter("Sepia")
 Effect:endEffectPass()
\ No newline at end of file
@@ -3,7 +3,7 @@
 Name = "Course"
 LayerAmount = 1
 FirstLayerName = "Course"
-ShaderName = "SoftShadowMapping"
+ShaderName = "CascadedShadowMapping"
 
 Ambient = {0.3, 0.3, 0.3, 1.0}
 Diffuse = {0.7, 0.7, 0.7, 1.0}
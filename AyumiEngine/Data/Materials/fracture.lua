@@ -3,7 +3,7 @@
 Name = "Fracture"
 LayerAmount = 1
 FirstLayerName = "Wall"
-ShaderName = "TextureMapping"
+ShaderName = "TextureMappingInstanced"
 
 Ambient = {0.3, 0.3, 0.3, 1.0}
 Diffuse = {0.7, 0.7, 0.7, 1.0}
@@ -16,4 +16,5 @@ Material:loadMaterialShader(ShaderName)
 Material:loadMaterialAmbient(Ambient)
 Material:loadMaterialDiffuse(Diffuse)
 Material:loadMaterialSpecular(Specular)
-Material:loadMaterialShininess(Shininess)
\ No newline at end of file
+Material:loadMaterialShininess(Shininess)
+Material:setInstancing("true")
\ No newline at end of file
@@ -6,6 +6,7 @@ FirstLayerName = "ColorMap"
 SecondLayerName = "GlossMap"
 ThirdLayerName = "NormalMap"
 ShaderName = "NormalMapping"
+DepthShaderName = "NormalMappingDepth"
 
 Ambient = {0.3, 0.3, 0.3, 1.0}
 Diffuse = {0.7, 0.7, 0.7, 1.0}
@@ -17,6 +18,7 @@ Material:loadMaterialLayer(FirstLayerName,0)
 Material:loadMaterialLayer(SecondLayerName,1)
 Material:loadMaterialLayer(ThirdLayerName,2)
 Material:loadMaterialShader(ShaderName)
+Material:loadMaterialDepthShader(DepthShaderName)
 Material:loadMaterialAmbient(Ambient)
 Material:loadMaterialDiffuse(Diffuse)
 Material:loadMaterialSpecular(Specular)
@@ -7,6 +7,7 @@ SecondLayerName = "GlossMap"
 ThirdLayerName = "NormalMap"
 FourthLayerName = "HeightMap"
 ShaderName = "ParallaxMapping"
+DepthShaderName = "ParallaxMappingDepth"
 
 Ambient = {0.3, 0.3, 0.3, 1.0}
 Diffuse = {0.7, 0.7, 0.7, 1.0}
@@ -19,6 +20,7 @@ Material:loadMaterialLayer(SecondLayerName,1)
 Material:loadMaterialLayer(ThirdLayerName,2)
 Material:loadMaterialLayer(FourthLayerName,3)
 Material:loadMaterialShader(ShaderName)
+Material:loadMaterialDepthShader(DepthShaderName)
 Material:loadMaterialAmbient(Ambient)
 Material:loadMaterialDiffuse(Diffuse)
 Material:loadMaterialSpecular(Specular)
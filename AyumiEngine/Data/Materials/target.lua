@@ -3,7 +3,7 @@
 Name = "Target"
 LayerAmount = 1
 FirstLayerName = "Target"
-ShaderName = "TextureMapping"
+ShaderName = "TextureMappingInstanced"
 
 Ambient = {1.0, 1.0, 1.0, 1.0}
 Diffuse = {1.0, 1.0, 1.0, 1.0}
@@ -16,4 +16,5 @@ Material:loadMaterialShader(ShaderName)
 Material:loadMaterialAmbient(Ambient)
 Material:loadMaterialDiffuse(Diffuse)
 Material:loadMaterialSpecular(Specular)
-Material:loadMaterialShininess(Shininess)
\ No newline at end of file
+Material:loadMaterialShininess(Shininess)
+Material:setInstancing("true")
\ No newline at end of file
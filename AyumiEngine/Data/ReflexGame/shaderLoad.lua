@@ -9,6 +9,7 @@
 ShaderManager:registerResource("Skybox","VertexFragment","Data/Shader/skybox.vert","Data/Shader/skybox.frag")
 
 ShaderManager:registerResource("TextureMapping","VertexFragment","Data/Shader/textureMapping.vert","Data/Shader/textureMapping.frag")
+ShaderManager:registerResource("TextureMappingInstanced","VertexFragment","Data/Shader/textureMappingInstanced.vert","Data/Shader/textureMapping.frag")
 
 ShaderManager:registerResource("ShadowMapping","VertexFragment","Data/Shader/shadowMapping.vert","Data/Shader/shadowMapping.frag")
 ShaderManager:registerResource("SoftShadowMapping","VertexFragment","Data/Shader/softShadowMapping.vert","Data/Shader/softShadowMapping.frag")
@@ -10,6 +10,12 @@ colorDepth = 32
 msaaLevel = 4
 fullscreenEnabled = false
 vSyncEnabled = false
+depthPrePassEnabled = true
+dynamicResolutionEnabled = false
+minResolutionScale = 0.5
+maxResolutionScale = 1.0
+targetFrameTime = 16.6
+offscreenEnabled = false
 windowCaption = "Ayumi Engine Demo"
 
 textureScriptName = "Data/Scripts/textureLoad.lua"
@@ -28,6 +34,12 @@ Config:setColorDepth(colorDepth)
 Config:setMSAALevel(msaaLevel)
 Config:setFullscreenEnabled(fullscreenEnabled)
 Config:setVSyncEnabled(vSyncEnabled)
+Config:setOffscreenEnabled(offscreenEnabled)
+Config:setDepthPrePassEnabled(depthPrePassEnabled)
+Config:setDynamicResolutionEnabled(dynamicResolutionEnabled)
+Config:setMinResolutionScale(minResolutionScale)
+Config:setMaxResolutionScale(maxResolutionScale)
+Config:setTargetFrameTime(targetFrameTime)
 Config:setWindowCaption(windowCaption)
 Config:setTextureScriptName(textureScriptName)
 Config:setMeshScriptName(meshScriptName)
@@ -3,6 +3,7 @@
 -- 07.10.2011
 
 -- communication with Engine
+-- dynamic resolution needs effect with off-screen scene pass, void.fx only upscale scene
 
 --EffectManager:loadEffect("Data/Effects/depthOfField.fx")
 --EffectManager:loadEffect("Data/Effects/grayscale.fx")
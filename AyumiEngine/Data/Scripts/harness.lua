@@ -0,0 +1,27 @@
+-- Render harness script
+-- Szymon "Veldrin" Jaboski
+-- 25.02.2012
+
+-- harness settings
+
+Harness:setConfigPath("Data/Scripts/harnessConfig.lua")
+Harness:setFrameAmount(200)
+Harness:setWarmupFrames(20)
+Harness:setCaptureInterval(50)
+Harness:setNullBackendFrames(100)
+Harness:setGoldenDirectory("Data/Harness/Golden/")
+Harness:setOutputDirectory("Data/Harness/Output/")
+Harness:setReportPath("Data/Harness/Output/report.json")
+Harness:setTolerance(8.0, 0.01)
+
+-- scene
+
+Harness:addIndependent("Sky", "Sphere", "Preetham", 0.0, -1000.0, 0.0, 1000.0)
+Harness:addIndependent("Terrain", "Terrain", "Terrain", -6400.0, -1200.0, -6400.0, 1.0)
+
+-- camera path: position and pitch, yaw, roll in degrees
+
+Harness:addCameraKey(50.0, 0.0, 50.0, 0.0, 0.0, 0.0)
+Harness:addCameraKey(1500.0, 200.0, 1500.0, -10.0, 45.0, 0.0)
+Harness:addCameraKey(3000.0, 600.0, 500.0, -20.0, 120.0, 0.0)
+Harness:addCameraKey(50.0, 0.0, 50.0, 0.0, 360.0, 0.0)
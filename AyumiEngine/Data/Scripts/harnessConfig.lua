@@ -0,0 +1,51 @@
+-- Render harness configuration script
+-- Szymon "Veldrin" Jaboski
+-- 24.02.2012
+
+-- configuration data
+
+resolutionWidth = 800
+resolutionHeight = 480	
+colorDepth = 32
+msaaLevel = 0
+fullscreenEnabled = false
+vSyncEnabled = false
+depthPrePassEnabled = true
+-- golden images are compared in full resolution
+dynamicResolutionEnabled = false
+minResolutionScale = 0.5
+maxResolutionScale = 1.0
+targetFrameTime = 16.6
+offscreenEnabled = true
+windowCaption = "Ayumi Engine Harness"
+
+textureScriptName = "Data/Scripts/textureLoad.lua"
+meshScriptName = "Data/Scripts/meshLoad.lua"
+shaderScriptName = "Data/Scripts/shaderLoad.lua"
+materialScriptName = "Data/Scripts/materialLoad.lua"
+lightScriptName = "Data/Scripts/lightLoad.lua"
+soundScriptName = "Data/Scripts/soundLoad.lua"
+effectScriptName = "Data/Scripts/effectLoad.lua"
+
+-- communication with Engine
+
+Config:setResolutionWidth(resolutionWidth)
+Config:setResolutionHeight(resolutionHeight)
+Config:setColorDepth(colorDepth)
+Config:setMSAALevel(msaaLevel)
+Config:setFullscreenEnabled(fullscreenEnabled)
+Config:setVSyncEnabled(vSyncEnabled)
+Config:setOffscreenEnabled(offscreenEnabled)
+Config:setDepthPrePassEnabled(depthPrePassEnabled)
+Config:setDynamicResolutionEnabled(dynamicResolutionEnabled)
+Config:setMinResolutionScale(minResolutionScale)
+Config:setMaxResolutionScale(maxResolutionScale)
+Config:setTargetFrameTime(targetFrameTime)
+Config:setWindowCaption(windowCaption)
+Config:setTextureScriptName(textureScriptName)
+Config:setMeshScriptName(meshScriptName)
+Config:setShaderScriptName(shaderScriptName)
+Config:setMaterialScriptName(materialScriptName)
+Config:setLightScriptName(lightScriptName)
+Config:setSoundScriptName(soundScriptName)
+Config:setEffectScriptName(effectScriptName)
\ No newline at end of file
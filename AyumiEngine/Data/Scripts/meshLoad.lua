@@ -29,6 +29,11 @@ MeshManager:registerResource("Box","MESH_VEL","Data/Mesh/cube.vel")
 
 -- animation demo
 --MeshManager:registerResource("Yoshi","MESH_MD2","Data/Mesh/yoshi.md2")
+--MeshManager:loadAnimationClip("Yoshi","death",178,183,7,false)
+--MeshManager:registerResource("Marine","MESH_MD5","Data/Mesh/marine.md5mesh")
+--MeshManager:loadSkeletalAnimation("Marine","walk","Data/Mesh/marineWalk.md5anim")
+MeshManager:registerResource("BendingBox","MESH_MD5","Data/Mesh/bendingBox.md5mesh")
+MeshManager:loadSkeletalAnimation("BendingBox","bend","Data/Mesh/bendingBoxBend.md5anim")
 
 -- csg demo
 --MeshManager:registerResource("Box2","MESH_VEL","Data/Mesh/cube2.vel")
@@ -10,6 +10,7 @@
 --ShaderManager:registerResource("GrayscaleFX","VertexFragment","Data/Shader/grayscale.vert","Data/Shader/grayscale.frag")
 --ShaderManager:registerResource("SepiaFX","VertexFragment","Data/Shader/sepia.vert","Data/Shader/sepia.frag")
 --ShaderManager:registerResource("ColorInvertFX","VertexFragment","Data/Shader/colorInvert.vert","Data/Shader/colorInvert.frag")
+--ShaderManager:registerResource("ColorFilterFX","VertexFragment","Data/Shader/colorFilter.vert","Data/Shader/colorFilter.frag")
 --ShaderManager:registerResource("MotionBlurFX","VertexFragment","Data/Shader/motionBlur.vert","Data/Shader/motionBlur.frag")
 --ShaderManager:registerResource("PixelationFX","VertexFragment","Data/Shader/pixelation.vert","Data/Shader/pixelation.frag")
 --ShaderManager:registerResource("ThermalVisionFX","VertexFragment","Data/Shader/thermalVision.vert","Data/Shader/thermalVision.frag")
@@ -38,8 +39,11 @@ ShaderManager:registerResource("Preetham","VertexFragment","Data/Shader/preetham
 
 -- materials demo
 ShaderManager:registerResource("TextureMapping","VertexFragment","Data/Shader/textureMapping.vert","Data/Shader/textureMapping.frag")
+ShaderManager:registerResource("TextureMappingInstanced","VertexFragment","Data/Shader/textureMappingInstanced.vert","Data/Shader/textureMapping.frag")
 --ShaderManager:registerResource("NormalMapping","VertexFragment","Data/Shader/normalMapping.vert","Data/Shader/normalMapping.frag")
+--ShaderManager:registerResource("NormalMappingDepth","VertexFragment","Data/Shader/normalMapping.vert","Data/Shader/depthPrePass.frag")
 --ShaderManager:registerResource("ParallaxMapping","VertexFragment","Data/Shader/parallaxMapping.vert","Data/Shader/parallaxMapping.frag")
+--ShaderManager:registerResource("ParallaxMappingDepth","VertexFragment","Data/Shader/parallaxMapping.vert","Data/Shader/depthPrePass.frag")
 --ShaderManager:registerResource("CubeMapping","VertexFragment","Data/Shader/cubeMapping.vert","Data/Shader/cubeMapping.frag")
 --ShaderManager:registerResource("SphereMapping","VertexFragment","Data/Shader/sphereMapping.vert","Data/Shader/sphereMapping.frag")
 --ShaderManager:registerResource("EnvironmentMapping","VertexFragment","Data/Shader/environmentMapping.vert","Data/Shader/environmentMapping.frag")
@@ -57,6 +61,7 @@ ShaderManager:registerResource("TextureMapping","VertexFragment","Data/Shader/te
 
 -- animation demo
 --ShaderManager:registerResource("Animation","VertexFragment","Data/Shader/animation.vert","Data/Shader/animation.frag")
+--ShaderManager:registerResource("Skinning","VertexFragment","Data/Shader/skinning.vert","Data/Shader/animation.frag")
 
 
 
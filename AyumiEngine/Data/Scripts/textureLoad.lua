@@ -22,7 +22,7 @@ TextureManager:registerResource("SkyDome","Data/Texture/skyDome.png","TEXTURE2D"
 TextureManager:registerResource("Box","Data/Texture/box.jpg","TEXTURE2D")
 TextureManager:registerResource("ColorMap","Data/Texture/colorMap.png","TEXTURE2D")
 TextureManager:registerResource("GlossMap","Data/Texture/glossMap.png","TEXTURE2D")
-TextureManager:registerResource("NormalMap","Data/Texture/normalMap.png","TEXTURE2D")
+TextureManager:registerResource("NormalMap","Data/Texture/normalMap.png","NORMALMAP")
 TextureManager:registerResource("HeightMap","Data/Texture/heightMap.png","TEXTURE2D")
 TextureManager:registerResource("ToonMap","Data/Texture/redToon.texture1d","TEXTURE1D")
 TextureManager:registerResource("Skybox","Data/Texture/Skybox/left.png","Data/Texture/Skybox/right.png","Data/Texture/Skybox/top.png","Data/Texture/Skybox/bottom.png","Data/Texture/Skybox/back.png","Data/Texture/Skybox/front.png","CUBEMAP")
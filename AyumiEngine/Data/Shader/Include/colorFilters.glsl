@@ -0,0 +1,45 @@
+// Per-pixel color filters shared by single filter effects and fused ColorFilterFX pass.
+// Filter ids match ColorFilter enumeration of engine RenderPass.
+
+#define MAX_COLOR_FILTERS 4
+#define SEPIA_FILTER 1
+#define GRAYSCALE_FILTER 2
+#define COLOR_INVERT_FILTER 3
+
+vec4 sepiaFilter(vec4 color)
+{
+	mat4 sepiaMatrix = mat4(0.5, 0.4, 0.2, 0.0,
+							0.4, 0.3, 0.2, 0.0,
+							0.3, 0.3, 0.2, 0.0,
+							0.0, 0.0, 0.0, 1.0);
+
+	color = transpose(sepiaMatrix) * color;
+	return color / color.a;
+}
+
+vec4 grayscaleFilter(vec4 color)
+{
+	mat4 grayscaleMatrix = mat4(0.3, 0.6, 0.1, 0.0,
+								0.3, 0.6, 0.1, 0.0,
+								0.3, 0.6, 0.1, 0.0,
+								0.0, 0.0, 0.0, 1.0);
+
+	color = transpose(grayscaleMatrix) * color;
+	return color / color.a;
+}
+
+vec4 colorInvertFilter(vec4 color)
+{
+	return vec4(1.0-color.x,1.0-color.y,1.0-color.z,1.0);
+}
+
+vec4 applyColorFilter(int filter, vec4 color)
+{
+	if(filter == SEPIA_FILTER)
+		return sepiaFilter(color);
+	else if(filter == GRAYSCALE_FILTER)
+		return grayscaleFilter(color);
+	else if(filter == COLOR_INVERT_FILTER)
+		return colorInvertFilter(color);
+	return color;
+}
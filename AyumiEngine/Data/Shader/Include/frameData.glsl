@@ -0,0 +1,198 @@
+// Engine uniform blocks shared by all lighting shaders. Blocks are updated by Renderer
+// once per frame (camera, lights, shadows) or per object (ring buffer range).
+
+#define MAX_LIGHTS_NUM 8
+#define MAX_SHADOWS_NUM 8
+#define MAX_CASCADES_NUM 4
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+};
+
+struct PointLight
+{
+	vec3 position;
+	float radius;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+};
+
+struct SpotLight
+{
+	vec3 position;
+	float range;
+	vec3 direction;
+	float cosInnerCone;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	float cosOuterCone;
+};
+
+layout(std140) uniform CameraData
+{
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 inverseCameraMatrix;
+};
+
+layout(std140) uniform LightData
+{
+	ivec4 lightAmount;
+	DirectionalLight directionalLight[MAX_LIGHTS_NUM];
+	PointLight pointLight[MAX_LIGHTS_NUM];
+	SpotLight spotLight[MAX_LIGHTS_NUM];
+	vec4 clusterData;
+};
+
+layout(std140) uniform ShadowData
+{
+	mat4 shadowMatrix[MAX_SHADOWS_NUM];
+	mat4 cascadeMatrix[MAX_CASCADES_NUM];
+	vec4 cascadeSplits;
+};
+
+layout(std140) uniform ObjectData
+{
+	mat4 modelMatrix;
+	mat4 modelViewMatrix;
+	mat3 normalMatrix;
+	vec4 keyFrameData;
+	vec4 blendFrameData;
+};
+
+// Key frame animation. Frames of mesh are packed once into keyFrames buffer - each vertex use two
+// texels: position and normal. Key frame data store first vertex of current and next frame,
+// interpolation value and fade weight of entity, blend frame data store the same frames of clip
+// which is cross-faded out. All instances share one buffer.
+#ifdef KEY_FRAME_ANIMATION
+uniform samplerBuffer keyFrames;
+
+// Returns interpolated texel of current vertex: 0 - position, 1 - normal.
+vec3 getFrameTexel(vec4 frameData, int texel)
+{
+	vec4 current = texelFetch(keyFrames, (int(frameData.x) + gl_VertexID) * 2 + texel);
+	vec4 next = texelFetch(keyFrames, (int(frameData.y) + gl_VertexID) * 2 + texel);
+	return mix(current.xyz, next.xyz, frameData.z);
+}
+
+// Returns interpolated object space position of current vertex.
+vec4 getKeyFramePosition()
+{
+	return vec4(mix(getFrameTexel(blendFrameData, 0), getFrameTexel(keyFrameData, 0), keyFrameData.w), 1.0);
+}
+
+// Returns interpolated object space normal of current vertex.
+vec3 getKeyFrameNormal()
+{
+	return normalize(mix(getFrameTexel(blendFrameData, 1), getFrameTexel(keyFrameData, 1), keyFrameData.w));
+}
+#endif
+
+// Skeletal animation. SkinData store skin matrices (joint pose * inverse bind pose) of entity,
+// each vertex use two texels of skinInfluences: indices and weights of four joints.
+#ifdef SKELETAL_ANIMATION
+#define MAX_SKIN_JOINTS 128
+
+layout(std140) uniform SkinData
+{
+	mat4 skinMatrix[MAX_SKIN_JOINTS];
+};
+
+uniform samplerBuffer skinInfluences;
+
+// Returns weighted skin matrix of current vertex.
+mat4 getSkinMatrix()
+{
+	vec4 joints = texelFetch(skinInfluences, gl_VertexID * 2);
+	vec4 weights = texelFetch(skinInfluences, gl_VertexID * 2 + 1);
+	return skinMatrix[int(joints.x)] * weights.x + skinMatrix[int(joints.y)] * weights.y +
+		skinMatrix[int(joints.z)] * weights.z + skinMatrix[int(joints.w)] * weights.w;
+}
+#endif
+
+// Clustered point and spot lights. Renderer bins lights into 16x9x24 clusters (screen tiles and
+// exponential depth slices). Each light use six texels of clusterLights: view space position and
+// radius, view space direction and inner cone, ambient, diffuse, specular, outer cone and type.
+#ifdef CLUSTERED_LIGHTING
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+#define CLUSTER_LIGHT_TEXELS 6
+
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterIndices;
+uniform samplerBuffer clusterLights;
+
+// Returns first light index and amount of lights of current fragment cluster.
+uvec2 getClusterRange(float viewDepth)
+{
+	ivec2 tile = ivec2(gl_FragCoord.xy / clusterData.xy * vec2(CLUSTER_X, CLUSTER_Y));
+	int slice = int(log(max(viewDepth, clusterData.z) / clusterData.z) / log(clusterData.w / clusterData.z) * float(CLUSTER_Z));
+	tile = clamp(tile, ivec2(0), ivec2(CLUSTER_X - 1, CLUSTER_Y - 1));
+	slice = clamp(slice, 0, CLUSTER_Z - 1);
+	return texelFetch(clusterGrid, (slice * CLUSTER_Y + tile.y) * CLUSTER_X + tile.x).xy;
+}
+
+// Returns first texel of cluster light.
+int getClusterLight(uvec2 range, uint i)
+{
+	return int(texelFetch(clusterIndices, int(range.x + i)).r) * CLUSTER_LIGHT_TEXELS;
+}
+
+// Accumulates ambient, diffuse and specular light of point and spot lights of fragment cluster.
+// Position, normal and view vector are in view space, material colors are applied by caller.
+void addClusterLights(vec3 position, vec3 N, vec3 V, float shininess, inout vec4 ambient, inout vec4 diffuse, inout vec4 specular)
+{
+	uvec2 cluster = getClusterRange(-position.z);
+	for(uint i = 0u; i < cluster.y; i++)
+	{
+		int light = getClusterLight(cluster, i);
+		vec4 lightPosition = texelFetch(clusterLights, light);
+		vec4 direction = texelFetch(clusterLights, light + 1);
+		vec4 cone = texelFetch(clusterLights, light + 5);
+
+		vec3 lightDir = (lightPosition.xyz - position) / lightPosition.w;
+		float atten = max(0.0, 1.0 - dot(lightDir, lightDir));
+
+		vec3 L = normalize(lightDir);
+		vec3 R = normalize(-reflect(L, N));
+
+		if(cone.y > 0.5)
+			atten *= smoothstep(cone.x, direction.w, dot(-L, normalize(direction.xyz)));
+
+		ambient += texelFetch(clusterLights, light + 2) * atten;
+		diffuse += texelFetch(clusterLights, light + 3) * max(0.0, dot(N, L)) * atten;
+		specular += texelFetch(clusterLights, light + 4) * pow(max(0.0, dot(R, V)), shininess) * atten;
+	}
+}
+#endif
+
+// Cascaded shadow maps of directional light. Cascade is selected by view depth, cascade matrices
+// transform view space position into texture coordinates of cascadeShadowTexture layer.
+#ifdef CASCADED_SHADOWS
+uniform sampler2DArrayShadow cascadeShadowTexture;
+
+// Returns lit factor of view space position, filtered by 2x2 PCF.
+float getCascadeShadow(vec3 viewPosition)
+{
+	float viewDepth = -viewPosition.z;
+	int cascade = 0;
+	for(int i = 0; i < MAX_CASCADES_NUM - 1; i++)
+		if(viewDepth > cascadeSplits[i])
+			cascade = i + 1;
+
+	vec4 coord = cascadeMatrix[cascade] * vec4(viewPosition, 1.0);
+	vec2 texel = 1.0 / vec2(textureSize(cascadeShadowTexture, 0).xy);
+	float shadow = 0.0;
+	for(float y = -0.5; y <= 0.5; y += 1.0)
+		for(float x = -0.5; x <= 0.5; x += 1.0)
+			shadow += texture(cascadeShadowTexture, vec4(coord.xy + vec2(x, y) * texel, float(cascade), coord.z - 0.0005));
+	return shadow * 0.25;
+}
+#endif
@@ -4,39 +4,11 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 1
-#define POINT_NUM 1
+#define POINT_NUM 0
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct Spotlight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#define KEY_FRAME_ANIMATION
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -46,22 +18,7 @@ uniform struct Material
 	float shininess;
 } material;
 
-uniform mat4 modelViewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat3 normalMatrix;
-
-in vec4 vertex;
-in vec3 normal;
 in vec2 texCoord;
-in vec4 tangent;
-
-in vec4 vertex2;
-in vec3 normal2;
-in vec2 texCoord2;
-in vec4 tangent2;
-in float interpolate;
 
 out vec3 VertexPos;
 out vec3 Normal;
@@ -75,11 +32,7 @@ void main()
 {						
 	// Tutaj caa zabawa interpolacji liniowej w shaderze
 	
-	float x = vertex.x + interpolate * (vertex2.x - vertex.x);
-	float y = vertex.y + interpolate * (vertex2.y - vertex.y);
-	float z = vertex.z + interpolate * (vertex2.z - vertex.z);
-	
-	vec4 pos = vec4(x,y,z,1.0f);   
+	vec4 pos = getKeyFramePosition();
 	gl_Position = projectionMatrix*modelViewMatrix*pos;
     
 	mat4 modelViewMatrix = viewMatrix * modelMatrix;
@@ -108,6 +61,6 @@ void main()
 		spotDir[i] = vec3(viewMatrix * vec4(spotLight[i].direction, 0.0));
 	}
 
-    Normal = normalMatrix * normal;
+    Normal = normalMatrix * getKeyFrameNormal();
     TexCoord = texCoord;
 }
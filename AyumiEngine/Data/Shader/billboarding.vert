@@ -4,39 +4,10 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 1
 #define POINT_NUM 1
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct Spotlight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -46,12 +17,6 @@ uniform struct Material
 	float shininess;
 } material;
 
-uniform mat4 modelViewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat3 normalMatrix;
-
 in vec4 vertex;
 in vec3 normal;
 in vec2 texCoord;
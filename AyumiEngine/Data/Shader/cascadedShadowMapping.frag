@@ -0,0 +1,63 @@
+#version 330
+
+#define DIR_NUM 0
+#define POINT_NUM 0
+#define SPOT_NUM 0
+#define CLUSTERED_LIGHTING
+#define CASCADED_SHADOWS
+#include "Include/frameData.glsl"
+
+uniform struct Material
+{
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	float shininess;
+} material;
+
+uniform sampler2D ColorMap;
+
+in vec3 VertexPos;
+in vec3 Normal;
+in vec2 TexCoord;
+in vec3 dirLightDir[MAX_LIGHTS_NUM];
+in vec3 pointLightDir[MAX_LIGHTS_NUM];
+in vec3 spotLightDir[MAX_LIGHTS_NUM];
+in vec3 spotDir[MAX_LIGHTS_NUM];
+
+out vec4 fragColor;
+
+void main()
+{
+	vec4 texel = texture(ColorMap, TexCoord);
+	vec3 N = normalize(Normal);
+	vec3 V = normalize(-VertexPos);
+	
+	fragColor = vec4(0.0);
+	
+	// Directional Lights
+	for(int i = 0; i < DIR_NUM; i++)
+	{
+		vec3 L = normalize(dirLightDir[i]);
+		vec3 R = normalize(-reflect(L, N));
+
+		float nDotL = max(0.0, dot(N, L));
+		float rDotV = max(0.0, dot(R, V));
+	
+		vec4 ambient = directionalLight[i].ambient * material.ambient;
+		vec4 diffuse = directionalLight[i].diffuse * material.diffuse * nDotL;
+		vec4 specular = directionalLight[i].specular * material.specular * pow(rDotV, material.shininess);
+
+		fragColor += (ambient + diffuse + specular) * texel;
+	}
+	
+	// Point and Spot Lights of fragment cluster
+	vec4 ambient = vec4(0.0);
+	vec4 diffuse = vec4(0.0);
+	vec4 specular = vec4(0.0);
+	addClusterLights(VertexPos, N, V, material.shininess, ambient, diffuse, specular);
+	fragColor += (ambient * material.ambient + diffuse * material.diffuse + specular * material.specular) * texel;
+	
+	// cascaded shadow mapping
+	fragColor = fragColor*(getCascadeShadow(VertexPos)+0.2);
+}
\ No newline at end of file
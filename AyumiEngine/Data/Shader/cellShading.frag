@@ -4,17 +4,8 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define POINT_NUM 1
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
+#include "Include/frameData.glsl"
 
 uniform sampler1D ToonMap;
 
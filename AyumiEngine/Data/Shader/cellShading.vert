@@ -4,23 +4,8 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define POINT_NUM 1
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform mat4 modelViewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat3 normalMatrix;
+#include "Include/frameData.glsl"
 
 in vec4 vertex;
 in vec3 normal;
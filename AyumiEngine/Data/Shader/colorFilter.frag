@@ -0,0 +1,21 @@
+#version 330
+
+#include "Include/colorFilters.glsl"
+
+uniform samplerRect FrameBuffer;
+uniform float FrameBufferScale;
+uniform int filterAmount;
+uniform int filterChain[MAX_COLOR_FILTERS];
+
+in vec2 TexCoord;
+out vec4 fragColor;
+
+void main()
+{
+	//Fused color filters, applied in effect load order
+	
+	vec4 color = vec4(texture(FrameBuffer,TexCoord*FrameBufferScale).rgb,1.0);
+	for(int i = 0; i < filterAmount; ++i)
+		color = applyColorFilter(filterChain[i],color);
+	fragColor = color;
+}
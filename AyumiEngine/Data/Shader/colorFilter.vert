@@ -0,0 +1,13 @@
+#version 330
+
+uniform mat4 modelViewProjectionMatrix;
+uniform float TexCoordScale;
+in vec4 vertex;
+in vec2 texCoord;
+out vec2 TexCoord;
+
+void main()
+{
+	gl_Position = modelViewProjectionMatrix * vertex;
+	TexCoord = texCoord * TexCoordScale;
+}
\ No newline at end of file
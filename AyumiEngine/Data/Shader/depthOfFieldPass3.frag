@@ -2,6 +2,7 @@
 
 uniform samplerRect FrameBuffer;
 uniform samplerRect FrameBuffer2;
+uniform float FrameBuffer2Scale;
 
 in vec2 TexCoord;
 out vec4 fragColor;
@@ -28,7 +29,7 @@ void main()
 	c = vec4(0.0);
 
 											// sample 1
-	tapLow = texture(FrameBuffer2,p + poisson1 * discRadiusLow);
+	tapLow = texture(FrameBuffer2,(p + poisson1 * discRadiusLow) * FrameBuffer2Scale);
 	tapHigh = texture(FrameBuffer, p + poisson1 * discRadiusLow);
 	blur = tapHigh.a;
 	tap = mix(tapHigh, tapLow, blur);
@@ -39,7 +40,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 2
-	tapLow   = texture(FrameBuffer2, p + poisson2 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson2 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson2 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -50,7 +51,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 3
-	tapLow   = texture(FrameBuffer2, p + poisson3 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson3 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson3 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -61,7 +62,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 4
-	tapLow   = texture(FrameBuffer2, p + poisson4 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson4 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson4 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -72,7 +73,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 5
-	tapLow   = texture(FrameBuffer2, p + poisson5 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson5 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson5 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -83,7 +84,7 @@ void main()
 	c.a   += tap.a;
 
 											// sample 6
-	tapLow   = texture(FrameBuffer2, p + poisson6 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson6 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson6 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -94,7 +95,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 7
-	tapLow   = texture(FrameBuffer2, p + poisson7 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson7 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson7 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
@@ -105,7 +106,7 @@ void main()
 	c.a   += tap.a;
 	
 											// sample 8
-	tapLow   = texture(FrameBuffer2, p + poisson8 * discRadiusLow );
+	tapLow   = texture(FrameBuffer2, (p + poisson8 * discRadiusLow) * FrameBuffer2Scale );
 	tapHigh  = texture(FrameBuffer,    p + poisson8 * discRadiusLow );
 	blur     = tapHigh.a;
 	tap      = mix ( tapHigh, tapLow, blur );
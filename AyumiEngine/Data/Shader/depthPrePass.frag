@@ -0,0 +1,9 @@
+// Depth only fragment shader of depth pre-pass. It is linked with vertex shader of material.
+// Author: Szymon "Veldrin" Jaboski
+// Date: 25.02.2012
+
+#version 330
+
+void main()
+{
+}
@@ -7,6 +7,7 @@ uniform float density;
 uniform float weight;
 uniform float lightPositionOnScreenX;
 uniform float lightPositionOnScreenY;
+uniform float TexCoordScale;
 
 in vec2 TexCoord;
 out vec4 fragColor;
@@ -15,7 +16,7 @@ const int NUM_SAMPLES = 100;
 
 void main()
 {
-	vec2 lightPos = vec2(lightPositionOnScreenX,lightPositionOnScreenY);
+	vec2 lightPos = vec2(lightPositionOnScreenX,lightPositionOnScreenY) * TexCoordScale;
 	
 	vec2 deltaTextCoord = vec2(TexCoord - lightPos.xy);	
 	vec2 textCoo = TexCoord;
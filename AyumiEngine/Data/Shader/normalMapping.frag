@@ -1,37 +1,9 @@
 #version 330
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 1
-#define POINT_NUM 1
+#define POINT_NUM 0
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct SpotLight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#define CLUSTERED_LIGHTING
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -45,9 +17,10 @@ uniform sampler2D ColorMapSampler;
 uniform sampler2D GlossMapSampler;
 uniform sampler2D NormalMapSampler;
 
-
+in vec3 VertexPos;
 in vec3 ViewDir;
 in vec2 TexCoord;
+in mat3 TangentMatrix;
 in vec3 dirLightDir[MAX_LIGHTS_NUM];
 in vec3 pointLightDir[MAX_LIGHTS_NUM];
 in vec3 spotLightDir[MAX_LIGHTS_NUM];
@@ -61,7 +34,8 @@ void main()
 	for(int i = 0; i < DIR_NUM; i++)
 	{
 		vec3 L = normalize(dirLightDir[i]);
-		vec3 N = normalize(texture(NormalMapSampler, TexCoord.st).xyz * 2.0 - 1.0);
+		vec2 normalXY = texture(NormalMapSampler, TexCoord.st).xy * 2.0 - 1.0;
+		vec3 N = vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
 		vec3 V = normalize(ViewDir);
 		vec3 R = normalize(-reflect(L, N));
 
@@ -76,5 +50,18 @@ void main()
 		
 		FragColor += (ambient + diffuse + (gloss * specular)) * texel;
 	}
+	
+	// Point and Spot Lights of fragment cluster, normal is transformed from tangent to view space
+	vec2 normalXY = texture(NormalMapSampler, TexCoord).xy * 2.0 - 1.0;
+	vec3 N = normalize(vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0))) * TangentMatrix);
+	vec3 V = normalize(-VertexPos);
+	vec4 texel = texture(ColorMapSampler, TexCoord);
+	float gloss = texture(GlossMapSampler, TexCoord).r;
+
+	vec4 ambient = vec4(0.0);
+	vec4 diffuse = vec4(0.0);
+	vec4 specular = vec4(0.0);
+	addClusterLights(VertexPos, N, V, material.shininess, ambient, diffuse, specular);
+	FragColor += (ambient * material.ambient + diffuse * material.diffuse + gloss * specular * material.specular) * texel;
 }
 
@@ -4,39 +4,11 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 1
-#define POINT_NUM 1
+#define POINT_NUM 0
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct SpotLight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#define CLUSTERED_LIGHTING
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -51,8 +23,10 @@ uniform sampler2D GlossMapSampler;
 uniform sampler2D NormalMapSampler;
 uniform sampler2D HeightMapSampler;
 
+in vec3 VertexPos;
 in vec3 ViewDir;
 in vec2 TexCoord;
+in mat3 TangentMatrix;
 in vec3 dirLightDir[MAX_LIGHTS_NUM];
 in vec3 pointLightDir[MAX_LIGHTS_NUM];
 in vec3 spotLightDir[MAX_LIGHTS_NUM];
@@ -73,7 +47,8 @@ void main()
 	
 		vec2 texCoord = TexCoord + (height * V.xy);
 	
-		vec3 N = normalize(texture(NormalMapSampler, texCoord.st).xyz * 2.0 - 1.0);
+		vec2 normalXY = texture(NormalMapSampler, texCoord.st).xy * 2.0 - 1.0;
+		vec3 N = vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
 		vec3 R = normalize(-reflect(L, N));
 
 		float nDotL = max(0.0, dot(N, L));
@@ -88,62 +63,18 @@ void main()
 		fragColor += (ambient + diffuse + specular) * texel;
 	}
 
-	// Point Lights
-	for(int i = 0; i < POINT_NUM; i++)
-	{
-		float atten = max(0.0, 1.0 - dot(pointLightDir[i], pointLightDir[i]));
-
-		vec3 L = normalize(pointLightDir[i]);
-		vec3 V = normalize(ViewDir);
-		
-		float height = texture(HeightMapSampler, TexCoord).r;
-		height = height * 0.04 + (-0.03);
-	
-		vec2 texCoord = TexCoord + (height * V.xy);
-	
-		vec3 N = normalize(texture(NormalMapSampler, texCoord.st).xyz * 2.0 - 1.0);
-		vec3 R = normalize(-reflect(L, N));
-
-		float nDotL = max(0.0, dot(N, L));
-		float rDotV = max(0.0, dot(R, V));
-	
-		vec4 ambient = pointLight[i].ambient * material.ambient * atten;
-		vec4 diffuse = pointLight[i].diffuse * material.diffuse * nDotL * atten;
-		vec4 specular = pointLight[i].specular * material.specular * pow(rDotV, material.shininess) * atten;
-		vec4 texel = texture(ColorMapSampler, texCoord);
-		float gloss = texture(GlossMapSampler, texCoord).r;
-		
-		fragColor += (ambient + diffuse + (gloss * specular)) * texel;
-	}
-	
-	// Spot Lights
-	for(int i = 0; i < SPOT_NUM; i++)
-	{
-		float atten = max(0.0, 1.0 - dot(spotLightDir[i], spotLightDir[i]));
-		vec3 L = normalize(spotLightDir[i]);
-		vec3 SL = normalize(spotDir[i]);
-		vec3 V = normalize(-ViewDir);
-		
-		float height = texture(HeightMapSampler, TexCoord).r;
-		height = height * 0.04 + (-0.03);
-		vec2 texCoord = TexCoord + (height * V.xy);
-		
-		vec3 N = normalize(texture(NormalMapSampler, texCoord.st).xyz * 2.0 - 1.0);
-		vec3 R = normalize(-reflect(L, N));
+	// Point and Spot Lights of fragment cluster, normal is transformed from tangent to view space
+	float height = texture(HeightMapSampler, TexCoord).r * 0.04 - 0.03;
+	vec2 texCoord = TexCoord + (height * normalize(ViewDir).xy);
+	vec2 normalXY = texture(NormalMapSampler, texCoord).xy * 2.0 - 1.0;
+	vec3 N = normalize(vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0))) * TangentMatrix);
+	vec3 V = normalize(-VertexPos);
+	vec4 texel = texture(ColorMapSampler, texCoord);
+	float gloss = texture(GlossMapSampler, texCoord).r;
 
-		float spotDot = dot(-L, SL);
-		float spotEffect = smoothstep(spotLight[i].cosOuterCone, spotLight[i].cosInnerCone, spotDot);
-		
-		atten *= spotEffect;
-		
-		float nDotL = max(0.0, dot(N, L));
-		float rDotV = max(0.0, dot(R, V));
-			
-		vec4 ambient = spotLight[i].ambient * material.ambient * atten;
-		vec4 diffuse = spotLight[i].diffuse * material.diffuse * nDotL * atten;
-		vec4 specular = spotLight[i].specular * material.specular * pow(rDotV, material.shininess) * atten;
-		vec4 texel = texture(ColorMapSampler, texCoord);
-		float gloss = texture(GlossMapSampler, texCoord).r;
-		fragColor = (ambient + diffuse + (gloss*specular)) * texel;
-	}
+	vec4 ambient = vec4(0.0);
+	vec4 diffuse = vec4(0.0);
+	vec4 specular = vec4(0.0);
+	addClusterLights(VertexPos, N, V, material.shininess, ambient, diffuse, specular);
+	fragColor += (ambient * material.ambient + diffuse * material.diffuse + gloss * specular * material.specular) * texel;
 }
@@ -4,39 +4,10 @@
 
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 1
-#define POINT_NUM 1
+#define POINT_NUM 0
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct SpotLight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -46,25 +17,24 @@ uniform struct Material
 	float shininess;
 } material;
 
-uniform mat4 modelViewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat3 normalMatrix;
-
 in vec4 vertex;
 in vec3 normal;
 in vec2 texCoord;
 in vec4 tangent;
 
+out vec3 VertexPos;
 out vec3 ViewDir;
 out vec2 TexCoord;
+out mat3 TangentMatrix;
 
 out vec3 dirLightDir[MAX_LIGHTS_NUM];
 out vec3 pointLightDir[MAX_LIGHTS_NUM];
 out vec3 spotLightDir[MAX_LIGHTS_NUM];
 out vec3 spotDir[MAX_LIGHTS_NUM];
 
+// Depth pre-pass uses this shader too, so both passes must compute equal depth.
+invariant gl_Position;
+
 void main()
 {
 	// TBN Matrix
@@ -82,6 +52,8 @@ void main()
     gl_Position = projectionMatrix*modelViewMatrix*pos;
     
     pos = modelViewMatrix * pos;
+	VertexPos = pos.xyz / pos.w;
+	TangentMatrix = tbnMatrix;
 	ViewDir = -(pos.xyz / pos.w);
 	ViewDir = tbnMatrix * ViewDir;
         	
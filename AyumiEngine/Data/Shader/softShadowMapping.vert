@@ -1,38 +1,9 @@
 #version 330
 
-#define MAX_LIGHTS_NUM 8
 #define DIR_NUM 0
-#define POINT_NUM 1
+#define POINT_NUM 0
 #define SPOT_NUM 0
-
-uniform struct DirectionalLight
-{
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} directionalLight[MAX_LIGHTS_NUM];
-
-uniform struct PointLight
-{
-	float radius;
-	vec3 position;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} pointLight[MAX_LIGHTS_NUM];
-
-uniform struct Spotlight
-{
-	float range;
-	float cosInnerCone;
-	float cosOuterCone;
-	vec3 position;
-	vec3 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-} spotLight[MAX_LIGHTS_NUM];
+#include "Include/frameData.glsl"
 
 uniform struct Material
 {
@@ -42,13 +13,6 @@ uniform struct Material
 	float shininess;
 } material;
 
-uniform mat4 modelViewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat3 normalMatrix;
-uniform mat4 shadowMatrix0;
-
 in vec4 vertex;
 in vec3 normal;
 in vec2 texCoord;
@@ -98,5 +62,5 @@ void main(void)
 
     Normal = normalMatrix * normal;
     TexCoord = texCoord;
-	projCoord = shadowMatrix0*modelViewMatrix*vertex;
+	projCoord = shadowMatrix[0]*modelViewMatrix*vertex;
 }
@@ -20,6 +20,7 @@ ShaderManager:registerResource("TextureMapping","VertexFragment","Data/Shader/te
 ShaderManager:registerResource("ShadowMapping","VertexFragment","Data/Shader/shadowMapping.vert","Data/Shader/shadowMapping.frag")
 
 ShaderManager:registerResource("SoftShadowMapping","VertexFragment","Data/Shader/softShadowMapping.vert","Data/Shader/softShadowMapping.frag")
+ShaderManager:registerResource("CascadedShadowMapping","VertexFragment","Data/Shader/cascadedShadowMapping.vert","Data/Shader/cascadedShadowMapping.frag")
 
 ShaderManager:registerResource("SmokeParticles","VertexGeometryFragment","Data/Shader/smokeParticles.vert","Data/Shader/smokeParticles.frag","Data/Shader/smokeParticles.geom")
 
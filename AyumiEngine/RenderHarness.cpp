@@ -0,0 +1,646 @@
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <boost/filesystem.hpp>
+
+#include "RenderHarness.hpp"
+
+using namespace std;
+using namespace boost;
+using namespace AyumiEngine;
+using namespace AyumiEngine::AyumiCore;
+using namespace AyumiEngine::AyumiRenderer;
+using namespace AyumiEngine::AyumiScene;
+using namespace AyumiEngine::AyumiMath;
+
+/**
+ * Class constructor with initialize parameters. Harness settings are default until script is executed.
+ * @param	scriptPath is path to harness Lua script.
+ */
+RenderHarness::RenderHarness(const string& scriptPath)
+{
+	this->scriptPath = scriptPath;
+	harnessScript = nullptr;
+	camera = nullptr;
+	configPath = "Data/Scripts/harnessConfig.lua";
+	goldenDirectory = "Data/Harness/Golden/";
+	outputDirectory = "Data/Harness/Output/";
+	reportPath = "Data/Harness/Output/report.json";
+	frameAmount = 100;
+	warmupFrames = 10;
+	captureInterval = 25;
+	currentFrame = 0;
+	nullBackendFrames = 0;
+	nullFrame = 0;
+	nullCpuTime = 0.0f;
+	nullBackend = nullptr;
+	pixelTolerance = 8.0f;
+	maxDifferentPixels = 0.01f;
+	updateGoldens = false;
+	isRunning = false;
+}
+
+/**
+ * Class destructor, free harness script.
+ */
+RenderHarness::~RenderHarness()
+{
+	delete harnessScript;
+}
+
+/**
+ * Method is used to run harness: execute harness script, start off-screen engine, create scene and render
+ * warm-up and measured frames. Streamed textures and pending shader programs are finished before first
+ * frame, so captured frames do not depend on loading time. Profiler return GPU times few frames later, so
+ * harness render additional frames after last measured one.
+ * @return	true if all compared frames match golden images and report was written.
+ */
+bool RenderHarness::runHarness()
+{
+	harnessScript = new AyumiScript(scriptPath.c_str());
+	prepareHarnessScript();
+	harnessScript->executeScript();
+	delete harnessScript;
+	harnessScript = nullptr;
+
+	boost::system::error_code error;
+	boost::filesystem::create_directories(outputDirectory,error);
+	boost::filesystem::create_directories(goldenDirectory,error);
+
+	EngineInterface::createEngine(configPath,false);
+	createScene();
+	updateCamera(0);
+	EngineInterface::finishResources();
+
+	currentFrame = 0;
+	samples.clear();
+	taskSamples.clear();
+	isRunning = cameraPath.size() > 0 && frameAmount > 0;
+	if(!isRunning)
+		Logger::getInstance()->saveLog(Log<string>("Render harness has no camera path or frames: " + scriptPath));
+
+	EngineInterface::addGameLoopTask("recordFrame",boost::bind(&RenderHarness::recordFrame,this));
+	EngineInterface::runGameLoop(&isRunning,false);
+
+	bool passed = writeReport();
+	for(vector<FrameSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+		passed = passed && (*it).passed;
+
+	EngineInterface::releaseEngine();
+	nullBackend = nullptr;
+	return passed;
+}
+
+/**
+ * Method is used to set engine configuration script. It should enable off-screen rendering.
+ * @param	path is configuration script path.
+ */
+void RenderHarness::setConfigPath(const string& path)
+{
+	configPath = path;
+}
+
+/**
+ * Method is used to set amount of measured frames.
+ * @param	frames is amount of frames.
+ */
+void RenderHarness::setFrameAmount(const int frames)
+{
+	frameAmount = frames;
+}
+
+/**
+ * Method is used to set amount of frames rendered before measurement, e.g. to fill caches and upload textures.
+ * @param	frames is amount of frames.
+ */
+void RenderHarness::setWarmupFrames(const int frames)
+{
+	warmupFrames = frames;
+}
+
+/**
+ * Method is used to set interval of captured frames. Zero disables capturing.
+ * @param	interval is amount of frames between captures.
+ */
+void RenderHarness::setCaptureInterval(const int interval)
+{
+	captureInterval = interval;
+}
+
+/**
+ * Method is used to set amount of frames rendered on NullRenderBackend after measured frames. Zero disables
+ * null backend benchmark.
+ * @param	frames is amount of frames.
+ */
+void RenderHarness::setNullBackendFrames(const int frames)
+{
+	nullBackendFrames = frames;
+}
+
+/**
+ * Method is used to set directory with golden images. It must end with separator.
+ * @param	directory is golden images directory.
+ */
+void RenderHarness::setGoldenDirectory(const string& directory)
+{
+	goldenDirectory = directory;
+}
+
+/**
+ * Method is used to set directory of captured images. It must end with separator.
+ * @param	directory is captured images directory.
+ */
+void RenderHarness::setOutputDirectory(const string& directory)
+{
+	outputDirectory = directory;
+}
+
+/**
+ * Method is used to set path of JSON report.
+ * @param	path is report path.
+ */
+void RenderHarness::setReportPath(const string& path)
+{
+	reportPath = path;
+}
+
+/**
+ * Method is used to set image comparison tolerance.
+ * @param	pixelTolerance is maximum difference of pixel channel which is not counted as difference.
+ * @param	maxDifferentPixels is maximum ratio of different pixels in passed frame.
+ */
+void RenderHarness::setTolerance(const float pixelTolerance, const float maxDifferentPixels)
+{
+	this->pixelTolerance = pixelTolerance;
+	this->maxDifferentPixels = maxDifferentPixels;
+}
+
+/**
+ * Method is used to enable writing captured frames as golden images when golden image does not exist. It is
+ * not available in harness script, golden images are updated only by --update-goldens command line option.
+ * @param	update is golden images update flag.
+ */
+void RenderHarness::setUpdateGoldens(const bool update)
+{
+	updateGoldens = update;
+}
+
+/**
+ * Method is used to add render task to engine render queue.
+ * @param	task is render task name.
+ */
+void RenderHarness::addRenderTask(const string& task)
+{
+	renderTasks.push_back(task);
+}
+
+/**
+ * Method is used to declare scene entity.
+ * @param	name is entity name.
+ * @param	mesh is entity mesh resource name.
+ * @param	material is entity material name.
+ * @param	x is entity position x value.
+ * @param	y is entity position y value.
+ * @param	z is entity position z value.
+ * @param	scale is entity uniform scale.
+ */
+void RenderHarness::addEntity(const string& name, const string& mesh, const string& material, const float x, const float y, const float z, const float scale)
+{
+	HarnessEntity entity;
+	entity.name = name;
+	entity.mesh = mesh;
+	entity.material = material;
+	entity.position.set(x,y,z);
+	entity.scale = scale;
+	entity.independent = false;
+	entities.push_back(entity);
+}
+
+/**
+ * Method is used to declare independent scene entity like sky or terrain.
+ * @param	name is entity name.
+ * @param	mesh is entity mesh resource name.
+ * @param	material is entity material name.
+ * @param	x is entity position x value.
+ * @param	y is entity position y value.
+ * @param	z is entity position z value.
+ * @param	scale is entity uniform scale.
+ */
+void RenderHarness::addIndependent(const string& name, const string& mesh, const string& material, const float x, const float y, const float z, const float scale)
+{
+	addEntity(name,mesh,material,x,y,z,scale);
+	entities.back().independent = true;
+}
+
+/**
+ * Method is used to add camera path key. Camera moves linearly between following keys.
+ * @param	x is camera position x value.
+ * @param	y is camera position y value.
+ * @param	z is camera position z value.
+ * @param	pitch is camera rotation around x axis in degrees.
+ * @param	yaw is camera rotation around y axis in degrees.
+ * @param	roll is camera rotation around z axis in degrees.
+ */
+void RenderHarness::addCameraKey(const float x, const float y, const float z, const float pitch, const float yaw, const float roll)
+{
+	CameraKey key;
+	key.position.set(x,y,z);
+	key.rotation.set(pitch,yaw,roll);
+	cameraPath.push_back(key);
+}
+
+/**
+ * Private method which is used to register harness API in harness script.
+ */
+void RenderHarness::prepareHarnessScript()
+{
+	luabind::module(harnessScript->getVirtualMachine())
+	[
+		luabind::class_<RenderHarness>("RenderHarness")
+		.def("setConfigPath",&RenderHarness::setConfigPath)
+		.def("setFrameAmount",&RenderHarness::setFrameAmount)
+		.def("setWarmupFrames",&RenderHarness::setWarmupFrames)
+		.def("setCaptureInterval",&RenderHarness::setCaptureInterval)
+		.def("setNullBackendFrames",&RenderHarness::setNullBackendFrames)
+		.def("setGoldenDirectory",&RenderHarness::setGoldenDirectory)
+		.def("setOutputDirectory",&RenderHarness::setOutputDirectory)
+		.def("setReportPath",&RenderHarness::setReportPath)
+		.def("setTolerance",&RenderHarness::setTolerance)
+		.def("addRenderTask",&RenderHarness::addRenderTask)
+		.def("addEntity",&RenderHarness::addEntity)
+		.def("addIndependent",&RenderHarness::addIndependent)
+		.def("addCameraKey",&RenderHarness::addCameraKey)
+	];
+
+	luabind::globals(harnessScript->getVirtualMachine())["Harness"] = this;
+}
+
+/**
+ * Private method which is used to create declared entities, render tasks and harness camera.
+ */
+void RenderHarness::createScene()
+{
+	for(vector<string>::const_iterator it = renderTasks.begin(); it != renderTasks.end(); ++it)
+		EngineInterface::addRenderTask(*it);
+
+	for(vector<HarnessEntity>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+	{
+		SceneEntity* entity = new SceneEntity((*it).name,(*it).mesh,(*it).material);
+		entity->initializeSceneEntity();
+		entity->setEntityPosition((*it).position.x(),(*it).position.y(),(*it).position.z());
+		entity->setEntityScale((*it).scale,(*it).scale,(*it).scale);
+		if((*it).independent)
+			EngineInterface::addIndependentToScene(entity);
+		else
+			EngineInterface::addEntityToScene(entity);
+	}
+
+	camera = new StaticCamera();
+	EngineInterface::addSceneCamera(camera);
+}
+
+/**
+ * Private method which is used to move camera to path position of frame. Path is sampled by frame index,
+ * not by elapsed time, so each run render the same views.
+ * @param	frame is index of measured frame, warm-up frames use first key.
+ */
+void RenderHarness::updateCamera(const int frame)
+{
+	if(cameraPath.empty())
+		return;
+
+	float pathPosition = 0.0f;
+	if(frame > 0 && frameAmount > 1)
+		pathPosition = static_cast<float>(min(frame,frameAmount - 1))/(frameAmount - 1)*(cameraPath.size() - 1);
+	const unsigned int key = min(static_cast<unsigned int>(pathPosition),static_cast<unsigned int>(cameraPath.size() - 1));
+	const unsigned int nextKey = min(key + 1,static_cast<unsigned int>(cameraPath.size() - 1));
+	const float weight = pathPosition - key;
+
+	const Vector3D position = cameraPath[key].position*(1.0f - weight) + cameraPath[nextKey].position*weight;
+	const Vector3D rotation = cameraPath[key].rotation*(1.0f - weight) + cameraPath[nextKey].rotation*weight;
+	camera->setPosition(position.x(),position.y(),position.z());
+	camera->setRotation(rotation.x(),rotation.y(),rotation.z());
+}
+
+/**
+ * Private method which is game loop task called after each rendered frame. It records CPU time of frame,
+ * GPU time of frame rendered PROFILER_FRAME_LATENCY frames earlier and captures frame image, then moves
+ * camera to next path position. Frames rendered on null backend are recorded separately.
+ */
+void RenderHarness::recordFrame()
+{
+	if(nullBackend != nullptr)
+	{
+		recordNullFrame();
+		return;
+	}
+
+	const int frame = currentFrame - warmupFrames;
+	++currentFrame;
+
+	const int gpuFrame = frame - static_cast<int>(PROFILER_FRAME_LATENCY);
+	if(gpuFrame >= 0 && gpuFrame < static_cast<int>(samples.size()))
+		samples[gpuFrame].gpuTime = EngineInterface::getFrameGpuTime();
+
+	if(frame >= 0 && frame < frameAmount)
+	{
+		FrameSample sample;
+		sample.frame = frame;
+		sample.cpuTime = EngineInterface::getFrameCpuTime();
+		sample.gpuTime = 0.0f;
+		sample.issuedStateCalls = EngineInterface::getStateStatistics().issuedCalls;
+		sample.filteredStateCalls = EngineInterface::getStateStatistics().filteredCalls;
+		sample.uniformCalls = EngineInterface::getUniformStatistics().uniformCalls;
+		sample.avoidedUniformCalls = EngineInterface::getUniformStatistics().avoidedCalls;
+		sample.missingUniformCalls = EngineInterface::getUniformStatistics().missingCalls;
+		sample.captured = captureInterval > 0 && frame%captureInterval == 0;
+		sample.compared = false;
+		sample.rootMeanSquare = 0.0f;
+		sample.differentPixels = 0.0f;
+		sample.passed = true;
+
+		if(sample.captured)
+		{
+			vector<unsigned char> pixels;
+			EngineInterface::captureFrame(pixels);
+			writeImage(outputDirectory + getFrameName(frame),pixels);
+			compareFrame(pixels,sample);
+		}
+		samples.push_back(sample);
+
+		const TaskTimings& timings = EngineInterface::getRenderTimings();
+		for(TaskTimings::const_iterator it = timings.begin(); it != timings.end(); ++it)
+		{
+			TaskSample& taskSample = taskSamples[(*it).name];
+			taskSample.cpuTime += (*it).cpuTime;
+			taskSample.gpuTime += (*it).gpuTime;
+			taskSample.frames++;
+		}
+	}
+
+	if(frame + 1 >= frameAmount + static_cast<int>(PROFILER_FRAME_LATENCY))
+	{
+		if(nullBackendFrames > 0)
+			startNullBackend();
+		else
+			isRunning = false;
+	}
+	else
+		updateCamera(frame + 1);
+}
+
+/**
+ * Private method which is used to replace engine render backend by NullRenderBackend. Renderer takes
+ * ownership of backend, so it is deleted with engine. Camera path is replayed from first key.
+ */
+void RenderHarness::startNullBackend()
+{
+	nullBackend = new NullRenderBackend();
+	EngineInterface::setRenderBackend(nullBackend);
+	nullFrame = 0;
+	nullCpuTime = 0.0f;
+	updateCamera(0);
+}
+
+/**
+ * Private method which is used to record CPU time of frame rendered on null backend. Null frames sample
+ * whole camera path.
+ */
+void RenderHarness::recordNullFrame()
+{
+	nullCpuTime += EngineInterface::getFrameCpuTime();
+	if(++nullFrame >= nullBackendFrames)
+		isRunning = false;
+	else
+		updateCamera(nullFrame*frameAmount/nullBackendFrames);
+}
+
+/**
+ * Private method which is used to compare captured frame with golden image. Missing golden image is written
+ * from captured frame if golden update is enabled, otherwise frame fails.
+ * @param	pixels is reference to captured RGBA pixels.
+ * @param	sample is reference to frame sample which store comparison result.
+ */
+void RenderHarness::compareFrame(const vector<unsigned char>& pixels, FrameSample& sample) const
+{
+	const string goldenPath = goldenDirectory + getFrameName(sample.frame);
+	vector<unsigned char> golden;
+	if(!readImage(goldenPath,golden))
+	{
+		if(updateGoldens)
+			writeImage(goldenPath,pixels);
+		else
+		{
+			Logger::getInstance()->saveLog(Log<string>("Render harness golden image is missing: " + goldenPath));
+			sample.passed = false;
+		}
+		return;
+	}
+
+	sample.compared = true;
+	const unsigned int pixelAmount = pixels.size()/4;
+	if(golden.size() != pixelAmount*3)
+	{
+		Logger::getInstance()->saveLog(Log<string>("Render harness golden image size mismatch: " + goldenPath));
+		sample.differentPixels = 1.0f;
+		sample.passed = false;
+		return;
+	}
+
+	const int width = Configuration::getInstance()->getResolutionWidth();
+	const int height = Configuration::getInstance()->getResolutionHeight();
+	double squareError = 0.0;
+	unsigned int differentPixels = 0;
+	for(int y = 0; y < height; ++y)
+	{
+		for(int x = 0; x < width; ++x)
+		{
+			const unsigned char* captured = &pixels[((height - 1 - y)*width + x)*4];
+			const unsigned char* expected = &golden[(y*width + x)*3];
+			int maxDifference = 0;
+			for(int i = 0; i < 3; ++i)
+			{
+				const int difference = abs(static_cast<int>(captured[i]) - static_cast<int>(expected[i]));
+				maxDifference = max(maxDifference,difference);
+				squareError += difference*difference;
+			}
+			if(maxDifference > pixelTolerance)
+				++differentPixels;
+		}
+	}
+
+	sample.rootMeanSquare = static_cast<float>(sqrt(squareError/(pixelAmount*3)));
+	sample.differentPixels = static_cast<float>(differentPixels)/pixelAmount;
+	sample.passed = sample.differentPixels <= maxDifferentPixels;
+}
+
+/**
+ * Private method which is used to read binary PPM image. Rows are stored top-down as RGB bytes.
+ * @param	path is image path.
+ * @param	pixels is reference to vector which store read pixels.
+ * @return	true if image was read.
+ */
+bool RenderHarness::readImage(const string& path, vector<unsigned char>& pixels) const
+{
+	ifstream image(path.c_str(),ios::in | ios::binary);
+	if(!image.is_open())
+		return false;
+
+	string magic;
+	int width = 0;
+	int height = 0;
+	int maxValue = 0;
+	image >> magic >> width >> height >> maxValue;
+	image.get();
+	if(!image || magic != "P6" || maxValue != 255 || width <= 0 || height <= 0)
+		return false;
+
+	pixels.resize(width*height*3);
+	image.read(reinterpret_cast<char*>(&pixels[0]),pixels.size());
+	return !image.fail();
+}
+
+/**
+ * Private method which is used to write captured frame as binary PPM image. Captured rows are bottom-up,
+ * so they are flipped.
+ * @param	path is image path.
+ * @param	pixels is reference to captured RGBA pixels.
+ * @return	true if image was written.
+ */
+bool RenderHarness::writeImage(const string& path, const vector<unsigned char>& pixels) const
+{
+	ofstream image(path.c_str(),ios::out | ios::binary | ios::trunc);
+	if(!image.is_open())
+	{
+		Logger::getInstance()->saveLog(Log<string>("Render harness image writing error occurred: " + path));
+		return false;
+	}
+
+	const int width = Configuration::getInstance()->getResolutionWidth();
+	const int height = Configuration::getInstance()->getResolutionHeight();
+	image << "P6\n" << width << " " << height << "\n255\n";
+	vector<unsigned char> row(width*3);
+	for(int y = height - 1; y >= 0; --y)
+	{
+		for(int x = 0; x < width; ++x)
+			for(int i = 0; i < 3; ++i)
+				row[x*3 + i] = pixels[(y*width + x)*4 + i];
+		image.write(reinterpret_cast<const char*>(&row[0]),row.size());
+	}
+	return image.good();
+}
+
+/**
+ * Private method which is used to get image file name of frame.
+ * @param	frame is index of measured frame.
+ * @return	image file name.
+ */
+string RenderHarness::getFrameName(const int frame) const
+{
+	ostringstream name;
+	name << "frame" << setw(4) << setfill('0') << frame << ".ppm";
+	return name.str();
+}
+
+/**
+ * Private method which is used to write JSON performance report. Report store average and maximum frame
+ * times, shader loading statistics, average times of each render task, per frame command statistics of null backend frames and all
+ * frame samples with image comparison results.
+ * @return	true if report was written.
+ */
+bool RenderHarness::writeReport() const
+{
+	ofstream report(reportPath.c_str(),ios::out | ios::trunc);
+	if(!report.is_open())
+	{
+		Logger::getInstance()->saveLog(Log<string>("Render harness report writing error occurred: " + reportPath));
+		return false;
+	}
+
+	float cpuTime = 0.0f;
+	float gpuTime = 0.0f;
+	float maxCpuTime = 0.0f;
+	float maxGpuTime = 0.0f;
+	float issuedStateCalls = 0.0f;
+	float filteredStateCalls = 0.0f;
+	float uniformCalls = 0.0f;
+	float avoidedUniformCalls = 0.0f;
+	float missingUniformCalls = 0.0f;
+	bool passed = true;
+	for(vector<FrameSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+	{
+		cpuTime += (*it).cpuTime;
+		gpuTime += (*it).gpuTime;
+		maxCpuTime = max(maxCpuTime,(*it).cpuTime);
+		maxGpuTime = max(maxGpuTime,(*it).gpuTime);
+		issuedStateCalls += (*it).issuedStateCalls;
+		filteredStateCalls += (*it).filteredStateCalls;
+		uniformCalls += (*it).uniformCalls;
+		avoidedUniformCalls += (*it).avoidedUniformCalls;
+		missingUniformCalls += (*it).missingUniformCalls;
+		passed = passed && (*it).passed;
+	}
+	const float frames = samples.empty() ? 1.0f : static_cast<float>(samples.size());
+
+	report << fixed << setprecision(4);
+	report << "{\n";
+	report << "\t\"script\": \"" << scriptPath << "\",\n";
+	report << "\t\"width\": " << Configuration::getInstance()->getResolutionWidth() << ",\n";
+	report << "\t\"height\": " << Configuration::getInstance()->getResolutionHeight() << ",\n";
+	report << "\t\"frames\": " << samples.size() << ",\n";
+	report << "\t\"passed\": " << (passed ? "true" : "false") << ",\n";
+	report << "\t\"averageCpuTime\": " << cpuTime/frames << ",\n";
+	report << "\t\"averageGpuTime\": " << gpuTime/frames << ",\n";
+	report << "\t\"maxCpuTime\": " << maxCpuTime << ",\n";
+	report << "\t\"maxGpuTime\": " << maxGpuTime << ",\n";
+	report << "\t\"stateCalls\": {\"issued\": " << issuedStateCalls/frames << ", \"filtered\": " << filteredStateCalls/frames << "},\n";
+	report << "\t\"uniformCalls\": {\"calls\": " << uniformCalls/frames << ", \"avoided\": " << avoidedUniformCalls/frames << ", \"missing\": " << missingUniformCalls/frames << "},\n";
+	const DepthPrePassStatistics& prePass = EngineInterface::getDepthPrePassStatistics();
+	report << "\t\"depthPrePass\": {\"enabled\": " << (Configuration::getInstance()->isDepthPrePassEnabled() ? "true" : "false");
+	report << ", \"entities\": " << prePass.prePassEntities << ", \"pipelineStatistics\": " << (prePass.pipelineStatistics ? "true" : "false");
+	report << ", \"prePassFragments\": " << prePass.prePassFragments << ", \"mainPassFragments\": " << prePass.mainPassFragments;
+	report << ", \"baselineFragments\": " << prePass.baselineFragments << ", \"savedFragments\": " << prePass.savedFragments << "},\n";
+	const AyumiResource::ShaderLoadingStatistics& shaderLoading = EngineInterface::getShaderLoadingStatistics();
+	report << "\t\"shaderLoading\": {\"cachedPrograms\": " << shaderLoading.cachedPrograms << ", \"compiledPrograms\": " << shaderLoading.compiledPrograms;
+	report << ", \"failedPrograms\": " << shaderLoading.failedPrograms << ", \"loadingTime\": " << shaderLoading.loadingTime*1000.0f << "},\n";
+	if(nullBackend != nullptr)
+	{
+		const RenderBackendStatistics& statistics = nullBackend->getStatistics();
+		const float nullFrames = static_cast<float>(max(1,nullFrame));
+		report << "\t\"nullBackend\": {\"frames\": " << nullFrame << ", \"averageCpuTime\": " << nullCpuTime/nullFrames;
+		report << ", \"drawCalls\": " << statistics.drawCalls/nullFrames << ", \"instances\": " << statistics.instances/nullFrames;
+		report << ", \"primitives\": " << statistics.primitives/nullFrames << ", \"shaderChanges\": " << statistics.shaderChanges/nullFrames;
+		report << ", \"vertexArrayChanges\": " << statistics.vertexArrayChanges/nullFrames << ", \"textureBindings\": " << statistics.textureBindings/nullFrames;
+		report << ", \"uniformValues\": " << statistics.uniformValues/nullFrames << ", \"bufferUploads\": " << statistics.bufferUploads/nullFrames;
+		report << ", \"uploadedBytes\": " << statistics.uploadedBytes/nullFrames << "},\n";
+	}
+	report << "\t\"tasks\": [";
+	for(map<string,TaskSample>::const_iterator it = taskSamples.begin(); it != taskSamples.end(); ++it)
+	{
+		const float taskFrames = static_cast<float>(max(1,it->second.frames));
+		report << (it == taskSamples.begin() ? "\n" : ",\n");
+		report << "\t\t{\"name\": \"" << it->first << "\", \"cpuTime\": " << it->second.cpuTime/taskFrames << ", \"gpuTime\": " << it->second.gpuTime/taskFrames << "}";
+	}
+	report << "\n\t],\n";
+	report << "\t\"samples\": [";
+	for(vector<FrameSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+	{
+		report << (it == samples.begin() ? "\n" : ",\n");
+		report << "\t\t{\"frame\": " << (*it).frame << ", \"cpuTime\": " << (*it).cpuTime << ", \"gpuTime\": " << (*it).gpuTime;
+		report << ", \"issuedStateCalls\": " << (*it).issuedStateCalls << ", \"filteredStateCalls\": " << (*it).filteredStateCalls;
+		report << ", \"uniformCalls\": " << (*it).uniformCalls << ", \"avoidedUniformCalls\": " << (*it).avoidedUniformCalls << ", \"missingUniformCalls\": " << (*it).missingUniformCalls;
+		if((*it).captured)
+		{
+			report << ", \"image\": \"" << getFrameName((*it).frame) << "\", \"compared\": " << ((*it).compared ? "true" : "false");
+			report << ", \"rootMeanSquare\": " << (*it).rootMeanSquare << ", \"differentPixels\": " << (*it).differentPixels;
+			report << ", \"passed\": " << ((*it).passed ? "true" : "false");
+		}
+		report << "}";
+	}
+	report << "\n\t]\n";
+	report << "}\n";
+	return report.good();
+}
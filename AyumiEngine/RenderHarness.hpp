@@ -0,0 +1,136 @@
+#ifndef RENDERHARNESS_HPP
+#define RENDERHARNESS_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AyumiEngine/EngineInterface.hpp"
+
+/**
+ * Structure represents key of scripted camera path - camera position and rotation in degrees.
+ */
+struct CameraKey
+{
+	AyumiEngine::AyumiMath::Vector3D position;
+	AyumiEngine::AyumiMath::Vector3D rotation;
+};
+
+/**
+ * Structure represents scene entity declared by harness script. Entities are created after engine start.
+ */
+struct HarnessEntity
+{
+	std::string name;
+	std::string mesh;
+	std::string material;
+	AyumiEngine::AyumiMath::Vector3D position;
+	float scale;
+	bool independent;
+};
+
+/**
+ * Structure represents measured frame of harness run. GPU time is zero when timer queries are not supported.
+ * State calls are StateMachine requests which reached OpenGL or were filtered as redundant. Uniform calls
+ * are shader uniform sets, avoided ones had unchanged value and missing ones are not active in program.
+ */
+struct FrameSample
+{
+	int frame;
+	float cpuTime;
+	float gpuTime;
+	unsigned int issuedStateCalls;
+	unsigned int filteredStateCalls;
+	unsigned int uniformCalls;
+	unsigned int avoidedUniformCalls;
+	unsigned int missingUniformCalls;
+	bool captured;
+	bool compared;
+	float rootMeanSquare;
+	float differentPixels;
+	bool passed;
+};
+
+/**
+ * Structure represents per task timing sums of harness run.
+ */
+struct TaskSample
+{
+	float cpuTime;
+	float gpuTime;
+	int frames;
+};
+
+/**
+ * Class represents off-screen render regression and performance harness. Harness script declares engine
+ * configuration, scene entities, render tasks and camera path. Engine is started without window, camera
+ * flies along the path with fixed step per frame, frames are captured into PPM images and compared with
+ * golden images with per channel tolerance. After measured frames camera path can be replayed on
+ * NullRenderBackend, which skips command execution, so CPU cost of scene traversal and command recording is
+ * measured apart from driver. CPU and GPU times of frames and render tasks and null backend command statistics
+ * are written into JSON report which can be tracked across builds. Harness is started by --harness command
+ * line option, process exit code is 0 when all frames passed.
+ */
+class RenderHarness
+{
+private:
+	AyumiEngine::AyumiScript* harnessScript;
+	AyumiEngine::AyumiScene::StaticCamera* camera;
+	std::string scriptPath;
+	std::string configPath;
+	std::string goldenDirectory;
+	std::string outputDirectory;
+	std::string reportPath;
+	std::vector<std::string> renderTasks;
+	std::vector<HarnessEntity> entities;
+	std::vector<CameraKey> cameraPath;
+	std::vector<FrameSample> samples;
+	std::map<std::string,TaskSample> taskSamples;
+	int frameAmount;
+	int warmupFrames;
+	int captureInterval;
+	int currentFrame;
+	int nullBackendFrames;
+	int nullFrame;
+	float nullCpuTime;
+	AyumiEngine::AyumiRenderer::NullRenderBackend* nullBackend;
+	float pixelTolerance;
+	float maxDifferentPixels;
+	bool updateGoldens;
+	bool isRunning;
+
+	void prepareHarnessScript();
+	void createScene();
+	void updateCamera(const int frame);
+	void recordFrame();
+	void startNullBackend();
+	void recordNullFrame();
+	void compareFrame(const std::vector<unsigned char>& pixels, FrameSample& sample) const;
+	bool readImage(const std::string& path, std::vector<unsigned char>& pixels) const;
+	bool writeImage(const std::string& path, const std::vector<unsigned char>& pixels) const;
+	std::string getFrameName(const int frame) const;
+	bool writeReport() const;
+
+public:
+	RenderHarness(const std::string& scriptPath);
+	~RenderHarness();
+
+	bool runHarness();
+
+	void setConfigPath(const std::string& path);
+	void setFrameAmount(const int frames);
+	void setWarmupFrames(const int frames);
+	void setCaptureInterval(const int interval);
+	void setNullBackendFrames(const int frames);
+	void setGoldenDirectory(const std::string& directory);
+	void setOutputDirectory(const std::string& directory);
+	void setReportPath(const std::string& path);
+	void setTolerance(const float pixelTolerance, const float maxDifferentPixels);
+	void setUpdateGoldens(const bool update);
+	void addRenderTask(const std::string& task);
+	void addEntity(const std::string& name, const std::string& mesh, const std::string& material, const float x, const float y, const float z, const float scale);
+	void addIndependent(const std::string& name, const std::string& mesh, const std::string& material, const float x, const float y, const float z, const float scale);
+	void addCameraKey(const float x, const float y, const float z, const float pitch, const float yaw, const float roll);
+};
+
+#endif
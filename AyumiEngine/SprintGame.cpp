@@ -46,6 +46,7 @@ void SprintGame::updateSunLight() {
 
 		light->radius = max(0.0f,7500.0f+cos(CommonMath::PI*sunTimeAccumulator)*lightRadius);
 	}
+	EngineInterface::updateCascadeSource(-normalize(EngineInterface::getPointLight(0)->position));
 }
 
 void SprintGame::updateONeil(EntityMaterial* material, const float deltaTime) {
@@ -114,7 +115,7 @@ void SprintGame::initGame()
 	EngineInterface::updateEffects("Data/SprintGame/gameEffects.lua");
 	EngineInterface::addRenderTask("renderParticles");
 	EngineInterface::addRenderTask("renderSprites");
-	EngineInterface::addRenderTask("renderShadows");
+	EngineInterface::addRenderTask("renderCascadedShadows");
 	EngineInterface::addGameLoopTask("ScoreUpdate",boost::bind(&SprintGame::updateScore,this));
 
 	camera = new FirstPersonCamera(Vector3D(0.0f,1.75f,1.0f),Vector3D(10.0f,0.0f,0.0f));
@@ -154,6 +155,7 @@ void SprintGame::initGame()
 		SceneEntity* c = new SceneEntity("Course"+i,"Course1","Course");
 		c->initializeSceneEntity();
 		c->entityPhysics.isKinematic = false;
+		c->entityState.isStatic = true;
 		c->setEntityPosition(0.0f,1.0f,-i*4.0f);
 		c->setEntityOrientation(-90.0f,0.0f,0.0f);
 		c->setEntityScale(4.0f,2.0f,2.0f);
@@ -184,6 +186,7 @@ void SprintGame::initGame()
 		EngineInterface::addCollisionCallback(name,"Vehicle",boost::bind(&SprintGame::collisionCallback,this));
 	}
 
+	EngineInterface::bakeStaticBatch(64.0f);
 	EngineInterface::addStaticActor(nullptr,PLANE,0,0);
 	EngineInterface::connectKeyboardAction(Escape,boost::bind(&SprintGame::exitGame,this));
 	EngineInterface::connectKeyboardAction(W,boost::bind(&SprintGame::accelerate,this));
@@ -210,7 +213,6 @@ void SprintGame::initGame()
 	moveDirection.set(0.0f,0.0f,0.0f);
 	disturbance.set(CommonMath::random(-0.2f,0.2f),CommonMath::random(-0.2f,0.2f),CommonMath::random(-0.2f,0.2f));
 	resistance.set(0.01f,0.01f,0.01f);
-	EngineInterface::updateShadowSource(0,Vector3D(0.0,10.0f,0.0f),Vector3D(90.0f,0.0f,0.0f));
 }
 
 void SprintGame::gameState()
@@ -341,9 +343,6 @@ void SprintGame::updateScore()
     ostringstream ss;
     ss << fixed << setprecision(2) << score;
 	EngineInterface::updateText("Score",ss.str());
-	Vector3D position = vehicle->entityState.position;
-	position += Vector3D(0.0f,5.0f,0.0f);
-	EngineInterface::updateShadowSource(0,position,Vector3D(90.0f,0.0f,0.0f));
 }
 
 void SprintGame::initEngineParticle(ParticleEmiter* emiter)
@@ -355,33 +354,6 @@ void SprintGame::updateEngineParticle(ParticleEmiter* emiter, const float elapse
 {
 	emiter->origin = vehicle->entityState.position;
 	emiter->origin += Vector3D(-0.16f,-0.03f,0.13f);
-	for(int i = 0; i < emiter->particleAmount; i++)
-	{
-		emiter->particles[i].lifeTime -= elapsedTime;
-		if(emiter->particles[i].lifeTime < 0.0f)
-		{
-			emiter->particles[i].lifeTime = 1.0f;
-			emiter->particles[i].position[0] = 0.0f;
-			emiter->particles[i].position[1] = 0.0f;
-			emiter->particles[i].position[2] = 0.0f;
-			emiter->particles[i].color[3] = 0.0f;
-			emiter->particles[i].velocity[2] = 0.0f;
-
-			emiter->particles[i].velocity[0] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[1] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[2] = CommonMath::random(0.0f,0.06f);
-		}
-		else
-		{
-			emiter->particles[i].color[3] += elapsedTime/5;
-			emiter->particles[i].position[0] += emiter->particles[i].velocity[0] * elapsedTime;
-			emiter->particles[i].position[1] += emiter->particles[i].velocity[1] * elapsedTime;
-			emiter->particles[i].position[2] += emiter->particles[i].velocity[2] * elapsedTime;
-		}
-		emiter->points[i].x = emiter->particles[i].position[0];
-		emiter->points[i].y = emiter->particles[i].position[1];
-		emiter->points[i].z = emiter->particles[i].position[2];
-	}
 }
 
 void SprintGame::initEngineParticle2(ParticleEmiter* emiter)
@@ -393,33 +365,6 @@ void SprintGame::updateEngineParticle2(ParticleEmiter* emiter, const float elaps
 {
 	emiter->origin = vehicle->entityState.position;
 	emiter->origin += Vector3D(-0.10f,-0.03f,0.13f);
-	for(int i = 0; i < emiter->particleAmount; i++)
-	{
-		emiter->particles[i].lifeTime -= elapsedTime;
-		if(emiter->particles[i].lifeTime < 0.0f)
-		{
-			emiter->particles[i].lifeTime = 1.0f;
-			emiter->particles[i].position[0] = 0.0f;
-			emiter->particles[i].position[1] = 0.0f;
-			emiter->particles[i].position[2] = 0.0f;
-			emiter->particles[i].color[3] = 0.0f;
-			emiter->particles[i].velocity[2] = 0.0f;
-
-			emiter->particles[i].velocity[0] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[1] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[2] = CommonMath::random(0.0f,0.06f);
-		}
-		else
-		{
-			emiter->particles[i].color[3] += elapsedTime/5;
-			emiter->particles[i].position[0] += emiter->particles[i].velocity[0] * elapsedTime;
-			emiter->particles[i].position[1] += emiter->particles[i].velocity[1] * elapsedTime;
-			emiter->particles[i].position[2] += emiter->particles[i].velocity[2] * elapsedTime;
-		}
-		emiter->points[i].x = emiter->particles[i].position[0];
-		emiter->points[i].y = emiter->particles[i].position[1];
-		emiter->points[i].z = emiter->particles[i].position[2];
-	}
 }
 
 void SprintGame::initEngineParticle3(ParticleEmiter* emiter)
@@ -431,33 +376,6 @@ void SprintGame::updateEngineParticle3(ParticleEmiter* emiter, const float elaps
 {
 	emiter->origin = vehicle->entityState.position;
 	emiter->origin += Vector3D(0.10f,-0.03f,0.13f);
-	for(int i = 0; i < emiter->particleAmount; i++)
-	{
-		emiter->particles[i].lifeTime -= elapsedTime;
-		if(emiter->particles[i].lifeTime < 0.0f)
-		{
-			emiter->particles[i].lifeTime = 1.0f;
-			emiter->particles[i].position[0] = 0.0f;
-			emiter->particles[i].position[1] = 0.0f;
-			emiter->particles[i].position[2] = 0.0f;
-			emiter->particles[i].color[3] = 0.0f;
-			emiter->particles[i].velocity[2] = 0.0f;
-
-			emiter->particles[i].velocity[0] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[1] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[2] = CommonMath::random(0.0f,0.06f);
-		}
-		else
-		{
-			emiter->particles[i].color[3] += elapsedTime/5;
-			emiter->particles[i].position[0] += emiter->particles[i].velocity[0] * elapsedTime;
-			emiter->particles[i].position[1] += emiter->particles[i].velocity[1] * elapsedTime;
-			emiter->particles[i].position[2] += emiter->particles[i].velocity[2] * elapsedTime;
-		}
-		emiter->points[i].x = emiter->particles[i].position[0];
-		emiter->points[i].y = emiter->particles[i].position[1];
-		emiter->points[i].z = emiter->particles[i].position[2];
-	}
 }
 
 void SprintGame::initEngineParticle4(ParticleEmiter* emiter)
@@ -469,31 +387,4 @@ void SprintGame::updateEngineParticle4(ParticleEmiter* emiter, const float elaps
 {
 	emiter->origin = vehicle->entityState.position;
 	emiter->origin += Vector3D(0.16f,-0.03f,0.13f);
-	for(int i = 0; i < emiter->particleAmount; i++)
-	{
-		emiter->particles[i].lifeTime -= elapsedTime;
-		if(emiter->particles[i].lifeTime < 0.0f)
-		{
-			emiter->particles[i].lifeTime = 1.0f;
-			emiter->particles[i].position[0] = 0.0f;
-			emiter->particles[i].position[1] = 0.0f;
-			emiter->particles[i].position[2] = 0.0f;
-			emiter->particles[i].color[3] = 0.0f;
-			emiter->particles[i].velocity[2] = 0.0f;
-
-			emiter->particles[i].velocity[0] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[1] = CommonMath::random(-0.01f,0.01f);
-			emiter->particles[i].velocity[2] = CommonMath::random(0.0f,0.06f);
-		}
-		else
-		{
-			emiter->particles[i].color[3] += elapsedTime/5;
-			emiter->particles[i].position[0] += emiter->particles[i].velocity[0] * elapsedTime;
-			emiter->particles[i].position[1] += emiter->particles[i].velocity[1] * elapsedTime;
-			emiter->particles[i].position[2] += emiter->particles[i].velocity[2] * elapsedTime;
-		}
-		emiter->points[i].x = emiter->particles[i].position[0];
-		emiter->points[i].y = emiter->particles[i].position[1];
-		emiter->points[i].z = emiter->particles[i].position[2];
-	}
 }
\ No newline at end of file
@@ -10,11 +10,43 @@
 #include "AyumiDemo.hpp"
 #include "SprintGame.hpp"
 #include "ReflexGame.hpp"
+#include "RenderHarness.hpp"
+#include "ClusterBenchmark.hpp"
 
 using namespace std;
 
-int main()
+int main(int argc, char* argv[])
 {
+	bool harnessMode = false;
+	bool updateGoldens = false;
+	bool clusterBenchmark = false;
+	for(int i = 1; i < argc; ++i)
+	{
+		if(string(argv[i]) == "--harness")
+			harnessMode = true;
+		else if(string(argv[i]) == "--update-goldens")
+			updateGoldens = true;
+		else if(string(argv[i]) == "--cluster-benchmark")
+			clusterBenchmark = true;
+	}
+
+	if(clusterBenchmark)
+	{
+		ClusterBenchmark* benchmark = new ClusterBenchmark();
+		bool passed = benchmark->runBenchmark();
+		cout << benchmark->getSummary() << endl;
+		delete benchmark;
+		return passed ? 0 : 1;
+	}
+
+	if(harnessMode)
+	{
+		RenderHarness* harness = new RenderHarness("Data/Scripts/harness.lua");
+		harness->setUpdateGoldens(updateGoldens);
+		bool passed = harness->runHarness();
+		delete harness;
+		return passed ? 0 : 1;
+	}
 
 	runSkyDemo();
 	//runIntelDemo();